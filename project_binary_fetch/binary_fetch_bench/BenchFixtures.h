@@ -0,0 +1,151 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/*
+ ---------------------------------------------------------
+                    Benchmark Fixtures
+ ---------------------------------------------------------
+
+  Inputs for BinaryFetchBench, recorded from real
+  machines so every run measures the same work no matter
+  what hardware the benchmark runs on. Each fixture carries
+  the output the collector produced for it, so a benchmark
+  that silently stops doing the real work is caught too.
+
+  To add one: capture the raw input (EDID block, WMI value,
+  memory module record, ...) on the machine,
+  paste it below and note the expected result.
+
+  Inputs of the portable parsers (/proc, sysfs, SMBIOS, CPUID)
+  live per module in ..\tests\fixtures, where the test target
+  checks them on every platform; the bench only times those.
+*/
+namespace Fixtures {
+
+// ---------------- DisplayInfo::parseEDID ----------------
+
+struct EdidFixture {
+    const char* label;
+    std::vector<unsigned char> bytes;
+    std::string name;   // expected friendlyName
+    int width;          // expected native width
+    int height;         // expected native height
+};
+
+inline const std::vector<EdidFixture>& edids() {
+    static const std::vector<EdidFixture> list = {
+        { "Dell U2720Q (4K, DP)", {
+            0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x10, 0xAC, 0xD4, 0xA0, 0x4C, 0x33, 0x50, 0x30,
+            0x1F, 0x1E, 0x01, 0x04, 0xB5, 0x3C, 0x22, 0x78, 0x3A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4D, 0xD0, 0x00, 0xA0, 0xF0, 0x70, 0x3C, 0x80, 0x30, 0x20,
+            0x35, 0x00, 0x55, 0x50, 0x21, 0x00, 0x00, 0x1A, 0x00, 0x00, 0x00, 0xFD, 0x00, 0x18, 0x4B, 0x1E,
+            0x8C, 0x3C, 0x00, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00, 0x00, 0x00, 0xFC, 0x00, 0x44,
+            0x45, 0x4C, 0x4C, 0x20, 0x55, 0x32, 0x37, 0x32, 0x30, 0x51, 0x0A, 0x20, 0x00, 0x00, 0x00, 0xFF,
+            0x00, 0x34, 0x4C, 0x33, 0x50, 0x30, 0x46, 0x50, 0x4A, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x01, 0x0D },
+          "DELL U2720Q", 3840, 2160 },
+
+        { "1080p panel, padded name", {
+            0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x10, 0xAC, 0xD4, 0xA0, 0x4C, 0x33, 0x50, 0x30,
+            0x1F, 0x1E, 0x01, 0x04, 0xB5, 0x3C, 0x22, 0x78, 0x3A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4D, 0xD0, 0x80, 0xA0, 0x70, 0x38, 0x3C, 0x40, 0x30, 0x20,
+            0x35, 0x00, 0x55, 0x50, 0x21, 0x00, 0x00, 0x1A, 0x00, 0x00, 0x00, 0xFD, 0x00, 0x18, 0x4B, 0x1E,
+            0x8C, 0x3C, 0x00, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00, 0x00, 0x00, 0xFC, 0x00, 0x56,
+            0x47, 0x32, 0x34, 0x38, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00, 0x00, 0x00, 0xFF,
+            0x00, 0x34, 0x4C, 0x33, 0x50, 0x30, 0x46, 0x50, 0x4A, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x01, 0x3C },
+          "VG248", 1920, 1080 },
+    };
+    return list;
+}
+
+
+// ---------------- CPUInfo::cache_size_label ----------------
+
+// Labels of the totals CpuTopology::fromSysfs sums from the recorded tree in
+// fixtures/CpuTopologyFixtures.h: 4 x 80 KB L1, 4 x 2 MB L2, 2 x 32 MB L3
+inline const char* expectedCacheLabel(int level) {
+    return level == 1 ? "320 KB" : level == 2 ? "8 MB" : "64 MB";
+}
+
+
+// ---------------- MemoryInfo ----------------
+
+struct MemoryFixture {
+    unsigned long long capacityBytes;   // Win32_PhysicalMemory.Capacity
+    std::string capacity;               // expected capacityLabel()
+    std::string type;
+    std::string speed;
+};
+
+inline const std::vector<MemoryFixture>& memoryModules() {
+    static const std::vector<MemoryFixture> list = {
+        { 17179869184ULL, "16GB", "DDR4", "3200 MHz" },
+        { 17179869184ULL, "16GB", "DDR4", "3200 MHz" },
+        { 8589934592ULL,  "8GB",  "DDR4", "2666 MHz" },
+        { 34359738368ULL, "32GB", "DDR5", "5600 MHz" },
+    };
+    return list;
+}
+
+
+// ---------------- StorageInfo::fill_capacity ----------------
+
+struct VolumeFixture {
+    unsigned long long totalBytes;   // GetDiskFreeSpaceExA
+    unsigned long long freeBytes;
+    std::string fileSystem;          // GetVolumeInformationA
+    std::string used;                // expected used_space
+    std::string total;               // expected total_space
+    std::string percent;             // expected used_percentage
+};
+
+inline const std::vector<VolumeFixture>& volumes() {
+    static const std::vector<VolumeFixture> list = {
+        { 511101108224ULL, 190232690688ULL, "NTFS",  "298.83", "476.00", "(62%)" },
+        { 2000381014016ULL, 1500285760512ULL, "NTFS", "465.75", "1863.00", "(25%)" },
+        { 31482445824ULL, 30001856512ULL, "exFAT", "1.38", "29.32", "(4%)" },
+        { 104857600ULL, 0ULL, "", "0.10", "0.10", "(100%)" },
+    };
+    return list;
+}
+
+
+// ---------------- NetworkInfo::format_speed ----------------
+
+struct SpeedFixture {
+    double mbps;
+    std::string text;
+};
+
+inline const std::vector<SpeedFixture>& speeds() {
+    static const std::vector<SpeedFixture> list = {
+        { 0.85, "850 Kbps" }, { 45.27, "45.3 Mbps" }, { 940.0, "940.0 Mbps" }, { 1210.0, "1.2 Gbps" },
+    };
+    return list;
+}
+
+
+// ---------------- AsciiArt width paths ----------------
+
+struct WidthFixture {
+    std::string line;   // as pushed into LivePrinter
+    size_t width;       // expected visible_width
+};
+
+inline const std::vector<WidthFixture>& infoLines() {
+    static const std::vector<WidthFixture> list = {
+        { "\x1b[31m[OS]\x1b[0m  -> \x1b[32mWindows 11 Pro\x1b[0m \x1b[34m(Build 22631)\x1b[0m (\x1b[33m64-bit\x1b[0m) (uptime: 2h 14m)", 63 },
+        { "\x1b[38;5;208m[CPU]\x1b[0m -> AMD Ryzen 7 5800X 8-Core Processor (8C/16T) @ 3.80 GHz", 63 },
+        { "\x1b[36m[Memory]\x1b[0m -> (total: 64 GB) (free: 41 GB) (\x1b[33m35%\x1b[0m)", 46 },
+        { "[Display 1] -> DELL U2720Q (3840 x 2160) (scale: 150%) (upscale: 1x) (60 Hz)", 76 },
+        { "[User] -> \xE6\x9D\x8E\xE9\x9B\xB7 @ DESKTOP-7Q2 (admin)", 36 },
+        { "", 0 },
+    };
+    return list;
+}
+
+} // namespace Fixtures
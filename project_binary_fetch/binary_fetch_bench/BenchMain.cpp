@@ -0,0 +1,27 @@
+#include "Benchmark.h"
+#include <iostream>
+#include <cstdlib>
+#include <string>
+
+/*
+  BinaryFetchBench [iterations]
+
+  Entry point of the benchmark project. Kept out of BinaryFetch.exe so
+  the allocation counter in Benchmark.cpp never wraps a normal fetch,
+  --agent or --watch run.
+*/
+int main(int argc, char* argv[]) {
+    size_t iterations = 20000;
+
+    if (argc > 1) {
+        std::string arg = argv[1];
+        if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: BinaryFetchBench [iterations]   (default 20000)\n";
+            return 0;
+        }
+        long n = std::atol(argv[1]);
+        if (n > 0) iterations = static_cast<size_t>(n);
+    }
+
+    return runBenchmarks(iterations);
+}
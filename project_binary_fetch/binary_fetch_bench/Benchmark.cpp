@@ -0,0 +1,388 @@
+#include "Benchmark.h"
+#include "BenchFixtures.h"
+#include "fixtures/CpuSamplerFixtures.h"
+#include "fixtures/CpuTopologyFixtures.h"
+#include "fixtures/CpuidFixtures.h"
+#include "fixtures/ProcessCounterFixtures.h"
+#include "fixtures/PressureInfoFixtures.h"
+#include "fixtures/NumaInfoFixtures.h"
+#include "fixtures/MemorySnapshotFixtures.h"
+#include "fixtures/MemoryPressureFixtures.h"
+#include "fixtures/CgroupLimitsFixtures.h"
+#include "fixtures/MountTableFixtures.h"
+#include "fixtures/SmbiosFixtures.h"
+#include "CPUInfo.h"
+#include "MemoryInfo.h"
+#include "StorageInfo.h"
+#include "NetworkInfo.h"
+#include "DisplayInfo.h"
+#include "AsciiArt.h"
+#include "CpuSampler.h"
+#include "CpuTopology.h"
+#include "Cpuid.h"
+#include "ProcessCounter.h"
+#include "TopProcesses.h"
+#include "PressureInfo.h"
+#include "NumaInfo.h"
+#include "MemorySnapshot.h"
+#include "Smbios.h"
+#include "MemoryPressure.h"
+#include "CgroupLimits.h"
+#include "MountTable.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+// ---------------- Allocation counter ----------------
+
+// Every heap allocation in BinaryFetchBench goes through here. The hook
+// only exists in this project; BinaryFetch.exe keeps the default allocator.
+static thread_local size_t allocationCount = 0;
+
+void* operator new(std::size_t size) {
+    allocationCount++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    allocationCount++;
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+
+// ---------------- Benchmark ----------------
+
+constexpr size_t Benchmark::BatchSize;   // bound to const& by std::max (MSVC builds as C++14)
+
+void Benchmark::run(const std::string& name, const Op& op) {
+    using clock = std::chrono::steady_clock;
+
+    // Warm-up: first-call costs (static regex, locale facets) are not what we measure
+    volatile size_t sink = 0;
+    for (size_t i = 0; i < (std::max<size_t>)(iterations / 10, BatchSize); ++i) sink += op();
+
+    size_t batches = (std::max<size_t>)(iterations / BatchSize, 1);
+    std::vector<double> samples;
+    samples.reserve(batches);
+
+    size_t allocsBefore = allocationCount;
+    auto start = clock::now();
+    for (size_t b = 0; b < batches; ++b) {
+        auto t0 = clock::now();
+        for (size_t i = 0; i < BatchSize; ++i) sink += op();
+        auto t1 = clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count() / BatchSize);
+    }
+    auto end = clock::now();
+    size_t allocs = allocationCount - allocsBefore;   // samples was reserved, so only op() allocates
+
+    size_t ops = batches * BatchSize;
+    std::sort(samples.begin(), samples.end());
+
+    Result r;
+    r.name = name;
+    r.nsPerOp = std::chrono::duration<double, std::nano>(end - start).count() / ops;
+    r.allocsPerOp = static_cast<double>(allocs) / ops;
+    r.p50Ns = samples[samples.size() / 2];
+    r.p99Ns = samples[(std::min)(samples.size() - 1, samples.size() * 99 / 100)];
+    results.push_back(r);
+}
+
+void Benchmark::fail(const std::string& name, const std::string& detail) {
+    failures.push_back(name + ": " + detail);
+}
+
+int Benchmark::report() const {
+    size_t width = 9;
+    for (const auto& r : results) width = (std::max)(width, r.name.size());
+
+    std::cout << "BinaryFetch benchmarks (" << iterations << " iterations, fixture data)\n\n";
+    std::cout << "  " << std::left << std::setw(static_cast<int>(width)) << "benchmark"
+        << std::right << std::setw(12) << "ns/op" << std::setw(12) << "allocs/op"
+        << std::setw(12) << "p50 ns" << std::setw(12) << "p99 ns" << "\n";
+
+    std::cout << std::fixed;
+    for (const auto& r : results) {
+        std::cout << "  " << std::left << std::setw(static_cast<int>(width)) << r.name << std::right
+            << std::setprecision(1) << std::setw(12) << r.nsPerOp
+            << std::setprecision(2) << std::setw(12) << r.allocsPerOp
+            << std::setprecision(1) << std::setw(12) << r.p50Ns
+            << std::setw(12) << r.p99Ns << "\n";
+    }
+    std::cout << std::defaultfloat;
+
+    if (failures.empty()) return 0;
+
+    std::cout << "\nFixture mismatches (the numbers above measured the wrong thing):\n";
+    for (const auto& f : failures) std::cout << "  " << f << "\n";
+    return 1;
+}
+
+
+// ---------------- Suite ----------------
+
+int runBenchmarks(size_t iterations) {
+    namespace fx = Fixtures;
+    Benchmark bench(iterations);
+
+    // CPUInfo: Task Manager style labels of the cache totals CpuTopology sums
+    // from a recorded sysfs tree (the sums themselves are checked in ..\tests)
+    const fx::SysfsTopologyFixture& tree = fx::sysfsTopology();
+    CpuTopology::FileReader readTree = [&](const std::string& path) {
+        auto it = tree.files.find(path);
+        return it == tree.files.end() ? std::string() : it->second;
+    };
+    const CpuTopology topology = CpuTopology::fromSysfs(readTree);
+    for (int level = 1; level <= 3; ++level) {
+        if (CPUInfo::cache_size_label(topology.cacheBytes[level], level) != fx::expectedCacheLabel(level)) {
+            bench.fail("CPUInfo::cache_size_label", "L" + std::to_string(level));
+        }
+    }
+    bench.run("CPUInfo::cache_size_label (L1-L3)", [&] {
+        size_t n = 0;
+        for (int level = 1; level <= 3; ++level) n += CPUInfo::cache_size_label(topology.cacheBytes[level], level).size();
+        return n;
+    });
+
+    // MemoryInfo: capacity labels, then the cache round trip of the module list
+    std::vector<MemoryModule> modules;
+    for (const auto& m : fx::memoryModules()) {
+        if (MemoryInfo::capacityLabel(m.capacityBytes) != m.capacity) bench.fail("MemoryInfo::capacityLabel", m.capacity);
+        modules.push_back({ m.capacity, m.type, m.speed });
+    }
+    const std::string packed = MemoryInfo::packModules(modules);
+    if (MemoryInfo::unpackModules(packed).size() != modules.size()) bench.fail("MemoryInfo::unpackModules", "module count");
+
+    bench.run("MemoryInfo::capacityLabel", [&] {
+        size_t n = 0;
+        for (const auto& m : fx::memoryModules()) n += MemoryInfo::capacityLabel(m.capacityBytes).size();
+        return n;
+    });
+    bench.run("MemoryInfo::packModules", [&] { return MemoryInfo::packModules(modules).size(); });
+    bench.run("MemoryInfo::unpackModules", [&] { return MemoryInfo::unpackModules(packed).size(); });
+
+    // StorageInfo: size / percent / file system strings per volume
+    for (const auto& v : fx::volumes()) {
+        storage_data d;
+        StorageInfo::fill_capacity(d, v.totalBytes, v.freeBytes, v.fileSystem);
+        if (d.used_space != v.used || d.total_space != v.total || d.used_percentage != v.percent) {
+            bench.fail("StorageInfo::fill_capacity", v.total + " GiB volume");
+        }
+    }
+    bench.run("StorageInfo::fill_capacity", [&] {
+        size_t n = 0;
+        storage_data d;
+        for (const auto& v : fx::volumes()) {
+            StorageInfo::fill_capacity(d, v.totalBytes, v.freeBytes, v.fileSystem);
+            n += d.used_space.size() + d.total_space.size();
+        }
+        return n;
+    });
+
+    // NetworkInfo: speed strings
+    for (const auto& s : fx::speeds()) {
+        if (NetworkInfo::format_speed(s.mbps) != s.text) bench.fail("NetworkInfo::format_speed", s.text);
+    }
+    bench.run("NetworkInfo::format_speed", [&] {
+        size_t n = 0;
+        for (const auto& s : fx::speeds()) n += NetworkInfo::format_speed(s.mbps).size();
+        return n;
+    });
+
+    // DisplayInfo: EDID blocks
+    for (const auto& e : fx::edids()) {
+        DisplayInfo::EDIDInfo info = DisplayInfo::parseEDID(e.bytes.data(), e.bytes.size());
+        if (!info.valid || info.friendlyName != e.name || info.nativeWidth != e.width || info.nativeHeight != e.height) {
+            bench.fail("DisplayInfo::parseEDID", e.label);
+        }
+    }
+    bench.run("DisplayInfo::parseEDID", [&] {
+        size_t n = 0;
+        for (const auto& e : fx::edids()) n += DisplayInfo::parseEDID(e.bytes.data(), e.bytes.size()).friendlyName.size();
+        return n;
+    });
+
+    // AsciiArt: the width math LivePrinter runs for every info line
+    for (const auto& l : fx::infoLines()) {
+        if (visible_width(l.line) != l.width) bench.fail("visible_width", "\"" + stripAnsiSequences(l.line) + "\"");
+    }
+    bench.run("AsciiArt stripAnsiSequences", [&] {
+        size_t n = 0;
+        for (const auto& l : fx::infoLines()) n += stripAnsiSequences(l.line).size();
+        return n;
+    });
+    bench.run("AsciiArt visible_width", [&] {
+        size_t n = 0;
+        for (const auto& l : fx::infoLines()) n += visible_width(l.line);
+        return n;
+    });
+
+
+    // Portable parsers below: correctness is checked per module by the
+    // ..\tests target, so these only time the same recorded inputs.
+
+    // CpuSampler: /proc/stat text -> per-CPU counters, clock window summary, delta kernel
+    const fx::ProcStatFixture& stat = fx::procStat();
+    std::vector<uint64_t> busy(stat.cores), total(stat.cores);
+    uint64_t aggBusy = 0, aggTotal = 0;
+    bench.run("CpuSampler::parseProcStat", [&] {
+        return CpuSampler::parseProcStat(stat.after.data(), stat.after.size(), aggBusy, aggTotal, busy.data(), total.data(), stat.cores);
+    });
+
+    const fx::ClockFixture& clocks = fx::clockWindow();
+    bench.run("CpuSampler::clockSummary (4 x 4)", [&] {
+        return CpuSampler::clockSummary(clocks.mhz.data(), clocks.samples, clocks.cores, clocks.ceiling.data()).samples;
+    });
+
+    // Kernel at server width: 256 CPUs per call
+    const size_t wide = 256;
+    std::vector<uint64_t> wideBusyOld(wide), wideTotalOld(wide), wideBusyNew(wide), wideTotalNew(wide);
+    for (size_t i = 0; i < wide; ++i) {
+        wideTotalOld[i] = 1000000 + i * 977;
+        wideBusyOld[i] = wideTotalOld[i] / 3;
+        wideTotalNew[i] = wideTotalOld[i] + 100 + (i % 7);
+        wideBusyNew[i] = wideBusyOld[i] + (i % 101);
+    }
+    std::vector<float> wideUsage(wide);
+    bench.run("CpuSampler::coreDeltaKernel (256 CPUs)", [&] {
+        CpuSampler::coreDeltaKernel(wideBusyNew.data(), wideBusyOld.data(), wideTotalNew.data(), wideTotalOld.data(), wideUsage.data(), wide);
+        return static_cast<size_t>(wideUsage[wide - 1]);
+    });
+
+    // CpuTopology: one pass over the recorded sysfs tree with offline CPUs
+    bench.run("CpuTopology::fromSysfs (8 of 16 CPUs online)", [&] {
+        return static_cast<size_t>(CpuTopology::fromSysfs(readTree).cores);
+    });
+
+    // Cpuid: recorded leaves through the decode tables
+    const fx::CpuidFixture& leaves = fx::cpuidSapphireRapidsKvm();
+    Cpuid::LeafSource recorded = [&](uint32_t leaf, uint32_t subleaf) {
+        Cpuid::Regs regs;
+        for (const auto& l : leaves.leaves) {
+            if (l.leaf == leaf && l.subleaf == subleaf) {
+                regs.eax = l.eax;
+                regs.ebx = l.ebx;
+                regs.ecx = l.ecx;
+                regs.edx = l.edx;
+            }
+        }
+        return regs;
+    };
+    bench.run("Cpuid::decode (recorded leaves)", [&] { return Cpuid::decode(recorded, leaves.xcr0).caches.size(); });
+
+    // ProcessCounter / TopProcesses: /proc/<pid>/stat lines
+    TopProcesses::StatFields fields;
+    bench.run("ProcessCounter::statThreads", [&] {
+        long long n = 0;
+        for (const auto& s : fx::procPidStats()) n += ProcessCounter::statThreads(s.line.data(), s.line.size());
+        return static_cast<size_t>(n);
+    });
+    bench.run("TopProcesses::parseStat", [&] {
+        size_t n = 0;
+        for (const auto& s : fx::procPidStats()) n += TopProcesses::parseStat(s.line.data(), s.line.size(), fields) ? fields.rssPages : 0;
+        return n;
+    });
+
+    // PressureInfo: one PSI file and /proc/loadavg
+    const std::string psi = fx::psiIo();
+    const std::string loadavg = fx::loadavg();
+    PressureInfo::Stall stall;
+    PressureInfo::Load load;
+    bench.run("PressureInfo::parseStall + parseLoadavg", [&] {
+        PressureInfo::parseStall(psi.data(), psi.size(), stall);
+        PressureInfo::parseLoadavg(loadavg.data(), loadavg.size(), load);
+        return static_cast<size_t>(load.running);
+    });
+
+    // NumaInfo: nodeN/{meminfo,cpulist}
+    const std::string nodeMeminfo = fx::numaNodeMeminfo();
+    const std::string cpulist = fx::numaCpulist();
+    NumaInfo::Node node;
+    bench.run("NumaInfo::parseNodeMeminfo + countCpus", [&] {
+        NumaInfo::parseNodeMeminfo(nodeMeminfo.data(), nodeMeminfo.size(), node.totalBytes, node.freeBytes);
+        return static_cast<size_t>(NumaInfo::countCpus(cpulist.data(), cpulist.size())) + static_cast<size_t>(node.freeBytes);
+    });
+
+    // MemorySnapshot: the one /proc/meminfo parse every RAM figure comes from
+    const std::string meminfo = fx::procMeminfo();
+    bench.run("MemorySnapshot::parseMeminfo", [&] {
+        MemorySnapshot s;
+        MemorySnapshot::parseMeminfo(meminfo.data(), meminfo.size(), s);
+        return static_cast<size_t>(s.availableBytes);
+    });
+
+    // MemoryPressure: perfect-hash vmstat scan
+    const std::string vmstat = fx::procVmstat();
+    bench.run("MemoryPressure::parseVmstat", [&] {
+        MemoryPressure::Counters c;
+        MemoryPressure::parseVmstat(vmstat.data(), vmstat.size(), c);
+        return static_cast<size_t>(c.pgfault);
+    });
+
+    // CgroupLimits: memory.stat of a 4 GiB container
+    const std::string memoryStat = fx::cgroupMemoryStat();
+    bench.run("CgroupLimits::parseMemoryStat", [&] {
+        CgroupLimits c;
+        CgroupLimits::parseMemoryStat(memoryStat.data(), memoryStat.size(), c);
+        return static_cast<size_t>(c.inactiveFileBytes);
+    });
+
+    // MountTable: workstation with Docker and NFS
+    const std::string mountinfo = fx::mountinfo();
+    bench.run("MountTable::MountinfoParser", [&] {
+        MountTable::MountinfoParser p;
+        p.feed(mountinfo.data(), mountinfo.size());
+        return p.finish().size();
+    });
+
+    // Smbios: captured tables (the fuzz pass lives in tests\SmbiosTests.cpp)
+    bench.run("Smbios::parse", [&] {
+        size_t n = 0;
+        for (const auto& t : fx::smbiosTables()) n += Smbios::parse(t.table.data(), t.table.size()).dimms.size();
+        return n;
+    });
+
+    return bench.report();
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: Benchmark
+OBJECT: bench (runBenchmarks, called from BenchMain.cpp)
+DESCRIPTION: Micro-benchmarks of collector parsing/formatting on fixture data.
+FUNCTIONS:
+    void run(const std::string& name, const Op& op)
+        Warm up, then time op in batches of BatchSize and record
+        ns/op, allocs/op, p50 and p99.
+
+    void fail(const std::string& name, const std::string& detail)
+        Record a fixture whose output no longer matches.
+
+    int report() const
+        Print the table; 1 if any fixture mismatched, else 0.
+
+    int runBenchmarks(size_t iterations)
+        The suite: CPUInfo, MemoryInfo, StorageInfo, NetworkInfo,
+        DisplayInfo EDID parsing and the AsciiArt width helpers
+        (checked here), then timings of the portable parsers whose
+        checks live in ..\tests.
+
+ADDING A BENCHMARK:
+    1. Move the parsing/formatting out of the WinAPI/WMI call into a
+       static member of the collector (see CPUInfo::cache_size_label)
+    2. Windows-only input: record it + the expected output in
+       BenchFixtures.h and check it once here. Portable parser: add
+       ..\tests\fixtures\<Module>Fixtures.h and <Module>Tests.cpp
+    3. bench.run() it here
+*/
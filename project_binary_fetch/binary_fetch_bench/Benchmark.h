@@ -0,0 +1,63 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+/*
+ ---------------------------------------------------------
+                    Benchmark Class
+ ---------------------------------------------------------
+
+  "BinaryFetchBench [iterations]" runs the parsing and
+  formatting code of the collectors against the recorded
+  inputs in BenchFixtures.h (no WMI, no hardware access),
+  so numbers are comparable between machines and releases.
+
+  This is its own project (binary_fetch_bench.vcxproj) that
+  compiles the collector sources next to Benchmark.cpp; the
+  allocation counter below replaces operator new in this
+  executable only, never in BinaryFetch.exe.
+
+  Per benchmark it reports:
+    ns/op       mean time of one operation
+    allocs/op   heap allocations (global operator new) per operation
+    p50 / p99   percentiles over batches of BatchSize operations
+
+  An operation returns a checksum (e.g. the length of the
+  string it built) so the optimizer can't drop the work.
+*/
+class Benchmark {
+public:
+    using Op = std::function<size_t()>;
+
+    struct Result {
+        std::string name;
+        double nsPerOp = 0;
+        double allocsPerOp = 0;
+        double p50Ns = 0;
+        double p99Ns = 0;
+    };
+
+    explicit Benchmark(size_t iterationCount) : iterations(iterationCount) {}
+
+    // Time op iterations times (after a short warm-up) and keep the result
+    void run(const std::string& name, const Op& op);
+
+    // Fixture output didn't match what the collector produced when it was recorded
+    void fail(const std::string& name, const std::string& detail);
+
+    // Print the results table (and any failures); returns the process exit code
+    int report() const;
+
+    static constexpr size_t BatchSize = 16;   // ops per timed sample
+
+private:
+    size_t iterations;
+    std::vector<Result> results;
+    std::vector<std::string> failures;
+};
+
+// Run the whole suite (see Benchmark.cpp) and print the table
+int runBenchmarks(size_t iterations);
@@ -0,0 +1,382 @@
+#include "Agent.h"
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>       // AF_UNIX on Windows 10 1803+
+#include <windows.h>
+#include <sddl.h>
+#pragma comment(lib, "ws2_32.lib")
+#pragma comment(lib, "advapi32.lib")
+typedef SOCKET socket_t;
+static const socket_t kInvalidSocket = INVALID_SOCKET;
+static void closeSocket(socket_t s) { closesocket(s); }
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/time.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+typedef int socket_t;
+static const socket_t kInvalidSocket = -1;
+static void closeSocket(socket_t s) { close(s); }
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0    // Windows has no SIGPIPE
+#endif
+
+static const char* kSnapshotHeader = "BFSNAP 1";
+
+// ---------------- Helpers ----------------
+
+static bool socketsReady() {
+#ifdef _WIN32
+    static bool ok = [] {
+        WSADATA wsa;
+        return WSAStartup(MAKEWORD(2, 2), &wsa) == 0;
+    }();
+    return ok;
+#else
+    return true;
+#endif
+}
+
+// ---- Private socket directory ----
+// The snapshot holds the user name, IPs and process list, and the client
+// prints whatever the socket sends, so the socket has to live somewhere
+// no other local user can read, create or replace files.
+
+#ifdef _WIN32
+// DACL granting the current user (and SYSTEM) full access, nothing inherited
+static std::string userOnlySddl() {
+    HANDLE token = nullptr;
+    if (!OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY, &token)) return "";
+
+    std::string sddl;
+    DWORD size = 0;
+    GetTokenInformation(token, TokenUser, nullptr, 0, &size);
+    std::vector<BYTE> buffer(size);
+    if (size > 0 && GetTokenInformation(token, TokenUser, buffer.data(), size, &size)) {
+        LPSTR sid = nullptr;
+        if (ConvertSidToStringSidA(reinterpret_cast<TOKEN_USER*>(buffer.data())->User.Sid, &sid)) {
+            sddl = std::string("D:P(A;OICI;FA;;;") + sid + ")(A;OICI;FA;;;SY)";
+            LocalFree(sid);
+        }
+    }
+    CloseHandle(token);
+    return sddl;
+}
+
+// Create the directory with the user-only DACL, or re-apply it to an existing one
+static bool privateDirectory(const std::string& dir) {
+    std::string sddl = userOnlySddl();
+    PSECURITY_DESCRIPTOR sd = nullptr;
+    if (sddl.empty() || !ConvertStringSecurityDescriptorToSecurityDescriptorA(sddl.c_str(), SDDL_REVISION_1, &sd, nullptr)) return false;
+
+    SECURITY_ATTRIBUTES sa = { sizeof(sa), sd, FALSE };
+    bool ok = CreateDirectoryA(dir.c_str(), &sa) != 0;
+    if (!ok && GetLastError() == ERROR_ALREADY_EXISTS) {
+        DWORD attrs = GetFileAttributesA(dir.c_str());
+        ok = attrs != INVALID_FILE_ATTRIBUTES && (attrs & FILE_ATTRIBUTE_DIRECTORY) && !(attrs & FILE_ATTRIBUTE_REPARSE_POINT)
+            && SetFileSecurityA(dir.c_str(), DACL_SECURITY_INFORMATION, sd) != 0;
+    }
+    LocalFree(sd);
+    return ok;
+}
+#else
+// A real directory (not a symlink) owned by us with no group/other access;
+// created 0700 if missing. Anything else is refused rather than "fixed".
+static bool privateDirectory(const std::string& dir) {
+    if (mkdir(dir.c_str(), 0700) != 0 && errno != EEXIST) return false;
+    struct stat st;
+    return lstat(dir.c_str(), &st) == 0 && S_ISDIR(st.st_mode) && st.st_uid == getuid() && (st.st_mode & 077) == 0;
+}
+
+// The agent on the other end runs as this user: the socket file is ours,
+// and so is the process that accepted the connection
+static bool ownedByUs(const std::string& socketPath, socket_t s) {
+    struct stat st;
+    if (lstat(socketPath.c_str(), &st) != 0 || !S_ISSOCK(st.st_mode) || st.st_uid != getuid()) return false;
+#ifdef SO_PEERCRED
+    struct ucred peer;
+    socklen_t length = sizeof(peer);
+    if (getsockopt(s, SOL_SOCKET, SO_PEERCRED, &peer, &length) != 0 || peer.uid != getuid()) return false;
+#else
+    (void)s;
+#endif
+    return true;
+}
+#endif
+
+static bool makeAddress(const std::string& path, sockaddr_un& addr) {
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) return false;
+    std::memcpy(addr.sun_path, path.c_str(), path.size());
+    return true;
+}
+
+static void removeSocketFile(const std::string& path) {
+#ifdef _WIN32
+    DeleteFileA(path.c_str());
+#else
+    unlink(path.c_str());
+#endif
+}
+
+static bool sendAll(socket_t s, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        int n = send(s, data.data() + sent, static_cast<int>(data.size() - sent), MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+static std::string serialize(const AgentSnapshot& snap) {
+    std::ostringstream out;
+    out << kSnapshotHeader << '\n'
+        << "config " << std::hex << snap.configHash << std::dec << '\n'
+        << "taken " << snap.takenAtMs << '\n'
+        << "interval " << snap.intervalMs << '\n'
+        << "lines " << snap.lines.size() << '\n';
+    for (const auto& line : snap.lines) out << line << '\n';
+    return out.str();
+}
+
+static bool parse(const std::string& data, AgentSnapshot& snap) {
+    std::istringstream in(data);
+    std::string header, key;
+    size_t count = 0;
+
+    if (!std::getline(in, header) || header != kSnapshotHeader) return false;
+    if (!(in >> key >> std::hex >> snap.configHash >> std::dec) || key != "config") return false;
+    if (!(in >> key >> snap.takenAtMs) || key != "taken") return false;
+    if (!(in >> key >> snap.intervalMs) || key != "interval") return false;
+    if (!(in >> key >> count) || key != "lines") return false;
+    in.ignore(1);   // the '\n' after the count
+
+    snap.lines.clear();
+    std::string line;
+    while (snap.lines.size() < count && std::getline(in, line)) snap.lines.push_back(line);
+    return snap.lines.size() == count;
+}
+
+
+// Connect, read until the agent closes, parse. No freshness checks.
+static bool readSnapshot(const std::string& socketPath, AgentSnapshot& out, int timeoutMs) {
+    if (socketPath.empty() || !socketsReady()) return false;
+
+    sockaddr_un addr;
+    if (!makeAddress(socketPath, addr)) return false;
+
+    socket_t s = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (s == kInvalidSocket) return false;
+
+    // A hung agent must not be slower than just collecting ourselves
+#ifdef _WIN32
+    DWORD tv = static_cast<DWORD>(timeoutMs);
+#else
+    timeval tv;
+    tv.tv_sec = timeoutMs / 1000;
+    tv.tv_usec = (timeoutMs % 1000) * 1000;
+#endif
+    setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&tv), sizeof(tv));
+
+    if (connect(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        closeSocket(s);
+        return false;
+    }
+#ifndef _WIN32
+    if (!ownedByUs(socketPath, s)) {
+        closeSocket(s);
+        return false;
+    }
+#endif
+
+    std::string data;
+    char buf[16384];
+    for (;;) {
+        int n = recv(s, buf, sizeof(buf), 0);
+        if (n < 0) { closeSocket(s); return false; }   // timeout or error
+        if (n == 0) break;                              // agent closed: snapshot complete
+        data.append(buf, static_cast<size_t>(n));
+    }
+    closeSocket(s);
+
+    return parse(data, out);
+}
+
+
+// ---------------- Free functions ----------------
+
+std::string agentSocketPath() {
+#ifdef _WIN32
+    const char* localAppData = std::getenv("LOCALAPPDATA");
+    if (!localAppData || !*localAppData) return "";
+    std::string dir = std::string(localAppData) + "\\BinaryFetch";
+    return privateDirectory(dir) ? dir + "\\agent.sock" : "";
+#else
+    // $XDG_RUNTIME_DIR is per user and 0700 by spec, but is checked like the fallback
+    const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR");
+    if (runtimeDir && *runtimeDir && privateDirectory(runtimeDir)) return std::string(runtimeDir) + "/binaryfetch.sock";
+
+    std::string dir = "/tmp/binaryfetch-" + std::to_string(getuid());
+    return privateDirectory(dir) ? dir + "/agent.sock" : "";
+#endif
+}
+
+uint64_t agentConfigHash(const std::string& configDump) {
+    uint64_t h = 1469598103934665603ULL;   // FNV-1a
+    for (unsigned char c : configDump) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+uint64_t agentNowMs() {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count());
+}
+
+
+// ---------------- AgentServer ----------------
+
+AgentServer::AgentServer(const std::string& socketPath, uint64_t hash, uint32_t interval)
+    : path(socketPath), configHash(hash), intervalMs(interval) {}
+
+int AgentServer::run(Collect collect) {
+    if (path.empty()) {
+        std::cout << "Agent: no private per-user directory for the socket." << std::endl;
+        return 1;
+    }
+    if (!socketsReady()) {
+        std::cout << "Agent: socket library could not be initialised." << std::endl;
+        return 1;
+    }
+
+    // Only one agent per socket; a stale file from a crashed agent is removed
+    AgentSnapshot probe;
+    if (readSnapshot(path, probe, 200)) {
+        std::cout << "Agent: already running on " << path << std::endl;
+        return 1;
+    }
+    removeSocketFile(path);
+
+    std::mutex snapMtx;
+    std::string published;
+    auto sample = [&] {
+        AgentSnapshot snap;
+        snap.configHash = configHash;
+        snap.intervalMs = intervalMs;
+        snap.lines = collect();
+        snap.takenAtMs = agentNowMs();
+
+        std::string data = serialize(snap);
+        std::lock_guard<std::mutex> lock(snapMtx);
+        published.swap(data);
+    };
+
+    // First snapshot before listening, so no client ever sees an empty one
+    sample();
+
+    sockaddr_un addr;
+    if (!makeAddress(path, addr)) {
+        std::cout << "Agent: socket path too long: " << path << std::endl;
+        return 1;
+    }
+
+    socket_t listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener == kInvalidSocket) {
+        std::cout << "Agent: could not create socket." << std::endl;
+        return 1;
+    }
+    if (bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listener, 16) != 0) {
+        std::cout << "Agent: could not listen on " << path << std::endl;
+        closeSocket(listener);
+        return 1;
+    }
+
+    std::cout << "BinaryFetch agent listening on " << path
+        << " (refresh every " << intervalMs << " ms)" << std::endl;
+
+    // Sampler: keeps the snapshot fresh while the main thread serves it
+    std::thread sampler([&] {
+        for (;;) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+            try { sample(); }
+            catch (...) { /* keep serving the previous snapshot */ }
+        }
+    });
+    sampler.detach();
+
+    for (;;) {
+        socket_t client = accept(listener, nullptr, nullptr);
+        if (client == kInvalidSocket) continue;
+
+        std::string data;
+        {
+            std::lock_guard<std::mutex> lock(snapMtx);
+            data = published;
+        }
+        sendAll(client, data);
+        closeSocket(client);
+    }
+}
+
+
+
+// ---------------- AgentClient ----------------
+
+bool AgentClient::fetch(const std::string& socketPath, uint64_t expectedConfigHash, AgentSnapshot& out, int timeoutMs) {
+    if (!readSnapshot(socketPath, out, timeoutMs)) return false;
+
+    // Rendered with a different config -> not what the user asked for
+    if (out.configHash != expectedConfigHash) return false;
+
+    // Agent stopped sampling (suspended, stuck collector): don't show old numbers
+    uint64_t now = agentNowMs();
+    uint64_t maxAge = 2ULL * out.intervalMs + 1000;
+    if (out.takenAtMs > now + 1000 || now - out.takenAtMs > maxAge) return false;
+
+    return true;
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: AgentServer / AgentClient
+DESCRIPTION: "binaryfetch --agent" keeps collectors warm and serves snapshots;
+             a plain "binaryfetch" renders the snapshot instead of collecting.
+SOCKET (per user; agentSocketPath() returns "" and the agent is off
+        when the directory isn't private):
+    Windows : %LOCALAPPDATA%\BinaryFetch\agent.sock (AF_UNIX, Windows 10 1803+),
+              directory DACL: current user + SYSTEM only
+    Linux   : $XDG_RUNTIME_DIR/binaryfetch.sock, else /tmp/binaryfetch-<uid>/agent.sock;
+              directory must be ours, not a symlink, mode 0700. The client
+              also checks the socket owner and the agent's SO_PEERCRED uid
+PROTOCOL (text, one request per connection):
+    client connects, agent writes the snapshot and closes
+        BFSNAP 1
+        config <hex hash of the parsed config>
+        taken <ms since epoch>
+        interval <ms>
+        lines <n>
+        <n info lines>
+CLIENT FALLBACK (collect in-process) when:
+    - no agent / connect or read fails (200 ms read timeout)
+    - config hash differs (config edited since the agent started)
+    - snapshot older than two sampling intervals + 1 s
+*/
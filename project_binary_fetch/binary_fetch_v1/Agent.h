@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+/*
+ ---------------------------------------------------------
+                   AgentSnapshot Struct
+ ---------------------------------------------------------
+
+  One complete fetch, exactly as the sections pushed it into
+  LivePrinter (art is added by whoever renders it).
+*/
+struct AgentSnapshot {
+    uint64_t configHash = 0;          // agentConfigHash() of the config that produced it
+    uint64_t takenAtMs = 0;           // wall clock (ms since epoch) when collection finished
+    uint32_t intervalMs = 0;          // agent sampling interval (tells the client what "fresh" means)
+    std::vector<std::string> lines;   // info lines in print order
+};
+
+// Where the agent listens: a local Unix domain socket in a directory only
+// the current user can access ("" if no such directory could be set up)
+std::string agentSocketPath();
+
+// Stable hash of the parsed config, so a client never shows a snapshot
+// rendered with someone else's / an older config
+uint64_t agentConfigHash(const std::string& configDump);
+
+// Wall clock in ms, as stored in AgentSnapshot::takenAtMs
+uint64_t agentNowMs();
+
+
+
+/*
+ ---------------------------------------------------------
+                    AgentServer Class
+ ---------------------------------------------------------
+
+  "binaryfetch --agent" runs this instead of printing.
+
+  A sampler thread re-runs every enabled section each
+  interval (collectors stay constructed, COM / PDH stay
+  initialised, static facts stay in memory). The main thread
+  accepts connections on the Unix socket and answers each one
+  with the latest snapshot, then closes it.
+*/
+class AgentServer {
+public:
+    using Collect = std::function<std::vector<std::string>()>;
+
+    AgentServer(const std::string& socketPath, uint64_t configHash, uint32_t intervalMs);
+
+    // Blocks forever (returns a process exit code if the socket can't be set up)
+    int run(Collect collect);
+
+private:
+    std::string path;
+    uint64_t configHash;
+    uint32_t intervalMs;
+};
+
+
+
+/*
+ ---------------------------------------------------------
+                    AgentClient Class
+ ---------------------------------------------------------
+
+  Used by a plain "binaryfetch": connect, read the snapshot,
+  done. Any failure (no agent, stale snapshot, timeout) just
+  returns false and main() collects in-process as usual.
+*/
+class AgentClient {
+public:
+    // true only for a fresh snapshot rendered with the same config
+    static bool fetch(const std::string& socketPath, uint64_t expectedConfigHash, AgentSnapshot& out, int timeoutMs = 200);
+};
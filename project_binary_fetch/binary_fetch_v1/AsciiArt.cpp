@@ -16,6 +16,7 @@
 #include <direct.h>
 #else
 #include <sys/stat.h>
+#include <sys/ioctl.h>
 #include <unistd.h>
 #include <pwd.h>
 #endif
@@ -190,6 +191,7 @@ void LivePrinter::push(const std::string& infoLine) {
     printArtAndPad();
     if (!infoLine.empty()) std::cout << infoLine;
     std::cout << '\n';
+    history.push_back(infoLine);
     index++;
 }
 
@@ -216,6 +218,45 @@ void LivePrinter::finish() {
         index++;
     }
 }
+
+int terminal_rows() {
+#ifdef _WIN32
+    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+    CONSOLE_SCREEN_BUFFER_INFO csbi;
+    if (!GetConsoleScreenBufferInfo(hOut, &csbi)) return 0;   // redirected
+    return csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
+#else
+    if (!isatty(STDOUT_FILENO)) return 0;
+    struct winsize ws;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) != 0) return 0;
+    return ws.ws_row;
+#endif
+}
+
+bool LivePrinter::patch(int row, const std::vector<std::string>& lines) {
+    if (row < 0 || row >= (int)history.size()) return false;
+
+    // The cursor sits under the last printed row; every row from "row"
+    // down has to be visible to be rewritten in place.
+    int up = index - row;
+    int rows = terminal_rows();
+    if (rows == 0 || up >= rows) return false;
+
+    history.erase(history.begin() + row);
+    history.insert(history.begin() + row, lines.begin(), lines.end());
+
+    // ESC[nF = cursor up n lines to column 0, ESC[K = clear to end of line,
+    // ESC[J = clear below (the patch may be shorter than the placeholder)
+    std::cout << "\x1b[" << up << "F";
+    index = row;
+    for (size_t i = row; i < history.size(); ++i) {
+        printArtAndPad();
+        std::cout << history[i] << "\x1b[K\n";
+        index++;
+    }
+    std::cout << "\x1b[J" << std::flush;
+    return true;
+}
 /*
 Color Code Feature:
 Use $n in BinaryArt.txt to set colors (n = 1-15):
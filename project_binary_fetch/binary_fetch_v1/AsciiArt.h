@@ -32,6 +32,10 @@ size_t visible_width(const std::string& s);
 // This trims them so alignment doesn't break.
 void sanitizeLeadingInvisible(std::string& s);
 
+// Visible rows of the terminal window, or 0 if stdout is not a
+// terminal (redirected to a file/pipe). Cursor tricks need > 0.
+int terminal_rows();
+
 
 
 /*
@@ -128,9 +132,20 @@ public:
     // ASCII art lines that weren't paired with info.
     void finish();
 
+    // Row the next push() will land on
+    int currentRow() const { return index; }
+
+    // Replace an already printed row with zero or more lines
+    // (used to fill in a late placeholder). Rows below it are
+    // redrawn one art line further down if needed.
+    // Returns false when the row can't be reached any more
+    // (output is not a terminal, or it scrolled off screen).
+    bool patch(int row, const std::vector<std::string>& lines);
+
 private:
     const AsciiArt& art;   // reference to the loaded ASCII art
     int index;             // which art line we are currently on
+    std::vector<std::string> history;   // info line of every printed row (for patch)
 
     // Core helper: prints the art line + spacing
     void printArtAndPad();
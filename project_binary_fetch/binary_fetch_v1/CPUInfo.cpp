@@ -1,351 +1,166 @@
 #include "CPUInfo.h"
+#include "StaticFactsCache.h"
+#include "Profiler.h"
+#include "SystemQuery.h"
+#include "CpuSampler.h"
+#include "CpuTopology.h"
+#include "Cpuid.h"
+#include "ProcessCounter.h"
 #include <windows.h>
-#include <intrin.h>
 #include <vector>
 #include <sstream>
-#include <wbemidl.h>
-#include <pdh.h>
-#include <comdef.h>
 #include <iomanip>
 
-#pragma comment(lib, "pdh.lib")
-#pragma comment(lib, "wbemuuid.lib")
-
 using namespace std;
 
-//helper fucntion for WMI queries-----------------------------------------------------------------
-string wmi_querysingle_value(const wchar_t* query, const wchar_t* property_name)
-{
-	HRESULT hres;
-	IWbemLocator* locator = NULL;
-	IWbemServices* services = NULL;
-	IEnumWbemClassObject* enumerator = NULL;
-	IWbemClassObject* clsObj = NULL;
-	ULONG uReturn = 0;
-	string result = "Unknown";
-
-	hres = CoInitializeEx(0, COINIT_MULTITHREADED);
-	if (FAILED(hres))
-	{
-		hres = CoInitializeEx(0, COINIT_APARTMENTTHREADED);
-		if (FAILED(hres)) return result;
-	}
-
-	hres = CoInitializeSecurity(NULL, -1, NULL, NULL,
-		RPC_C_AUTHN_LEVEL_DEFAULT, RPC_C_IMP_LEVEL_IMPERSONATE, NULL, EOAC_NONE, NULL);
-	if (FAILED(hres) && hres != RPC_E_TOO_LATE)
-	{
-		CoUninitialize();
-		return result;
-	}
-
-	hres = CoCreateInstance(CLSID_WbemLocator, 0, CLSCTX_INPROC_SERVER, IID_IWbemLocator, (LPVOID*)&locator);
-	if (FAILED(hres))
-	{
-		CoUninitialize();
-		return result;
-	}
-
-	hres = locator->ConnectServer(_bstr_t(L"ROOT\\CIMV2"), NULL, NULL, 0, NULL, 0, 0, &services);
-	if (FAILED(hres))
-	{
-		locator->Release();
-		CoUninitialize();
-		return result;
-	}
-
-	hres = CoSetProxyBlanket(services, RPC_C_AUTHN_WINNT, RPC_C_AUTHZ_NONE, NULL,
-		RPC_C_AUTHN_LEVEL_CALL, RPC_C_IMP_LEVEL_IMPERSONATE, NULL, EOAC_NONE);
-	if (FAILED(hres))
-	{
-		services->Release();
-		locator->Release();
-		CoUninitialize();
-		return result;
-	}
-
-	hres = services->ExecQuery(_bstr_t(L"WQL"), _bstr_t(query),
-		WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY, NULL, &enumerator);
-	if (FAILED(hres))
-	{
-		services->Release();
-		locator->Release();
-		CoUninitialize();
-		return result;
-	}
-
-	if (enumerator)
-	{
-		while (enumerator->Next(WBEM_INFINITE, 1, &clsObj, &uReturn) == S_OK && uReturn > 0)
-		{
-			VARIANT vtProp;
-			VariantInit(&vtProp);
-			hres = clsObj->Get(property_name, 0, &vtProp, 0, 0);
-			if (SUCCEEDED(hres))
-			{
-				if (vtProp.vt == VT_BSTR && vtProp.bstrVal != NULL)
-					result = _bstr_t(vtProp.bstrVal);
-				else if (vtProp.vt == VT_I4)
-					result = to_string(vtProp.intVal);
-				else if (vtProp.vt == VT_UI4)
-					result = to_string(vtProp.uintVal);
-				else if (vtProp.vt == VT_UI2)
-					result = to_string(vtProp.uiVal);
-				VariantClear(&vtProp);
-			}
-			clsObj->Release();
-			break;
-		}
-		enumerator->Release();
-	}
-
-	if (services) services->Release();
-	if (locator) locator->Release();
-	CoUninitialize();
-	return result;
-}
-
 // get the cpu model and brand (like task manager shows)
 string CPUInfo::get_cpu_info()
 {
-	int cpu_data[4] = { -1 };
-	char cpu_brand[0x40];
-	memset(cpu_brand, 0, sizeof(cpu_brand));
-
-	//call cpu _cpuid with 0x80000002, 0x80000003, 0x80000004 to get brand string
-	__cpuid(cpu_data, 0x80000002);
-	memcpy(cpu_brand, cpu_data, sizeof(cpu_data));
-
-	__cpuid(cpu_data, 0x80000003);
-	memcpy(cpu_brand + 16, cpu_data, sizeof(cpu_data));
-
-	__cpuid(cpu_data, 0x80000004);
-	memcpy(cpu_brand + 32, cpu_data, sizeof(cpu_data));
-
-	return string(cpu_brand);
+	PROFILE_SCOPE("CPUInfo::get_cpu_info");
+	// CPUID 0x80000002-4, decoded once per run
+	return Cpuid::current().brand;
 }
 
 // get utilization percentage (like task manager)
 float CPUInfo::get_cpu_utilization()
 {
-	static PDH_HQUERY query = NULL;
-	static PDH_HCOUNTER counter = NULL;
-	static bool initialized = false;
-
-	if (!initialized)
-	{
-		PdhOpenQuery(NULL, 0, &query);
-		PdhAddCounter(query, TEXT("\\Processor(_Total)\\% Processor Time"), 0, &counter);
-		PdhCollectQueryData(query);
-		initialized = true;
-		Sleep(100);
-	}
-
-	PDH_FMT_COUNTERVALUE value;
-	PdhCollectQueryData(query);
-	PdhGetFormattedCounterValue(counter, PDH_FMT_DOUBLE, NULL, &value);
-
-	return (float)value.doubleValue;
+	PROFILE_SCOPE("CPUInfo::get_cpu_utilization");
+	// Latest window of the background sampler, no sleeping here
+	return static_cast<float>(CpuSampler::instance().usagePercent());
 }
 
 // get base speed in GHz (like task manager shows)
 string CPUInfo::get_cpu_base_speed()
 {
-	string base_clock_speed = wmi_querysingle_value(L"SELECT MaxClockSpeed FROM Win32_Processor", L"MaxClockSpeed");
-	if (base_clock_speed == "Unknown" || base_clock_speed.empty()) return "N/A";
-	try
-	{
-		float speed = stof(base_clock_speed) / 1000.0f;
-		ostringstream ss;
-		ss << fixed << setprecision(2) << speed << " GHz";
-		return ss.str();
-	}
-	catch (...)
-	{
-		return "N/A";
-	}
+	PROFILE_SCOPE("CPUInfo::get_cpu_base_speed");
+	int mhz = CpuTopology::current().baseMHz;
+	if (mhz <= 0) return "N/A";
+
+	ostringstream ss;
+	ss << fixed << setprecision(2) << (mhz / 1000.0f) << " GHz";
+	return ss.str();
 }
 
 // get current speed in GHz (like task manager shows)
 string CPUInfo::get_cpu_speed()
 {
-	string current_clock_speed = wmi_querysingle_value(L"SELECT CurrentClockSpeed FROM Win32_Processor", L"CurrentClockSpeed");
-	if (current_clock_speed == "Unknown" || current_clock_speed.empty()) return "N/A";
-	try
-	{
-		float speed = stof(current_clock_speed) / 1000.0f;
+	PROFILE_SCOPE("CPUInfo::get_cpu_speed");
+	// Window average, plus min / max and time at the top clock once there
+	// is more than one sample (watch / agent, or a slow fetch)
+	CpuSampler::ClockStats clocks = CpuSampler::instance().clockStats();
+	if (clocks.avgMHz > 0.0f) {
 		ostringstream ss;
-		ss << fixed << setprecision(2) << speed << " GHz";
+		ss << fixed << setprecision(2) << (clocks.avgMHz / 1000.0f) << " GHz";
+		if (clocks.samples > 1) {
+			ss << " (" << (clocks.minMHz / 1000.0f) << " - " << (clocks.maxMHz / 1000.0f) << " GHz, "
+				<< setprecision(0) << clocks.atMaxPercent << "% at max)";
+		}
 		return ss.str();
 	}
-	catch (...)
-	{
-		return "N/A";
-	}
+
+	long long mhz = SystemQuery::instance().first("Win32_Processor", { "CurrentClockSpeed" }).integer("CurrentClockSpeed");
+	if (mhz <= 0) return "N/A";
+
+	ostringstream ss;
+	ss << fixed << setprecision(2) << (mhz / 1000.0f) << " GHz";
+	return ss.str();
 }
 
 // get sockets (usually 1 for consumer PCs)
 int CPUInfo::get_cpu_sockets()
 {
-	string sockets = wmi_querysingle_value(L"SELECT COUNT(*) FROM Win32_Processor", L"COUNT(*)");
-	if (sockets == "Unknown" || sockets.empty()) return 1;
-	try
-	{
-		return stoi(sockets);
-	}
-	catch (...)
-	{
-		return 1;
-	}
+	PROFILE_SCOPE("CPUInfo::get_cpu_sockets");
+	int sockets = CpuTopology::current().sockets;
+	return sockets > 0 ? sockets : 1;
 }
 
 // get number of cores (physical)
 int CPUInfo::get_cpu_cores()
 {
-	DWORD buffer_length = 0;
-	GetLogicalProcessorInformation(NULL, &buffer_length);
-	if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
-	{
-		return -1;
-	}
-
-	vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> buffer(buffer_length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
-	if (!GetLogicalProcessorInformation(buffer.data(), &buffer_length))
-	{
-		return -1;
-	}
-
-	int physical_cores = 0;
-	for (auto& info : buffer)
-	{
-		if (info.Relationship == RelationProcessorCore)
-		{
-			physical_cores++;
-		}
-	}
-	return physical_cores;
+	PROFILE_SCOPE("CPUInfo::get_cpu_cores");
+	int cores = CpuTopology::current().cores;
+	return cores > 0 ? cores : -1;
 }
 
-// get number of logical processors (threads)
+// get number of logical processors (threads), online ones across all processor groups
 int CPUInfo::get_cpu_logical_processors()
 {
-	SYSTEM_INFO sys_info;
-	GetSystemInfo(&sys_info);
-	return sys_info.dwNumberOfProcessors;
+	PROFILE_SCOPE("CPUInfo::get_cpu_logical_processors");
+	return CpuTopology::current().logical;
 }
 
 // get virtualization status
 string CPUInfo::get_cpu_virtualization()
 {
+	PROFILE_SCOPE("CPUInfo::get_cpu_virtualization");
+	const Cpuid& id = Cpuid::current();
+
+	// Running under a hypervisor (Hyper-V with VBS / WSL2, or a VM guest)
+	if (!id.hypervisor.empty()) return "Enabled (" + id.hypervisor + ")";
+
+	// No VT-x / AMD-V on this CPU at all; otherwise ask whether firmware
+	// turned it on (IsProcessorFeaturePresent reads shared user data, no syscall)
+	if (!id.has(Cpuid::VMX) && !id.has(Cpuid::SVM)) return "Not supported";
 	BOOL isEnabled = IsProcessorFeaturePresent(PF_VIRT_FIRMWARE_ENABLED);
 	return std::string(isEnabled ? "Enabled" : "Disabled");
 }
 
-// get L1 cache
-string CPUInfo::get_cpu_l1_cache()
+// get supported SIMD / crypto extensions (AVX / AVX-512 / AMX only when the OS enabled them)
+string CPUInfo::get_cpu_features()
 {
-	DWORD buffer_length = 0;
-	GetLogicalProcessorInformation(NULL, &buffer_length);
-	if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
-	{
-		return "N/A";
-	}
-
-	vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> buffer(buffer_length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
-	if (!GetLogicalProcessorInformation(buffer.data(), &buffer_length))
-	{
-		return "N/A";
-	}
-
-	DWORD l1_cache = 0;
-	for (auto& info : buffer)
-	{
-		if (info.Relationship == RelationCache && info.Cache.Level == 1)
-		{
-			l1_cache += info.Cache.Size;
-		}
-	}
+	PROFILE_SCOPE("CPUInfo::get_cpu_features");
+	const Cpuid& id = Cpuid::current();
+	string features = id.featureLine();
+	if (features.empty()) return "N/A";
+	if (id.has(Cpuid::HYBRID)) features += " (hybrid)";
+	return features;
+}
 
-	if (l1_cache == 0) return "N/A";
+// Format a CpuTopology cache total like Task Manager.
+// L1 is always shown in KB, L2/L3 switch to MB once they reach 1 MB.
+string CPUInfo::cache_size_label(unsigned long long total, int level)
+{
+	if (total == 0) return "N/A";
 
 	ostringstream ss;
-	ss << (l1_cache / 1024) << " KB";
+	if (level > 1 && total >= 1024 * 1024)
+		ss << (total / (1024 * 1024)) << " MB";
+	else
+		ss << (total / 1024) << " KB";
 	return ss.str();
 }
 
+// get L1 cache
+string CPUInfo::get_cpu_l1_cache()
+{
+	PROFILE_SCOPE("CPUInfo::get_cpu_l1_cache");
+	return StaticFactsCache::instance().getOrCompute("cpu.l1", []() -> string {
+		return cache_size_label(CpuTopology::current().cacheBytes[1], 1);
+	});
+}
+
 // get L2 cache
 string CPUInfo::get_cpu_l2_cache()
 {
-	DWORD buffer_length = 0;
-	GetLogicalProcessorInformation(NULL, &buffer_length);
-	if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
-	{
-		return "N/A";
-	}
-
-	vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> buffer(buffer_length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
-	if (!GetLogicalProcessorInformation(buffer.data(), &buffer_length))
-	{
-		return "N/A";
-	}
-
-	DWORD l2_cache = 0;
-	for (auto& info : buffer)
-	{
-		if (info.Relationship == RelationCache && info.Cache.Level == 2)
-		{
-			l2_cache += info.Cache.Size;
-		}
-	}
-
-	if (l2_cache == 0) return "N/A";
-
-	ostringstream ss;
-	if (l2_cache >= 1024 * 1024)
-		ss << (l2_cache / (1024 * 1024)) << " MB";
-	else
-		ss << (l2_cache / 1024) << " KB";
-	return ss.str();
+	PROFILE_SCOPE("CPUInfo::get_cpu_l2_cache");
+	return StaticFactsCache::instance().getOrCompute("cpu.l2", []() -> string {
+		return cache_size_label(CpuTopology::current().cacheBytes[2], 2);
+	});
 }
 
 // get L3 cache
 string CPUInfo::get_cpu_l3_cache()
 {
-	DWORD buffer_length = 0;
-	GetLogicalProcessorInformation(NULL, &buffer_length);
-	if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
-	{
-		return "N/A";
-	}
-
-	vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> buffer(buffer_length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
-	if (!GetLogicalProcessorInformation(buffer.data(), &buffer_length))
-	{
-		return "N/A";
-	}
-
-	DWORD l3_cache = 0;
-	for (auto& info : buffer)
-	{
-		if (info.Relationship == RelationCache && info.Cache.Level == 3)
-		{
-			l3_cache += info.Cache.Size;
-		}
-	}
-
-	if (l3_cache == 0) return "N/A";
-
-	ostringstream ss;
-	if (l3_cache >= 1024 * 1024)
-		ss << (l3_cache / (1024 * 1024)) << " MB";
-	else
-		ss << (l3_cache / 1024) << " KB";
-	return ss.str();
+	PROFILE_SCOPE("CPUInfo::get_cpu_l3_cache");
+	return StaticFactsCache::instance().getOrCompute("cpu.l3", []() -> string {
+		return cache_size_label(CpuTopology::current().cacheBytes[3], 3);
+	});
 }
 
 // get uptime (system uptime)
 string CPUInfo::get_system_uptime()
 {
+	PROFILE_SCOPE("CPUInfo::get_system_uptime");
 	ULONGLONG uptime_ms = GetTickCount64();
 	ULONGLONG seconds = uptime_ms / 1000;
 	ULONGLONG minutes = seconds / 60;
@@ -358,47 +173,26 @@ string CPUInfo::get_system_uptime()
 	return ss.str();
 }
 
-// get number of processes
+// get number of processes (one shared sample for processes / threads / handles)
 int CPUInfo::get_process_count()
 {
-	string processes = wmi_querysingle_value(L"SELECT COUNT(*) FROM Win32_Process", L"COUNT(*)");
-	if (processes == "Unknown" || processes.empty()) return 0;
-	try
-	{
-		return stoi(processes);
-	}
-	catch (...)
-	{
-		return 0;
-	}
+	PROFILE_SCOPE("CPUInfo::get_process_count");
+	long long processes = ProcessCounter::instance().counts().processes;
+	return processes > 0 ? static_cast<int>(processes) : 0;
 }
 
 // get number of threads
 int CPUInfo::get_thread_count()
 {
-	string threads = wmi_querysingle_value(L"SELECT ThreadCount FROM Win32_PerfFormattedData_PerfProc_Process WHERE Name='_Total'", L"ThreadCount");
-	if (threads == "Unknown" || threads.empty()) return 0;
-	try
-	{
-		return stoi(threads);
-	}
-	catch (...)
-	{
-		return 0;
-	}
+	PROFILE_SCOPE("CPUInfo::get_thread_count");
+	long long threads = ProcessCounter::instance().counts().threads;
+	return threads > 0 ? static_cast<int>(threads) : 0;
 }
 
 // get number of handles
 int CPUInfo::get_handle_count()
 {
-	string handles = wmi_querysingle_value(L"SELECT HandleCount FROM Win32_PerfFormattedData_PerfProc_Process WHERE Name='_Total'", L"HandleCount");
-	if (handles == "Unknown" || handles.empty()) return 0;
-	try
-	{
-		return stoi(handles);
-	}
-	catch (...)
-	{
-		return 0;
-	}
-}
\ No newline at end of file
+	PROFILE_SCOPE("CPUInfo::get_handle_count");
+	long long handles = ProcessCounter::instance().counts().handles;
+	return handles > 0 ? static_cast<int>(handles) : 0;
+}
@@ -22,6 +22,9 @@ public:
 	// virtualization status
 	string get_cpu_virtualization();
 
+	// SIMD / crypto extensions ("SSE4.2 AVX AVX2 ...")
+	string get_cpu_features();
+
 	// cache information
 	string get_cpu_l1_cache();          // L1 cache size
 	string get_cpu_l2_cache();          // L2 cache size
@@ -32,4 +35,7 @@ public:
 	int get_process_count();            // number of processes
 	int get_thread_count();             // number of threads
 	int get_handle_count();             // number of handles
+
+	// formatting behind the cache getters (CpuTopology sums the bytes; also timed by BinaryFetchBench)
+	static string cache_size_label(unsigned long long total, int level);
 };
\ No newline at end of file
@@ -0,0 +1,272 @@
+#include "CgroupLimits.h"
+#include "Profiler.h"
+#include "MemorySnapshot.h"
+#include <mutex>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include "SystemQuery.h"
+#include "NumaInfo.h"
+#endif
+
+
+double CgroupLimits::effectiveCpus(int hostThreads) const {
+    double cpus = hostThreads > 0 ? static_cast<double>(hostThreads) : 0.0;
+    if (cpusetCpus > 0 && (cpus == 0.0 || cpusetCpus < cpus)) cpus = cpusetCpus;
+    if (cpuQuota > 0.0 && (cpus == 0.0 || cpuQuota < cpus)) cpus = cpuQuota;
+    return cpus;
+}
+
+bool CgroupLimits::cpuLimited(int hostThreads) const {
+    return hostThreads > 0 ? effectiveCpus(hostThreads) < hostThreads : (cpuQuota > 0.0 || cpusetCpus > 0);
+}
+
+std::string CgroupLimits::cpuText(int hostThreads) const {
+    if (!cpuLimited(hostThreads)) return "";
+    double allowed = effectiveCpus(hostThreads);
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(allowed == static_cast<int>(allowed) ? 0 : 2) << allowed << " CPUs";
+    return ss.str();
+}
+
+std::string CgroupLimits::memoryText(uint64_t hostTotalBytes) const {
+    if (!memoryLimited() || memoryMax >= hostTotalBytes) return "";
+    uint64_t used = workingSetBytes();
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << MemorySnapshot::gib(used) << " / " << MemorySnapshot::gib(memoryMax)
+        << " GB, " << (used * 100 + memoryMax / 2) / memoryMax << "%";
+    return ss.str();
+}
+
+
+// ---------------- Parsers ----------------
+
+std::string CgroupLimits::parseSelfCgroup(const char* text, size_t length) {
+    // "hierarchy-ID:controllers:path" per line; v2 is the one with ID 0 and no controllers
+    const char* p = text;
+    const char* end = text + length;
+    while (p < end) {
+        const char* next = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!next) next = end;
+        if (next - p >= 3 && p[0] == '0' && p[1] == ':' && p[2] == ':') return std::string(p + 3, next);
+        p = next + 1;
+    }
+    return "";
+}
+
+// Decimal at p, false if there is no digit
+static bool parseNumber(const char*& p, const char* end, uint64_t& out) {
+    const char* start = p;
+    uint64_t value = 0;
+    while (p < end && *p >= '0' && *p <= '9') value = value * 10 + static_cast<uint64_t>(*p++ - '0');
+    out = value;
+    return p != start;
+}
+
+bool CgroupLimits::parseCpuMax(const char* text, size_t length, double& cores) {
+    const char* p = text;
+    const char* end = text + length;
+    uint64_t quota = 0, period = 0;
+    bool unlimited = end - p >= 3 && std::memcmp(p, "max", 3) == 0;
+    if (unlimited) p += 3;
+    else if (!parseNumber(p, end, quota)) return false;
+
+    if (p >= end || *p != ' ') return false;
+    ++p;
+    if (!parseNumber(p, end, period) || period == 0) return false;
+
+    cores = unlimited ? -1.0 : static_cast<double>(quota) / static_cast<double>(period);
+    return true;
+}
+
+bool CgroupLimits::parseBytes(const char* text, size_t length, uint64_t& bytes) {
+    const char* p = text;
+    const char* end = text + length;
+    if (end - p >= 3 && std::memcmp(p, "max", 3) == 0) {
+        bytes = 0;
+        return true;
+    }
+    return parseNumber(p, end, bytes);
+}
+
+namespace {
+
+    struct StatKey {
+        const char* name;
+        size_t length;
+        uint64_t CgroupLimits::* field;
+    };
+
+    const StatKey kStatKeys[] = {
+        { "anon",           4, &CgroupLimits::anonBytes },
+        { "file",           4, &CgroupLimits::fileBytes },
+        { "kernel",         6, &CgroupLimits::kernelBytes },
+        { "shmem",          5, &CgroupLimits::shmemBytes },
+        { "inactive_file", 13, &CgroupLimits::inactiveFileBytes },
+    };
+    const size_t kStatKeyCount = sizeof(kStatKeys) / sizeof(kStatKeys[0]);
+
+}
+
+size_t CgroupLimits::parseMemoryStat(const char* text, size_t length, CgroupLimits& out) {
+    // "key value\n", about 50 lines; same scan as MemorySnapshot::parseMeminfo
+    const char* p = text;
+    const char* end = text + length;
+    size_t seen = 0;
+
+    while (p < end && seen < kStatKeyCount) {
+        const char* space = static_cast<const char*>(memchr(p, ' ', static_cast<size_t>(end - p)));
+        if (!space) break;
+        size_t keyLength = static_cast<size_t>(space - p);
+
+        for (const StatKey& k : kStatKeys) {
+            if (k.length == keyLength && std::memcmp(p, k.name, keyLength) == 0) {
+                const char* value = space + 1;
+                uint64_t bytes = 0;
+                if (parseNumber(value, end, bytes)) {
+                    out.*(k.field) = bytes;
+                    ++seen;
+                }
+                break;
+            }
+        }
+
+        const char* next = static_cast<const char*>(memchr(space, '\n', static_cast<size_t>(end - space)));
+        if (!next) break;
+        p = next + 1;
+    }
+    return seen;
+}
+
+
+// ---------------- Backend ----------------
+
+#ifdef _WIN32
+
+static CgroupLimits probe() {
+    return CgroupLimits();
+}
+
+#else
+
+namespace {
+
+    // Where this process sits in the unified hierarchy
+    struct Location {
+        std::string mount;       // "/sys/fs/cgroup", "" without cgroup v2
+        std::string relative;    // "/user.slice/..." from /proc/self/cgroup
+    };
+
+    // Resolved once: moving a running process between cgroups is rare and
+    // not worth a /proc/self/cgroup read per --watch frame
+    const Location& location() {
+        static const Location where = [] {
+            Location l;
+            std::string text = SystemQuery::instance().readFile("/proc/self/cgroup");
+            l.relative = CgroupLimits::parseSelfCgroup(text.data(), text.size());
+            if (l.relative.empty() || l.relative[0] != '/') return Location();
+
+            const char* const mounts[] = { "/sys/fs/cgroup", "/sys/fs/cgroup/unified" };
+            for (const char* mount : mounts) {
+                if (access((std::string(mount) + "/cgroup.controllers").c_str(), F_OK) == 0) {
+                    l.mount = mount;
+                    break;
+                }
+            }
+            return l.mount.empty() ? Location() : l;
+        }();
+        return where;
+    }
+
+}
+
+static CgroupLimits probe() {
+    PROFILE_SCOPE("CgroupLimits::probe");
+    CgroupLimits c;
+    const Location& where = location();
+    if (where.mount.empty()) return c;
+    c.path = where.relative;
+
+    SystemQuery& query = SystemQuery::instance();
+    std::string directory = where.mount + (where.relative == "/" ? "" : where.relative);
+    auto read = [&](const std::string& dir, const char* file) { return query.readFile(dir + "/" + file); };
+
+    // Own cgroup: cpuset (already intersected with the ancestors), usage, breakdown
+    std::string text = read(directory, "cpuset.cpus.effective");
+    if (!text.empty()) c.cpusetCpus = NumaInfo::countCpus(text.data(), text.size());
+    text = read(directory, "memory.current");
+    CgroupLimits::parseBytes(text.data(), text.size(), c.memoryCurrent);
+    text = read(directory, "memory.stat");
+    CgroupLimits::parseMemoryStat(text.data(), text.size(), c);
+
+    // Limits: the tightest one on the way up to the mount (the root has neither file)
+    for (std::string dir = directory; ; dir.erase(dir.rfind('/'))) {
+        double cores = -1.0;
+        text = read(dir, "cpu.max");
+        if (CgroupLimits::parseCpuMax(text.data(), text.size(), cores) && cores > 0.0 && (c.cpuQuota < 0.0 || cores < c.cpuQuota)) {
+            c.cpuQuota = cores;
+        }
+        uint64_t bytes = 0;
+        text = read(dir, "memory.max");
+        if (CgroupLimits::parseBytes(text.data(), text.size(), bytes) && bytes > 0 && (c.memoryMax == 0 || bytes < c.memoryMax)) {
+            c.memoryMax = bytes;
+        }
+        if (dir.size() <= where.mount.size()) break;
+    }
+    return c;
+}
+
+#endif
+
+static std::mutex limitsMutex;
+static CgroupLimits shared;
+static bool sharedValid = false;
+
+CgroupLimits CgroupLimits::current() {
+    std::lock_guard<std::mutex> lock(limitsMutex);
+    if (!sharedValid) {
+        shared = probe();
+        sharedValid = true;
+    }
+    return shared;
+}
+
+void CgroupLimits::refresh() {
+    std::lock_guard<std::mutex> lock(limitsMutex);
+    sharedValid = false;
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: CgroupLimits
+OBJECT: CgroupLimits::current(), read by main.cpp's compact_cpu and
+        compact_memory lines ("show_cgroup")
+DESCRIPTION: cgroup v2 CPU / memory limits and usage of the calling process.
+FUNCTIONS:
+    static CgroupLimits current()
+        Reads on first call, then hands out copies until refresh(). The
+        cgroup directory itself is resolved only once per process.
+
+    static void refresh()
+        Called by --watch and --agent next to MemorySnapshot::refresh().
+
+    double effectiveCpus(int hostThreads) const
+    bool cpuLimited(int hostThreads) const
+        Quota vs cpuset vs host, whichever is smallest.
+
+    std::string cpuText(int hostThreads) const
+    std::string memoryText(uint64_t hostTotalBytes) const
+        The "show_cgroup" values; "" unless a limit is below the host.
+
+    static std::string parseSelfCgroup(const char* text, size_t length)
+    static bool parseCpuMax(const char* text, size_t length, double& cores)
+    static bool parseBytes(const char* text, size_t length, uint64_t& bytes)
+    static size_t parseMemoryStat(const char* text, size_t length, CgroupLimits& out)
+        One-pass parsers of the cgroup files, checked by tests\CgroupLimitsTests.cpp.
+*/
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ ---------------------------------------------------------
+                   CgroupLimits Struct
+ ---------------------------------------------------------
+
+  The CPU and memory the calling process is actually allowed,
+  for runs inside containers / pods / systemd slices where
+  CompactMemory and CompactCPU report host totals. The
+  compact_cpu and compact_memory lines print these next to
+  the host figures whenever a limit is in effect.
+
+    Linux   : cgroup v2 only. The process's cgroup is resolved
+              once from the "0::" line of /proc/self/cgroup and
+              joined to the unified mount (/sys/fs/cgroup, or
+              /sys/fs/cgroup/unified on hybrid hosts). Then:
+                cpu.max                quota / period -> cores
+                cpuset.cpus.effective  CPUs we may run on
+                memory.max             hard limit
+                memory.current         charged right now
+                memory.stat            anon / file / kernel /
+                                       shmem / inactive_file
+              cpu.max and memory.max are also read on every
+              ancestor up to the root and the tightest one wins
+              (a pod limit usually sits on the parent of the
+              container's cgroup). All reads go through
+              SystemQuery's kept-open descriptors.
+    Windows : no cgroups; nothing is reported.
+
+  Like MemorySnapshot, one reading is shared until refresh().
+*/
+struct CgroupLimits {
+    std::string path;                 // "/kubepods.slice/..." relative to the mount, "" = no cgroup v2
+    double cpuQuota = -1.0;           // cores allowed by cpu.max (2.5 = 250 ms per 100 ms), -1 = "max"
+    int cpusetCpus = 0;               // CPUs in cpuset.cpus.effective, 0 = unknown
+    uint64_t memoryMax = 0;           // memory.max, 0 = "max"
+    uint64_t memoryCurrent = 0;       // memory.current
+    uint64_t anonBytes = 0;           // memory.stat anon
+    uint64_t fileBytes = 0;           // memory.stat file (page cache)
+    uint64_t kernelBytes = 0;         // memory.stat kernel
+    uint64_t shmemBytes = 0;          // memory.stat shmem
+    uint64_t inactiveFileBytes = 0;   // memory.stat inactive_file
+
+    // What the kernel weighs against memory.max before reclaiming (the kubelet's "working set")
+    uint64_t workingSetBytes() const {
+        return memoryCurrent > inactiveFileBytes ? memoryCurrent - inactiveFileBytes : 0;
+    }
+
+    // CPUs the process can use: the smallest of quota, cpuset and host threads
+    double effectiveCpus(int hostThreads) const;
+
+    // True if cpu.max, cpuset or memory.max restricts us below the host
+    bool cpuLimited(int hostThreads) const;
+    bool memoryLimited() const { return memoryMax > 0; }
+
+    // What compact_cpu / compact_memory print, "" when the cgroup
+    // doesn't restrict us below the host:
+    //   cpuText     "2.50 CPUs" ("2 CPUs" for whole numbers)
+    //   memoryText  "1.2 / 4.0 GB, 30%" (working set against memory.max)
+    std::string cpuText(int hostThreads) const;
+    std::string memoryText(uint64_t hostTotalBytes) const;
+
+    // The shared reading, taken on first use and after refresh()
+    static CgroupLimits current();
+    static void refresh();
+
+    // ---- sources (public so the tests can feed recorded files) ----
+
+    // /proc/self/cgroup -> the v2 ("0::") path, "" if there is none
+    static std::string parseSelfCgroup(const char* text, size_t length);
+
+    // cpu.max "quota period" -> cores, -1 for "max". false if malformed.
+    static bool parseCpuMax(const char* text, size_t length, double& cores);
+
+    // memory.max / memory.current -> bytes, 0 for "max". false if malformed.
+    static bool parseBytes(const char* text, size_t length, uint64_t& bytes);
+
+    // memory.stat -> the fields above. Returns the number of keys found.
+    static size_t parseMemoryStat(const char* text, size_t length, CgroupLimits& out);
+};
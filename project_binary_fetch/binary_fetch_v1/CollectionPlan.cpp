@@ -0,0 +1,277 @@
+#include "CollectionPlan.h"
+
+using json = nlohmann::json;
+
+namespace {
+
+    // How a rule's key is looked up (mirrors the helper lambdas in main.cpp)
+    enum class Gate {
+        Always,      // section enabled is enough (isEnabled)
+        Sub,         // config[keySection][key]                    (isSubEnabled)
+        SectionKey,  // config[keySection]["sections"][key]        (isSectionEnabled)
+        Path         // dotted path below config[keySection]       (getNestedBool)
+    };
+
+    struct Rule {
+        Collector collector;
+        const char* section;     // section whose "enabled" flag guards the block
+        const char* keySection;  // section the key is read from (dummy sections borrow keys)
+        Gate gate;
+        const char* key;
+    };
+
+    // One row per config key that makes main() call into a collector.
+    constexpr Rule kRules[] = {
+        // ---------------- compact sections ----------------
+        { Collector::CompactOS,          "compact_os",            "compact_os",          Gate::Sub, "show_name" },
+        { Collector::CompactOS,          "compact_os",            "compact_os",          Gate::Sub, "show_build" },
+        { Collector::CompactOS,          "compact_os",            "compact_os",          Gate::Sub, "show_arch" },
+        { Collector::CompactOS,          "compact_os",            "compact_os",          Gate::Sub, "show_uptime" },
+
+        { Collector::CompactCPU,         "compact_cpu",           "compact_cpu",         Gate::Sub, "show_name" },
+        { Collector::CompactCPU,         "compact_cpu",           "compact_cpu",         Gate::Sub, "show_cores" },
+        { Collector::CompactCPU,         "compact_cpu",           "compact_cpu",         Gate::Sub, "show_threads" },
+        { Collector::CompactCPU,         "compact_cpu",           "compact_cpu",         Gate::Sub, "show_cgroup" },
+        { Collector::CompactCPU,         "compact_cpu",           "compact_cpu",         Gate::Sub, "show_clock" },
+
+        { Collector::CpuCores,           "cpu_cores",             "cpu_cores",           Gate::Sub, "show_usage" },
+        { Collector::CpuCores,           "cpu_cores",             "cpu_cores",           Gate::Sub, "show_frequency" },
+
+        { Collector::CompactGPU,         "compact_gpu",           "compact_gpu",         Gate::Sub, "show_name" },
+        { Collector::CompactGPU,         "compact_gpu",           "compact_gpu",         Gate::Sub, "show_usage" },
+        { Collector::CompactGPU,         "compact_gpu",           "compact_gpu",         Gate::Sub, "show_vram" },
+        { Collector::CompactGPU,         "compact_gpu",           "compact_gpu",         Gate::Sub, "show_freq" },
+
+        { Collector::CompactMemory,      "compact_memory",        "compact_memory",      Gate::Sub, "show_total" },
+        { Collector::CompactMemory,      "compact_memory",        "compact_memory",      Gate::Sub, "show_free" },
+        { Collector::CompactMemory,      "compact_memory",        "compact_memory",      Gate::Sub, "show_percent" },
+
+        { Collector::CompactAudio,       "compact_audio",         "compact_audio",       Gate::Sub, "show_input" },
+        { Collector::CompactAudio,       "compact_audio",         "compact_audio",       Gate::Sub, "show_output" },
+
+        { Collector::CompactPerformance, "compact_performance",   "compact_performance", Gate::Sub, "show_cpu" },
+        { Collector::CompactPerformance, "compact_performance",   "compact_performance", Gate::Sub, "show_gpu" },
+        { Collector::CompactPerformance, "compact_performance",   "compact_performance", Gate::Sub, "show_ram" },
+        { Collector::CompactPerformance, "compact_performance",   "compact_performance", Gate::Sub, "show_disk" },
+
+        { Collector::Pressure,           "compact_pressure",      "compact_pressure",    Gate::Sub, "show_cpu" },
+        { Collector::Pressure,           "compact_pressure",      "compact_pressure",    Gate::Sub, "show_memory" },
+        { Collector::Pressure,           "compact_pressure",      "compact_pressure",    Gate::Sub, "show_io" },
+        { Collector::Pressure,           "compact_pressure",      "compact_pressure",    Gate::Sub, "show_load" },
+        { Collector::Pressure,           "compact_pressure",      "compact_pressure",    Gate::Sub, "show_switches" },
+
+        { Collector::CompactUser,        "compact_user",          "compact_user",        Gate::Sub, "show_username" },
+        { Collector::CompactUser,        "compact_user",          "compact_user",        Gate::Sub, "show_domain" },
+        { Collector::CompactUser,        "compact_user",          "compact_user",        Gate::Sub, "show_type" },
+
+        { Collector::CompactNetwork,     "compact_network",       "compact_network",     Gate::Sub, "show_name" },
+        { Collector::CompactNetwork,     "compact_network",       "compact_network",     Gate::Sub, "show_type" },
+        { Collector::CompactNetwork,     "compact_network",       "compact_network",     Gate::Sub, "show_ip" },
+        { Collector::CompactNetwork,     "dummy_compact_network", "compact_network",     Gate::Sub, "show_type" },
+
+        { Collector::Disk,               "compact_disk",          "compact_disk",        Gate::Sub, "show_usage" },
+        { Collector::Disk,               "compact_disk",          "compact_disk",        Gate::Sub, "show_capacity" },
+
+        // ---------------- detailed sections ----------------
+        { Collector::Memory,             "detailed_memory",       "detailed_memory",     Gate::SectionKey, "total" },
+        { Collector::Memory,             "detailed_memory",       "detailed_memory",     Gate::SectionKey, "free" },
+        { Collector::Memory,             "detailed_memory",       "detailed_memory",     Gate::SectionKey, "used_percentage" },
+        { Collector::Memory,             "detailed_memory",       "detailed_memory",     Gate::SectionKey, "modules" },
+
+        { Collector::Storage,            "detailed_storage",      "detailed_storage",    Gate::Path, "sections.storage_summary" },
+
+        { Collector::Network,            "network_info",          "network_info",        Gate::Sub, "show_name" },
+        { Collector::Network,            "network_info",          "network_info",        Gate::Sub, "show_local_ip" },
+        { Collector::Network,            "network_info",          "network_info",        Gate::Sub, "show_public_ip" },
+        { Collector::Network,            "network_info",          "network_info",        Gate::Sub, "show_locale" },
+        { Collector::Network,            "network_info",          "network_info",        Gate::Sub, "show_mac" },
+        { Collector::Network,            "network_info",          "network_info",        Gate::Sub, "show_upload" },
+        { Collector::Network,            "network_info",          "network_info",        Gate::Sub, "show_download" },
+        { Collector::CompactNetwork,     "network_info",          "network_info",        Gate::Sub, "show_type" },
+
+        { Collector::Network,            "dummy_network_info",    "network_info",        Gate::Sub, "show_locale" },
+        { Collector::Network,            "dummy_network_info",    "network_info",        Gate::Sub, "show_upload" },
+        { Collector::Network,            "dummy_network_info",    "network_info",        Gate::Sub, "show_download" },
+        { Collector::CompactNetwork,     "dummy_network_info",    "network_info",        Gate::Sub, "show_type" },
+
+        { Collector::OS,                 "os_info",               "os_info",             Gate::Sub, "show_name" },
+        { Collector::OS,                 "os_info",               "os_info",             Gate::Sub, "show_build" },
+        { Collector::OS,                 "os_info",               "os_info",             Gate::Sub, "show_architecture" },
+        { Collector::OS,                 "os_info",               "os_info",             Gate::Sub, "show_kernel" },
+        { Collector::OS,                 "os_info",               "os_info",             Gate::Sub, "show_uptime" },
+        { Collector::OS,                 "os_info",               "os_info",             Gate::Sub, "show_install_date" },
+        { Collector::OS,                 "os_info",               "os_info",             Gate::Sub, "show_serial" },
+
+        { Collector::CPU,                "cpu_info",              "cpu_info",            Gate::Sub, "show_brand" },
+        { Collector::CPU,                "cpu_info",              "cpu_info",            Gate::Sub, "show_utilization" },
+        { Collector::CPU,                "cpu_info",              "cpu_info",            Gate::Sub, "show_speed" },
+        { Collector::CPU,                "cpu_info",              "cpu_info",            Gate::Sub, "show_base_speed" },
+        { Collector::CPU,                "cpu_info",              "cpu_info",            Gate::Sub, "show_cores" },
+        { Collector::CPU,                "cpu_info",              "cpu_info",            Gate::Sub, "show_logical_processors" },
+        { Collector::CPU,                "cpu_info",              "cpu_info",            Gate::Sub, "show_sockets" },
+        { Collector::CPU,                "cpu_info",              "cpu_info",            Gate::Sub, "show_virtualization" },
+        { Collector::CPU,                "cpu_info",              "cpu_info",            Gate::Sub, "show_features" },
+        { Collector::CPU,                "cpu_info",              "cpu_info",            Gate::Sub, "show_l1_cache" },
+        { Collector::CPU,                "cpu_info",              "cpu_info",            Gate::Sub, "show_l2_cache" },
+        { Collector::CPU,                "cpu_info",              "cpu_info",            Gate::Sub, "show_l3_cache" },
+
+        // the GPU list decides between "No GPU detected." and the per-GPU lines
+        { Collector::GPU,                "gpu_info",              "gpu_info",            Gate::Always, "" },
+        { Collector::DetailedGPU,        "gpu_info",              "gpu_info",            Gate::Sub, "show_primary_details" },
+
+        // every display_info line comes from the screen list
+        { Collector::Display,            "display_info",          "display_info",        Gate::Always, "" },
+
+        { Collector::System,             "bios_mb_info",          "bios_mb_info",        Gate::Sub, "show_bios_vendor" },
+        { Collector::System,             "bios_mb_info",          "bios_mb_info",        Gate::Sub, "show_bios_version" },
+        { Collector::System,             "bios_mb_info",          "bios_mb_info",        Gate::Sub, "show_bios_date" },
+        { Collector::System,             "bios_mb_info",          "bios_mb_info",        Gate::Sub, "show_mb_model" },
+        { Collector::System,             "bios_mb_info",          "bios_mb_info",        Gate::Sub, "show_mb_manufacturer" },
+
+        { Collector::User,               "user_info",             "user_info",           Gate::Sub, "show_username" },
+        { Collector::User,               "user_info",             "user_info",           Gate::Sub, "show_computer_name" },
+        { Collector::User,               "user_info",             "user_info",           Gate::Sub, "show_domain" },
+
+        { Collector::Performance,        "performance_info",      "performance_info",    Gate::Sub, "show_uptime" },
+        { Collector::Performance,        "performance_info",      "performance_info",    Gate::Sub, "show_cpu_usage" },
+        { Collector::Performance,        "performance_info",      "performance_info",    Gate::Sub, "show_ram_usage" },
+        { Collector::Performance,        "performance_info",      "performance_info",    Gate::Sub, "show_disk_usage" },
+        { Collector::Performance,        "performance_info",      "performance_info",    Gate::Sub, "show_gpu_usage" },
+
+        { Collector::TopProcesses,       "top_processes",         "top_processes",       Gate::Sub, "show_by_cpu" },
+        { Collector::TopProcesses,       "top_processes",         "top_processes",       Gate::Sub, "show_by_memory" },
+
+        // the node list decides whether the section prints at all
+        { Collector::Numa,               "numa_info",             "numa_info",           Gate::Always, "" },
+
+        { Collector::MemoryPressure,     "memory_pressure",       "memory_pressure",     Gate::Sub, "show_swap" },
+        { Collector::MemoryPressure,     "memory_pressure",       "memory_pressure",     Gate::Sub, "show_compression" },
+        { Collector::MemoryPressure,     "memory_pressure",       "memory_pressure",     Gate::Sub, "show_hugepages" },
+        { Collector::MemoryPressure,     "memory_pressure",       "memory_pressure",     Gate::Sub, "show_dirty" },
+        { Collector::MemoryPressure,     "memory_pressure",       "memory_pressure",     Gate::Sub, "show_faults" },
+    };
+
+    // A collector without any row could never be planned, so every
+    // LazyCollector<T>::get() for it would report a missing row at run time
+    constexpr bool everyCollectorHasRule() {
+        for (size_t c = 0; c < static_cast<size_t>(Collector::Count); ++c) {
+            bool found = false;
+            for (const Rule& rule : kRules) {
+                if (static_cast<size_t>(rule.collector) == c) found = true;
+            }
+            if (!found) return false;
+        }
+        return true;
+    }
+    static_assert(everyCollectorHasRule(), "a Collector has no row in kRules");
+
+    // Same defaults as main.cpp: anything missing from the config counts as enabled
+    bool sectionEnabled(const json& config, bool loaded, const char* section) {
+        if (!loaded || !config.contains(section)) return true;
+        return config[section].value("enabled", true);
+    }
+
+    bool keyEnabled(const json& config, bool loaded, const Rule& rule) {
+        if (rule.gate == Gate::Always) return true;
+        if (!loaded || !config.contains(rule.keySection)) return true;
+
+        const json& sec = config[rule.keySection];
+        switch (rule.gate) {
+        case Gate::Sub:
+            return sec.value(rule.key, true);
+
+        case Gate::SectionKey:
+            if (!sec.contains("sections")) return true;
+            return sec["sections"].value(rule.key, true);
+
+        case Gate::Path: {
+            const json* current = &sec;
+            std::string path = rule.key;
+            size_t start = 0;
+            while (start <= path.size()) {
+                size_t dot = path.find('.', start);
+                std::string k = path.substr(start, dot == std::string::npos ? std::string::npos : dot - start);
+                if (!current->is_object() || !current->contains(k)) return true;
+                current = &(*current)[k];
+                if (dot == std::string::npos) break;
+                start = dot + 1;
+            }
+            return current->is_boolean() ? current->get<bool>() : true;
+        }
+
+        default:
+            return true;
+        }
+    }
+}
+
+CollectionPlan::CollectionPlan(const json& config, bool configLoaded) {
+    for (const Rule& rule : kRules) {
+        if (planned.test(static_cast<size_t>(rule.collector))) continue;
+        if (!sectionEnabled(config, configLoaded, rule.section)) continue;
+        if (!keyEnabled(config, configLoaded, rule)) continue;
+        planned.set(static_cast<size_t>(rule.collector));
+    }
+}
+
+const char* CollectionPlan::name(Collector c) {
+    switch (c) {
+    case Collector::OS:                 return "OSInfo";
+    case Collector::CPU:                return "CPUInfo";
+    case Collector::Memory:             return "MemoryInfo";
+    case Collector::GPU:                return "GPUInfo";
+    case Collector::DetailedGPU:        return "DetailedGPUInfo";
+    case Collector::Storage:            return "StorageInfo";
+    case Collector::Network:            return "NetworkInfo";
+    case Collector::User:               return "UserInfo";
+    case Collector::Performance:        return "PerformanceInfo";
+    case Collector::Display:            return "DisplayInfo";
+    case Collector::System:             return "SystemInfo";
+    case Collector::CompactAudio:       return "CompactAudio";
+    case Collector::CompactOS:          return "CompactOS";
+    case Collector::CompactCPU:         return "CompactCPU";
+    case Collector::CompactMemory:      return "CompactMemory";
+    case Collector::CompactGPU:         return "CompactGPU";
+    case Collector::CompactPerformance: return "CompactPerformance";
+    case Collector::CompactUser:        return "CompactUser";
+    case Collector::CompactNetwork:     return "CompactNetwork";
+    case Collector::Disk:               return "DiskInfo";
+    case Collector::CpuCores:           return "CpuCores";
+    case Collector::TopProcesses:       return "TopProcesses";
+    case Collector::Pressure:           return "Pressure";
+    case Collector::Numa:               return "NumaInfo";
+    case Collector::MemoryPressure:     return "MemoryPressure";
+    default:                            return "Unknown";
+    }
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: CollectionPlan
+OBJECT: plan (main.cpp)
+DESCRIPTION: Turns the JSON config into the set of collectors this run needs.
+FUNCTIONS:
+    bool needs(Collector c) const
+        True if at least one enabled field reads from the collector.
+
+    size_t count() const
+        Number of collectors that will be built.
+
+TEMPLATE: LazyCollector<T>
+DESCRIPTION: Builds the collector on first use, under a mutex (thread safe).
+             Using a collector the plan ruled out still builds it, and the
+             first such use names the collector on stderr (every build).
+             reset() makes the next use build a fresh instance.
+
+ADDING A FIELD:
+    New getter call in main.cpp -> add a Rule row with the same section/key
+    that guards it. Otherwise LazyCollector reports the collector on
+    stderr the first time that field is enabled without the rest of the
+    collector's rows. A call that runs whenever the section is enabled
+    needs a Gate::Always row, or a plan.needs() check in the section
+    (compact_pressure, memory_pressure). A new Collector enum value
+    without any row fails to compile (static_assert on kRules).
+*/
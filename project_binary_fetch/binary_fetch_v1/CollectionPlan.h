@@ -0,0 +1,158 @@
+#pragma once
+
+#include <string>
+#include <bitset>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include <cstdio>
+#include "nlohmann/json.hpp"
+#include "Profiler.h"
+
+/*
+ ---------------------------------------------------------
+                    Collector IDs
+ ---------------------------------------------------------
+
+  One entry per collector object that main() can build.
+  Compact helpers that are built inside their own section
+  (CompactScreen, TimeInfo, ExtraInfo for audio/power) are
+  not listed: they only exist while their section runs.
+*/
+enum class Collector {
+    OS,
+    CPU,
+    Memory,
+    GPU,
+    DetailedGPU,
+    Storage,
+    Network,
+    User,
+    Performance,
+    Display,
+    System,
+    CompactAudio,
+    CompactOS,
+    CompactCPU,
+    CompactMemory,
+    CompactGPU,
+    CompactPerformance,
+    CompactUser,
+    CompactNetwork,
+    Disk,
+    CpuCores,
+    TopProcesses,
+    Pressure,
+    Numa,
+    MemoryPressure,
+    Count
+};
+
+
+
+/*
+ ---------------------------------------------------------
+                   CollectionPlan Class
+ ---------------------------------------------------------
+
+  Compiles BinaryFetch_Config.json into the exact set of
+  collectors the current run needs.
+
+  The isEnabled / isSubEnabled / ... lambdas in main() only
+  decide what gets *printed*. This plan answers the earlier
+  question: "will any field of this collector be shown?"
+  If not, the collector is never constructed or queried.
+
+  The rules are a flat table in CollectionPlan.cpp, one row
+  per (collector, config key) pair that reads from it. When
+  a section starts using a new getter, add its row there.
+*/
+class CollectionPlan {
+public:
+    CollectionPlan(const nlohmann::json& config, bool configLoaded);
+
+    // Will any enabled field read from this collector?
+    bool needs(Collector c) const { return planned.test(static_cast<size_t>(c)); }
+
+    // Number of collectors this run will build
+    size_t count() const { return planned.count(); }
+
+    // Human readable collector name (for diagnostics)
+    static const char* name(Collector c);
+
+private:
+    std::bitset<static_cast<size_t>(Collector::Count)> planned;
+};
+
+
+
+/*
+ ---------------------------------------------------------
+                 LazyCollector<T> Template
+ ---------------------------------------------------------
+
+  Holds a collector that is built on first use instead of
+  at the top of main(). Several sections may touch the same
+  collector from different worker threads, so construction
+  is guarded by a mutex.
+
+  Asking for a collector the plan ruled out means the rule
+  table is missing a row. The collector is still built, so
+  the fetch goes on, and the first such use is named on
+  stderr (release builds too) so the row gets added.
+  Sections whose collector call doesn't depend on a show_*
+  key either have a Gate::Always row or check plan.needs()
+  before touching the collector.
+
+  reset() drops the instance so the next use builds a fresh
+  one (agent mode does this for collectors that only read
+  their values in the constructor).
+
+  Usage:   LazyCollector<MemoryInfo> ram(plan, Collector::Memory);
+           ram->getTotal();
+*/
+template <typename T>
+class LazyCollector {
+public:
+    LazyCollector(const CollectionPlan& planRef, Collector idValue)
+        : plan(planRef), id(idValue) {}
+
+    T* get() {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!instance) {
+            // A section asked for a collector the plan ruled out: the rule
+            // table in CollectionPlan.cpp is missing a row. Say so once and
+            // build it anyway rather than losing the whole fetch.
+            if (!plan.needs(id) && !reportedUnplanned) {
+                reportedUnplanned = true;
+                std::fprintf(stderr, "BinaryFetch: %s used but not planned - add its row to kRules in CollectionPlan.cpp\n",
+                    CollectionPlan::name(id));
+            }
+            ProfileScope span(std::string(CollectionPlan::name(id)) + " (construct)", "construct");
+            instance = std::make_unique<T>();
+        }
+        return instance.get();
+    }
+
+    T* operator->() { return get(); }
+    T& operator*() { return *get(); }
+
+    // true once something has actually asked for the collector
+    bool built() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return instance != nullptr;
+    }
+
+    // Forget the instance; only call while no section is running
+    void reset() {
+        std::lock_guard<std::mutex> lock(mtx);
+        instance.reset();
+    }
+
+private:
+    const CollectionPlan& plan;
+    Collector id;
+    bool reportedUnplanned = false;
+    mutable std::mutex mtx;
+    std::unique_ptr<T> instance;
+};
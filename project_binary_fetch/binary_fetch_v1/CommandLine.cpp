@@ -0,0 +1,77 @@
+#include "CommandLine.h"
+#include <iostream>
+#include <cstdlib>
+
+CommandLineOptions parseCommandLine(int argc, char* argv[]) {
+    CommandLineOptions opts;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--refresh-cache") opts.refreshCache = true;
+        else if (arg == "--timings") opts.showTimings = true;
+        else if (arg == "--trace") {
+            // optional file name; default lands in the current directory
+            opts.tracePath = "trace.json";
+            if (i + 1 < argc && argv[i + 1][0] != '-') opts.tracePath = argv[++i];
+        }
+        else if (arg == "--help" || arg == "-h") opts.showHelp = true;
+        else if (arg == "--agent") opts.agentMode = true;
+        else if (arg == "--no-agent") opts.noAgent = true;
+        else if (arg == "--agent-interval" && i + 1 < argc) {
+            // keep it sane: faster than 100 ms just burns CPU on WMI/PDH
+            int ms = std::atoi(argv[++i]);
+            opts.agentIntervalMs = ms >= 100 ? static_cast<unsigned>(ms) : 100;
+        }
+        else if (arg == "--watch") {
+            // "--watch 2" = every 2 s, "--watch 500ms" = every 500 ms, no value = 1 s
+            opts.watchMs = 1000;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                std::string v = argv[++i];
+                bool inMs = v.size() > 2 && v.compare(v.size() - 2, 2, "ms") == 0;
+                double n = std::atof(v.c_str());
+                if (n > 0) opts.watchMs = static_cast<unsigned>(inMs ? n : n * 1000.0);
+            }
+            if (opts.watchMs < 100) opts.watchMs = 100;
+        }
+        else opts.unknown.push_back(arg);
+    }
+
+    return opts;
+}
+
+void printUsage() {
+    std::cout
+        << "Usage: binaryfetch [options]\n"
+        << "\n"
+        << "  --refresh-cache         Re-probe static facts (CPU, BIOS, RAM modules, ...) and rewrite the cache\n"
+        << "  --timings               Print fetch time, cache hit/miss counts and per-collector latency after the output\n"
+        << "  --trace [file]          Write every collector call as a Chrome/Perfetto trace (default trace.json)\n"
+        << "  --agent                 Stay resident, keep collectors warm and serve snapshots over a local socket\n"
+        << "  --agent-interval <ms>   How often the agent re-samples (default 2000)\n"
+        << "  --no-agent              Don't ask a running agent, always collect in-process\n"
+        << "  --watch [interval]      Keep running and update live values in place (2 = 2 s, 500ms)\n"
+        << "  -h, --help              Show this help\n";
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+STRUCT: CommandLineOptions
+OBJECT: options (main.cpp)
+DESCRIPTION: Parsed command line switches.
+FUNCTIONS:
+    CommandLineOptions parseCommandLine(int argc, char* argv[])
+        Fill the struct from argv. Unknown arguments are collected
+        in opts.unknown so main can warn about them.
+
+    void printUsage()
+        Help text for --help.
+
+ADDING AN OPTION:
+    1. Add the field to CommandLineOptions
+    2. Match the flag in parseCommandLine
+    3. Describe it in printUsage
+*/
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/*
+ ---------------------------------------------------------
+                  CommandLineOptions Struct
+ ---------------------------------------------------------
+
+  Everything BinaryFetch understands on the command line.
+  Plain "binaryfetch" keeps every default, so the fields
+  below all start out as "off".
+*/
+struct CommandLineOptions {
+    bool refreshCache = false;          // --refresh-cache : ignore BinaryFetch_Cache.bin and rebuild it
+    bool showTimings = false;           // --timings       : print fetch time, cache stats + collector latency table at the end
+    std::string tracePath;              // --trace [file]  : write per-collector spans as Chrome trace JSON
+    bool showHelp = false;              // --help / -h
+
+    bool agentMode = false;             // --agent          : stay resident and serve snapshots
+    bool noAgent = false;               // --no-agent       : always collect in-process
+    unsigned agentIntervalMs = 2000;    // --agent-interval : how often the agent re-samples
+
+    unsigned watchMs = 0;               // --watch <interval> : redraw live values every interval (0 = off)
+
+    std::vector<std::string> unknown;   // anything we didn't recognise (warned about, then ignored)
+};
+
+// Parse argv into CommandLineOptions (never fails, unknown flags are collected)
+CommandLineOptions parseCommandLine(int argc, char* argv[]);
+
+// Print the list of supported options
+void printUsage();
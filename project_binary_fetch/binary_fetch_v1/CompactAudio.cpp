@@ -1,4 +1,5 @@
 #include "CompactAudio.h"
+#include "Profiler.h"
 #include <windows.h>
 #include <mmdeviceapi.h>
 #include <functiondiscoverykeys_devpkey.h>
@@ -35,17 +36,21 @@ std::string get_audio_device_name(EDataFlow flow) {
 
 
 std::string CompactAudio::active_audio_output() {
+    PROFILE_SCOPE("CompactAudio::active_audio_output");
     return get_audio_device_name(eRender);
 }
 
 std::string CompactAudio::active_audio_output_status() {
+    PROFILE_SCOPE("CompactAudio::active_audio_output_status");
     return "Active"; // Currently only fetching default active device
 }
 
 std::string CompactAudio::active_audio_input() {
+    PROFILE_SCOPE("CompactAudio::active_audio_input");
     return get_audio_device_name(eCapture);
 }
 
 std::string CompactAudio::active_audio_input_status() {
+    PROFILE_SCOPE("CompactAudio::active_audio_input_status");
     return "Active"; // Currently only fetching default active device
 }
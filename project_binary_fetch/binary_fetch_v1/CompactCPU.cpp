@@ -1,67 +1,42 @@
 #include "CompactCPU.h"
+#include "Profiler.h"
+#include "CpuSampler.h"
+#include "CpuTopology.h"
+#include "Cpuid.h"
 #include <windows.h>
-#include <pdh.h>
-#include <pdhmsg.h>
-#include <intrin.h>
-#include <vector>
-#include <thread>
-#include <chrono>
-#include <cstring>
 #include <sstream>
 #include <iomanip>
 
-#pragma comment(lib, "pdh.lib")
-
 //---------------- Get CPU Name ------------------
 std::string CompactCPU::getCPUName()
 {
-    int cpuInfo[4] = { -1 };
-    char cpuBrand[0x40];
-    __cpuid(cpuInfo, 0x80000000);
-    unsigned int nExids = cpuInfo[0];
-    memset(cpuBrand, 0, sizeof(cpuBrand));
-
-    for (unsigned int i = 0x80000000; i <= nExids; ++i)
-    {
-        __cpuid(cpuInfo, i);
-        if (i == 0x80000002) memcpy(cpuBrand, cpuInfo, sizeof(cpuInfo));
-        else if (i == 0x80000003) memcpy(cpuBrand + 16, cpuInfo, sizeof(cpuInfo));
-        else if (i == 0x80000004) memcpy(cpuBrand + 32, cpuInfo, sizeof(cpuInfo));
-    }
-
-    std::string name(cpuBrand);
-    name.erase(name.find_last_not_of(' ') + 1);
-    return name;
+    PROFILE_SCOPE("CompactCPU::getCPUName");
+    return Cpuid::current().brand;
 }
 
 //---------------- Get CPU Core Count ------------------
 std::string CompactCPU::getCPUCores()
 {
-    DWORD coreCount = 0;
-    DWORD returnLength = 0;
-    GetLogicalProcessorInformation(nullptr, &returnLength);
-    std::vector<uint8_t> buffer(returnLength);
-    PSYSTEM_LOGICAL_PROCESSOR_INFORMATION info =
-        reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION>(buffer.data());
-
-    if (GetLogicalProcessorInformation(info, &returnLength))
-    {
-        size_t count = returnLength / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
-        for (size_t i = 0; i < count; ++i)
-            if (info[i].Relationship == RelationProcessorCore) coreCount++;
-    }
-    return std::to_string(coreCount);
+    PROFILE_SCOPE("CompactCPU::getCPUCores");
+    return std::to_string(CpuTopology::current().cores);
 }
 
 //---------------- Get CPU Thread Count ------------------
 std::string CompactCPU::getCPUThreads()
 {
-    return std::to_string(GetActiveProcessorCount(ALL_PROCESSOR_GROUPS));
+    PROFILE_SCOPE("CompactCPU::getCPUThreads");
+    return std::to_string(CpuTopology::current().logical);
 }
 
 //---------------- Get CPU Clock Speed (GHz) ------------------
 double CompactCPU::getClockSpeed()
 {
+    PROFILE_SCOPE("CompactCPU::getClockSpeed");
+    // Average effective clock over the sampler window (one registry value can
+    // catch a turbo spike or a power-capped dip)
+    CpuSampler::ClockStats clocks = CpuSampler::instance().clockStats();
+    if (clocks.avgMHz > 0.0f) return clocks.avgMHz / 1000.0;
+
     DWORD mhz = 0;
     DWORD bufSize = sizeof(DWORD);
     HKEY hKey;
@@ -77,20 +52,22 @@ double CompactCPU::getClockSpeed()
     return static_cast<double>(mhz) / 1000.0;
 }
 
-//---------------- Get CPU Usage (%) Using PDH ------------------
-double CompactCPU::getUsagePercent()
+//---------------- Get CPU Clock Range ------------------
+std::string CompactCPU::getClockRange()
 {
-    PDH_HQUERY query;
-    PDH_HCOUNTER counter;
-    PDH_FMT_COUNTERVALUE counterVal;
+    PROFILE_SCOPE("CompactCPU::getClockRange");
+    CpuSampler::ClockStats clocks = CpuSampler::instance().clockStats();
+    if (clocks.samples == 0 || clocks.minMHz <= 0.0f) return "";
 
-    PdhOpenQuery(nullptr, 0, &query);
-    PdhAddCounter(query, L"\\Processor(_Total)\\% Processor Time", 0, &counter);
-    PdhCollectQueryData(query);
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
-    PdhCollectQueryData(query);
-    PdhGetFormattedCounterValue(counter, PDH_FMT_DOUBLE, nullptr, &counterVal);
-    double usage = counterVal.doubleValue;
-    PdhCloseQuery(query);
-    return usage;
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(2) << clocks.minMHz / 1000.0f << "-" << clocks.maxMHz / 1000.0f << " GHz, "
+        << std::setprecision(0) << clocks.atMaxPercent << "% max";
+    return ss.str();
+}
+
+//---------------- Get CPU Usage (%) ------------------
+double CompactCPU::getUsagePercent()
+{
+    PROFILE_SCOPE("CompactCPU::getUsagePercent");
+    return CpuSampler::instance().usagePercent();
 }
@@ -6,6 +6,7 @@ public:
     std::string getCPUName();
     std::string getCPUCores();      // returns "6" (core)
     std::string getCPUThreads();    // returns "12" (threds)
-    double getClockSpeed();         // returns 4.40 (ghz)
+    double getClockSpeed();         // returns 4.40 (ghz, average over the sampler window)
+    std::string getClockRange();    // returns "3.80-4.70 GHz, 62% max" ("" before the first clock sample)
     double getUsagePercent();       // returns 12.5 (usage in double)
 };
@@ -1,4 +1,5 @@
 #include "CompactNetwork.h"
+#include "Profiler.h"
 #include <string>
 #include <vector>
 #include <winsock2.h>
@@ -15,6 +16,7 @@
 // ------------------- Public Functions -------------------
 
 std::string CompactNetwork::get_network_name() {
+    PROFILE_SCOPE("CompactNetwork::get_network_name");
     std::string ssidName = get_wifi_ssid();
     if (!ssidName.empty()) return ssidName;
 
@@ -23,10 +25,12 @@ std::string CompactNetwork::get_network_name() {
 }
 
 std::string CompactNetwork::get_network_type() {
+    PROFILE_SCOPE("CompactNetwork::get_network_type");
     return !get_wifi_ssid().empty() ? "WiFi" : "Ethernet";
 }
 
 std::string CompactNetwork::get_network_ip() {
+    PROFILE_SCOPE("CompactNetwork::get_network_ip");
     WSADATA wsaData;
     if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) return "Unknown";
 
@@ -62,6 +66,7 @@ std::string CompactNetwork::get_network_ip() {
 // ------------------- Private Helpers -------------------
 
 std::string CompactNetwork::get_wifi_ssid() {
+    PROFILE_SCOPE("CompactNetwork::get_wifi_ssid");
     HANDLE hClient = NULL;
     DWORD dwMaxClient = 2;
     DWORD dwCurVersion = 0;
@@ -98,6 +103,7 @@ std::string CompactNetwork::get_wifi_ssid() {
 }
 
 std::string CompactNetwork::get_ethernet_name() {
+    PROFILE_SCOPE("CompactNetwork::get_ethernet_name");
     ULONG size = 0;
     if (GetAdaptersInfo(nullptr, &size) != ERROR_BUFFER_OVERFLOW) return "";
     std::vector<BYTE> buffer(size);
@@ -1,4 +1,5 @@
 #include "CompactOS.h"
+#include "Profiler.h"
 #include <sstream>
 #include <iomanip>
 #include <Windows.h>
@@ -10,6 +11,7 @@ typedef LONG(WINAPI* RtlGetVersionPtr)(PRTL_OSVERSIONINFOEXW);
 //---------------- Get OS Name ------------------
 std::string CompactOS::getOSName()
 {
+    PROFILE_SCOPE("CompactOS::getOSName");
     RTL_OSVERSIONINFOEXW rovi = { 0 };
     rovi.dwOSVersionInfoSize = sizeof(rovi);
 
@@ -44,6 +46,7 @@ std::string CompactOS::getOSName()
 //---------------- Get OS Build ------------------
 std::string CompactOS::getOSBuild()
 {
+    PROFILE_SCOPE("CompactOS::getOSBuild");
     RTL_OSVERSIONINFOEXW rovi = { 0 };
     rovi.dwOSVersionInfoSize = sizeof(rovi);
 
@@ -63,6 +66,7 @@ std::string CompactOS::getOSBuild()
 //---------------- Get OS Uptime -----------------
 std::string CompactOS::getUptime()
 {
+    PROFILE_SCOPE("CompactOS::getUptime");
     ULONGLONG ms = GetTickCount64();
     ULONGLONG seconds = ms / 1000;
     int days = (int)(seconds / 86400);
@@ -79,6 +83,7 @@ std::string CompactOS::getUptime()
 //---------------- Get System Architecture -------
 std::string CompactOS::getArchitecture()
 {
+    PROFILE_SCOPE("CompactOS::getArchitecture");
     SYSTEM_INFO si = { 0 };
     GetNativeSystemInfo(&si);
 
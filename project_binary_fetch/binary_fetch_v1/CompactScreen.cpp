@@ -1,4 +1,5 @@
 ﻿#include "CompactScreen.h"
+#include "Profiler.h"
 
 #include <windows.h>
 #include <dxgi1_6.h>
@@ -29,10 +30,12 @@ static std::string WideToUtf8(const wchar_t* w) {
 }
 
 CompactScreen::CompactScreen() {
+    PROFILE_SCOPE("CompactScreen::CompactScreen");
     refresh();
 }
 
 bool CompactScreen::refresh() {
+    PROFILE_SCOPE("CompactScreen::refresh");
     screens.clear();
     if (!populateFromDXGI()) return false;
     enrichWithNVAPI();
@@ -129,6 +132,7 @@ CompactScreen::EDIDInfo CompactScreen::parseEDID(const unsigned char* edid, size
 }
 
 std::string CompactScreen::getFriendlyNameFromEDID(const std::wstring& deviceName) {
+    PROFILE_SCOPE("CompactScreen::getFriendlyNameFromEDID");
     // Attempt to derive the monitor hardware ID for this DXGI device name.
     // This improves matching against the registry entries under
     // SYSTEM\\CurrentControlSet\\Enum\\DISPLAY\\<vendor>\\<instance>\\Device Parameters\\EDID
@@ -262,6 +266,7 @@ std::string CompactScreen::getFriendlyNameFromEDID(const std::wstring& deviceNam
 }
 
 bool CompactScreen::populateFromDXGI() {
+    PROFILE_SCOPE("CompactScreen::populateFromDXGI");
     IDXGIFactory1* factory = nullptr;
     if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&factory)))) return false;
 
@@ -481,6 +486,7 @@ bool CompactScreen::populateFromDXGI() {
 }
 
 bool CompactScreen::enrichWithNVAPI() {
+    PROFILE_SCOPE("CompactScreen::enrichWithNVAPI");
 #ifdef USE_NVAPI
     // NVAPI integration can be added here for more accurate DSR detection
 #endif
@@ -488,6 +494,7 @@ bool CompactScreen::enrichWithNVAPI() {
 }
 
 bool CompactScreen::enrichWithADL() {
+    PROFILE_SCOPE("CompactScreen::enrichWithADL");
 #ifdef USE_ADL
     // ADL integration can be added here for more accurate VSR detection
 #endif
@@ -1,66 +1,27 @@
 #include "CompactSystem.h"
-#include <windows.h>
+#include "StaticFactsCache.h"
+#include "Profiler.h"
+#include "Smbios.h"
 #include <string>
-#include <iostream>
 
-std::string readRegistryValue(HKEY root, const std::string& subkey, const std::string& valueName) {
-    HKEY hKey;
-    if (RegOpenKeyExA(root, subkey.c_str(), 0, KEY_READ, &hKey) != ERROR_SUCCESS)
-        return "Unknown";
-
-    char value[256];
-    DWORD value_length = sizeof(value);
-    DWORD type = 0;
-
-    if (RegQueryValueExA(hKey, valueName.c_str(), nullptr, &type, reinterpret_cast<LPBYTE>(value), &value_length) != ERROR_SUCCESS) {
-        RegCloseKey(hKey);
-        return "Unknown";
-    }
-
-    RegCloseKey(hKey);
-
-    if (type == REG_SZ || type == REG_EXPAND_SZ)
-        return std::string(value);
-    else
-        return "Unknown";
+static std::string orUnknown(const std::string& value) {
+    return value.empty() ? "Unknown" : value;
 }
 
 std::string CompactSystem::getBIOSInfo() {
-    // Registry paths for BIOS
-    std::string biosVersion = readRegistryValue(
-        HKEY_LOCAL_MACHINE,
-        "HARDWARE\\DESCRIPTION\\System\\BIOS",
-        "BIOSVersion"
-    );
-
-    std::string biosVendor = readRegistryValue(
-        HKEY_LOCAL_MACHINE,
-        "HARDWARE\\DESCRIPTION\\System\\BIOS",
-        "BIOSVendor"
-    );
-
-    std::string biosDate = readRegistryValue(
-        HKEY_LOCAL_MACHINE,
-        "HARDWARE\\DESCRIPTION\\System\\BIOS",
-        "BIOSReleaseDate"
-    );
-
-    return biosVendor + " " + biosVersion + " (" + biosDate + ")";
+    PROFILE_SCOPE("CompactSystem::getBIOSInfo");
+    return StaticFactsCache::instance().getOrCompute("compact.bios", []() -> std::string {
+        // SMBIOS type 0, same parse SystemInfo reads
+        const Smbios& smbios = Smbios::current();
+        return orUnknown(smbios.biosVendor) + " " + orUnknown(smbios.biosVersion) + " (" + orUnknown(smbios.biosDate) + ")";
+    });
 }
 
 std::string CompactSystem::getMotherboardInfo() {
-    // Registry paths for Motherboard (BaseBoard)
-    std::string boardProduct = readRegistryValue(
-        HKEY_LOCAL_MACHINE,
-        "HARDWARE\\DESCRIPTION\\System\\BIOS",
-        "BaseBoardProduct"
-    );
-
-    std::string boardManufacturer = readRegistryValue(
-        HKEY_LOCAL_MACHINE,
-        "HARDWARE\\DESCRIPTION\\System\\BIOS",
-        "BaseBoardManufacturer"
-    );
-
-    return boardManufacturer + " " + boardProduct;
+    PROFILE_SCOPE("CompactSystem::getMotherboardInfo");
+    return StaticFactsCache::instance().getOrCompute("compact.board", []() -> std::string {
+        // SMBIOS type 2 (baseboard)
+        const Smbios& smbios = Smbios::current();
+        return orUnknown(smbios.boardManufacturer) + " " + orUnknown(smbios.boardProduct);
+    });
 }
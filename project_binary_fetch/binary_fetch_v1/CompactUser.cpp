@@ -1,4 +1,5 @@
 #include "CompactUser.h"
+#include "Profiler.h"
 #include <Windows.h>
 #include <lmcons.h>
 #include <iostream>
@@ -8,6 +9,7 @@ using namespace std;
 
 string CompactUser::getUsername()
 {
+	PROFILE_SCOPE("CompactUser::getUsername");
 	char username[UNLEN + 1];
 	DWORD size = UNLEN + 1;
 	if (GetUserNameA(username, &size))
@@ -17,6 +19,7 @@ string CompactUser::getUsername()
 }
 
 std::string CompactUser::getDomain() {
+    PROFILE_SCOPE("CompactUser::getDomain");
     char computerName[MAX_COMPUTERNAME_LENGTH + 1];
     DWORD size = MAX_COMPUTERNAME_LENGTH + 1;
     if (GetComputerNameA(computerName, &size))
@@ -25,6 +28,7 @@ std::string CompactUser::getDomain() {
 }
 
 std::string CompactUser::isAdmin() {
+    PROFILE_SCOPE("CompactUser::isAdmin");
     BOOL isAdmin = FALSE;
     HANDLE hToken = NULL;
     DWORD size = 0;
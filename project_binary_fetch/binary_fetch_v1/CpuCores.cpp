@@ -0,0 +1,120 @@
+#include "CpuCores.h"
+#include "CpuSampler.h"
+#include "Profiler.h"
+#include <thread>
+
+size_t CpuCores::count() {
+    PROFILE_SCOPE("CpuCores::count");
+    size_t n = CpuSampler::instance().coreCount();
+    return n > 0 ? n : std::thread::hardware_concurrency();
+}
+
+std::vector<float> CpuCores::usagePercent() {
+    PROFILE_SCOPE("CpuCores::usagePercent");
+    std::vector<float> usage = CpuSampler::instance().coreUsagePercent();
+    usage.resize(count(), -1.0f);
+    return usage;
+}
+
+
+// ---------------- Clocks ----------------
+
+// Both come from CpuSampler's clock ring (CallNtPowerInformation, APERF /
+// MPERF or scaling_cur_freq), the same readings compact_cpu / cpu_info summarize
+
+std::vector<float> CpuCores::currentMHz() {
+    PROFILE_SCOPE("CpuCores::currentMHz");
+    CpuSampler& sampler = CpuSampler::instance();
+    sampler.trackClocks();
+    std::vector<float> mhz = sampler.coreClockMHz();
+    mhz.resize(count(), -1.0f);
+    return mhz;
+}
+
+std::vector<float> CpuCores::maxMHz() {
+    PROFILE_SCOPE("CpuCores::maxMHz");
+    CpuSampler& sampler = CpuSampler::instance();
+    sampler.trackClocks();
+    std::vector<float> mhz = sampler.coreMaxMHz();
+    mhz.resize(count(), -1.0f);
+    return mhz;
+}
+
+
+// ---------------- Rendering ----------------
+
+std::string CpuCores::heatRow(const std::vector<float>& values, const std::vector<float>& full, float fullScale,
+    size_t begin, size_t end, const Palette& palette) {
+    // U+2581 .. U+2588, lower one eighth block .. full block
+    static const char* const levels[8] = {
+        "\xE2\x96\x81", "\xE2\x96\x82", "\xE2\x96\x83", "\xE2\x96\x84",
+        "\xE2\x96\x85", "\xE2\x96\x86", "\xE2\x96\x87", "\xE2\x96\x88"
+    };
+    static const char* const offline = "\xC2\xB7";   // middle dot
+
+    std::string out;
+    const std::string* current = nullptr;
+    if (end > values.size()) end = values.size();
+
+    for (size_t i = begin; i < end; ++i) {
+        float scale = (i < full.size() && full[i] > 0.0f) ? full[i] : fullScale;
+        if (values[i] < 0.0f || scale <= 0.0f) {
+            if (current) out += palette.reset;
+            current = nullptr;
+            out += offline;
+            continue;
+        }
+
+        float ratio = values[i] / scale;
+        if (ratio > 1.0f) ratio = 1.0f;
+        const std::string* band = ratio < 0.5f ? &palette.low : ratio < 0.8f ? &palette.mid : &palette.high;
+        if (band != current) {
+            out += *band;
+            current = band;
+        }
+        out += levels[static_cast<int>(ratio * 7.0f + 0.5f)];
+    }
+    if (current) out += palette.reset;
+    return out;
+}
+
+float CpuCores::average(const std::vector<float>& values) {
+    double sum = 0.0;
+    size_t n = 0;
+    for (float v : values) {
+        if (v >= 0.0f) {
+            sum += v;
+            n++;
+        }
+    }
+    return n > 0 ? static_cast<float>(sum / n) : -1.0f;
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: CpuCores
+OBJECT: cpu_cores (main.cpp, "cpu_cores" section)
+DESCRIPTION: Per-CPU load and clock, drawn as one glyph per CPU.
+FUNCTIONS:
+    size_t count()
+        Per-CPU slots the sampler tracks (hardware_concurrency if none).
+
+    std::vector<float> usagePercent()
+        CpuSampler::coreUsagePercent(), -1 for offline CPUs.
+
+    std::vector<float> currentMHz() / maxMHz()
+        Newest reading / ceiling from CpuSampler's clock ring
+        (CpuSampler::trackClocks() on first use). The ceiling is
+        read once by the sampler.
+
+    static std::string heatRow(values, full, fullScale, begin, end, palette)
+        One glyph per CPU: 8 block heights by values[i] / full[i],
+        low / mid / high color below 50 % / 80 % / above, a dot
+        for unknown values.
+
+    static float average(const std::vector<float>& values)
+        Mean of the known (>= 0) values.
+*/
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/*
+ ---------------------------------------------------------
+                     CpuCores Class
+ ---------------------------------------------------------
+
+  Per logical CPU view for the "cpu_cores" section: load
+  and clock both from the shared CpuSampler ring (clocks via
+  CpuSampler::trackClocks(), see CpuSampler.h for backends).
+
+  heatRow() turns one value per CPU into one glyph per CPU
+  (▁ .. █ by level, colored by band), so a 192-thread server
+  still fits on a few lines.
+
+  Vectors are indexed by CPU number; -1 = offline / unknown.
+*/
+class CpuCores {
+public:
+    size_t count();                          // CPUs in the view (highest CPU number + 1)
+
+    std::vector<float> usagePercent();       // 0..100 over the last second
+    std::vector<float> currentMHz();
+    std::vector<float> maxMHz();             // per CPU ceiling (read once by the sampler)
+
+    // Colors for the three bands of heatRow()
+    struct Palette {
+        std::string low;      // below 50 % of full
+        std::string mid;      // below 80 %
+        std::string high;
+        std::string reset;
+    };
+
+    // Glyphs for values[begin, end), each scaled against full[i]
+    // (or fullScale when full is empty). Color codes only change
+    // between bands, so a mostly idle row stays short.
+    static std::string heatRow(const std::vector<float>& values, const std::vector<float>& full, float fullScale,
+        size_t begin, size_t end, const Palette& palette);
+
+    // Mean of the non-negative entries, -1 if there are none
+    static float average(const std::vector<float>& values);
+};
@@ -0,0 +1,595 @@
+#include "CpuSampler.h"
+#include "Profiler.h"
+
+#include "CpuTopology.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <winternl.h>
+#include <powerbase.h>
+#pragma comment(lib, "PowrProf.lib")
+#else
+#include "SystemQuery.h"
+#include <string>
+#include <fstream>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+const unsigned CpuSampler::IntervalMs;
+const size_t CpuSampler::RingSize;
+const size_t CpuSampler::MaxCores;
+const unsigned CpuSampler::ClockPrimeMs;
+
+CpuSampler& CpuSampler::instance() {
+    static CpuSampler sampler;
+    return sampler;
+}
+
+CpuSampler::~CpuSampler() {
+    stop();
+}
+
+
+// ---------------- Parsing / delta math ----------------
+
+size_t CpuSampler::parseProcStat(const char* text, size_t length, uint64_t& aggregateBusy, uint64_t& aggregateTotal,
+    uint64_t* busy, uint64_t* total, size_t maxCores) {
+    size_t seen = 0;
+    const char* p = text;
+    const char* end = text + length;
+
+    // The cpu lines come first; stop at the first other line ("intr" can be huge)
+    while (end - p > 3 && p[0] == 'c' && p[1] == 'p' && p[2] == 'u') {
+        p += 3;
+        bool isAggregate = (*p == ' ');
+        size_t index = 0;
+        while (p < end && *p >= '0' && *p <= '9') index = index * 10 + static_cast<size_t>(*p++ - '0');
+
+        // user nice system idle iowait irq softirq steal [guest guest_nice]
+        uint64_t field[8] = { 0 };
+        for (int i = 0; i < 8; ++i) {
+            while (p < end && *p == ' ') ++p;
+            if (p >= end || *p < '0' || *p > '9') break;   // older kernels have fewer columns
+            uint64_t v = 0;
+            while (p < end && *p >= '0' && *p <= '9') v = v * 10 + static_cast<uint64_t>(*p++ - '0');
+            field[i] = v;
+        }
+        while (p < end && *p != '\n') ++p;
+        if (p < end) ++p;
+
+        // guest / guest_nice are already counted in user / nice
+        uint64_t sum = 0;
+        for (uint64_t v : field) sum += v;
+        uint64_t idle = field[3] + field[4];
+
+        if (isAggregate) {
+            aggregateTotal = sum;
+            aggregateBusy = sum - idle;
+        }
+        else {
+            if (index < maxCores) {
+                total[index] = sum;
+                busy[index] = sum - idle;
+            }
+            if (index + 1 > seen) seen = index + 1;
+        }
+    }
+    return seen;
+}
+
+uint64_t CpuSampler::parseContextSwitches(const char* text, size_t length) {
+    // ctxt follows the (possibly very long) intr line; skip line to line
+    const char* p = text;
+    const char* end = text + length;
+    while (p < end) {
+        if (end - p > 5 && p[0] == 'c' && p[1] == 't' && p[2] == 'x' && p[3] == 't' && p[4] == ' ') {
+            p += 5;
+            uint64_t v = 0;
+            while (p < end && *p >= '0' && *p <= '9') v = v * 10 + static_cast<uint64_t>(*p++ - '0');
+            return v;
+        }
+        const char* next = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!next) break;
+        p = next + 1;
+    }
+    return 0;
+}
+
+void CpuSampler::coreDeltaKernel(const uint64_t* busyNew, const uint64_t* busyOld,
+    const uint64_t* totalNew, const uint64_t* totalOld, float* out, size_t n) {
+    // A window is at most RingSize * IntervalMs (4 s), so per-CPU deltas fit in
+    // 31 bits in either backend's units; narrowing first keeps every lane 32-bit.
+    // valid is 0/1 arithmetic instead of a branch so the loop vectorizes.
+    for (size_t i = 0; i < n; ++i) {
+        int32_t dt = static_cast<int32_t>(totalNew[i] - totalOld[i]);
+        int32_t db = static_cast<int32_t>(busyNew[i] - busyOld[i]);
+        int32_t valid = dt > 0;
+        float share = 100.0f * static_cast<float>(db) / static_cast<float>(dt * valid + (1 - valid));
+        out[i] = share * static_cast<float>(valid) + static_cast<float>(valid - 1);
+    }
+}
+
+
+CpuSampler::ClockStats CpuSampler::clockSummary(const float* mhz, size_t samples, size_t cores, const float* ceiling) {
+    ClockStats stats;
+    float lo = 0.0f, hi = 0.0f;
+    double sum = 0.0;
+    size_t n = 0;
+    for (size_t i = 0; i < samples * cores; ++i) {
+        float v = mhz[i];
+        if (v <= 0.0f) continue;
+        if (n == 0 || v < lo) lo = v;
+        if (n == 0 || v > hi) hi = v;
+        sum += v;
+        n++;
+    }
+    if (n == 0) return stats;
+
+    // "At max" = within 5 % of the CPU's own ceiling, so a hybrid part's
+    // E-cores count as boosting at their (lower) top clock
+    size_t atMax = 0;
+    for (size_t s = 0; s < samples; ++s) {
+        for (size_t c = 0; c < cores; ++c) {
+            float v = mhz[s * cores + c];
+            float top = (ceiling && ceiling[c] > 0.0f) ? ceiling[c] : hi;
+            if (v > 0.0f && v >= top * 0.95f) atMax++;
+        }
+    }
+
+    stats.minMHz = lo;
+    stats.maxMHz = hi;
+    stats.avgMHz = static_cast<float>(sum / static_cast<double>(n));
+    stats.atMaxPercent = 100.0f * static_cast<float>(atMax) / static_cast<float>(n);
+    stats.samples = samples;
+    return stats;
+}
+
+
+// ---------------- Backends ----------------
+
+#ifdef _WIN32
+
+static uint64_t fileTimeValue(const FILETIME& ft) {
+    return (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+}
+
+typedef LONG(WINAPI* NtQuerySystemInformationPtr)(SYSTEM_INFORMATION_CLASS, PVOID, ULONG, PULONG);
+
+static NtQuerySystemInformationPtr ntQuerySystemInformation() {
+    static NtQuerySystemInformationPtr fn = reinterpret_cast<NtQuerySystemInformationPtr>(
+        GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtQuerySystemInformation"));
+    return fn;
+}
+
+// Per-CPU counters cover the calling thread's processor group (up to 64 CPUs)
+size_t CpuSampler::probeCores() {
+    if (!ntQuerySystemInformation()) return 0;
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors;
+}
+
+bool CpuSampler::read(Sample& out, uint64_t* busy, uint64_t* total) {
+    FILETIME idle, kernel, user;
+    if (!GetSystemTimes(&idle, &kernel, &user)) return false;
+
+    // Kernel time already includes the idle time (100 ns units)
+    out.total = fileTimeValue(kernel) + fileTimeValue(user);
+    out.busy = out.total - fileTimeValue(idle);
+    out.at = Clock::now();
+
+    if (busy && cores > 0) {
+        SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION perCpu[64];
+        ULONG size = static_cast<ULONG>(sizeof(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION) * (std::min)(cores, static_cast<size_t>(64)));
+        ULONG returned = 0;
+        if (ntQuerySystemInformation()(SystemProcessorPerformanceInformation, perCpu, size, &returned) >= 0) {
+            size_t n = returned / sizeof(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION);
+            for (size_t i = 0; i < n && i < cores; ++i) {
+                total[i] = static_cast<uint64_t>(perCpu[i].KernelTime.QuadPart + perCpu[i].UserTime.QuadPart);
+                busy[i] = total[i] - static_cast<uint64_t>(perCpu[i].IdleTime.QuadPart);
+            }
+        }
+    }
+    return true;
+}
+
+// Documented layout, but not declared in any SDK header
+struct ProcessorPowerInformation {
+    ULONG Number;
+    ULONG MaxMhz;
+    ULONG CurrentMhz;
+    ULONG MhzLimit;
+    ULONG MaxIdleState;
+    ULONG CurrentIdleState;
+};
+
+static bool powerInformation(std::vector<ProcessorPowerInformation>& info) {
+    ULONG size = static_cast<ULONG>(info.size() * sizeof(ProcessorPowerInformation));
+    return CallNtPowerInformation(ProcessorInformation, nullptr, 0, info.data(), size) == 0;
+}
+
+void CpuSampler::probeClockSource() {
+    std::vector<ProcessorPowerInformation> info(cores);
+    clockCeiling.assign(cores, -1.0f);
+    if (!powerInformation(info)) return;
+    for (const auto& p : info) {
+        if (p.Number < cores) clockCeiling[p.Number] = static_cast<float>(p.MaxMhz);
+    }
+}
+
+bool CpuSampler::readClocks(float* mhz) {
+    std::vector<ProcessorPowerInformation> info(cores);
+    if (!powerInformation(info)) return false;
+    std::fill(mhz, mhz + cores, -1.0f);
+    for (const auto& p : info) {
+        if (p.Number < cores) mhz[p.Number] = static_cast<float>(p.CurrentMhz);
+    }
+    return true;
+}
+
+#else
+
+size_t CpuSampler::probeCores() {
+    std::string stat = SystemQuery::instance().readFile("/proc/stat");
+    uint64_t b = 0, t = 0;
+    return parseProcStat(stat.data(), stat.size(), b, t, nullptr, nullptr, 0);
+}
+
+bool CpuSampler::read(Sample& out, uint64_t* busy, uint64_t* total) {
+    std::string stat = SystemQuery::instance().readFile("/proc/stat");
+    if (stat.compare(0, 4, "cpu ") != 0) return false;
+
+    parseProcStat(stat.data(), stat.size(), out.busy, out.total, busy, total, busy ? cores : 0);
+    out.switches = parseContextSwitches(stat.data(), stat.size());
+    out.at = Clock::now();
+    return true;
+}
+
+static const off_t MsrMperf = 0xE7;
+static const off_t MsrAperf = 0xE8;
+
+void CpuSampler::probeClockSource() {
+    clockCeiling.assign(cores, -1.0f);
+    for (size_t i = 0; i < cores; ++i) {
+        std::ifstream f("/sys/devices/system/cpu/cpu" + std::to_string(i) + "/cpufreq/cpuinfo_max_freq");
+        std::string khz;
+        if (std::getline(f, khz) && !khz.empty()) clockCeiling[i] = static_cast<float>(std::strtod(khz.c_str(), nullptr) / 1000.0);
+    }
+
+    // APERF / MPERF give the average clock *between* two readings, not a
+    // point sample; MPERF ticks at the nominal (base) rate
+    nominalMHz = static_cast<float>(CpuTopology::current().baseMHz);
+    int first = nominalMHz > 0.0f ? open("/dev/cpu/0/msr", O_RDONLY | O_CLOEXEC) : -1;
+    if (first < 0) return;
+
+    msrFd.assign(cores, -1);
+    msrFd[0] = first;
+    for (size_t i = 1; i < cores; ++i) {
+        msrFd[i] = open(("/dev/cpu/" + std::to_string(i) + "/msr").c_str(), O_RDONLY | O_CLOEXEC);
+    }
+    lastAperf.assign(cores, 0);
+    lastMperf.assign(cores, 0);
+}
+
+bool CpuSampler::readClocks(float* mhz) {
+    if (!msrFd.empty()) {
+        for (size_t i = 0; i < cores; ++i) {
+            uint64_t aperf = 0, mperf = 0;
+            mhz[i] = -1.0f;
+            if (msrFd[i] < 0 || pread(msrFd[i], &aperf, sizeof(aperf), MsrAperf) != sizeof(aperf)
+                || pread(msrFd[i], &mperf, sizeof(mperf), MsrMperf) != sizeof(mperf)) {
+                continue;
+            }
+            uint64_t da = aperf - lastAperf[i];
+            uint64_t dm = mperf - lastMperf[i];
+            if (lastMperf[i] != 0 && dm > 0) mhz[i] = static_cast<float>(nominalMHz * static_cast<double>(da) / static_cast<double>(dm));
+            lastAperf[i] = aperf;
+            lastMperf[i] = mperf;
+        }
+        return true;
+    }
+
+    bool any = false;
+    for (size_t i = 0; i < cores; ++i) {
+        std::string khz = SystemQuery::instance().readFile("/sys/devices/system/cpu/cpu" + std::to_string(i) + "/cpufreq/scaling_cur_freq");
+        mhz[i] = khz.empty() ? -1.0f : static_cast<float>(std::strtod(khz.c_str(), nullptr) / 1000.0);
+        any = any || !khz.empty();
+    }
+    return any;
+}
+
+#endif
+
+
+// ---------------- Sampling thread ----------------
+
+void CpuSampler::start() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (running) return;
+
+    cores = (std::min)(probeCores(), MaxCores);
+    coreBusy.assign(RingSize * cores, 0);
+    coreTotal.assign(RingSize * cores, 0);
+    scratchBusy.assign(cores, 0);
+    scratchTotal.assign(cores, 0);
+
+    Sample first;
+    if (!read(first, coreBusy.data(), coreTotal.data())) return;    // no counters: usagePercent() reports -1
+    ring[0] = first;
+    head = 1;
+    count = 1;
+
+    running = true;
+    worker = std::thread(&CpuSampler::loop, this);
+}
+
+void CpuSampler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!running) return;
+        running = false;
+    }
+    wake.notify_all();
+    if (worker.joinable()) worker.join();
+
+#ifndef _WIN32
+    for (int fd : msrFd) if (fd >= 0) close(fd);
+    msrFd.clear();
+#endif
+}
+
+void CpuSampler::trackClocks() {
+    std::lock_guard<std::mutex> probeLock(clockProbeMtx);
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (clocksOn || !running || cores == 0) return;
+    }
+
+    // Opening the MSRs and reading cpufreq is file I/O: do it without mtx so
+    // the sampler thread and the usage getters don't stall behind it. The
+    // thread only touches the clock state once clocksOn is set below.
+    probeClockSource();
+    std::vector<float> first(cores, -1.0f);
+    bool ok = readClocks(first.data());
+
+    // APERF / MPERF give the clock between two readings, so the first one
+    // only primes the counters; take the second after a short gap so a
+    // one-shot fetch has real values too
+    if (ok && !msrFd.empty()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ClockPrimeMs));
+        ok = readClocks(first.data());
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    coreClock.assign(RingSize * cores, -1.0f);
+    scratchClock.assign(cores, -1.0f);
+
+    // It goes with the newest CPU sample (the thread isn't reading clocks yet)
+    size_t newest = (head + RingSize - 1) % RingSize;
+    if (ok) std::copy(first.begin(), first.end(), coreClock.begin() + newest * cores);
+    clockValid[newest] = ok;
+    clocksOn = true;
+}
+
+void CpuSampler::loop() {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (running) {
+        if (wake.wait_for(lock, std::chrono::milliseconds(IntervalMs), [this] { return !running; })) break;
+
+        // Only this thread touches the scratch arrays, so the OS read runs unlocked
+        bool clocks = clocksOn;
+        lock.unlock();
+        Sample s;
+        bool ok = read(s, scratchBusy.data(), scratchTotal.data());
+        bool clockOk = clocks && readClocks(scratchClock.data());
+        lock.lock();
+
+        if (ok) {
+            ring[head] = s;
+            std::copy(scratchBusy.begin(), scratchBusy.end(), coreBusy.begin() + head * cores);
+            std::copy(scratchTotal.begin(), scratchTotal.end(), coreTotal.begin() + head * cores);
+            if (clockOk) std::copy(scratchClock.begin(), scratchClock.end(), coreClock.begin() + head * cores);
+            clockValid[head] = clockOk;
+            head = (head + 1) % RingSize;
+            if (count < RingSize) count++;
+            wake.notify_all();
+        }
+    }
+}
+
+
+// ---------------- Readers ----------------
+
+void CpuSampler::window(unsigned windowMs, size_t& newest, size_t& oldest) const {
+    newest = (head + RingSize - 1) % RingSize;
+    oldest = newest;
+    for (size_t back = 1; back < count; ++back) {
+        oldest = (head + RingSize - 1 - back) % RingSize;
+        if (ring[newest].at - ring[oldest].at >= std::chrono::milliseconds(windowMs)) break;
+    }
+}
+
+double CpuSampler::usagePercent(unsigned windowMs) {
+    PROFILE_SCOPE("CpuSampler::usagePercent");
+    std::unique_lock<std::mutex> lock(mtx);
+    if (count == 0) return -1.0;
+
+    size_t newestSlot, oldestSlot;
+    window(windowMs, newestSlot, oldestSlot);
+    Sample oldest = ring[oldestSlot];
+    Sample latest = ring[newestSlot];
+
+    if (count == 1) {
+        // Asked before the first interval passed: compare a fresh reading with
+        // the launch sample. If the OS counters haven't ticked yet (~15 ms on
+        // Windows), wait for the sampler's next reading instead.
+        lock.unlock();
+        bool ok = read(latest, nullptr, nullptr);
+        lock.lock();
+        if (!ok || latest.total == oldest.total) {
+            wake.wait_for(lock, std::chrono::milliseconds(IntervalMs * 2), [this] { return count > 1 || !running; });
+            if (count > 1) latest = ring[(head + RingSize - 1) % RingSize];
+        }
+    }
+
+    uint64_t total = latest.total - oldest.total;
+    if (total == 0) return 0.0;
+    double usage = 100.0 * static_cast<double>(latest.busy - oldest.busy) / static_cast<double>(total);
+    if (usage < 0.0) usage = 0.0;
+    if (usage > 100.0) usage = 100.0;
+    return usage;
+}
+
+std::vector<float> CpuSampler::coreUsagePercent(unsigned windowMs) {
+    PROFILE_SCOPE("CpuSampler::coreUsagePercent");
+    std::unique_lock<std::mutex> lock(mtx);
+    if (cores == 0 || count == 0) return {};
+
+    // Per-CPU deltas need two ring slots; right after launch wait for the second one
+    if (count < 2) {
+        wake.wait_for(lock, std::chrono::milliseconds(IntervalMs * 2), [this] { return count > 1 || !running; });
+        if (count < 2) return std::vector<float>(cores, -1.0f);
+    }
+
+    size_t newestSlot, oldestSlot;
+    window(windowMs, newestSlot, oldestSlot);
+
+    std::vector<float> out(cores);
+    coreDeltaKernel(&coreBusy[newestSlot * cores], &coreBusy[oldestSlot * cores],
+        &coreTotal[newestSlot * cores], &coreTotal[oldestSlot * cores], out.data(), cores);
+    return out;
+}
+
+size_t CpuSampler::coreCount() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return cores;
+}
+
+CpuSampler::ClockStats CpuSampler::clockStats(unsigned windowMs) {
+    PROFILE_SCOPE("CpuSampler::clockStats");
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!clocksOn || count == 0) return ClockStats();
+
+    // Gather the window's clock slots into one flat block (at most RingSize * cores)
+    size_t newestSlot, oldestSlot;
+    window(windowMs, newestSlot, oldestSlot);
+    std::vector<float> block;
+    size_t samples = 0;
+    for (size_t slot = oldestSlot;; slot = (slot + 1) % RingSize) {
+        if (clockValid[slot]) {
+            block.insert(block.end(), coreClock.begin() + slot * cores, coreClock.begin() + (slot + 1) * cores);
+            samples++;
+        }
+        if (slot == newestSlot) break;
+    }
+    return clockSummary(block.data(), samples, cores, clockCeiling.data());
+}
+
+std::vector<float> CpuSampler::coreClockMHz() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!clocksOn || count == 0) return {};
+
+    // Newest slot that has a clock reading
+    for (size_t back = 0; back < count; ++back) {
+        size_t slot = (head + RingSize - 1 - back) % RingSize;
+        if (clockValid[slot]) return std::vector<float>(coreClock.begin() + slot * cores, coreClock.begin() + (slot + 1) * cores);
+    }
+    return std::vector<float>(cores, -1.0f);
+}
+
+std::vector<float> CpuSampler::coreMaxMHz() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!clocksOn) return {};
+    return clockCeiling;
+}
+
+double CpuSampler::switchRate(unsigned windowMs) {
+    PROFILE_SCOPE("CpuSampler::switchRate");
+    std::unique_lock<std::mutex> lock(mtx);
+    if (count == 0) return -1.0;
+
+    size_t newestSlot, oldestSlot;
+    window(windowMs, newestSlot, oldestSlot);
+    Sample oldest = ring[oldestSlot];
+    Sample latest = ring[newestSlot];
+    if (oldest.switches == 0) return -1.0;
+
+    if (count == 1) {
+        // ctxt is an exact counter, so a fresh reading a few ms after the
+        // launch sample already gives a usable rate; closer than that, wait
+        lock.unlock();
+        bool ok = read(latest, nullptr, nullptr);
+        lock.lock();
+        if (!ok || latest.at - oldest.at < std::chrono::milliseconds(10)) {
+            wake.wait_for(lock, std::chrono::milliseconds(IntervalMs * 2), [this] { return count > 1 || !running; });
+            if (count < 2) return -1.0;
+            latest = ring[(head + RingSize - 1) % RingSize];
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(latest.at - oldest.at).count();
+    if (seconds <= 0.0 || latest.switches < oldest.switches) return -1.0;
+    return static_cast<double>(latest.switches - oldest.switches) / seconds;
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: CpuSampler (singleton)
+OBJECT: CpuSampler::instance(), started in main.cpp; read by
+        CPUInfo::get_cpu_utilization, CompactCPU::getUsagePercent,
+        CompactPerformance::getCPUUsage, PerformanceInfo::get_cpu_usage_percent,
+        CpuCores (cpu_cores heat row), PressureInfo (context switch rate)
+DESCRIPTION: Background CPU time sampler so usage getters never sleep.
+FUNCTIONS:
+    void start()
+        First reading + sampling thread (every IntervalMs = 250 ms).
+
+    void stop()
+        Wake and join the thread.
+
+    double usagePercent(unsigned windowMs = 1000)
+        (busy delta / total delta) between the newest sample and the
+        oldest one within windowMs. -1 if the counters are unreadable.
+
+    std::vector<float> coreUsagePercent(unsigned windowMs = 1000)
+        Same per logical CPU via coreDeltaKernel (-1 = offline).
+
+    void trackClocks() / ClockStats clockStats(unsigned windowMs = 2000)
+        Per-CPU effective clocks recorded with every reading from then on
+        (APERF / MPERF, scaling_cur_freq or CallNtPowerInformation),
+        summarized by clockSummary over the window. Used by
+        CompactCPU::getClockSpeed and CPUInfo::get_cpu_speed.
+        trackClocks() probes the backend without holding mtx; with
+        APERF / MPERF it reads twice, ClockPrimeMs (20 ms) apart, so the
+        first slot already has a clock.
+
+    std::vector<float> coreClockMHz() / coreMaxMHz()
+        Newest per-CPU reading and per-CPU ceiling from the same ring,
+        for CpuCores (cpu_cores "Core clock" row).
+
+    double switchRate(unsigned windowMs = 1000)
+        Context switches / s from the "ctxt" values stored in the same
+        ring (Linux). Used by PressureInfo, so --watch never re-reads
+        /proc/stat for it.
+
+    static size_t parseProcStat(text, length, aggBusy, aggTotal, busy, total, maxCores)
+    static void coreDeltaKernel(busyNew, busyOld, totalNew, totalOld, out, n)
+    static uint64_t parseContextSwitches(text, length)
+    static ClockStats clockSummary(mhz, samples, cores, ceiling)
+        Parsing and delta math, public so the tests can run them on fixtures.
+
+RING BUFFER:
+    RingSize = 16 samples (4 s), a fixed array; old samples are
+    overwritten in place. Per-CPU counters: coreBusy / coreTotal hold
+    RingSize * cores values each, slot k starting at k * cores.
+    coreClock uses the same layout; clockValid marks the slots that
+    have a clock reading (taken after trackClocks()).
+*/
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+/*
+ ---------------------------------------------------------
+                    CpuSampler Class
+ ---------------------------------------------------------
+
+  Every CPU usage getter used to take its own two readings
+  with a sleep in between (100-500 ms each, several times per
+  fetch). CpuSampler is started as soon as main() has parsed
+  the command line and records the CPU time counters every
+  IntervalMs on a background thread:
+
+    Windows : GetSystemTimes (all CPUs) and
+              NtQuerySystemInformation (per CPU)
+    Linux   : /proc/stat, "cpu" and "cpuN" lines (kept-open fd),
+              plus the "ctxt" context switch counter
+
+  The last RingSize readings live in a ring buffer, so
+  usagePercent() just compares two of them and returns at
+  once. Only a getter that runs before the first interval has
+  passed takes a fresh reading of its own.
+
+  Per-CPU counters are kept as structure-of-arrays (one busy
+  and one total array per ring slot), so the per-core delta
+  for hundreds of CPUs is one tight loop over flat memory.
+
+  Once trackClocks() is called, every reading also records
+  each CPU's effective clock into the same ring slots:
+
+    Windows : CallNtPowerInformation(ProcessorInformation)
+    Linux   : APERF / MPERF deltas from /dev/cpu/N/msr when
+              readable (root + msr module), else
+              cpuN/cpufreq/scaling_cur_freq
+
+  clockStats() then summarizes the window (min / avg / max,
+  share of samples at the top clock) instead of reporting one
+  instantaneous value that may have caught a turbo spike or a
+  power-capped dip. CpuCores reads the per-CPU values from the
+  same ring, so there is one clock source per process.
+*/
+class CpuSampler {
+public:
+    static const unsigned IntervalMs = 250;
+    static const size_t RingSize = 16;          // 4 s of history
+    static const size_t MaxCores = 4096;        // sanity cap for the per-CPU arrays
+    static const unsigned ClockPrimeMs = 20;    // APERF / MPERF: gap between the first two readings
+
+    static CpuSampler& instance();
+
+    // Start the sampling thread (takes the first reading right away). Idempotent.
+    void start();
+
+    // Stop and join the thread (also done on destruction)
+    void stop();
+
+    // Busy share of all CPUs over (at most) the last windowMs, 0..100.
+    // -1 if the counters can't be read on this system.
+    double usagePercent(unsigned windowMs = 1000);
+
+    // Same per logical CPU, indexed by CPU number. Offline CPUs (no counters
+    // moving) read -1. Empty if per-CPU counters are not available.
+    std::vector<float> coreUsagePercent(unsigned windowMs = 1000);
+
+    // Number of per-CPU slots tracked (highest CPU number + 1)
+    size_t coreCount();
+
+    // Effective clock over a window, in MHz across all CPUs and samples
+    struct ClockStats {
+        float minMHz = -1.0f;
+        float avgMHz = -1.0f;
+        float maxMHz = -1.0f;
+        float atMaxPercent = -1.0f;   // share of per-CPU samples within 5 % of that CPU's ceiling
+        size_t samples = 0;           // ring slots summarized
+    };
+
+    // Start recording per-CPU clocks with every reading (takes one right
+    // away). Idempotent; sections that show a clock call it up front.
+    void trackClocks();
+
+    // Clock statistics over (at most) the last windowMs. samples = 0 when
+    // clocks aren't tracked or can't be read.
+    ClockStats clockStats(unsigned windowMs = 2000);
+
+    // Newest per-CPU clock reading and per-CPU ceiling (read once), in MHz,
+    // indexed by CPU number; -1 = unknown. Empty until trackClocks().
+    std::vector<float> coreClockMHz();
+    std::vector<float> coreMaxMHz();
+
+    // Context switches per second over (at most) the last windowMs.
+    // -1 where the counter isn't sampled (Windows) or unreadable.
+    double switchRate(unsigned windowMs = 1000);
+
+    // ---- parsing / math behind the getters (also fed fixtures by the tests) ----
+
+    // Read /proc/stat text into aggregate + per-CPU counters. busy / total hold
+    // maxCores entries; CPUs missing from the text keep their previous value.
+    // Returns highest CPU number + 1 (call with maxCores = 0 just to size).
+    static size_t parseProcStat(const char* text, size_t length, uint64_t& aggregateBusy, uint64_t& aggregateTotal,
+        uint64_t* busy, uint64_t* total, size_t maxCores);
+
+    // min / avg / max / at-max share of mhz[samples * cores] (slot-major, -1 =
+    // no value). ceiling[i] is CPU i's top clock; <= 0 uses the observed maximum.
+    static ClockStats clockSummary(const float* mhz, size_t samples, size_t cores, const float* ceiling);
+
+    // Value of the "ctxt" line of /proc/stat (context switches since boot), 0 if missing
+    static uint64_t parseContextSwitches(const char* text, size_t length);
+
+    // out[i] = 100 * busy delta / total delta, or -1 where total didn't move.
+    // Branch-free over flat arrays so the compiler vectorizes it.
+    static void coreDeltaKernel(const uint64_t* busyNew, const uint64_t* busyOld,
+        const uint64_t* totalNew, const uint64_t* totalOld, float* out, size_t n);
+
+    ~CpuSampler();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Sample {
+        Clock::time_point at;
+        uint64_t busy = 0;      // all non-idle time, in backend units
+        uint64_t total = 0;     // busy + idle
+        uint64_t switches = 0;  // context switches since boot, 0 = not sampled
+    };
+
+    CpuSampler() = default;
+
+    // One reading from the OS counters; per-CPU values go to busy / total when given
+    bool read(Sample& out, uint64_t* busy, uint64_t* total);
+    size_t probeCores();
+    bool readClocks(float* mhz);              // one MHz value per CPU (-1 = unknown)
+    void probeClockSource();                  // picks the backend, fills clockCeiling (no mtx needed)
+    void loop();
+
+    // Ring slots of the newest sample and of the oldest one inside windowMs.
+    // Caller holds mtx; count >= 2.
+    void window(unsigned windowMs, size_t& newest, size_t& oldest) const;
+
+    std::mutex mtx;
+    std::mutex clockProbeMtx;                 // one trackClocks() probes, the others wait for it
+    std::condition_variable wake;             // stop() interrupts the interval wait
+    std::thread worker;
+    bool running = false;
+
+    Sample ring[RingSize];
+    size_t head = 0;                          // next slot to write
+    size_t count = 0;                         // valid samples in ring
+
+    size_t cores = 0;                         // per-CPU slots (0 = not available)
+    std::vector<uint64_t> coreBusy;           // RingSize * cores, slot k at [k * cores]
+    std::vector<uint64_t> coreTotal;
+    std::vector<uint64_t> scratchBusy;        // sampler thread writes here, then copies in
+    std::vector<uint64_t> scratchTotal;
+
+    bool clocksOn = false;
+    std::vector<float> coreClock;             // RingSize * cores MHz, same layout as coreBusy
+    bool clockValid[RingSize] = {};           // slot has a clock reading
+    std::vector<float> scratchClock;
+    std::vector<float> clockCeiling;          // per CPU top clock (read once)
+    std::vector<int> msrFd;                   // Linux: /dev/cpu/N/msr, empty = use cpufreq
+    std::vector<uint64_t> lastAperf;
+    std::vector<uint64_t> lastMperf;
+    float nominalMHz = 0.0f;                  // MPERF rate
+};
@@ -0,0 +1,245 @@
+#include "CpuTopology.h"
+#include "Profiler.h"
+#include "Cpuid.h"
+#include <vector>
+#include <set>
+#include <map>
+#include <thread>
+#include <fstream>
+#include <cstdlib>
+#include <cstddef>
+
+#ifdef _WIN32
+#include <windows.h>
+#include "SystemQuery.h"
+#endif
+
+
+// ---------------- Helpers ----------------
+
+uint64_t CpuTopology::parseSize(const std::string& text) {
+    char* end = nullptr;
+    uint64_t value = std::strtoull(text.c_str(), &end, 10);
+    if (end && (*end == 'K' || *end == 'k')) value *= 1024;
+    else if (end && *end == 'M') value *= 1024 * 1024;
+    else if (end && *end == 'G') value *= 1024ULL * 1024 * 1024;
+    return value;
+}
+
+
+// ---------------- Linux: sysfs ----------------
+
+CpuTopology CpuTopology::fromSysfs(const FileReader& read) {
+    const std::string base = "/sys/devices/system/cpu/";
+    CpuTopology t;
+
+    std::string online = read(base + "online");
+    std::vector<unsigned> cpus;
+    forEachCpu(online, [&](unsigned cpu) { cpus.push_back(cpu); });
+    if (cpus.empty()) return t;
+
+    std::string present = read(base + "present");
+    if (present.empty()) present = read(base + "possible");
+    int presentCount = 0;
+    forEachCpu(present, [&](unsigned) { presentCount++; });
+    t.logical = static_cast<int>(cpus.size());
+    t.offline = presentCount > t.logical ? presentCount - t.logical : 0;
+
+    // Every core / cache instance is read once, from its first online CPU;
+    // the CPUs listed as sharing it are marked so their copies are skipped.
+    size_t slots = cpus.back() + 1;
+    std::vector<bool> coreDone(slots, false);
+    std::map<int, std::vector<bool>> cacheDone;   // index number -> CPUs covered
+    std::set<std::string> packages;
+
+    auto mark = [&](std::vector<bool>& done, const std::string& list, unsigned self) {
+        bool any = false;
+        forEachCpu(list, [&](unsigned cpu) {
+            if (cpu < done.size()) done[cpu] = true;
+            any = true;
+        });
+        if (!any) done[self] = true;
+    };
+
+    for (unsigned cpu : cpus) {
+        const std::string dir = base + "cpu" + std::to_string(cpu) + "/";
+
+        if (!coreDone[cpu]) {
+            std::string siblings = read(dir + "topology/thread_siblings_list");
+            mark(coreDone, siblings, cpu);
+            t.cores++;
+
+            std::string package = read(dir + "topology/physical_package_id");
+            if (!package.empty()) packages.insert(package);
+        }
+
+        for (int index = 0; ; ++index) {
+            std::vector<bool>& done = cacheDone[index];
+            if (done.empty()) done.assign(slots, false);
+            if (done[cpu]) continue;
+
+            const std::string cache = dir + "cache/index" + std::to_string(index) + "/";
+            std::string level = read(cache + "level");
+            if (level.empty()) break;
+
+            int lvl = std::atoi(level.c_str());
+            if (lvl >= 1 && lvl <= 3) t.cacheBytes[lvl] += parseSize(read(cache + "size"));
+            mark(done, read(cache + "shared_cpu_list"), cpu);
+        }
+    }
+    t.sockets = packages.empty() ? 1 : static_cast<int>(packages.size());
+
+    const std::string freq = base + "cpu" + std::to_string(cpus.front()) + "/cpufreq/";
+    std::string khz = read(freq + "base_frequency");
+    if (khz.empty()) khz = read(freq + "cpuinfo_max_freq");
+    t.baseMHz = static_cast<int>(std::strtoull(khz.c_str(), nullptr, 10) / 1000);
+
+    t.source = "sysfs";
+    return t;
+}
+
+
+// ---------------- Windows: GetLogicalProcessorInformationEx ----------------
+
+CpuTopology CpuTopology::fromProcessorInformation(const void* buffer, size_t length) {
+    CpuTopology t;
+#ifdef _WIN32
+    const uint8_t* p = static_cast<const uint8_t*>(buffer);
+    const uint8_t* end = p + length;
+
+    // Records are variable-sized; Size covers the group masks that follow
+    while (end - p >= static_cast<ptrdiff_t>(offsetof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX, Processor))) {
+        auto info = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(p);
+        if (info->Size == 0 || info->Size > static_cast<DWORD>(end - p)) break;
+
+        switch (info->Relationship) {
+        case RelationProcessorPackage:
+            t.sockets++;
+            break;
+        case RelationProcessorCore:
+            t.cores++;
+            for (WORD g = 0; g < info->Processor.GroupCount; ++g) {
+                KAFFINITY mask = info->Processor.GroupMask[g].Mask;
+                for (; mask; mask &= mask - 1) t.logical++;
+            }
+            break;
+        case RelationCache:
+            if (info->Cache.Level >= 1 && info->Cache.Level <= 3) t.cacheBytes[info->Cache.Level] += info->Cache.CacheSize;
+            break;
+        default:
+            break;
+        }
+        p += info->Size;
+    }
+    if (t.logical > 0) t.source = "GetLogicalProcessorInformationEx";
+#else
+    (void)buffer;
+    (void)length;
+#endif
+    return t;
+}
+
+
+// ---------------- CPUID fallback ----------------
+
+CpuTopology CpuTopology::fromCpuid() {
+    CpuTopology t;
+    const Cpuid& id = Cpuid::current();
+    t.logical = static_cast<int>(std::thread::hardware_concurrency());
+    if (id.maxLeaf == 0 || t.logical <= 0) return CpuTopology();
+
+    int threadsPerCore = id.threadsPerCore > 0 ? id.threadsPerCore : 1;
+    t.cores = (t.logical + threadsPerCore - 1) / threadsPerCore;
+    t.sockets = 1;
+
+    // Each descriptor is one instance; count how many the visible threads need
+    for (const Cpuid::Cache& cache : id.caches) {
+        if (cache.level < 1 || cache.level > 3) continue;
+        uint64_t instances = (static_cast<unsigned>(t.logical) + cache.sharing - 1) / cache.sharing;
+        t.cacheBytes[cache.level] += static_cast<uint64_t>(cache.sizeBytes) * (instances > 0 ? instances : 1);
+    }
+
+    t.baseMHz = id.baseMHz;
+    t.source = "cpuid";
+    return t;
+}
+
+
+// ---------------- Shared snapshot ----------------
+
+static CpuTopology probe() {
+    PROFILE_SCOPE("CpuTopology::probe");
+    CpuTopology t;
+
+#ifdef _WIN32
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+    if (GetLastError() == ERROR_INSUFFICIENT_BUFFER) {
+        std::vector<uint8_t> buffer(length);
+        if (GetLogicalProcessorInformationEx(RelationAll,
+            reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &length)) {
+            t = CpuTopology::fromProcessorInformation(buffer.data(), length);
+        }
+    }
+    if (t.logical > 0) {
+        int configured = static_cast<int>(GetMaximumProcessorCount(ALL_PROCESSOR_GROUPS));
+        t.offline = configured > t.logical ? configured - t.logical : 0;
+    }
+#else
+    // One-shot reads: these files are read once, keeping them open buys nothing
+    t = CpuTopology::fromSysfs([](const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        return line;
+    });
+#endif
+
+    if (t.logical == 0) t = CpuTopology::fromCpuid();
+    if (t.baseMHz == 0) t.baseMHz = Cpuid::current().baseMHz;
+
+#ifdef _WIN32
+    // AMD parts have no leaf 0x16; Win32_Processor knows the rated clock
+    if (t.baseMHz == 0) {
+        auto rows = SystemQuery::instance().cachedRows("Win32_Processor", { "MaxClockSpeed" });
+        if (!rows.empty() && rows[0].integer("MaxClockSpeed") > 0) t.baseMHz = static_cast<int>(rows[0].integer("MaxClockSpeed"));
+    }
+#endif
+    return t;
+}
+
+const CpuTopology& CpuTopology::current() {
+    static const CpuTopology topology = probe();
+    return topology;
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: CpuTopology
+OBJECT: CpuTopology::current(), read by CPUInfo (cores, threads, sockets,
+        caches, base speed) and CompactCPU (cores, threads)
+DESCRIPTION: One-pass CPU topology / cache snapshot.
+FUNCTIONS:
+    static const CpuTopology& current()
+        Probe on first call: OS source, then CPUID if it gave nothing.
+
+    static CpuTopology fromSysfs(const FileReader& read)
+        Walks the online CPU list only. Cores: one thread_siblings_list
+        read per core. Caches: one level/size/shared_cpu_list read per
+        cache instance; sharing CPUs are marked and skipped.
+
+    static CpuTopology fromProcessorInformation(const void* buffer, size_t length)
+        Packages, cores (+ popcount of every group mask) and cache
+        instances from a RelationAll buffer.
+
+    static CpuTopology fromCpuid()
+        hardware_concurrency + Cpuid::current() (SMT width, cache
+        descriptors, base MHz). Assumes one socket.
+
+    static uint64_t parseSize(const std::string& text)
+    template forEachCpu(list, fn)
+        Helpers for sysfs values ("48K", "0-3,8-11").
+*/
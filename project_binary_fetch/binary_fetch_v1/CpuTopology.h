@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <functional>
+#include <cstdint>
+
+/*
+ ---------------------------------------------------------
+                    CpuTopology Struct
+ ---------------------------------------------------------
+
+  Sockets, cores, threads, cache totals and base clock,
+  filled in one pass the first time anyone asks and shared
+  by CPUInfo and CompactCPU (which used to run a separate
+  GetLogicalProcessorInformation / WMI query per getter).
+
+    Windows : GetLogicalProcessorInformationEx(RelationAll),
+              all processor groups (> 64 threads)
+    Linux   : /sys/devices/system/cpu/{online,present} and
+              cpuN/topology + cpuN/cache/index* for the online
+              CPUs only
+    Either  : CPUID leaves 0xB / 4 / 0x8000001D / 0x16 when the
+              OS source is missing (containers without /sys)
+
+  Offline CPUs and holes in the CPU numbering (e.g. "0-63,128-191"
+  on a partly populated NUMA box) are skipped, not counted.
+  Values that could not be read stay 0.
+*/
+struct CpuTopology {
+    int sockets = 0;
+    int cores = 0;                 // physical cores
+    int logical = 0;               // online logical processors
+    int offline = 0;               // present (or possible) but not online
+    uint64_t cacheBytes[4] = { 0, 0, 0, 0 };   // [level], every instance summed (L1 = data + instruction)
+    int baseMHz = 0;
+    const char* source = "none";   // "sysfs", "GetLogicalProcessorInformationEx" or "cpuid"
+
+    // The shared snapshot (probed once, thread-safe)
+    static const CpuTopology& current();
+
+    // ---- sources (public so the tests can feed recorded trees) ----
+
+    // path -> file contents ("" if missing), e.g. "/sys/devices/system/cpu/online"
+    using FileReader = std::function<std::string(const std::string&)>;
+
+    // logical == 0 if the tree isn't there
+    static CpuTopology fromSysfs(const FileReader& read);
+
+    // Buffer filled by GetLogicalProcessorInformationEx(RelationAll, ...)
+    static CpuTopology fromProcessorInformation(const void* buffer, size_t length);
+
+    // logical == 0 on non-x86 builds
+    static CpuTopology fromCpuid();
+
+    // "32K", "1024K", "8M" (sysfs cache/index*/size) -> bytes
+    static uint64_t parseSize(const std::string& text);
+
+    // Call fn(cpu) for every CPU in a sysfs list ("0-3,8,10-11"), in order
+    template <typename Fn>
+    static void forEachCpu(const std::string& list, Fn fn) {
+        const char* p = list.c_str();
+        while (*p) {
+            if (*p < '0' || *p > '9') { ++p; continue; }
+            unsigned first = 0;
+            while (*p >= '0' && *p <= '9') first = first * 10 + static_cast<unsigned>(*p++ - '0');
+            unsigned last = first;
+            if (*p == '-') {
+                ++p;
+                last = 0;
+                while (*p >= '0' && *p <= '9') last = last * 10 + static_cast<unsigned>(*p++ - '0');
+            }
+            for (unsigned cpu = first; cpu <= last; ++cpu) fn(cpu);
+        }
+    }
+};
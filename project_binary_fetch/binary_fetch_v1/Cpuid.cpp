@@ -0,0 +1,313 @@
+#include "Cpuid.h"
+#include "Profiler.h"
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CPUID_X86 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+
+// ---------------- Decode tables ----------------
+
+namespace {
+
+    enum Reg : uint8_t { EAX, EBX, ECX, EDX };
+
+    // XCR0 state components an extension needs the OS to save
+    const uint64_t kYmm = 0x6;        // SSE + AVX
+    const uint64_t kZmm = 0xE6;       // + opmask, ZMM_Hi256, Hi16_ZMM
+    const uint64_t kTile = 0x60000;   // TILECFG + TILEDATA
+
+    struct FeatureBit {
+        const char* name;     // as printed on the features line ("" = not printed)
+        uint32_t leaf;
+        uint32_t subleaf;
+        Reg reg;
+        uint8_t bit;
+        uint64_t xcr0;        // required OS state, 0 = none
+    };
+
+    constexpr FeatureBit kFeatureBits[] = {
+        { "SSE2",         0x1,        0, EDX, 26, 0 },
+        { "SSE3",         0x1,        0, ECX, 0,  0 },
+        { "SSSE3",        0x1,        0, ECX, 9,  0 },
+        { "SSE4.1",       0x1,        0, ECX, 19, 0 },
+        { "SSE4.2",       0x1,        0, ECX, 20, 0 },
+        { "POPCNT",       0x1,        0, ECX, 23, 0 },
+        { "AES",          0x1,        0, ECX, 25, 0 },
+        { "PCLMUL",       0x1,        0, ECX, 1,  0 },
+        { "SHA",          0x7,        0, EBX, 29, 0 },
+        { "AVX",          0x1,        0, ECX, 28, kYmm },
+        { "F16C",         0x1,        0, ECX, 29, kYmm },
+        { "FMA",          0x1,        0, ECX, 12, kYmm },
+        { "AVX2",         0x7,        0, EBX, 5,  kYmm },
+        { "BMI1",         0x7,        0, EBX, 3,  0 },
+        { "BMI2",         0x7,        0, EBX, 8,  0 },
+        { "AVX-VNNI",     0x7,        1, EAX, 4,  kYmm },
+        { "AVX-512F",     0x7,        0, EBX, 16, kZmm },
+        { "AVX-512DQ",    0x7,        0, EBX, 17, kZmm },
+        { "AVX-512BW",    0x7,        0, EBX, 30, kZmm },
+        { "AVX-512VL",    0x7,        0, EBX, 31, kZmm },
+        { "AVX-512VNNI",  0x7,        0, ECX, 11, kZmm },
+        { "AVX-512BF16",  0x7,        1, EAX, 5,  kZmm },
+        { "AVX-512FP16",  0x7,        0, EDX, 23, kZmm },
+        { "AMX-TILE",     0x7,        0, EDX, 24, kTile },
+        { "AMX-INT8",     0x7,        0, EDX, 25, kTile },
+        { "AMX-BF16",     0x7,        0, EDX, 22, kTile },
+        { "",             0x1,        0, ECX, 5,  0 },       // VMX
+        { "",             0x80000001, 0, ECX, 2,  0 },       // SVM
+        { "",             0x1,        0, ECX, 31, 0 },       // hypervisor present
+        { "",             0x7,        0, EDX, 15, 0 },       // hybrid
+    };
+    static_assert(sizeof(kFeatureBits) / sizeof(kFeatureBits[0]) == Cpuid::FeatureCount,
+        "kFeatureBits must have one row per Cpuid::Feature");
+
+    struct HypervisorName {
+        const char* signature;    // leaf 0x40000000 EBX ECX EDX, trimmed like text()
+        const char* name;
+    };
+
+    constexpr HypervisorName kHypervisors[] = {
+        { "Microsoft Hv", "Hyper-V" },
+        { "KVMKVMKVM",    "KVM" },
+        { "VMwareVMware", "VMware" },
+        { "VBoxVBoxVBox", "VirtualBox" },
+        { "XenVMMXenVMM", "Xen" },
+        { "TCGTCGTCGTCG", "QEMU" },
+        { "lrpepyh  vr",  "Parallels" },
+        { "ACRNACRNACRN", "ACRN" },
+        { "bhyve bhyve",  "bhyve" },
+        { "QNXQVMBSQG",   "QNX" },
+        { "Apple VZ",     "Apple Virtualization" },
+    };
+
+    constexpr const char* kCacheTypes[] = { "", "Data", "Instruction", "Unified" };
+
+    uint32_t pick(const Cpuid::Regs& r, Reg reg) {
+        return reg == EAX ? r.eax : reg == EBX ? r.ebx : reg == ECX ? r.ecx : r.edx;
+    }
+
+    std::string text(const uint32_t* words, size_t count) {
+        std::string s(reinterpret_cast<const char*>(words), count * 4);
+        s.erase(std::find(s.begin(), s.end(), '\0'), s.end());
+        size_t first = s.find_first_not_of(' ');
+        if (first == std::string::npos) return "";
+        return s.substr(first, s.find_last_not_of(' ') - first + 1);
+    }
+
+} // namespace
+
+
+// ---------------- Raw access ----------------
+
+bool Cpuid::supported() {
+#ifdef CPUID_X86
+    return true;
+#else
+    return false;
+#endif
+}
+
+Cpuid::Regs Cpuid::query(uint32_t leaf, uint32_t subleaf) {
+    Regs r;
+#ifdef CPUID_X86
+#ifdef _MSC_VER
+    int v[4];
+    __cpuidex(v, static_cast<int>(leaf), static_cast<int>(subleaf));
+    r.eax = static_cast<uint32_t>(v[0]);
+    r.ebx = static_cast<uint32_t>(v[1]);
+    r.ecx = static_cast<uint32_t>(v[2]);
+    r.edx = static_cast<uint32_t>(v[3]);
+#else
+    __cpuid_count(leaf, subleaf, r.eax, r.ebx, r.ecx, r.edx);
+#endif
+#else
+    (void)leaf;
+    (void)subleaf;
+#endif
+    return r;
+}
+
+// XGETBV(0) if the OS enabled it (CPUID.1:ECX.OSXSAVE), else 0
+static uint64_t readXcr0() {
+#ifdef CPUID_X86
+    if (!((Cpuid::query(1).ecx >> 27) & 1)) return 0;
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    uint32_t lo = 0, hi = 0;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+#else
+    return 0;
+#endif
+}
+
+const char* Cpuid::coreType() {
+    if (!current().has(HYBRID) || current().maxLeaf < 0x1A) return "";
+    switch (query(0x1A).eax >> 24) {
+    case 0x40: return "Performance";
+    case 0x20: return "Efficient";
+    default:   return "";
+    }
+}
+
+
+// ---------------- Decoder ----------------
+
+Cpuid Cpuid::decode(const LeafSource& leaf, uint64_t xcr0) {
+    Cpuid c;
+    Regs r = leaf(0, 0);
+    c.maxLeaf = r.eax;
+    if (c.maxLeaf == 0) return c;
+
+    const uint32_t vendorWords[3] = { r.ebx, r.edx, r.ecx };
+    c.vendor = text(vendorWords, 3);
+    c.maxExtended = leaf(0x80000000, 0).eax;
+
+    Regs l1 = leaf(1, 0);
+    int baseFamily = (l1.eax >> 8) & 0xF;
+    c.family = baseFamily == 0xF ? baseFamily + static_cast<int>((l1.eax >> 20) & 0xFF) : baseFamily;
+    c.model = static_cast<int>((l1.eax >> 4) & 0xF);
+    if (baseFamily == 0x6 || baseFamily == 0xF) c.model |= static_cast<int>((l1.eax >> 12) & 0xF0);
+    c.stepping = static_cast<int>(l1.eax & 0xF);
+
+    // Feature bits, straight off the table
+    for (unsigned f = 0; f < FeatureCount; ++f) {
+        const FeatureBit& b = kFeatureBits[f];
+        uint32_t top = b.leaf >= 0x80000000 ? c.maxExtended : c.maxLeaf;
+        if (b.leaf > top) continue;
+        if (((pick(leaf(b.leaf, b.subleaf), b.reg) >> b.bit) & 1) && (xcr0 & b.xcr0) == b.xcr0) c.features |= 1ULL << f;
+    }
+
+    if (c.has(HYPERVISOR)) {
+        Regs h = leaf(0x40000000, 0);
+        const uint32_t words[3] = { h.ebx, h.ecx, h.edx };
+        std::string signature = text(words, 3);
+        c.hypervisor = signature.empty() ? "Unknown" : signature;
+        for (const auto& known : kHypervisors) {
+            if (signature == known.signature) {
+                c.hypervisor = known.name;
+                break;
+            }
+        }
+    }
+
+    if (c.maxExtended >= 0x80000004) {
+        uint32_t words[12];
+        for (uint32_t i = 0; i < 3; ++i) {
+            Regs b = leaf(0x80000002 + i, 0);
+            words[i * 4] = b.eax;
+            words[i * 4 + 1] = b.ebx;
+            words[i * 4 + 2] = b.ecx;
+            words[i * 4 + 3] = b.edx;
+        }
+        c.brand = text(words, 12);
+    }
+
+    // Topology: 0x1F (newer Intel) supersedes 0xB; ECX[15:8] = level type, EBX[15:0] = threads up to that level
+    uint32_t topologyLeaf = c.maxLeaf >= 0x1F && leaf(0x1F, 0).ebx ? 0x1F : (c.maxLeaf >= 0xB ? 0xB : 0);
+    for (uint32_t sub = 0; topologyLeaf && sub < 8; ++sub) {
+        Regs t = leaf(topologyLeaf, sub);
+        uint32_t type = (t.ecx >> 8) & 0xFF;
+        if (type == 0) break;
+        if (type == 1) c.threadsPerCore = static_cast<int>(t.ebx & 0xFFFF);
+        c.threadsPerPackage = static_cast<int>(t.ebx & 0xFFFF);
+    }
+    if (c.threadsPerPackage == 0 && ((l1.edx >> 28) & 1)) c.threadsPerPackage = static_cast<int>((l1.ebx >> 16) & 0xFF);
+
+    // Deterministic cache parameters, same layout in both leaves
+    uint32_t cacheLeaf = c.maxExtended >= 0x8000001D && c.vendor != "GenuineIntel" ? 0x8000001D : (c.maxLeaf >= 4 ? 4u : 0u);
+    for (uint32_t sub = 0; cacheLeaf && sub < 16; ++sub) {
+        Regs d = leaf(cacheLeaf, sub);
+        uint32_t type = d.eax & 0x1F;
+        if (type == 0) break;
+
+        Cache cache;
+        cache.level = static_cast<int>((d.eax >> 5) & 0x7);
+        cache.type = type < 4 ? kCacheTypes[type] : "Unknown";
+        cache.sizeBytes = ((d.ebx >> 22) + 1) * (((d.ebx >> 12) & 0x3FF) + 1) * ((d.ebx & 0xFFF) + 1) * (d.ecx + 1);
+        cache.sharing = ((d.eax >> 14) & 0xFFF) + 1;
+        c.caches.push_back(cache);
+    }
+
+    // Older AMD: L2 per core in 0x80000006 ECX[31:16] KB, L3 in EDX[31:18] * 512 KB
+    if (c.caches.empty() && c.maxExtended >= 0x80000006) {
+        Regs e = leaf(0x80000006, 0);
+        if (e.ecx >> 16) {
+            Cache l2;
+            l2.level = 2;
+            l2.type = "Unified";
+            l2.sizeBytes = (e.ecx >> 16) * 1024;
+            l2.sharing = c.threadsPerCore > 0 ? c.threadsPerCore : 1;
+            c.caches.push_back(l2);
+        }
+        if (e.edx >> 18) {
+            Cache l3;
+            l3.level = 3;
+            l3.type = "Unified";
+            l3.sizeBytes = (e.edx >> 18) * 512 * 1024;
+            l3.sharing = c.threadsPerPackage > 0 ? c.threadsPerPackage : 1;
+            c.caches.push_back(l3);
+        }
+    }
+
+    if (c.maxLeaf >= 0x16) c.baseMHz = static_cast<int>(leaf(0x16, 0).eax & 0xFFFF);
+    return c;
+}
+
+const Cpuid& Cpuid::current() {
+    static const Cpuid info = [] {
+        PROFILE_SCOPE("Cpuid::decode");
+        if (!supported()) return Cpuid();
+        return decode([](uint32_t leaf, uint32_t subleaf) { return query(leaf, subleaf); }, readXcr0());
+    }();
+    return info;
+}
+
+std::string Cpuid::featureLine() const {
+    std::string line;
+    for (unsigned f = 0; f < FeatureCount; ++f) {
+        if (!has(static_cast<Feature>(f)) || !kFeatureBits[f].name[0]) continue;
+        if (!line.empty()) line += ' ';
+        line += kFeatureBits[f].name;
+    }
+    return line;
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: Cpuid
+OBJECT: Cpuid::current(), read by CPUInfo (brand, virtualization, features),
+        CompactCPU (name) and CpuTopology (CPUID fallback)
+DESCRIPTION: CPUID leaves decoded once through constexpr bit tables.
+FUNCTIONS:
+    static const Cpuid& current()
+        decode() over the real instruction + XGETBV, once per run.
+
+    static Cpuid decode(const LeafSource& leaf, uint64_t xcr0)
+        Vendor / family / model, kFeatureBits (a flag only counts when
+        its XCR0 state is enabled), hypervisor via kHypervisors, brand,
+        0x1F / 0xB topology, 0x4 / 0x8000001D caches (0x80000006 on old
+        AMD), 0x16 base clock.
+
+    static const char* coreType()
+        Leaf 0x1A on hybrid parts: "Performance" / "Efficient".
+
+    std::string featureLine() const
+        Names of the supported SIMD / crypto rows of kFeatureBits.
+
+ADDING A FEATURE:
+    Add the enum value in Cpuid.h and the row at the same position in
+    kFeatureBits (the static_assert catches a mismatch).
+*/
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+/*
+ ---------------------------------------------------------
+                      Cpuid Class
+ ---------------------------------------------------------
+
+  Everything BinaryFetch reads from the CPUID instruction,
+  decoded once per run (no syscalls, no WMI):
+
+    0x0 / 0x80000000   vendor, highest leaves
+    0x1                family / model, feature flags, hypervisor bit
+    0x4 / 0x8000001D   cache descriptors (Intel / AMD)
+    0x7                AVX2 / AVX-512 / AMX / SHA, hybrid flag
+    0xB / 0x1F         threads per core, threads per package
+    0x16               base clock (Intel)
+    0x1A               core type of the calling thread (hybrid parts)
+    0x40000000         hypervisor vendor
+    0x80000002-4       brand string
+    0x80000006         L2 / L3 size (older AMD without 0x8000001D)
+
+  Which bit means what lives in constexpr tables in Cpuid.cpp;
+  decode() walks them over any leaf source, so the tests can run
+  the decoder on leaves recorded from other machines.
+
+  Non-x86 builds get an empty result (supported() == false).
+*/
+class Cpuid {
+public:
+    struct Regs {
+        uint32_t eax = 0, ebx = 0, ecx = 0, edx = 0;
+    };
+
+    // Order matches kFeatureBits in Cpuid.cpp
+    enum Feature : unsigned {
+        SSE2, SSE3, SSSE3, SSE41, SSE42, POPCNT, AES, PCLMUL, SHA,
+        AVX, F16C, FMA, AVX2, BMI1, BMI2, AVX_VNNI,
+        AVX512F, AVX512DQ, AVX512BW, AVX512VL, AVX512_VNNI, AVX512_BF16, AVX512_FP16,
+        AMX_TILE, AMX_INT8, AMX_BF16,
+        VMX, SVM, HYPERVISOR, HYBRID,
+        FeatureCount
+    };
+
+    struct Cache {
+        int level = 0;
+        const char* type = "";       // "Data", "Instruction", "Unified"
+        uint32_t sizeBytes = 0;      // one instance
+        unsigned sharing = 1;        // logical processors sharing one instance
+    };
+
+    // Decoded leaves of this CPU (first call runs CPUID, thread-safe)
+    static const Cpuid& current();
+
+    static bool supported();                                    // x86 / x64 build
+    static Regs query(uint32_t leaf, uint32_t subleaf = 0);     // raw CPUID (zeros if !supported)
+
+    // Decode from any leaf source. xcr0 = enabled register state (XGETBV 0);
+    // AVX / AVX-512 / AMX only count when the OS saves their registers.
+    using LeafSource = std::function<Regs(uint32_t leaf, uint32_t subleaf)>;
+    static Cpuid decode(const LeafSource& leaf, uint64_t xcr0);
+
+    // "Performance", "Efficient" or "" - core type of the calling thread
+    static const char* coreType();
+
+    bool has(Feature f) const { return (features >> f) & 1; }
+
+    // Supported SIMD / crypto extensions, e.g. "SSE4.2 AVX AVX2 FMA AVX-512F ..."
+    std::string featureLine() const;
+
+    std::string vendor;              // "GenuineIntel", "AuthenticAMD", ...
+    std::string brand;               // trimmed brand string
+    std::string hypervisor;          // "Hyper-V", "KVM", ... ("" on bare metal)
+    uint32_t maxLeaf = 0;
+    uint32_t maxExtended = 0;
+    int family = 0, model = 0, stepping = 0;
+    int threadsPerCore = 0;          // 0 = unknown
+    int threadsPerPackage = 0;
+    int baseMHz = 0;
+    std::vector<Cache> caches;
+    uint64_t features = 0;           // bit per Feature
+};
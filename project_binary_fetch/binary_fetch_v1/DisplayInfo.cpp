@@ -1,4 +1,5 @@
 #include "DisplayInfo.h"
+#include "Profiler.h"
 
 #include <windows.h>
 #include <dxgi1_6.h>
@@ -137,6 +138,7 @@ DisplayInfo::EDIDInfo DisplayInfo::parseEDID(const unsigned char* edid, size_t s
 }
 
 std::string DisplayInfo::getFriendlyNameFromEDID(const std::wstring& deviceName) {
+    PROFILE_SCOPE("DisplayInfo::getFriendlyNameFromEDID");
     // Preserve CompactScreen registry scanning logic to obtain friendly name
     std::wstring monitorHardwareId;
     DISPLAY_DEVICEW ddMon{};
@@ -258,10 +260,12 @@ std::string DisplayInfo::getFriendlyNameFromEDID(const std::wstring& deviceName)
 // ----------------- Core DXGI population (kept intact, extended) -----------------
 
 DisplayInfo::DisplayInfo() {
+    PROFILE_SCOPE("DisplayInfo::DisplayInfo");
     refresh();
 }
 
 bool DisplayInfo::refresh() {
+    PROFILE_SCOPE("DisplayInfo::refresh");
     screens.clear();
     if (!populateFromDXGI()) return false;
     enrichWithNVAPI();
@@ -270,10 +274,12 @@ bool DisplayInfo::refresh() {
 }
 
 const std::vector<DisplayInfo::ScreenInfo>& DisplayInfo::getScreens() const {
+    PROFILE_SCOPE("DisplayInfo::getScreens");
     return screens;
 }
 
 bool DisplayInfo::populateFromDXGI() {
+    PROFILE_SCOPE("DisplayInfo::populateFromDXGI");
     IDXGIFactory1* factory = nullptr;
     if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&factory)))) return false;
 
@@ -519,6 +525,7 @@ bool DisplayInfo::populateFromDXGI() {
 }
 
 bool DisplayInfo::enrichWithNVAPI() {
+    PROFILE_SCOPE("DisplayInfo::enrichWithNVAPI");
 #ifdef USE_NVAPI
     // NVAPI integration can be added here for more accurate DSR detection
     // (left intentionally empty to preserve build when NVAPI isn't used)
@@ -527,6 +534,7 @@ bool DisplayInfo::enrichWithNVAPI() {
 }
 
 bool DisplayInfo::enrichWithADL() {
+    PROFILE_SCOPE("DisplayInfo::enrichWithADL");
 #ifdef USE_ADL
     // ADL integration can be added here for more accurate VSR detection
     // (left intentionally empty to preserve build when ADL isn't used)
@@ -35,6 +35,16 @@ public:
     bool refresh();
     const std::vector<ScreenInfo>& getScreens() const;
 
+    struct EDIDInfo {
+        std::string friendlyName;
+        int nativeWidth;
+        int nativeHeight;
+        bool valid;
+    };
+
+    // Pure parser for a raw EDID block (also used by BinaryFetchBench)
+    static EDIDInfo parseEDID(const unsigned char* edid, size_t size);
+
 private:
     std::vector<ScreenInfo> screens;
 
@@ -52,13 +62,5 @@ private:
     bool isNvidiaPresent();
     bool isAMDPresent();
 
-    struct EDIDInfo {
-        std::string friendlyName;
-        int nativeWidth;
-        int nativeHeight;
-        bool valid;
-    };
-
-    static EDIDInfo parseEDID(const unsigned char* edid, size_t size);
     std::string getFriendlyNameFromEDID(const std::wstring& deviceName);
 };
@@ -1,4 +1,5 @@
 #include "ExtraInfo.h"
+#include "Profiler.h"
 #include <windows.h>
 #include <mmdeviceapi.h>
 #include <functiondiscoverykeys_devpkey.h>
@@ -12,6 +13,7 @@ using namespace std;
  */
 vector<AudioDevice> ExtraInfo::get_output_devices()
 {
+    PROFILE_SCOPE("ExtraInfo::get_output_devices");
     vector<AudioDevice> devices;
     HRESULT hr;
 
@@ -113,6 +115,7 @@ vector<AudioDevice> ExtraInfo::get_output_devices()
  */
 vector<AudioDevice> ExtraInfo::get_input_devices()
 {
+    PROFILE_SCOPE("ExtraInfo::get_input_devices");
     vector<AudioDevice> devices;
     HRESULT hr;
 
@@ -214,6 +217,7 @@ vector<AudioDevice> ExtraInfo::get_input_devices()
  */
 PowerStatus ExtraInfo::get_power_status()
 {
+    PROFILE_SCOPE("ExtraInfo::get_power_status");
     PowerStatus status;
     SYSTEM_POWER_STATUS sps;
 
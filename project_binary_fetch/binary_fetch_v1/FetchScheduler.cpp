@@ -0,0 +1,260 @@
+#include "FetchScheduler.h"
+#include "AsciiArt.h"
+#include "Profiler.h"
+#include <thread>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <objbase.h>
+#endif
+
+// ---------------- SectionPrinter ----------------
+
+void SectionPrinter::push(const std::string& infoLine) {
+    owner.appendLine(slot, infoLine);
+}
+
+void SectionPrinter::pushBlank() {
+    owner.appendLine(slot, "");
+}
+
+// ---------------- FetchScheduler ----------------
+
+FetchScheduler::FetchScheduler(unsigned workerCount)
+    : requestedWorkers(workerCount), nextSlot(0) {}
+
+void FetchScheduler::add(const std::string& name, Task task) {
+    add(name, 0, std::move(task));
+}
+
+void FetchScheduler::add(const std::string& name, unsigned deadlineMs, Task task) {
+    Slot s;
+    s.name = name;
+    s.task = std::move(task);
+    s.deadlineMs = deadlineMs;
+    slots.push_back(std::move(s));
+}
+
+void FetchScheduler::appendLine(size_t slot, const std::string& line) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        slots[slot].lines.push_back(line);
+    }
+    progress.notify_all();
+}
+
+// Most sections spend their time waiting on WMI/PDH/network rather than
+// burning CPU, so the pool is allowed to be wider than the core count.
+unsigned FetchScheduler::poolSize() const {
+    if (requestedWorkers > 0) return requestedWorkers;
+
+    unsigned hw = std::thread::hardware_concurrency();
+    unsigned wanted = (std::max)(4u, hw);
+    return static_cast<unsigned>((std::min<size_t>)(wanted, slots.size()));
+}
+
+void FetchScheduler::workerLoop() {
+#ifdef _WIN32
+    // The collectors use WMI, DXGI and MMDevice, which all need COM on the calling thread
+    HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif
+
+    for (;;) {
+        // Slots are handed out in config order, so the first lines start first
+        size_t i = nextSlot.fetch_add(1);
+        if (i >= slots.size()) break;
+        if (dynamicPass && !slots[i].dynamic) continue;   // keeps its lines from last time
+
+        SectionPrinter out(*this, i);
+        try {
+            ProfileScope span(slots[i].name, "section");
+            slots[i].task(out);
+        }
+        catch (...) {
+            // a failing section must not take the rest of the fetch down
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            slots[i].done = true;
+        }
+        progress.notify_all();
+    }
+
+#ifdef _WIN32
+    if (SUCCEEDED(hr)) CoUninitialize();
+#endif
+}
+
+// Stand-in row for a section that missed its deadline (dim, so it reads as temporary)
+static std::string placeholderLine(const std::string& name) {
+    return "\x1b[90m~ " + name + ": still loading...\x1b[0m";
+}
+
+// Called with the lock held. Every late section that has finished gets its
+// remaining lines written over its placeholder row.
+void FetchScheduler::patchLate(LivePrinter& lp, std::vector<LateSlot>& late, std::unique_lock<std::mutex>& lock) {
+    for (auto it = late.begin(); it != late.end();) {
+        const Slot& s = slots[it->slot];
+        if (!s.done) { ++it; continue; }
+
+        std::vector<std::string> rest(s.lines.begin() + it->printed, s.lines.end());
+        int row = it->row;
+        it = late.erase(it);
+
+        lock.unlock();
+        int before = lp.currentRow();
+        if (lp.patch(row, rest)) {
+            // rows under the patch moved down; keep later placeholders pointing at themselves
+            int shift = lp.currentRow() - before;
+            for (auto& other : late) {
+                if (other.row > row) other.row += shift;
+            }
+        }
+        lock.lock();
+    }
+}
+
+void FetchScheduler::markDynamic(const std::vector<std::string>& names) {
+    for (auto& s : slots) {
+        if (std::find(names.begin(), names.end(), s.name) != names.end()) s.dynamic = true;
+    }
+}
+
+// Clear results of a previous run so the same tasks can run again
+void FetchScheduler::resetSlots(bool dynamicOnly) {
+    for (auto& s : slots) {
+        if (dynamicOnly && !s.dynamic) continue;
+        s.lines.clear();
+        s.done = false;
+    }
+    dynamicPass = dynamicOnly;
+    nextSlot = 0;
+}
+
+std::vector<std::string> FetchScheduler::collect(bool dynamicOnly) {
+    resetSlots(dynamicOnly);
+
+    std::vector<std::thread> workers;
+    unsigned n = poolSize();
+    for (unsigned w = 0; w < n; ++w) {
+        workers.emplace_back(&FetchScheduler::workerLoop, this);
+    }
+    for (auto& t : workers) t.join();
+
+    return lines();
+}
+
+std::vector<std::string> FetchScheduler::lines() const {
+    std::vector<std::string> all;
+    for (const auto& s : slots) {
+        all.insert(all.end(), s.lines.begin(), s.lines.end());
+    }
+    return all;
+}
+
+void FetchScheduler::run(LivePrinter& lp) {
+    if (slots.empty()) return;
+    resetSlots(false);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<LateSlot> late;
+    auto lateFinished = [&] {
+        return std::any_of(late.begin(), late.end(), [&](const LateSlot& l) { return slots[l.slot].done; });
+    };
+
+    std::vector<std::thread> workers;
+    unsigned n = poolSize();
+    for (unsigned w = 0; w < n; ++w) {
+        workers.emplace_back(&FetchScheduler::workerLoop, this);
+    }
+
+    // Reorder buffer: only the current slot may print. Its lines are flushed
+    // as they arrive; later slots keep collecting until their turn comes.
+    for (size_t i = 0; i < slots.size(); ++i) {
+        size_t printed = 0;
+        bool finished = false;
+        const bool hasDeadline = slots[i].deadlineMs > 0;
+        const auto deadline = start + std::chrono::milliseconds(slots[i].deadlineMs);
+
+        while (!finished) {
+            std::vector<std::string> batch;
+            bool expired = false;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                auto ready = [&] { return slots[i].lines.size() > printed || slots[i].done || lateFinished(); };
+                if (hasDeadline) expired = !progress.wait_until(lock, deadline, ready);
+                else progress.wait(lock, ready);
+
+                patchLate(lp, late, lock);
+
+                batch.assign(slots[i].lines.begin() + printed, slots[i].lines.end());
+                printed = slots[i].lines.size();
+                finished = slots[i].done;
+            }
+
+            // print outside the lock so workers never wait on the console
+            for (const auto& line : batch) lp.push(line);
+
+            if (expired && !finished) {
+                late.push_back({ i, printed, lp.currentRow() });
+                lp.push(placeholderLine(slots[i].name));
+                break;
+            }
+        }
+    }
+
+    // Last chance for late sections, then leave the rest behind
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        patchLate(lp, late, lock);
+        stragglers = late.size();
+    }
+
+    for (auto& t : workers) {
+        if (stragglers == 0) t.join();
+        else t.detach();   // a stuck WinHTTP/disk call must not hold up the exit
+    }
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: FetchScheduler
+OBJECT: sched (main.cpp)
+DESCRIPTION: Runs the JSON-enabled sections concurrently and prints them in config order.
+FUNCTIONS:
+    void add(const std::string& name, Task task)
+        Register a section. Task receives a SectionPrinter and pushes
+        its lines exactly like it would into LivePrinter.
+
+    void add(const std::string& name, unsigned deadlineMs, Task task)
+        Same, but the section gets deadlineMs from the start of run().
+        Missed -> one placeholder row, patched in place if the section
+        finishes before run() returns.
+
+    void run(LivePrinter& lp)
+        Start the worker pool and stream finished lines into LivePrinter.
+        A line is printed once it and every line before it are ready.
+
+    bool abandoned() const
+        run() left late sections running. Exit with std::quick_exit.
+
+    std::vector<std::string> collect(bool dynamicOnly = false)
+        Run everything, return the lines instead of printing them
+        (agent mode re-runs this on every sampling tick).
+        dynamicOnly: only sections passed to markDynamic() run again (--watch).
+
+    void markDynamic(const std::vector<std::string>& names)
+        Sections whose values change between frames.
+
+CLASS: SectionPrinter
+DESCRIPTION: Per-section stand-in for LivePrinter (push / pushBlank).
+
+NOTES:
+    - Sections share collector objects, so collector methods called from
+      more than one section must not keep unsynchronised static state.
+    - Each worker initializes COM (MTA) for itself on Windows.
+*/
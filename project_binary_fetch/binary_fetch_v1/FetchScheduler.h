@@ -0,0 +1,133 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+class LivePrinter;
+class FetchScheduler;
+
+/*
+ ---------------------------------------------------------
+                   SectionPrinter Class
+ ---------------------------------------------------------
+
+  Every section task gets one of these instead of the real
+  LivePrinter. It has the same push()/pushBlank() calls, so
+  section code in main.cpp reads exactly like before, but the
+  lines land in that section's slot of the reorder buffer.
+*/
+class SectionPrinter {
+public:
+    void push(const std::string& infoLine);
+    void pushBlank();
+
+private:
+    friend class FetchScheduler;
+    SectionPrinter(FetchScheduler& ownerRef, size_t slotIndex) : owner(ownerRef), slot(slotIndex) {}
+
+    FetchScheduler& owner;   // scheduler that owns the reorder buffer
+    size_t slot;             // which section this printer writes into
+};
+
+
+
+/*
+ ---------------------------------------------------------
+                   FetchScheduler Class
+ ---------------------------------------------------------
+
+  Runs every enabled section on a small worker pool, so slow
+  probes (WMI, PDH, WinHTTP, disk benchmarks) overlap instead
+  of adding up one after another.
+
+  Sections are registered in config order with add(). run()
+  starts the workers and then drains a reorder buffer in front
+  of LivePrinter::push: a line is printed as soon as it and
+  every line before it are ready. The final output is exactly
+  what the old sequential main() printed.
+
+  Deadlines: a section may be given a budget in ms (config key
+  "deadline_ms", counted from the start of run()). If it is
+  not done by then, its missing lines are replaced by a single
+  placeholder row and printing moves on. When the section
+  finishes while run() is still printing, the placeholder is
+  patched in place. Sections still running when run() is done
+  are abandoned (see abandoned()).
+*/
+class FetchScheduler {
+public:
+    using Task = std::function<void(SectionPrinter&)>;
+
+    // workerCount = 0 -> pick a pool size from the section count
+    explicit FetchScheduler(unsigned workerCount = 0);
+
+    // Register a section (call in the order it should be printed)
+    void add(const std::string& name, Task task);
+
+    // Same, with a deadline in ms (0 = wait as long as it takes)
+    void add(const std::string& name, unsigned deadlineMs, Task task);
+
+    // Start all sections and stream their lines into LivePrinter.
+    // Returns once every section has been printed or has missed
+    // its deadline.
+    void run(LivePrinter& lp);
+
+    // True if run() left sections behind that are still running.
+    // Their worker threads still use the collectors, so the caller
+    // must leave through std::quick_exit instead of returning.
+    bool abandoned() const { return stragglers > 0; }
+
+    // Run every section to completion and return all lines in print
+    // order without printing anything (used by --agent). Deadlines
+    // are ignored. Can be called repeatedly.
+    // dynamicOnly = re-run just the sections marked dynamic and reuse
+    // the last lines of the others (used by --watch).
+    std::vector<std::string> collect(bool dynamicOnly = false);
+
+    // Lines of the last run()/collect(), in print order
+    std::vector<std::string> lines() const;
+
+    // Flag sections whose output changes from second to second
+    // (usage, clocks, uptime, time). Unknown names are ignored.
+    void markDynamic(const std::vector<std::string>& names);
+
+private:
+    friend class SectionPrinter;
+
+    struct Slot {
+        std::string name;                 // config key, e.g. "compact_cpu"
+        Task task;                        // the section body from main.cpp
+        std::vector<std::string> lines;   // lines produced so far
+        bool done = false;                // task has returned
+        unsigned deadlineMs = 0;          // 0 = no deadline
+        bool dynamic = false;             // re-run by collect(true)
+    };
+
+    // A section that missed its deadline and still owes lines
+    struct LateSlot {
+        size_t slot;                      // index into slots
+        size_t printed;                   // lines already printed before the placeholder
+        int row;                          // LivePrinter row of the placeholder
+    };
+
+    void patchLate(LivePrinter& lp, std::vector<LateSlot>& late, std::unique_lock<std::mutex>& lock);
+
+    void appendLine(size_t slot, const std::string& line);
+    void workerLoop();
+    unsigned poolSize() const;
+    void resetSlots(bool dynamicOnly);
+
+    std::vector<Slot> slots;
+    unsigned requestedWorkers;
+    std::atomic<size_t> nextSlot;
+    size_t stragglers = 0;                // late sections still running when run() returned
+    bool dynamicPass = false;             // workers skip slots that aren't dynamic
+
+    std::mutex mtx;                       // guards lines/done of every slot
+    std::condition_variable progress;     // signalled on every new line / finished slot
+};
@@ -0,0 +1,386 @@
+#include "GpuSnapshot.h"
+#include "Profiler.h"
+#include "SystemQuery.h"
+#include <windows.h>
+#include <dxgi.h>
+#include <pdh.h>
+#include <pdhmsg.h>
+#include <algorithm>
+#include <sstream>
+#include <thread>
+#include <chrono>
+#include <map>
+#include <cwctype>
+#include <cwchar>
+#include "nvapi.h"
+
+#pragma comment(lib, "dxgi.lib")
+#pragma comment(lib, "pdh.lib")
+#pragma comment(lib, "nvapi64.lib")
+
+// ---------------- Helpers ----------------
+
+static std::string wideToUtf8(const wchar_t* w) {
+    int size = WideCharToMultiByte(CP_UTF8, 0, w, -1, nullptr, 0, nullptr, nullptr);
+    if (size <= 1) return "";
+    std::string out(size - 1, '\0');
+    WideCharToMultiByte(CP_UTF8, 0, w, -1, &out[0], size, nullptr, nullptr);
+    return out;
+}
+
+static bool nvapiAvailable() {
+    HMODULE nv = LoadLibraryA("nvapi64.dll");
+    if (!nv) return false;
+    FreeLibrary(nv);
+    return true;
+}
+
+static std::string vendorName(unsigned vendorId) {
+    switch (vendorId) {
+    case 0x10DE: return "NVIDIA";
+    case 0x1002:
+    case 0x1022: return "AMD";
+    case 0x8086: return "Intel";
+    default:     return "Unknown";
+    }
+}
+
+// Rough boost clocks for cards NVAPI can't read (better than nothing on a summary line)
+static float estimateClockMHz(const std::wstring& gpuName) {
+    std::wstring name = gpuName;
+    std::transform(name.begin(), name.end(), name.begin(), ::towlower);
+
+    // AMD
+    if (name.find(L"rx 7900") != std::wstring::npos) return 2500.0f;
+    if (name.find(L"rx 7800") != std::wstring::npos) return 2400.0f;
+    if (name.find(L"rx 7700") != std::wstring::npos) return 2300.0f;
+    if (name.find(L"rx 6900") != std::wstring::npos) return 2250.0f;
+    if (name.find(L"rx 6800") != std::wstring::npos) return 2100.0f;
+    if (name.find(L"rx 6700") != std::wstring::npos) return 2400.0f;
+
+    // Intel Arc
+    if (name.find(L"arc a770") != std::wstring::npos) return 2400.0f;
+    if (name.find(L"arc a750") != std::wstring::npos) return 2350.0f;
+    if (name.find(L"arc a580") != std::wstring::npos) return 2000.0f;
+
+    // Intel integrated
+    if (name.find(L"intel") != std::wstring::npos && name.find(L"iris") != std::wstring::npos) return 1300.0f;
+    if (name.find(L"intel") != std::wstring::npos && name.find(L"uhd") != std::wstring::npos) return 1150.0f;
+
+    return -1.0f;
+}
+
+
+// ---------------- NVAPI readers (session opened by probeAdapters) ----------------
+
+static float nvTemperature(NvPhysicalGpuHandle handle) {
+    NV_GPU_THERMAL_SETTINGS thermal = {};
+    thermal.version = NV_GPU_THERMAL_SETTINGS_VER;
+
+    // Prefer the GPU core sensor, then whatever sensor comes first
+    if (NvAPI_GPU_GetThermalSettings(handle, NVAPI_THERMAL_TARGET_ALL, &thermal) == NVAPI_OK && thermal.count > 0) {
+        for (NvU32 i = 0; i < thermal.count; i++) {
+            if (thermal.sensor[i].controller == NVAPI_THERMAL_CONTROLLER_GPU_INTERNAL &&
+                thermal.sensor[i].target == NVAPI_THERMAL_TARGET_GPU) {
+                return static_cast<float>(thermal.sensor[i].currentTemp);
+            }
+        }
+        if (thermal.sensor[0].currentTemp > 0) return static_cast<float>(thermal.sensor[0].currentTemp);
+    }
+
+    // Older drivers only answer for a single target
+    NV_THERMAL_TARGET targets[] = { NVAPI_THERMAL_TARGET_GPU, NVAPI_THERMAL_TARGET_NONE };
+    for (NV_THERMAL_TARGET target : targets) {
+        thermal = {};
+        thermal.version = NV_GPU_THERMAL_SETTINGS_VER;
+        if (NvAPI_GPU_GetThermalSettings(handle, target, &thermal) == NVAPI_OK && thermal.count > 0) {
+            return static_cast<float>(thermal.sensor[0].currentTemp);
+        }
+    }
+    return -1.0f;
+}
+
+static float nvUsage(NvPhysicalGpuHandle handle) {
+    NV_GPU_DYNAMIC_PSTATES_INFO_EX pStates = {};
+    pStates.version = NV_GPU_DYNAMIC_PSTATES_INFO_EX_VER;
+    if (NvAPI_GPU_GetDynamicPstatesInfoEx(handle, &pStates) == NVAPI_OK) {
+        return static_cast<float>(pStates.utilization[0].percentage);   // 0 = graphics engine
+    }
+    return -1.0f;
+}
+
+static int nvCoreCount(NvPhysicalGpuHandle handle) {
+    NvU32 count = 0;
+    if (NvAPI_GPU_GetGpuCoreCount(handle, &count) == NVAPI_OK) return static_cast<int>(count);
+    return 0;
+}
+
+static float nvClockMHz(NvPhysicalGpuHandle handle) {
+    NV_GPU_CLOCK_FREQUENCIES clocks = {};
+    clocks.version = NV_GPU_CLOCK_FREQUENCIES_VER;
+    clocks.ClockType = NV_GPU_CLOCK_FREQUENCIES_CURRENT_FREQ;
+    if (NvAPI_GPU_GetAllClockFrequencies(handle, &clocks) != NVAPI_OK) return -1.0f;
+
+    // Graphics domain first, otherwise the first domain that reports anything (kHz)
+    if (clocks.domain[NVAPI_GPU_PUBLIC_CLOCK_GRAPHICS].bIsPresent &&
+        clocks.domain[NVAPI_GPU_PUBLIC_CLOCK_GRAPHICS].frequency > 0) {
+        return clocks.domain[NVAPI_GPU_PUBLIC_CLOCK_GRAPHICS].frequency / 1000.0f;
+    }
+    for (int i = 0; i < NVAPI_MAX_GPU_PUBLIC_CLOCKS; i++) {
+        if (clocks.domain[i].bIsPresent && clocks.domain[i].frequency > 0) {
+            return clocks.domain[i].frequency / 1000.0f;
+        }
+    }
+    return -1.0f;
+}
+
+// NVAPI and DXGI don't enumerate in the same order on every machine: pair them
+// by PCI device / subsystem id, and fall back to "next unused NVIDIA handle".
+static int matchNvapiHandle(const NvPhysicalGpuHandle* handles, NvU32 count, std::vector<bool>& used, const DXGI_ADAPTER_DESC1& desc) {
+    for (NvU32 i = 0; i < count; ++i) {
+        if (used[i]) continue;
+        NvU32 deviceId = 0, subSystemId = 0, revisionId = 0, extDeviceId = 0;
+        if (NvAPI_GPU_GetPCIIdentifiers(handles[i], &deviceId, &subSystemId, &revisionId, &extDeviceId) == NVAPI_OK &&
+            (deviceId >> 16) == desc.DeviceId && subSystemId == desc.SubSysId) {
+            used[i] = true;
+            return static_cast<int>(i);
+        }
+    }
+    for (NvU32 i = 0; i < count; ++i) {
+        if (!used[i]) {
+            used[i] = true;
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+
+// ---------------- WMI temperature fallback ----------------
+
+static float wmiTemperature() {
+    SystemQuery& wmi = SystemQuery::instance();
+
+    // OpenHardwareMonitor publishes real GPU sensors (if it is installed and running)
+    QueryRow ohm = wmi.first("Sensor", { "Value" },
+        "SensorType='Temperature' AND (Name LIKE '%GPU%' OR Parent LIKE '%GPU%')", "ROOT\\OpenHardwareMonitor");
+    if (ohm.has("Value")) return static_cast<float>(ohm.real("Value"));
+
+    // ACPI thermal zone: not the GPU itself, but close on laptops (tenths of Kelvin)
+    QueryRow zone = wmi.first("MSAcpi_ThermalZoneTemperature", { "CurrentTemperature" }, "", "ROOT\\WMI");
+    if (!zone.has("CurrentTemperature")) return -1.0f;
+
+    float temp = static_cast<float>(zone.real("CurrentTemperature"));
+    if (temp > 2000.0f) temp = temp / 10.0f - 273.15f;
+    return temp;
+}
+
+
+// ---------------- PDH usage fallback ----------------
+
+// "pid_1234_luid_0x00000000_0x0000C3F1_phys_0_eng_0_engtype_3D" -> LUID
+static bool parseEngineLuid(const wchar_t* instance, int64_t& luid) {
+    const wchar_t* p = wcsstr(instance, L"luid_0x");
+    unsigned long high = 0, low = 0;
+    if (!p || swscanf_s(p, L"luid_0x%lx_0x%lx", &high, &low) != 2) return false;
+    luid = (static_cast<int64_t>(high) << 32) | low;
+    return true;
+}
+
+// 3D engine load per adapter LUID, summed over every process using it.
+// Empty map = PDH not usable; a missing LUID = nobody is rendering (0 %).
+static bool pdhUsageByLuid(std::map<int64_t, double>& perLuid) {
+    PDH_HQUERY query;
+    PDH_HCOUNTER counter;
+    if (PdhOpenQuery(nullptr, 0, &query) != ERROR_SUCCESS) return false;
+
+    bool ok = false;
+    if (PdhAddEnglishCounterW(query, L"\\GPU Engine(*engtype_3D)\\Utilization Percentage", 0, &counter) == ERROR_SUCCESS) {
+        PdhCollectQueryData(query);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        PdhCollectQueryData(query);
+
+        DWORD bytes = 0, count = 0;
+        if (PdhGetFormattedCounterArrayW(counter, PDH_FMT_DOUBLE, &bytes, &count, nullptr) == PDH_MORE_DATA) {
+            std::vector<unsigned char> buffer(bytes);
+            auto* items = reinterpret_cast<PDH_FMT_COUNTERVALUE_ITEM_W*>(buffer.data());
+            if (PdhGetFormattedCounterArrayW(counter, PDH_FMT_DOUBLE, &bytes, &count, items) == ERROR_SUCCESS) {
+                ok = true;
+                for (DWORD i = 0; i < count; ++i) {
+                    int64_t luid = 0;
+                    if (items[i].FmtValue.CStatus == ERROR_SUCCESS && parseEngineLuid(items[i].szName, luid)) {
+                        perLuid[luid] += items[i].FmtValue.doubleValue;
+                    }
+                }
+            }
+        }
+        else ok = true;   // counter exists but no process is using a 3D engine
+    }
+
+    PdhCloseQuery(query);
+    return ok;
+}
+
+
+// ---------------- GpuSnapshot ----------------
+
+GpuSnapshot& GpuSnapshot::instance() {
+    static GpuSnapshot snapshot;
+    return snapshot;
+}
+
+void GpuSnapshot::probeAdapters() {
+    PROFILE_SCOPE("GpuSnapshot::probeAdapters");
+    list.clear();
+
+    IDXGIFactory1* factory = nullptr;
+    if (FAILED(CreateDXGIFactory1(__uuidof(IDXGIFactory1), (void**)&factory))) return;
+
+    // One NVAPI session for every NVIDIA card in the box
+    bool nvapi = false;
+    NvPhysicalGpuHandle handles[NVAPI_MAX_PHYSICAL_GPUS] = { 0 };
+    NvU32 nvCount = 0;
+    if (nvapiAvailable() && NvAPI_Initialize() == NVAPI_OK) {
+        nvapi = true;
+        if (NvAPI_EnumPhysicalGPUs(handles, &nvCount) != NVAPI_OK) nvCount = 0;
+    }
+    std::vector<bool> used(nvCount, false);
+
+    IDXGIAdapter1* adapter = nullptr;
+    for (UINT i = 0; factory->EnumAdapters1(i, &adapter) != DXGI_ERROR_NOT_FOUND; ++i) {
+        DXGI_ADAPTER_DESC1 desc{};
+        if (FAILED(adapter->GetDesc1(&desc))) {
+            adapter->Release();
+            continue;
+        }
+
+        GpuAdapter g;
+        g.index = static_cast<int>(i);
+        g.name = wideToUtf8(desc.Description);
+        g.vendorId = desc.VendorId;
+        g.vendor = vendorName(desc.VendorId);
+        g.vramGB = static_cast<double>(desc.DedicatedVideoMemory) / (1024.0 * 1024.0 * 1024.0);
+        g.luid = (static_cast<int64_t>(desc.AdapterLuid.HighPart) << 32) | desc.AdapterLuid.LowPart;
+
+        LARGE_INTEGER driver{};
+        if (SUCCEEDED(adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &driver))) {
+            std::ostringstream oss;
+            oss << HIWORD(driver.HighPart) << "." << LOWORD(driver.HighPart) << "."
+                << HIWORD(driver.LowPart) << "." << LOWORD(driver.LowPart);
+            g.driverVersion = oss.str();
+        }
+        else g.driverVersion = "Unknown";
+
+        if (nvapi && desc.VendorId == 0x10DE) {
+            int h = matchNvapiHandle(handles, nvCount, used, desc);
+            if (h >= 0) {
+                g.temperatureC = nvTemperature(handles[h]);
+                g.usagePercent = nvUsage(handles[h]);
+                g.coreCount = nvCoreCount(handles[h]);
+                g.clockMHz = nvClockMHz(handles[h]);
+            }
+        }
+
+        if (g.clockMHz < 0.0f) {
+            g.clockMHz = estimateClockMHz(desc.Description);
+            g.clockEstimated = g.clockMHz > 0.0f;
+        }
+
+        list.push_back(g);
+        adapter->Release();
+    }
+
+    if (nvapi) NvAPI_Unload();
+    factory->Release();
+}
+
+void GpuSnapshot::fillUsage() {
+    PROFILE_SCOPE("GpuSnapshot::fillUsage");
+    bool missing = std::any_of(list.begin(), list.end(), [](const GpuAdapter& g) { return g.usagePercent < 0.0f; });
+    if (!missing) return;
+
+    std::map<int64_t, double> perLuid;
+    if (!pdhUsageByLuid(perLuid)) return;
+
+    for (auto& g : list) {
+        if (g.usagePercent >= 0.0f) continue;
+        auto it = perLuid.find(g.luid);
+        g.usagePercent = (it == perLuid.end()) ? 0.0f : static_cast<float>((std::min)(it->second, 100.0));
+    }
+}
+
+void GpuSnapshot::fillTemperature() {
+    PROFILE_SCOPE("GpuSnapshot::fillTemperature");
+    bool missing = std::any_of(list.begin(), list.end(), [](const GpuAdapter& g) { return g.temperatureC < 0.0f; });
+    if (!missing) return;
+
+    float temp = wmiTemperature();
+    if (temp < 0.0f) return;
+    for (auto& g : list) {
+        if (g.temperatureC < 0.0f) g.temperatureC = temp;
+    }
+}
+
+std::vector<GpuAdapter> GpuSnapshot::adapters(unsigned need) {
+    PROFILE_SCOPE("GpuSnapshot::adapters");
+    std::lock_guard<std::mutex> lock(mtx);
+
+    if (!probed) {
+        probeAdapters();
+        probed = true;
+    }
+    if ((need & Usage) && !usageFilled) {
+        fillUsage();
+        usageFilled = true;
+    }
+    if ((need & Temperature) && !temperatureFilled) {
+        fillTemperature();
+        temperatureFilled = true;
+    }
+    return list;
+}
+
+GpuAdapter GpuSnapshot::primary(unsigned need) {
+    std::vector<GpuAdapter> all = adapters(need);
+    if (!all.empty()) return all[0];
+
+    GpuAdapter none;
+    none.index = -1;
+    none.name = "No GPU Found";
+    none.vendor = "Unknown";
+    none.driverVersion = "Unknown";
+    return none;
+}
+
+void GpuSnapshot::refresh() {
+    std::lock_guard<std::mutex> lock(mtx);
+    probed = usageFilled = temperatureFilled = false;
+    list.clear();
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: GpuSnapshot (singleton)
+OBJECT: GpuSnapshot::instance(), used by CompactGPU, GPUInfo,
+        DetailedGPUInfo, CompactPerformance and PerformanceInfo
+DESCRIPTION: One GPU probe per run, shared by every GPU section.
+FUNCTIONS:
+    std::vector<GpuAdapter> adapters(unsigned need)
+        First call: DXGI enumeration + one NVAPI session (name, vendor,
+        driver, VRAM, LUID; NVIDIA: clock, usage, temperature, cores).
+        need & Usage       -> one PDH "GPU Engine" sample, split per LUID
+        need & Temperature -> one WMI query (OpenHardwareMonitor, ACPI)
+        Every step runs at most once until refresh().
+
+    GpuAdapter primary(unsigned need)
+        Adapter 0, or a "No GPU Found" entry with index -1.
+
+    void refresh()
+        Drop the snapshot (watch / agent re-sample between frames).
+
+UNKNOWN VALUES:
+    clockMHz / usagePercent / temperatureC < 0, coreCount == 0
+*/
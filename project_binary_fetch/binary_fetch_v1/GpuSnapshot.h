@@ -0,0 +1,84 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+
+/*
+ ---------------------------------------------------------
+                    GpuAdapter Struct
+ ---------------------------------------------------------
+
+  Everything BinaryFetch shows about one graphics adapter.
+  Numbers that could not be read stay negative (or 0 for
+  coreCount), so every section decides itself how to print
+  "unknown".
+*/
+struct GpuAdapter {
+    int index = 0;                 // DXGI enumeration order (0 = primary)
+    std::string name;              // "NVIDIA GeForce RTX 4070 SUPER"
+    unsigned vendorId = 0;         // PCI vendor id
+    std::string vendor;            // "NVIDIA", "AMD", "Intel" or "Unknown"
+    std::string driverVersion;     // "32.0.15.6094" or "Unknown"
+    double vramGB = 0.0;           // dedicated video memory
+    float clockMHz = -1.0f;        // current graphics clock
+    bool clockEstimated = false;   // clockMHz guessed from the model name, not measured
+    float usagePercent = -1.0f;    // 3D engine load
+    float temperatureC = -1.0f;
+    int coreCount = 0;             // shader / CUDA cores (NVAPI only)
+    int64_t luid = 0;              // DXGI adapter LUID (matches PDH "GPU Engine" instances)
+};
+
+
+
+/*
+ ---------------------------------------------------------
+                   GpuSnapshot Class
+ ---------------------------------------------------------
+
+  One GPU probe per run, shared by every GPU-related section
+  (compact_gpu, gpu_info + primary details, compact_performance,
+  performance_info).
+
+  adapters() enumerates DXGI once and, for NVIDIA cards, reads
+  clocks / usage / temperature / cores through a single NVAPI
+  session. Adapters NVAPI doesn't cover get their usage from one
+  PDH "GPU Engine" sample and their temperature from one WMI
+  query - and only when a section actually asks for those.
+
+  Sections run on several worker threads; the first one to ask
+  does the work, the rest wait for it and read the result.
+*/
+class GpuSnapshot {
+public:
+    enum Need : unsigned {
+        Basic = 0,            // name, vendor, driver, VRAM + whatever NVAPI reported
+        Usage = 1,            // also fill usage for non-NVIDIA adapters (PDH, ~100 ms)
+        Temperature = 2,      // also fill temperature for non-NVIDIA adapters (WMI)
+    };
+
+    static GpuSnapshot& instance();
+
+    // All adapters, probed on first use. need = Usage | Temperature as required.
+    std::vector<GpuAdapter> adapters(unsigned need = Basic);
+
+    // Adapter 0 (the one Windows renders the desktop on); index -1 if there is none
+    GpuAdapter primary(unsigned need = Basic);
+
+    // Forget everything so the next call probes again (--watch, --agent)
+    void refresh();
+
+private:
+    GpuSnapshot() = default;
+
+    void probeAdapters();       // DXGI + NVAPI pass
+    void fillUsage();           // PDH fallback
+    void fillTemperature();     // WMI fallback
+
+    std::mutex mtx;
+    bool probed = false;
+    bool usageFilled = false;
+    bool temperatureFilled = false;
+    std::vector<GpuAdapter> list;
+};
@@ -0,0 +1,267 @@
+#include "MemoryBench.h"
+#include "StaticFactsCache.h"
+#include "CpuTopology.h"
+#include "Cpuid.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <cstdio>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define MEMBENCH_X86 1
+#include <immintrin.h>
+#endif
+
+// GCC / Clang only emit AVX code in functions that ask for it; MSVC always can
+#if defined(MEMBENCH_X86) && defined(__GNUC__)
+#define MEMBENCH_TARGET(isa) __attribute__((target(isa)))
+#else
+#define MEMBENCH_TARGET(isa)
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+
+// ---------------- Kernels ----------------
+
+namespace {
+
+    const double kScalar = 3.0;
+
+    void copyScalar(double* c, const double* a, size_t n) {
+        for (size_t i = 0; i < n; ++i) c[i] = a[i];
+    }
+
+    void triadScalar(double* a, const double* b, const double* c, size_t n) {
+        for (size_t i = 0; i < n; ++i) a[i] = b[i] + kScalar * c[i];
+    }
+
+#ifdef MEMBENCH_X86
+    MEMBENCH_TARGET("avx2")
+    void copyAvx2(double* c, const double* a, size_t n) {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) _mm256_storeu_pd(c + i, _mm256_loadu_pd(a + i));
+        for (; i < n; ++i) c[i] = a[i];
+    }
+
+    MEMBENCH_TARGET("avx2,fma")
+    void triadAvx2(double* a, const double* b, const double* c, size_t n) {
+        const __m256d s = _mm256_set1_pd(kScalar);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) _mm256_storeu_pd(a + i, _mm256_fmadd_pd(s, _mm256_loadu_pd(c + i), _mm256_loadu_pd(b + i)));
+        for (; i < n; ++i) a[i] = b[i] + kScalar * c[i];
+    }
+
+    MEMBENCH_TARGET("avx512f")
+    void copyAvx512(double* c, const double* a, size_t n) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) _mm512_storeu_pd(c + i, _mm512_loadu_pd(a + i));
+        for (; i < n; ++i) c[i] = a[i];
+    }
+
+    MEMBENCH_TARGET("avx512f")
+    void triadAvx512(double* a, const double* b, const double* c, size_t n) {
+        const __m512d s = _mm512_set1_pd(kScalar);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) _mm512_storeu_pd(a + i, _mm512_fmadd_pd(s, _mm512_loadu_pd(c + i), _mm512_loadu_pd(b + i)));
+        for (; i < n; ++i) a[i] = b[i] + kScalar * c[i];
+    }
+#endif
+
+    using CopyFn = void (*)(double*, const double*, size_t);
+    using TriadFn = void (*)(double*, const double*, const double*, size_t);
+
+    struct Kernels {
+        CopyFn copy = copyScalar;
+        TriadFn triad = triadScalar;
+        const char* name = "scalar";
+    };
+
+    Kernels pickKernels() {
+        Kernels k;
+#ifdef MEMBENCH_X86
+        const Cpuid& id = Cpuid::current();
+        if (id.has(Cpuid::AVX512F)) {
+            k.copy = copyAvx512;
+            k.triad = triadAvx512;
+            k.name = "AVX-512";
+        }
+        else if (id.has(Cpuid::AVX2) && id.has(Cpuid::FMA)) {
+            k.copy = copyAvx2;
+            k.triad = triadAvx2;
+            k.name = "AVX2";
+        }
+#endif
+        return k;
+    }
+
+    // Run fn(thread) on every thread at once; returns the wall time from
+    // the common start to the last thread finishing
+    template <typename Fn>
+    double together(int threads, Fn fn) {
+        std::atomic<bool> go(false);
+        std::vector<std::thread> pool;
+        pool.reserve(threads);
+        for (int t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t] {
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                fn(t);
+            });
+        }
+        auto start = Clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& th : pool) th.join();
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+}
+
+
+// ---------------- Measurement ----------------
+
+MemoryBench::Result MemoryBench::measure(unsigned budgetMs) {
+    PROFILE_SCOPE("MemoryBench::measure");
+    Result r;
+    const Clock::time_point start = Clock::now();
+    auto at = [&](double share) { return start + std::chrono::microseconds(static_cast<long long>(budgetMs * 1000.0 * share)); };
+
+    // 4x the last level cache per array, so the passes stream from DRAM
+    uint64_t llc = 0;
+    for (int level = 3; level >= 2 && llc == 0; --level) llc = CpuTopology::current().cacheBytes[level];
+    size_t arrayBytes = static_cast<size_t>((std::min)((std::max)(llc * 4, uint64_t(16) << 20), uint64_t(64) << 20));
+
+    int threads = static_cast<int>((std::max)(1u, std::thread::hardware_concurrency()));
+    size_t perThread = arrayBytes / sizeof(double) / threads;
+    perThread -= perThread % 8;
+    if (perThread < 1024) {
+        threads = (std::max)(1, static_cast<int>(arrayBytes / sizeof(double) / 1024));
+        perThread = arrayBytes / sizeof(double) / threads;
+        perThread -= perThread % 8;
+    }
+    const size_t n = perThread * threads;
+
+    // new[] leaves the pages untouched: each thread faults in its own slice
+    std::unique_ptr<double[]> a(new double[n]), b(new double[n]), c(new double[n]);
+    together(threads, [&](int t) {
+        size_t base = static_cast<size_t>(t) * perThread;
+        std::fill(a.get() + base, a.get() + base + perThread, 1.0);
+        std::fill(b.get() + base, b.get() + base + perThread, 2.0);
+        std::fill(c.get() + base, c.get() + base + perThread, 0.0);
+    });
+
+    Kernels kernels = pickKernels();
+    r.kernel = kernels.name;
+    r.threads = threads;
+
+    // Each thread repeats its slice until the phase deadline (at least once)
+    std::vector<uint64_t> passes(threads);
+    auto phase = [&](Clock::time_point until, auto pass) {
+        std::fill(passes.begin(), passes.end(), 0);
+        double seconds = together(threads, [&](int t) {
+            size_t base = static_cast<size_t>(t) * perThread;
+            do {
+                pass(base);
+                passes[t]++;
+            } while (Clock::now() < until);
+        });
+        uint64_t total = 0;
+        for (uint64_t p : passes) total += p;
+        return static_cast<double>(total) * perThread / seconds;   // elements per second
+    };
+
+    // STREAM counting: copy moves 2 doubles per element, triad 3
+    double copyRate = phase(at(0.35), [&](size_t base) { kernels.copy(c.get() + base, a.get() + base, perThread); });
+    r.copyGBs = copyRate * 2 * sizeof(double) / 1e9;
+    double triadRate = phase(at(0.60), [&](size_t base) { kernels.triad(a.get() + base, b.get() + base, c.get() + base, perThread); });
+    r.triadGBs = triadRate * 3 * sizeof(double) / 1e9;
+
+    // Latency: one random cycle through every cache line of a separate buffer
+    const size_t stride = 64 / sizeof(size_t);
+    const size_t lines = arrayBytes / 64;
+    std::unique_ptr<size_t[]> chain(new size_t[lines * stride]);
+    for (size_t i = 0; i < lines; ++i) chain[i * stride] = i;
+    uint64_t rnd = 0x2545F4914F6CDD1DULL;
+    for (size_t i = lines - 1; i > 0; --i) {
+        rnd ^= rnd << 13; rnd ^= rnd >> 7; rnd ^= rnd << 17;
+        size_t j = static_cast<size_t>(rnd % i);   // Sattolo: j < i keeps it one cycle
+        std::swap(chain[i * stride], chain[j * stride]);
+    }
+
+    const Clock::time_point until = at(1.0);
+    size_t p = 0;
+    uint64_t loads = 0;
+    auto chaseStart = Clock::now();
+    do {
+        for (int k = 0; k < 65536; ++k) p = chain[p * stride];
+        loads += 65536;
+    } while (Clock::now() < until);
+    double chaseNs = std::chrono::duration<double, std::nano>(Clock::now() - chaseStart).count();
+    r.latencyNs = chaseNs / static_cast<double>(loads) + (p == lines ? 1.0 : 0.0);   // p keeps the chase alive
+
+    return r;
+}
+
+
+// ---------------- Cache ----------------
+
+std::string MemoryBench::pack(const Result& r) {
+    char buffer[96];
+    std::snprintf(buffer, sizeof(buffer), "%.2f %.2f %.2f %d %s", r.copyGBs, r.triadGBs, r.latencyNs, r.threads, r.kernel);
+    return buffer;
+}
+
+bool MemoryBench::unpack(const std::string& packed, Result& out) {
+    std::istringstream in(packed);
+    std::string kernel;
+    Result r;
+    if (!(in >> r.copyGBs >> r.triadGBs >> r.latencyNs >> r.threads >> kernel)) return false;
+
+    // Back to the static names measure() hands out
+    static const char* const kNames[] = { "AVX-512", "AVX2", "scalar" };
+    for (const char* name : kNames) if (kernel == name) r.kernel = name;
+    if (!*r.kernel || r.copyGBs <= 0.0 || r.latencyNs <= 0.0) return false;
+
+    out = r;
+    return true;
+}
+
+MemoryBench::Result MemoryBench::get(unsigned budgetMs) {
+    PROFILE_SCOPE("MemoryBench::get");
+    Result r;
+    std::string packed = StaticFactsCache::instance().getOrCompute("memory.bench", [budgetMs] {
+        return pack(measure(budgetMs));
+    });
+    if (!unpack(packed, r)) r = measure(budgetMs);
+    return r;
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: MemoryBench
+OBJECT: MemoryBench::get(), called by main.cpp's "memory_bench" section
+        (off unless "enabled": true in the config)
+DESCRIPTION: Measured DRAM copy / triad bandwidth and load-to-load latency.
+FUNCTIONS:
+    static Result get(unsigned budgetMs)
+        StaticFactsCache "memory.bench", so the kernels run once per boot.
+
+    static Result measure(unsigned budgetMs)
+        Parallel first touch, then copy until 35 % of the budget, triad
+        until 60 %, pointer chase until 100 % (each phase runs at least
+        one pass even if setup ate its share).
+
+    static std::string pack(const Result& r)
+    static bool unpack(const std::string& packed, Result& out)
+        Cache encoding.
+
+    static double channelPeakGBs(unsigned mts)
+        Theoretical peak of one 64-bit channel, for the single-channel hint.
+*/
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ ---------------------------------------------------------
+                    MemoryBench Class
+ ---------------------------------------------------------
+
+  Measured memory throughput and latency for the opt-in
+  "memory_bench" section, next to the rated DIMM speed that
+  detailed_memory prints. A 3200 MT/s kit running on one
+  channel looks identical to a dual-channel one on paper;
+  here it shows up as half the bandwidth.
+
+    Bandwidth : STREAM-style copy (c = a) and triad
+                (a = b + s * c) over doubles, one slice per
+                hardware thread, each thread first-touching its
+                own slice. AVX-512F / AVX2 / scalar kernel,
+                picked from Cpuid::current() (only when the OS
+                saves the registers).
+    Latency   : one thread chasing a random cyclic chain of
+                cache lines (Sattolo permutation), so every load
+                depends on the previous one and the prefetchers
+                can't guess the next line.
+
+  The buffers are 4x the last level cache (16-64 MB per array)
+  so the numbers are DRAM, not cache. Everything runs inside
+  budgetMs (default 300 ms): the passes stop when their share
+  of the budget is used, however far they got.
+
+  Results are stored in StaticFactsCache ("memory.bench"), so
+  the kernels run once per boot; --refresh-cache measures again.
+*/
+class MemoryBench {
+public:
+    static const unsigned DefaultBudgetMs = 300;
+
+    struct Result {
+        double copyGBs = -1.0;        // GB/s, 1e9 bytes, STREAM byte counting
+        double triadGBs = -1.0;
+        double latencyNs = -1.0;      // per dependent load
+        int threads = 0;
+        const char* kernel = "";      // "AVX-512", "AVX2" or "scalar"
+    };
+
+    // Cached result, or measure now (blocks for up to budgetMs)
+    static Result get(unsigned budgetMs = DefaultBudgetMs);
+
+    // Always measure
+    static Result measure(unsigned budgetMs);
+
+    // Cache encoding ("copy triad latency threads kernel"), public for the tests
+    static std::string pack(const Result& r);
+    static bool unpack(const std::string& packed, Result& out);
+
+    // Peak of one 64-bit channel at a transfer rate: 3200 MT/s -> 25.6 GB/s
+    static double channelPeakGBs(unsigned mts) { return mts * 8.0 / 1000.0; }
+};
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <vector>
+#include <mutex>
 
 struct MemoryModule {
     std::string capacity; // e.g., "16GB"
@@ -12,21 +13,25 @@ struct MemoryModule {
 
 class MemoryInfo {
 private:
-    int totalGB;
-    int freeGB;
-    std::vector<MemoryModule> modules;
+    mutable std::vector<MemoryModule> modules;
+    mutable std::once_flag modulesOnce; // SMBIOS module walk runs on first getModules()
 
-    void fetchSystemMemory();    // total/free memory
-    void fetchModulesInfo();     // per-module info
+    void fetchModulesInfo() const; // per-module info (SMBIOS type 17)
 
 public:
     MemoryInfo();
 
-    int getTotal() const;
-    int getFree() const;
+    // From the shared MemorySnapshot, so they match every other memory section
+    double getTotal() const;     // GB, 0.1 steps
+    double getFree() const;      // available GB, 0.1 steps
     int getUsedPercentage() const;
 
     const std::vector<MemoryModule>& getModules() const;
+
+    // Formatting / cache encoding of module records (also used by BinaryFetchBench)
+    static std::string capacityLabel(unsigned long long bytes);   // 17179869184 -> "16GB"
+    static std::string packModules(const std::vector<MemoryModule>& modules);
+    static std::vector<MemoryModule> unpackModules(const std::string& packed);
 };
 
 #endif
@@ -0,0 +1,302 @@
+#include "MemoryPressure.h"
+#include "Profiler.h"
+#include "SystemQuery.h"
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+
+
+// ---------------- /proc/vmstat ----------------
+
+namespace {
+
+    struct VmstatKey {
+        const char* name;
+        size_t length;
+        uint64_t MemoryPressure::Counters::* field;
+    };
+
+    const VmstatKey kVmstatKeys[] = {
+        { "pswpin",              6, &MemoryPressure::Counters::pswpin },
+        { "pswpout",             7, &MemoryPressure::Counters::pswpout },
+        { "pgfault",             7, &MemoryPressure::Counters::pgfault },
+        { "pgmajfault",         10, &MemoryPressure::Counters::pgmajfault },
+        { "zswpin",              6, &MemoryPressure::Counters::zswpin },
+        { "zswpout",             7, &MemoryPressure::Counters::zswpout },
+        { "thp_fault_alloc",    15, &MemoryPressure::Counters::thpFaultAlloc },
+        { "thp_fault_fallback", 18, &MemoryPressure::Counters::thpFaultFallback },
+        { "thp_collapse_alloc", 18, &MemoryPressure::Counters::thpCollapseAlloc },
+        { "oom_kill",            8, &MemoryPressure::Counters::oomKill },
+    };
+    const size_t kVmstatKeyCount = sizeof(kVmstatKeys) / sizeof(kVmstatKeys[0]);
+
+    // Perfect for the ten keys above (found by search; MemoryPressureTests re-checks it).
+    // Any other key lands on some slot and fails the memcmp.
+    inline unsigned vmstatHash(const char* key, size_t length) {
+        return (3u * static_cast<unsigned char>(key[0]) + 3u * static_cast<unsigned char>(key[1])
+            + static_cast<unsigned char>(key[length - 1]) + static_cast<unsigned>(length)) & 15u;
+    }
+
+    // slot -> index into kVmstatKeys, -1 = empty
+    const signed char kVmstatSlots[16] = { 2, 7, 5, 3, 1, -1, 6, -1, -1, 8, -1, 4, -1, 0, 9, -1 };
+
+}
+
+bool MemoryPressure::vmstatTableValid() {
+    bool used[16] = {};
+    for (size_t i = 0; i < kVmstatKeyCount; ++i) {
+        unsigned slot = vmstatHash(kVmstatKeys[i].name, kVmstatKeys[i].length);
+        if (used[slot] || kVmstatSlots[slot] != static_cast<signed char>(i)) return false;
+        used[slot] = true;
+    }
+    return true;
+}
+
+size_t MemoryPressure::parseVmstat(const char* text, size_t length, Counters& out) {
+    const char* p = text;
+    const char* end = text + length;
+    size_t seen = 0;
+
+    while (p < end && seen < kVmstatKeyCount) {
+        // "key value\n"
+        const char* space = static_cast<const char*>(memchr(p, ' ', static_cast<size_t>(end - p)));
+        if (!space) break;
+        size_t keyLength = static_cast<size_t>(space - p);
+
+        if (keyLength >= 2) {
+            int index = kVmstatSlots[vmstatHash(p, keyLength)];
+            if (index >= 0 && kVmstatKeys[index].length == keyLength && std::memcmp(p, kVmstatKeys[index].name, keyLength) == 0) {
+                uint64_t value = 0;
+                for (p = space + 1; p < end && *p >= '0' && *p <= '9'; ++p) value = value * 10 + static_cast<uint64_t>(*p - '0');
+                out.*(kVmstatKeys[index].field) = value;
+                ++seen;
+            }
+        }
+
+        const char* next = static_cast<const char*>(memchr(space, '\n', static_cast<size_t>(end - space)));
+        if (!next) break;
+        p = next + 1;
+    }
+    return seen;
+}
+
+bool MemoryPressure::parseMmStat(const char* text, size_t length, Zram& out) {
+    const char* p = text;
+    const char* end = text + length;
+    uint64_t* fields[] = { &out.origBytes, &out.comprBytes, &out.usedBytes };
+    for (uint64_t* field : fields) {
+        while (p < end && (*p == ' ' || *p == '\t')) ++p;
+        if (p == end || *p < '0' || *p > '9') return false;
+        uint64_t value = 0;
+        while (p < end && *p >= '0' && *p <= '9') value = value * 10 + static_cast<uint64_t>(*p++ - '0');
+        *field = value;
+    }
+    return true;
+}
+
+
+// ---------------- Formatting ----------------
+
+static std::string gb(uint64_t bytes) {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << MemorySnapshot::gib(bytes) << " GB";
+    return ss.str();
+}
+
+static std::string mb(double bytes) {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << bytes / (1024.0 * 1024.0) << " MB";
+    return ss.str();
+}
+
+static std::string perSec(double n) {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    if (n >= 1000.0) ss << n / 1000.0 << "k/s";
+    else ss << std::setprecision(0) << n << "/s";
+    return ss.str();
+}
+
+static std::string compressed(uint64_t original, uint64_t stored) {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1) << MemoryPressure::ratio(original, stored) << "x";
+    return gb(original) + " -> " + gb(stored) + " (" + ss.str() + ")";
+}
+
+std::vector<MemoryPressure::Row> MemoryPressure::rows(const Snapshot& s) {
+    const MemorySnapshot& m = s.memory;
+    std::vector<Row> out;
+
+    std::string swap = m.swapTotalBytes
+        ? gb(m.swapTotalBytes - (std::min)(m.swapFreeBytes, m.swapTotalBytes)) + " / " + gb(m.swapTotalBytes) + " used"
+        : std::string("none");
+    if (s.swapInBytesPerSec >= 0.0) swap += ", in " + mb(s.swapInBytesPerSec) + "/s, out " + mb(s.swapOutBytesPerSec) + "/s";
+    out.push_back({ "swap", "Swap", swap });
+    if (s.pagingInBytesPerSec >= 0.0) {
+        out.push_back({ "swap", "Paging (file + mapped)",
+            "in " + mb(s.pagingInBytesPerSec) + "/s, out " + mb(s.pagingOutBytesPerSec) + "/s" });
+    }
+
+    // zswap pool (meminfo) and every zram device; nothing stored, no line
+    if (m.zswapBytes > 0) out.push_back({ "compression", "Zswap", compressed(m.zswappedBytes, m.zswapBytes) });
+    for (const auto& z : s.zram) {
+        out.push_back({ "compression", z.device, compressed(z.origBytes, z.comprBytes) + ", " + gb(z.usedBytes) + " RAM" });
+    }
+
+    std::string huge = "THP " + gb(m.anonHugeBytes);
+    if (m.hugePagesTotal > 0) {
+        huge += ", explicit " + std::to_string(m.hugePagesTotal - (std::min)(m.hugePagesFree, m.hugePagesTotal)) + " / "
+            + std::to_string(m.hugePagesTotal) + " x " + std::to_string(m.hugePageBytes / 1024) + " kB used";
+    }
+    if (s.counters.thpFaultFallback > 0) huge += ", " + std::to_string(s.counters.thpFaultFallback) + " THP fallbacks";
+    out.push_back({ "hugepages", "Huge Pages", huge });
+
+    out.push_back({ "dirty", "Dirty / Writeback",
+        mb(static_cast<double>(m.dirtyBytes)) + " / " + mb(static_cast<double>(m.writebackBytes)) });
+
+    if (s.faultsPerSec >= 0.0) {
+        std::string faults = perSec(s.faultsPerSec);
+        if (s.majorFaultsPerSec >= 0.0) faults += " (major " + perSec(s.majorFaultsPerSec) + ")";
+        else if (s.pageReadsPerSec >= 0.0) faults += " (hard-fault reads " + perSec(s.pageReadsPerSec) + ")";
+        if (s.counters.oomKill > 0) faults += ", " + std::to_string(s.counters.oomKill) + " OOM kills since boot";
+        out.push_back({ "faults", "Page Faults", faults });
+    }
+    return out;
+}
+
+
+// ---------------- Backends ----------------
+
+#ifdef _WIN32
+
+// PerfOS_Memory already reports per-second values: no counters to keep
+bool MemoryPressure::sample(Counters&) {
+    return false;
+}
+
+MemoryPressure::Snapshot MemoryPressure::snapshot() {
+    PROFILE_SCOPE("MemoryPressure::snapshot");
+    Snapshot s;
+    s.memory = MemorySnapshot::current();
+
+    const double pageBytes = 4096.0;
+    QueryRow row = SystemQuery::instance().first("Win32_PerfFormattedData_PerfOS_Memory",
+        { "PagesInputPersec", "PagesOutputPersec", "PageFaultsPersec", "PageReadsPersec" });
+    long long in = row.integer("PagesInputPersec");
+    long long out = row.integer("PagesOutputPersec");
+    long long faults = row.integer("PageFaultsPersec");
+    long long reads = row.integer("PageReadsPersec");
+    // Pages Input / Output cover every hard fault, mapped files included, so
+    // they are paging rates, not the pswpin / pswpout swap traffic of Linux
+    if (in >= 0) s.pagingInBytesPerSec = in * pageBytes;
+    if (out >= 0) s.pagingOutBytesPerSec = out * pageBytes;
+    if (faults >= 0) s.faultsPerSec = static_cast<double>(faults);
+    if (reads >= 0) s.pageReadsPerSec = static_cast<double>(reads);
+    return s;
+}
+
+#else
+
+bool MemoryPressure::sample(Counters& out) {
+    std::string vmstat = SystemQuery::instance().readFile("/proc/vmstat");
+    return parseVmstat(vmstat.data(), vmstat.size(), out) > 0;
+}
+
+MemoryPressure::Snapshot MemoryPressure::snapshot() {
+    PROFILE_SCOPE("MemoryPressure::snapshot");
+    std::lock_guard<std::mutex> lock(mtx);
+    Snapshot s;
+    s.memory = MemorySnapshot::current();
+
+    Counters now;
+    auto at = std::chrono::steady_clock::now();
+    if (sample(now)) {
+        double seconds = std::chrono::duration<double>(at - sampledAt).count();
+        if (hasSample && seconds > 0.0) {
+            static const double pageBytes = static_cast<double>(sysconf(_SC_PAGESIZE));
+            auto rate = [seconds](uint64_t after, uint64_t before) {
+                return after >= before ? static_cast<double>(after - before) / seconds : 0.0;
+            };
+            s.swapInBytesPerSec = rate(now.pswpin, previous.pswpin) * pageBytes;
+            s.swapOutBytesPerSec = rate(now.pswpout, previous.pswpout) * pageBytes;
+            s.faultsPerSec = rate(now.pgfault, previous.pgfault);
+            s.majorFaultsPerSec = rate(now.pgmajfault, previous.pgmajfault);
+        }
+        s.counters = now;
+        previous = now;
+        sampledAt = at;
+        hasSample = true;
+    }
+
+    // zram devices come and go with swap setup, not between two frames
+    if (!zramListed) {
+        zramListed = true;
+        if (DIR* dir = opendir("/sys/block")) {
+            while (dirent* entry = readdir(dir)) {
+                if (std::strncmp(entry->d_name, "zram", 4) == 0) zramDevices.push_back(entry->d_name);
+            }
+            closedir(dir);
+        }
+    }
+    for (const std::string& device : zramDevices) {
+        std::string text = SystemQuery::instance().readFile("/sys/block/" + device + "/mm_stat");
+        Zram z;
+        z.device = device;
+        if (parseMmStat(text.data(), text.size(), z) && z.origBytes > 0) s.zram.push_back(z);
+    }
+    return s;
+}
+
+#endif
+
+void MemoryPressure::prime() {
+    PROFILE_SCOPE("MemoryPressure::prime");
+    std::lock_guard<std::mutex> lock(mtx);
+    if (hasSample) return;
+    hasSample = sample(previous);
+    sampledAt = std::chrono::steady_clock::now();
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: MemoryPressure
+OBJECT: mem_pressure (main.cpp, "memory_pressure" section)
+DESCRIPTION: Swap traffic, zswap / zram compression, huge pages, dirty /
+             writeback and page fault rates.
+FUNCTIONS:
+    Snapshot snapshot()
+        Linux: MemorySnapshot::current() for sizes, /proc/vmstat through
+        SystemQuery::readFile (kept-open descriptor), mm_stat of every zram
+        device (listed once). Rates against the previous reading (the
+        prime() baseline for the first one); never sleeps.
+        Windows: MemorySnapshot plus one PerfOS_Memory row; its page in /
+        out rates fill pagingIn/OutBytesPerSec (mapped files included), not
+        the swap fields, and PageReadsPersec fills pageReadsPerSec.
+
+    void prime()
+        Baseline /proc/vmstat read, called by main() at launch when the plan
+        needs MemoryPressure. No-op on Windows (PerfOS rates are per second).
+
+    static size_t parseVmstat(const char* text, size_t length, Counters& out)
+        Perfect-hash lookup per line, memchr skip for unwanted keys, stops
+        after the last wanted key.
+
+    static bool vmstatTableValid()
+        Test-side check that the precomputed slot table matches the hash.
+
+    static bool parseMmStat(const char* text, size_t length, Zram& out)
+        First three mm_stat columns.
+
+    static std::vector<Row> rows(const Snapshot& s)
+        The memory_pressure lines as text, tagged with their show_<name> key.
+*/
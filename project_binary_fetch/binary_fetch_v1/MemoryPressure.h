@@ -0,0 +1,128 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "MemorySnapshot.h"
+
+/*
+ ---------------------------------------------------------
+                  MemoryPressure Class
+ ---------------------------------------------------------
+
+  Where memory is going rather than how much is left, for the
+  "memory_pressure" section: swap traffic, compressed swap
+  (zswap / zram), huge pages, dirty / writeback and page
+  faults.
+
+    Linux   : MemorySnapshot (the shared /proc/meminfo read)
+              for sizes, /proc/vmstat for the event counters,
+              and mm_stat of every /sys/block/zram device
+    Windows : MemorySnapshot plus one PerfOS_Memory row
+              (paging in / out, faults and hard-fault reads
+              per second; no compressed swap or huge page
+              breakdown). PerfOS has no page-file-only rate:
+              Pages Input / Output also count memory-mapped
+              files, so they are kept apart from swap traffic
+              as "paging" and never shown as swap in / out.
+
+  /proc/vmstat has close to 200 lines and we want ten of them.
+  parseVmstat() doesn't build a map: each line's key goes
+  through a small perfect hash (first two bytes, last byte,
+  length) into a 16-slot table of the wanted keys, one
+  memcmp confirms, and every other line is skipped with a
+  memchr to the next newline. It stops once all ten were seen.
+
+  Rates need two samples. main() calls prime() at launch to
+  read the /proc/vmstat baseline, and the object keeps the
+  previous counters, so every snapshot() (first fetch, --watch,
+  --agent) compares against the last reading and never sleeps.
+  An unprimed first snapshot has no rates. Values that can't
+  be read stay -1 (rates) or 0.
+
+  rows() turns a snapshot into the section's label / value
+  lines; main.cpp only picks the enabled ones and colors them.
+*/
+class MemoryPressure {
+public:
+    // The /proc/vmstat counters we keep (pages or events since boot)
+    struct Counters {
+        uint64_t pswpin = 0;
+        uint64_t pswpout = 0;
+        uint64_t pgfault = 0;
+        uint64_t pgmajfault = 0;
+        uint64_t zswpin = 0;
+        uint64_t zswpout = 0;
+        uint64_t thpFaultAlloc = 0;
+        uint64_t thpFaultFallback = 0;
+        uint64_t thpCollapseAlloc = 0;
+        uint64_t oomKill = 0;
+    };
+
+    // One zram device, from mm_stat
+    struct Zram {
+        std::string device;          // "zram0"
+        uint64_t origBytes = 0;      // data stored, uncompressed
+        uint64_t comprBytes = 0;     // after compression
+        uint64_t usedBytes = 0;      // RAM the device really takes (allocator overhead included)
+    };
+
+    struct Snapshot {
+        MemorySnapshot memory;
+        double swapInBytesPerSec = -1.0;     // Linux: pswpin / pswpout
+        double swapOutBytesPerSec = -1.0;
+        double pagingInBytesPerSec = -1.0;   // Windows: all hard-fault paging (page file + mapped files)
+        double pagingOutBytesPerSec = -1.0;
+        double faultsPerSec = -1.0;
+        double majorFaultsPerSec = -1.0;     // Linux: pgmajfault
+        double pageReadsPerSec = -1.0;       // Windows: disk reads to resolve hard faults (not a fault count)
+        Counters counters;           // totals since boot (THP / OOM lines)
+        std::vector<Zram> zram;
+    };
+
+    // Read the counter baseline now, so the first snapshot() has rates. Idempotent.
+    void prime();
+
+    // Everything above in one pass
+    Snapshot snapshot();
+
+    // One memory_pressure line: "Swap" -> "1.2 GB / 8.0 GB used, ..."
+    struct Row {
+        const char* name;            // config key show_<name>
+        std::string label;
+        std::string value;
+    };
+
+    // The lines of s in display order (one per zram device; rows with
+    // nothing to show, like faults before a rate exists, are left out)
+    static std::vector<Row> rows(const Snapshot& s);
+
+    // Uncompressed / compressed, 0 if nothing is stored
+    static double ratio(uint64_t original, uint64_t compressed) {
+        return compressed ? static_cast<double>(original) / compressed : 0.0;
+    }
+
+    // ---- parsers (public so the tests can run them on fixtures) ----
+
+    // /proc/vmstat text -> out. Returns the number of wanted keys found.
+    static size_t parseVmstat(const char* text, size_t length, Counters& out);
+
+    // Wanted key -> slot check for the tests: true if every key hashes to its own slot
+    static bool vmstatTableValid();
+
+    // "orig compr used limit ..." -> Zram sizes. false if under three numbers.
+    static bool parseMmStat(const char* text, size_t length, Zram& out);
+
+private:
+    bool sample(Counters& out);
+
+    std::mutex mtx;
+    Counters previous;
+    std::chrono::steady_clock::time_point sampledAt;
+    bool hasSample = false;
+    std::vector<std::string> zramDevices;   // listed once
+    bool zramListed = false;
+};
@@ -0,0 +1,177 @@
+#include "MemorySnapshot.h"
+#include "Profiler.h"
+#include <mutex>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#include <algorithm>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <string>
+#include "SystemQuery.h"
+#endif
+
+
+double MemorySnapshot::gib(uint64_t bytes) {
+    // Tenths of a GiB, rounded half up, so 31.96 GiB reads 32.0 in every section
+    const uint64_t tenth = (1ULL << 30) / 10;
+    return static_cast<double>((bytes + tenth / 2) / tenth) / 10.0;
+}
+
+int MemorySnapshot::usedPercent() const {
+    if (totalBytes == 0) return 0;
+    return static_cast<int>((usedBytes() * 200 / totalBytes + 1) / 2);
+}
+
+
+// ---------------- /proc/meminfo ----------------
+
+namespace {
+
+    struct MeminfoKey {
+        const char* name;
+        size_t length;
+        uint64_t MemorySnapshot::* field;
+    };
+
+    // Every key we keep; values in kB are scaled to bytes, HugePages_* are page counts
+    const MeminfoKey kMeminfoKeys[] = {
+        { "MemTotal",        8, &MemorySnapshot::totalBytes },
+        { "MemFree",         7, &MemorySnapshot::freeBytes },
+        { "MemAvailable",   12, &MemorySnapshot::availableBytes },
+        { "Buffers",         7, &MemorySnapshot::buffersBytes },
+        { "Cached",          6, &MemorySnapshot::cachedBytes },
+        { "SwapCached",     10, &MemorySnapshot::swapCachedBytes },
+        { "SwapTotal",       9, &MemorySnapshot::swapTotalBytes },
+        { "SwapFree",        8, &MemorySnapshot::swapFreeBytes },
+        { "HugePages_Total",15, &MemorySnapshot::hugePagesTotal },
+        { "HugePages_Free", 14, &MemorySnapshot::hugePagesFree },
+        { "Hugepagesize",   12, &MemorySnapshot::hugePageBytes },
+        { "AnonHugePages",  13, &MemorySnapshot::anonHugeBytes },
+        { "Dirty",           5, &MemorySnapshot::dirtyBytes },
+        { "Writeback",       9, &MemorySnapshot::writebackBytes },
+        { "Zswap",           5, &MemorySnapshot::zswapBytes },
+        { "Zswapped",        8, &MemorySnapshot::zswappedBytes },
+    };
+    const size_t kMeminfoKeyCount = sizeof(kMeminfoKeys) / sizeof(kMeminfoKeys[0]);
+
+}
+
+size_t MemorySnapshot::parseMeminfo(const char* text, size_t length, MemorySnapshot& out) {
+    const char* p = text;
+    const char* end = text + length;
+    size_t seen = 0;
+
+    while (p < end && seen < kMeminfoKeyCount) {
+        // "Key:   12345 kB\n" - key up to the colon, then the number and an optional unit
+        const char* colon = static_cast<const char*>(memchr(p, ':', static_cast<size_t>(end - p)));
+        if (!colon) break;
+        size_t keyLength = static_cast<size_t>(colon - p);
+
+        const MeminfoKey* key = nullptr;
+        for (const MeminfoKey& k : kMeminfoKeys) {
+            if (k.length == keyLength && p[0] == k.name[0] && std::memcmp(p, k.name, keyLength) == 0) { key = &k; break; }
+        }
+
+        p = colon + 1;
+        if (key) {
+            while (p < end && *p == ' ') ++p;
+            uint64_t value = 0;
+            while (p < end && *p >= '0' && *p <= '9') value = value * 10 + static_cast<uint64_t>(*p++ - '0');
+            if (end - p >= 3 && p[0] == ' ' && p[1] == 'k' && p[2] == 'B') value *= 1024;
+            out.*(key->field) = value;
+            ++seen;
+        }
+
+        const char* next = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!next) break;
+        p = next + 1;
+    }
+
+    // Kernels before 3.14 have no MemAvailable; free + reclaimable cache is what it estimates
+    if (out.availableBytes == 0) out.availableBytes = out.freeBytes + out.buffersBytes + out.cachedBytes;
+    return seen;
+}
+
+
+// ---------------- Backends ----------------
+
+static MemorySnapshot probe() {
+    PROFILE_SCOPE("MemorySnapshot::probe");
+    MemorySnapshot s;
+
+#ifdef _WIN32
+    MEMORYSTATUSEX status = {};
+    status.dwLength = sizeof(status);
+    if (GlobalMemoryStatusEx(&status)) {
+        s.totalBytes = status.ullTotalPhys;
+        s.availableBytes = status.ullAvailPhys;
+        s.freeBytes = status.ullAvailPhys;
+        // The commit limit is RAM + page files; the difference is the page file
+        if (status.ullTotalPageFile > status.ullTotalPhys) s.swapTotalBytes = status.ullTotalPageFile - status.ullTotalPhys;
+        if (status.ullAvailPageFile > status.ullAvailPhys) s.swapFreeBytes = (std::min)(status.ullAvailPageFile - status.ullAvailPhys, s.swapTotalBytes);
+    }
+
+    PERFORMANCE_INFORMATION perf = {};
+    perf.cb = sizeof(perf);
+    if (GetPerformanceInfo(&perf, sizeof(perf))) {
+        s.cachedBytes = static_cast<uint64_t>(perf.SystemCache) * perf.PageSize;
+    }
+    s.hugePageBytes = GetLargePageMinimum();
+#else
+    std::string meminfo = SystemQuery::instance().readFile("/proc/meminfo");
+    MemorySnapshot::parseMeminfo(meminfo.data(), meminfo.size(), s);
+#endif
+
+    return s;
+}
+
+static std::mutex snapshotMutex;
+static MemorySnapshot shared;
+static bool sharedValid = false;
+
+MemorySnapshot MemorySnapshot::current() {
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    if (!sharedValid) {
+        shared = probe();
+        sharedValid = true;
+    }
+    return shared;
+}
+
+void MemorySnapshot::refresh() {
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    sharedValid = false;
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: MemorySnapshot
+OBJECT: MemorySnapshot::current(), read by MemoryInfo (total / free /
+        used %), CompactMemory (total / free / used %),
+        CompactPerformance::getRAMUsage, PerformanceInfo::get_ram_usage_percent,
+        MemoryPressure (swap, huge pages, dirty / writeback, zswap)
+DESCRIPTION: One shared system memory reading in exact bytes.
+FUNCTIONS:
+    static MemorySnapshot current()
+        Reads on first call, then hands out copies until refresh().
+        Every section of one fetch (or one --watch frame) sees the same
+        numbers.
+
+    static void refresh()
+        Called by --watch and --agent before re-collecting.
+
+    static double gib(uint64_t bytes)
+    int usedPercent() const
+        The only rounding rules: 0.1 GiB and whole percent, half up.
+
+    static size_t parseMeminfo(const char* text, size_t length, MemorySnapshot& out)
+        One pass over /proc/meminfo: key up to ':' matched against a
+        fixed table of (name, length, field), stops once every table
+        key was seen. MemAvailable falls back to free + buffers + cached.
+*/
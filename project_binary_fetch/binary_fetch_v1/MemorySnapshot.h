@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ ---------------------------------------------------------
+                  MemorySnapshot Struct
+ ---------------------------------------------------------
+
+  System memory in exact bytes, read once and shared by every
+  section that shows RAM figures (detailed_memory,
+  compact_memory, compact_performance, performance_info), so
+  they all format the same numbers and agree with each other.
+
+    Windows : one GlobalMemoryStatusEx + GetPerformanceInfo
+              (system cache) call
+    Linux   : one read of /proc/meminfo (kept-open fd), parsed
+              with a table-driven key scanner - no iostreams,
+              no allocation, a few microseconds
+
+  "Used" is total - available everywhere: memory the kernel
+  can hand out without swapping (page cache included) counts
+  as free. Fields that could not be read stay 0.
+*/
+struct MemorySnapshot {
+    uint64_t totalBytes = 0;          // MemTotal
+    uint64_t freeBytes = 0;           // MemFree (truly unused)
+    uint64_t availableBytes = 0;      // MemAvailable
+    uint64_t buffersBytes = 0;        // Buffers
+    uint64_t cachedBytes = 0;         // Cached (page cache, Windows: system cache)
+    uint64_t swapCachedBytes = 0;     // SwapCached
+    uint64_t swapTotalBytes = 0;      // SwapTotal (Windows: page file beyond RAM)
+    uint64_t swapFreeBytes = 0;       // SwapFree
+    uint64_t hugePagesTotal = 0;      // HugePages_Total (pages, not bytes)
+    uint64_t hugePagesFree = 0;       // HugePages_Free (pages)
+    uint64_t hugePageBytes = 0;       // Hugepagesize
+    uint64_t anonHugeBytes = 0;       // AnonHugePages (transparent huge pages in use)
+    uint64_t dirtyBytes = 0;          // Dirty (waiting to be written back)
+    uint64_t writebackBytes = 0;      // Writeback (being written right now)
+    uint64_t zswapBytes = 0;          // Zswap (compressed pool size, 5.19+)
+    uint64_t zswappedBytes = 0;       // Zswapped (what the pool holds, uncompressed)
+
+    uint64_t usedBytes() const { return totalBytes > availableBytes ? totalBytes - availableBytes : 0; }
+
+    // Shared formatting: GiB rounded to 0.1, percent rounded to a whole number
+    static double gib(uint64_t bytes);
+    int usedPercent() const;
+
+    // The shared snapshot, read on first use and after refresh()
+    static MemorySnapshot current();
+
+    // Forget it so the next current() reads again (--watch, --agent)
+    static void refresh();
+
+    // ---- source (public so the tests can feed recorded files) ----
+
+    // /proc/meminfo text -> out. Returns the number of fields recognised.
+    static size_t parseMeminfo(const char* text, size_t length, MemorySnapshot& out);
+};
@@ -0,0 +1,412 @@
+#include "MountTable.h"
+#include "Profiler.h"
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <set>
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/statvfs.h>
+#endif
+
+const unsigned MountTable::DefaultTimeoutMs;
+const unsigned MountTable::PoolSize;
+
+
+// ---------------- /proc/self/mountinfo ----------------
+
+namespace {
+
+    // Next space-separated field of [p, end), octal escapes ("\040") decoded
+    bool nextField(const char*& p, const char* end, std::string& out) {
+        while (p < end && *p == ' ') ++p;
+        if (p == end) return false;
+        out.clear();
+        while (p < end && *p != ' ') {
+            if (*p == '\\' && end - p >= 4 && p[1] >= '0' && p[1] <= '3'
+                && p[2] >= '0' && p[2] <= '7' && p[3] >= '0' && p[3] <= '7') {
+                out += static_cast<char>((p[1] - '0') * 64 + (p[2] - '0') * 8 + (p[3] - '0'));
+                p += 4;
+            } else {
+                out += *p++;
+            }
+        }
+        return true;
+    }
+
+    // Skip one field without copying it
+    bool skipField(const char*& p, const char* end) {
+        while (p < end && *p == ' ') ++p;
+        if (p == end) return false;
+        while (p < end && *p != ' ') ++p;
+        return true;
+    }
+
+}
+
+bool MountTable::parseLine(const char* begin, const char* end, Mount& out) {
+    // "36 35 98:0 /mnt1 /mnt2 rw,noatime master:1 - ext3 /dev/root rw,errors=continue"
+    //  id par dev root point  options  [optional...] - type source super-options
+    const char* p = begin;
+    std::string root, field;
+    if (!skipField(p, end) || !skipField(p, end)) return false;
+    if (!nextField(p, end, out.deviceId) || !nextField(p, end, root)) return false;
+    if (!nextField(p, end, out.mountPoint) || !skipField(p, end)) return false;
+
+    // Optional fields (shared:N, master:N ...) up to the lone "-"
+    for (;;) {
+        if (!nextField(p, end, field)) return false;
+        if (field == "-") break;
+    }
+    if (!nextField(p, end, out.fsType) || !nextField(p, end, out.device)) return false;
+
+    out.kind = isNetworkFs(out.fsType) ? Kind::Network : Kind::Local;
+    return !out.mountPoint.empty() && out.mountPoint[0] == '/';
+}
+
+bool MountTable::isNetworkFs(const std::string& fsType) {
+    static const char* const network[] = {
+        "nfs", "nfs4", "cifs", "smb3", "smbfs", "ncpfs", "9p", "ceph", "glusterfs",
+        "afs", "lustre", "beegfs", "gpfs", "davfs",
+        "fuse.sshfs", "fuse.glusterfs", "fuse.s3fs", "fuse.rclone", "fuse.gcsfuse",
+    };
+    for (const char* type : network) {
+        if (fsType == type) return true;
+    }
+    return false;
+}
+
+bool MountTable::isStorage(const Mount& m) {
+    if (m.kind == Kind::Network) return true;
+    if (m.fsType == "squashfs") return false;          // snaps, live media: always 100% full
+    if (m.fsType == "zfs") return true;                // "pool/dataset" rather than a /dev node
+    if (m.fsType == "overlay") return m.mountPoint == "/";    // a container's root, not every layer
+    // Everything else backed by a block device; proc, sysfs, tmpfs,
+    // cgroup2, devpts, autofs ... all have a word as their source
+    return m.device.compare(0, 5, "/dev/") == 0;
+}
+
+void MountTable::MountinfoParser::line(const char* begin, const char* end) {
+    Mount m;
+    if (!parseLine(begin, end, m) || !isStorage(m)) return;
+
+    // Bind mounts and btrfs subvolumes repeat one device: keep the
+    // shortest mount point ("/" rather than "/etc/hosts" in a container)
+    for (Mount& seen : mounts) {
+        if (seen.deviceId == m.deviceId && seen.kind != Kind::Network) {
+            if (m.mountPoint.size() < seen.mountPoint.size()) seen = m;
+            return;
+        }
+    }
+    mounts.push_back(m);
+}
+
+void MountTable::MountinfoParser::feed(const char* data, size_t length) {
+    const char* p = data;
+    const char* end = data + length;
+
+    // Finish the line the previous chunk cut off
+    if (!partial.empty()) {
+        const char* newline = static_cast<const char*>(memchr(p, '\n', length));
+        if (!newline) {
+            partial.append(p, length);
+            return;
+        }
+        partial.append(p, newline);
+        line(partial.data(), partial.data() + partial.size());
+        partial.clear();
+        p = newline + 1;
+    }
+
+    while (p < end) {
+        const char* newline = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!newline) {
+            partial.assign(p, end);
+            return;
+        }
+        line(p, newline);
+        p = newline + 1;
+    }
+}
+
+std::vector<MountTable::Mount> MountTable::MountinfoParser::finish() {
+    if (!partial.empty()) {
+        line(partial.data(), partial.data() + partial.size());
+        partial.clear();
+    }
+    std::vector<Mount> out;
+    out.swap(mounts);
+    return out;
+}
+
+
+// ---------------- Listing ----------------
+
+#ifdef _WIN32
+
+std::vector<MountTable::Mount> MountTable::list() {
+    PROFILE_SCOPE("MountTable::list");
+    std::vector<Mount> mounts;
+
+    DWORD mask = GetLogicalDrives();
+    if (mask == 0) {
+        // Same fallback StorageInfo always had
+        char buffer[256] = {};
+        DWORD length = GetLogicalDriveStringsA(sizeof(buffer), buffer);
+        for (const char* drive = buffer; length > 0 && *drive; drive += strlen(drive) + 1) {
+            if (drive[0] >= 'A' && drive[0] <= 'Z') mask |= 1u << (drive[0] - 'A');
+        }
+    }
+    if (mask == 0) mask = (1u << ('C' - 'A')) | (1u << ('D' - 'A'));
+
+    for (int i = 0; i < 26; ++i) {
+        if (!(mask & (1u << i))) continue;
+        Mount m;
+        m.device = std::string(1, static_cast<char>('A' + i)) + ":";
+        m.mountPoint = m.device + "\\";
+
+        switch (GetDriveTypeA(m.mountPoint.c_str())) {
+            case DRIVE_NO_ROOT_DIR:
+            case DRIVE_UNKNOWN:   continue;
+            case DRIVE_FIXED:     m.kind = Kind::Local; break;
+            case DRIVE_REMOVABLE: m.kind = Kind::Removable; break;
+            case DRIVE_REMOTE:    m.kind = Kind::Network; break;
+            default:              m.kind = Kind::Other; break;    // CD-ROM, RAM disk
+        }
+        mounts.push_back(m);
+    }
+    return mounts;
+}
+
+#else
+
+std::vector<MountTable::Mount> MountTable::list() {
+    PROFILE_SCOPE("MountTable::list");
+    MountinfoParser parser;
+
+    // Streamed: never holds more than one chunk plus a partial line,
+    // however many mounts a container host has
+    int fd = open("/proc/self/mountinfo", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return parser.finish();
+    char chunk[16384];
+    for (;;) {
+        ssize_t got = read(fd, chunk, sizeof(chunk));
+        if (got <= 0) break;
+        parser.feed(chunk, static_cast<size_t>(got));
+    }
+    close(fd);
+
+    std::vector<Mount> mounts = parser.finish();
+
+    // Removable: USB sticks and card readers, from the whole disk's sysfs flag
+    for (Mount& m : mounts) {
+        if (m.kind != Kind::Local || m.deviceId.empty()) continue;
+        const char* const paths[] = { "/removable", "/../removable" };
+        for (const char* path : paths) {
+            int flag = open(("/sys/dev/block/" + m.deviceId + path).c_str(), O_RDONLY | O_CLOEXEC);
+            if (flag < 0) continue;
+            char c = '0';
+            if (read(flag, &c, 1) == 1 && c == '1') m.kind = Kind::Removable;
+            close(flag);
+            break;
+        }
+    }
+    return mounts;
+}
+
+#endif
+
+
+// ---------------- Probing ----------------
+
+namespace {
+
+    // One capacity call; this is what may never return
+    void statMount(MountTable::Mount& m) {
+#ifdef _WIN32
+        ULARGE_INTEGER avail, total, totalFree;
+        if (!GetDiskFreeSpaceExA(m.mountPoint.c_str(), &avail, &total, &totalFree)) {
+            m.state = MountTable::State::Failed;
+            return;
+        }
+        m.totalBytes = total.QuadPart;
+        m.freeBytes = totalFree.QuadPart;
+        m.availBytes = avail.QuadPart;
+
+        char fsName[MAX_PATH] = {};
+        if (GetVolumeInformationA(m.mountPoint.c_str(), nullptr, 0, nullptr, nullptr, nullptr, fsName, sizeof(fsName))) {
+            m.fsType = fsName;
+        }
+#else
+        struct statvfs vfs;
+        if (statvfs(m.mountPoint.c_str(), &vfs) != 0) {
+            m.state = MountTable::State::Failed;
+            return;
+        }
+        uint64_t unit = vfs.f_frsize ? vfs.f_frsize : vfs.f_bsize;
+        m.totalBytes = static_cast<uint64_t>(vfs.f_blocks) * unit;
+        m.freeBytes = static_cast<uint64_t>(vfs.f_bfree) * unit;
+        m.availBytes = static_cast<uint64_t>(vfs.f_bavail) * unit;
+#endif
+        m.state = MountTable::State::Ok;
+    }
+
+    enum Step { Queued, Running, Done, TimedOut };
+
+    // Shared between probe() and its workers. Workers own a reference, so a
+    // worker that comes back after probe() has given up still has it.
+    struct ProbeJob {
+        std::mutex mtx;
+        std::condition_variable changed;
+        std::vector<MountTable::Mount> mounts;
+        std::vector<Step> steps;
+        std::vector<std::chrono::steady_clock::time_point> started;
+        size_t next = 0;        // first Queued index
+        size_t resolved = 0;    // Done + TimedOut
+    };
+
+    // Mount points whose capacity call is still stuck in the kernel, across
+    // probes. Locked after a ProbeJob's mutex, never before.
+    std::mutex hungMutex;
+    std::set<std::string> hungMounts;
+
+    void worker(std::shared_ptr<ProbeJob> job) {
+        for (;;) {
+            size_t i;
+            MountTable::Mount m;
+            {
+                std::lock_guard<std::mutex> lock(job->mtx);
+                while (job->next < job->steps.size() && job->steps[job->next] != Queued) ++job->next;
+                if (job->next == job->steps.size()) return;
+                i = job->next++;
+                job->steps[i] = Running;
+                job->started[i] = std::chrono::steady_clock::now();
+                m = job->mounts[i];
+            }
+
+            statMount(m);
+
+            std::lock_guard<std::mutex> lock(job->mtx);
+            if (job->steps[i] == Running) {
+                job->mounts[i] = m;
+                job->steps[i] = Done;
+                ++job->resolved;
+                job->changed.notify_all();
+            } else {
+                // Too late: probe() already reported it. The mount answers
+                // again, so the next probe may try it.
+                std::lock_guard<std::mutex> hung(hungMutex);
+                hungMounts.erase(m.mountPoint);
+                return;    // probe() started a replacement for this thread
+            }
+        }
+    }
+
+}
+
+void MountTable::probe(std::vector<Mount>& mounts, unsigned timeoutMs) {
+    PROFILE_SCOPE("MountTable::probe");
+    if (mounts.empty()) return;
+
+    auto job = std::make_shared<ProbeJob>();
+    job->mounts = mounts;
+    job->steps.assign(mounts.size(), Queued);
+    job->started.resize(mounts.size());
+
+    std::unique_lock<std::mutex> lock(job->mtx);
+
+    // Still stuck from an earlier probe: don't queue another thread behind it
+    {
+        std::lock_guard<std::mutex> hung(hungMutex);
+        for (size_t i = 0; i < mounts.size(); ++i) {
+            if (hungMounts.count(mounts[i].mountPoint)) {
+                job->mounts[i].state = State::Unresponsive;
+                job->steps[i] = TimedOut;
+                ++job->resolved;
+            }
+        }
+    }
+
+    size_t pending = mounts.size() - job->resolved;
+    size_t workers = (std::min)(static_cast<size_t>(PoolSize), pending);
+    for (size_t w = 0; w < workers; ++w) std::thread(worker, job).detach();
+
+    const auto timeout = std::chrono::milliseconds(timeoutMs);
+    while (job->resolved < mounts.size()) {
+        // Sleep until a worker reports or the oldest running call is due
+        auto now = std::chrono::steady_clock::now();
+        auto wake = now + timeout;
+        for (size_t i = 0; i < mounts.size(); ++i) {
+            if (job->steps[i] == Running) wake = (std::min)(wake, job->started[i] + timeout);
+        }
+        job->changed.wait_until(lock, wake);
+
+        now = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < mounts.size(); ++i) {
+            if (job->steps[i] != Running || now < job->started[i] + timeout) continue;
+            job->mounts[i].state = State::Unresponsive;
+            job->steps[i] = TimedOut;
+            ++job->resolved;
+            {
+                std::lock_guard<std::mutex> hung(hungMutex);
+                hungMounts.insert(job->mounts[i].mountPoint);
+            }
+            // Its worker is gone until the kernel lets go; keep the pool at
+            // full strength for whatever is still queued
+            if (job->resolved < mounts.size()) std::thread(worker, job).detach();
+        }
+    }
+
+    mounts = job->mounts;
+}
+
+std::vector<MountTable::Mount> MountTable::snapshot(unsigned timeoutMs) {
+    std::vector<Mount> mounts = list();
+    probe(mounts, timeoutMs);
+    return mounts;
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: MountTable
+OBJECT: used by StorageInfo::process_storage_info (detailed_storage) and
+        DiskInfo::getAllDiskUsage / getDiskCapacity (compact_disk)
+DESCRIPTION: Storage volumes and their capacity, probed concurrently with a
+             per-mount timeout so a hung network mount can't stall the fetch.
+FUNCTIONS:
+    static std::vector<Mount> snapshot(unsigned timeoutMs)
+        list() then probe().
+
+    static std::vector<Mount> list()
+        Linux: /proc/self/mountinfo streamed through MountinfoParser in 16 KB
+        reads; removable flag from /sys/dev/block/<major:minor>.
+        Windows: drive letters and GetDriveTypeA.
+
+    static void probe(std::vector<Mount>& mounts, unsigned timeoutMs)
+        statvfs (Linux) / GetDiskFreeSpaceExA + GetVolumeInformationA
+        (Windows) on up to PoolSize detached threads. A call running longer
+        than timeoutMs marks its mount Unresponsive; the thread is abandoned
+        (a blocked statvfs can't be cancelled), replaced, and its mount
+        reported Unresponsive by later probes until the call returns.
+
+    MountinfoParser::feed(const char* data, size_t length)
+    MountinfoParser::finish()
+        Incremental mountinfo parser; lines may be split across chunks.
+
+    static bool parseLine(const char* begin, const char* end, Mount& out)
+    static bool isStorage(const Mount& m)
+    static bool isNetworkFs(const std::string& fsType)
+        Per-line parse and filters, checked by tests\MountTableTests.cpp.
+*/
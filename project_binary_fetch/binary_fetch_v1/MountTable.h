@@ -0,0 +1,87 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ ---------------------------------------------------------
+                    MountTable Struct
+ ---------------------------------------------------------
+
+  Every storage volume with its capacity, for StorageInfo
+  (detailed_storage) and DiskInfo (compact_disk), without
+  letting one dead network share stall the fetch.
+
+    Linux   : /proc/self/mountinfo, read in 16 KB chunks and
+              parsed line by line as they arrive (container
+              hosts can have thousands of mounts), pseudo file
+              systems dropped, bind mounts of one device
+              collapsed; then statvfs() per mount
+    Windows : drive letters (GetLogicalDrives), then
+              GetDiskFreeSpaceExA + GetVolumeInformationA per
+              drive
+
+  The capacity calls are the ones that block: statvfs on a hard
+  NFS mount whose server is gone waits forever, and so does
+  GetDiskFreeSpaceExA on a mapped drive. They run on a small
+  pool (PoolSize threads), each with its own timeout; a mount
+  that doesn't answer in time is marked Unresponsive and the
+  fetch moves on. A worker stuck in the kernel is replaced so
+  the remaining mounts still get probed, and its mount is
+  remembered: later probes (--watch) report it unresponsive
+  straight away instead of piling more threads onto it, until
+  the stuck call finally returns.
+*/
+struct MountTable {
+    static const unsigned DefaultTimeoutMs = 1000;    // per mount
+    static const unsigned PoolSize = 4;
+
+    enum class Kind { Local, Removable, Network, Other };
+    enum class State { Pending, Ok, Failed, Unresponsive };
+
+    struct Mount {
+        std::string device;        // "/dev/nvme0n1p2", "nas:/export", "C:"
+        std::string mountPoint;    // "/home", "C:\\"
+        std::string fsType;        // "ext4", "nfs4", "NTFS" (Windows: filled by the probe)
+        std::string deviceId;      // "259:2" (Linux major:minor, for sysfs lookups)
+        Kind kind = Kind::Local;
+        State state = State::Pending;
+        uint64_t totalBytes = 0;
+        uint64_t freeBytes = 0;    // free for root / the volume as a whole
+        uint64_t availBytes = 0;   // free for the calling user
+    };
+
+    // Listed and probed, in mount order
+    static std::vector<Mount> snapshot(unsigned timeoutMs = DefaultTimeoutMs);
+
+    // Storage mounts only (no capacity yet)
+    static std::vector<Mount> list();
+
+    // Fill capacity / state of every mount, concurrently, timeoutMs each
+    static void probe(std::vector<Mount>& mounts, unsigned timeoutMs);
+
+    // ---- /proc/self/mountinfo (public so the tests can feed recorded text) ----
+
+    // Incremental: feed() chunks of any size, finish() once at the end.
+    // Keeps storage mounts only, one per device (the shortest mount point).
+    class MountinfoParser {
+    public:
+        void feed(const char* data, size_t length);
+        std::vector<Mount> finish();
+    private:
+        void line(const char* begin, const char* end);
+        std::string partial;       // a line cut by the chunk boundary
+        std::vector<Mount> mounts;
+    };
+
+    // One mountinfo line -> out (octal escapes decoded). false if malformed.
+    static bool parseLine(const char* begin, const char* end, Mount& out);
+
+    // Real storage rather than proc / sysfs / tmpfs / cgroup / squashfs ...
+    static bool isStorage(const Mount& m);
+
+    // "nfs4", "cifs", "fuse.sshfs" ...
+    static bool isNetworkFs(const std::string& fsType);
+};
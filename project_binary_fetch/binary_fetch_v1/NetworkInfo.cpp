@@ -1,4 +1,5 @@
 ﻿#include "NetworkInfo.h"
+#include "Profiler.h"
 #include <WinSock2.h>
 #include <iphlpapi.h>
 #include <WS2tcpip.h>
@@ -27,6 +28,7 @@ using namespace std::chrono;
 //-----------------------------------------get_local_ip--------------------------------//
 string NetworkInfo::get_local_ip()
 {
+	PROFILE_SCOPE("NetworkInfo::get_local_ip");
 	string result = "Unknown";
 
 	WSADATA wsa_data;
@@ -71,6 +73,7 @@ string NetworkInfo::get_local_ip()
 //-----------------------------------------get_mac_address--------------------------------//
 string NetworkInfo::get_mac_address()
 {
+	PROFILE_SCOPE("NetworkInfo::get_mac_address");
 	string mac = "Unknown";
 	ULONG out_buf_len = 15000;
 	PIP_ADAPTER_ADDRESSES adapter_addresses = (IP_ADAPTER_ADDRESSES*)malloc(out_buf_len);
@@ -99,6 +102,7 @@ string NetworkInfo::get_mac_address()
 //-----------------------------------------get_locale--------------------------------//
 string NetworkInfo::get_locale()
 {
+	PROFILE_SCOPE("NetworkInfo::get_locale");
 	WCHAR locale_name[LOCALE_NAME_MAX_LENGTH];
 	if (GetUserDefaultLocaleName(locale_name, LOCALE_NAME_MAX_LENGTH))
 	{
@@ -112,6 +116,7 @@ string NetworkInfo::get_locale()
 //-----------------------------------------get_network_name--------------------------------//
 string NetworkInfo::get_network_name()
 {
+	PROFILE_SCOPE("NetworkInfo::get_network_name");
 	string ssid_str = "Unknown";
 	HANDLE hClient = NULL;
 	DWORD dwMaxClient = 2;
@@ -155,6 +160,7 @@ string NetworkInfo::get_network_name()
 //-----------------------------------------get_public_ip--------------------------------//
 string NetworkInfo::get_public_ip()
 {
+	PROFILE_SCOPE("NetworkInfo::get_public_ip");
 	string public_ip = "Unknown";
 
 	HINTERNET hSession = WinHttpOpen(L"NetworkInfo/1.0", WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
@@ -201,7 +207,7 @@ string NetworkInfo::get_public_ip()
 }
 
 //-----------------------------------------HELPER: Format Speed--------------------------------//
-static string format_speed(double mbps)
+string NetworkInfo::format_speed(double mbps)
 {
 	ostringstream oss;
 	if (mbps >= 1000.0)
@@ -227,6 +233,7 @@ static string format_speed(double mbps)
  */
 string NetworkInfo::get_network_download_speed()
 {
+	PROFILE_SCOPE("NetworkInfo::get_network_download_speed");
 	string speed_str = "Unknown";
 
 	// Fast test: Download ~1MB file from cloudflare CDN (very fast servers)
@@ -319,6 +326,7 @@ string NetworkInfo::get_network_download_speed()
  */
 string NetworkInfo::get_network_upload_speed()
 {
+	PROFILE_SCOPE("NetworkInfo::get_network_upload_speed");
 	string speed_str = "Unknown";
 
 	HINTERNET hSession = WinHttpOpen(L"SpeedTest/1.0",
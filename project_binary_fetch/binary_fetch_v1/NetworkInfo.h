@@ -11,4 +11,6 @@ public:
 	string get_network_upload_speed(); //Rturns connected network's upload speed
 	string get_network_download_speed();//Returns connected network's download speed
 	string get_public_ip();     //Returns public ip (if it's available)
+
+	static string format_speed(double mbps); //Mbps -> "45.3 Mbps" / "1.2 Gbps" / "850 Kbps"
 };  
\ No newline at end of file
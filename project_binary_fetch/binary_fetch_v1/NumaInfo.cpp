@@ -0,0 +1,186 @@
+#include "NumaInfo.h"
+#include "Profiler.h"
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include "SystemQuery.h"
+#endif
+
+
+double NumaInfo::Node::freePercent() const {
+    if (totalBytes == 0) return -1.0;
+    return 100.0 * static_cast<double>(freeBytes) / static_cast<double>(totalBytes);
+}
+
+bool NumaInfo::Node::starved() const {
+    double percent = freePercent();
+    return percent >= 0.0 && percent < StarvedPercent;
+}
+
+
+// ---------------- Parsers ----------------
+
+// Call fn(first, last) for every range of a sysfs list ("0-3,8" -> (0,3), (8,8))
+template <typename Fn>
+static void forEachRange(const char* p, const char* end, Fn fn) {
+    while (p < end) {
+        if (*p < '0' || *p > '9') { ++p; continue; }
+        unsigned first = 0;
+        while (p < end && *p >= '0' && *p <= '9') first = first * 10 + static_cast<unsigned>(*p++ - '0');
+        unsigned last = first;
+        if (p < end && *p == '-') {
+            ++p;
+            last = 0;
+            while (p < end && *p >= '0' && *p <= '9') last = last * 10 + static_cast<unsigned>(*p++ - '0');
+        }
+        if (last >= first) fn(first, last);
+    }
+}
+
+int NumaInfo::countCpus(const char* text, size_t length) {
+    int cpus = 0;
+    forEachRange(text, text + length, [&](unsigned first, unsigned last) { cpus += static_cast<int>(last - first + 1); });
+    return cpus;
+}
+
+bool NumaInfo::parseNodeMeminfo(const char* text, size_t length, uint64_t& totalBytes, uint64_t& freeBytes) {
+    const char* p = text;
+    const char* end = text + length;
+    bool haveTotal = false, haveFree = false;
+
+    while (p < end && !(haveTotal && haveFree)) {
+        // "Node 0 MemTotal:       65755612 kB": key starts after the second space run
+        const char* eol = p;
+        while (eol < end && *eol != '\n') ++eol;
+
+        const char* key = p;
+        for (int field = 0; field < 2 && key < eol; ++field) {
+            while (key < eol && *key != ' ') ++key;
+            while (key < eol && *key == ' ') ++key;
+        }
+        const char* colon = key;
+        while (colon < eol && *colon != ':') ++colon;
+
+        size_t keyLength = static_cast<size_t>(colon - key);
+        uint64_t* target = nullptr;
+        if (keyLength == 8 && std::memcmp(key, "MemTotal", 8) == 0) target = &totalBytes;
+        else if (keyLength == 7 && std::memcmp(key, "MemFree", 7) == 0) target = &freeBytes;
+
+        if (target && colon < eol) {
+            const char* v = colon + 1;
+            while (v < eol && *v == ' ') ++v;
+            uint64_t kb = 0;
+            while (v < eol && *v >= '0' && *v <= '9') kb = kb * 10 + static_cast<uint64_t>(*v++ - '0');
+            *target = kb * 1024;
+            if (target == &totalBytes) haveTotal = true;
+            else haveFree = true;
+        }
+        p = eol < end ? eol + 1 : end;
+    }
+    return haveTotal && haveFree;
+}
+
+size_t NumaInfo::parseDistance(const char* text, size_t length, std::vector<int>& out) {
+    const char* p = text;
+    const char* end = text + length;
+    size_t read = 0;
+    while (p < end) {
+        if (*p < '0' || *p > '9') { ++p; continue; }
+        int value = 0;
+        while (p < end && *p >= '0' && *p <= '9') value = value * 10 + (*p++ - '0');
+        out.push_back(value);
+        ++read;
+    }
+    return read;
+}
+
+
+// ---------------- Backends ----------------
+
+#ifdef _WIN32
+
+NumaInfo::Topology NumaInfo::snapshot() {
+    PROFILE_SCOPE("NumaInfo::snapshot");
+    Topology t;
+    ULONG highest = 0;
+    if (!GetNumaHighestNodeNumber(&highest)) return t;
+
+    for (USHORT id = 0; id <= highest; ++id) {
+        GROUP_AFFINITY affinity = {};
+        if (!GetNumaNodeProcessorMaskEx(id, &affinity)) continue;
+
+        Node node;
+        node.id = id;
+        for (KAFFINITY mask = affinity.Mask; mask; mask &= mask - 1) node.cpus++;
+
+        ULONGLONG available = 0;
+        if (GetNumaAvailableMemoryNodeEx(id, &available)) node.freeBytes = available;
+
+        // A node with neither CPUs nor memory is a hole in the numbering
+        if (node.cpus > 0 || node.freeBytes > 0) t.nodes.push_back(node);
+    }
+    return t;
+}
+
+#else
+
+NumaInfo::Topology NumaInfo::snapshot() {
+    PROFILE_SCOPE("NumaInfo::snapshot");
+    Topology t;
+    SystemQuery& query = SystemQuery::instance();
+
+    std::string online = query.readFile("/sys/devices/system/node/online");
+    forEachRange(online.data(), online.data() + online.size(), [&](unsigned first, unsigned last) {
+        for (unsigned id = first; id <= last; ++id) {
+            std::string dir = "/sys/devices/system/node/node" + std::to_string(id) + "/";
+            Node node;
+            node.id = static_cast<int>(id);
+
+            node.cpuList = query.readFile(dir + "cpulist");
+            while (!node.cpuList.empty() && (node.cpuList.back() == '\n' || node.cpuList.back() == ' ')) node.cpuList.pop_back();
+            node.cpus = countCpus(node.cpuList.data(), node.cpuList.size());
+
+            std::string meminfo = query.readFile(dir + "meminfo");
+            parseNodeMeminfo(meminfo.data(), meminfo.size(), node.totalBytes, node.freeBytes);
+
+            std::string distance = query.readFile(dir + "distance");
+            parseDistance(distance.data(), distance.size(), t.distance);
+
+            t.nodes.push_back(std::move(node));
+        }
+    });
+
+    // Every row has one entry per node, or the matrix is unusable
+    if (t.distance.size() != t.nodes.size() * t.nodes.size()) t.distance.clear();
+    return t;
+}
+
+#endif
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: NumaInfo
+OBJECT: numa (main.cpp, "numa_info" section)
+DESCRIPTION: Per node CPUs, total / free memory and node distances.
+FUNCTIONS:
+    Topology snapshot()
+        Linux: node/online, then nodeN/{cpulist,meminfo,distance} via
+        SystemQuery::readFile (descriptors stay open between --watch
+        frames, so a refresh is 3 pread() calls per node).
+        Windows: GetNumaNodeProcessorMaskEx + GetNumaAvailableMemoryNodeEx.
+
+    bool Node::starved()
+        Less than StarvedPercent (10 %) of the node's own memory free.
+
+    static int countCpus(const char* text, size_t length)
+        Sum of (last - first + 1) over the ranges; never expands them.
+
+    static bool parseNodeMeminfo(text, length, totalBytes, freeBytes)
+    static size_t parseDistance(text, length, out)
+        Parsers for the per-node sysfs files.
+*/
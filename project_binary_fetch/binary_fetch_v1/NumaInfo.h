@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ ---------------------------------------------------------
+                     NumaInfo Class
+ ---------------------------------------------------------
+
+  Per NUMA node CPUs and memory plus the node distance
+  matrix, for the "numa_info" section. On a dual-socket box
+  a node that runs out of local memory makes its CPUs pay
+  the remote distance on every miss, which the machine-wide
+  free figure never shows.
+
+    Linux   : /sys/devices/system/node/online, then for each
+              node nodeN/{cpulist,meminfo,distance} through
+              SystemQuery's kept-open descriptors
+    Windows : GetNumaNodeProcessorMaskEx (the node's processor
+              group) and GetNumaAvailableMemoryNodeEx; no
+              per-node total or distance, those stay 0 / empty
+
+  cpulist is kept as the kernel prints it ("0-63,128-191")
+  and CPUs are counted range by range, so a node with
+  thousands of CPUs never gets expanded into a list.
+*/
+class NumaInfo {
+public:
+    // Below this share of its own memory free, a node is flagged as starved
+    static constexpr double StarvedPercent = 10.0;
+
+    struct Node {
+        int id = 0;
+        std::string cpuList;          // sysfs list form, "" if unknown
+        int cpus = 0;
+        uint64_t totalBytes = 0;      // 0 = unknown (Windows)
+        uint64_t freeBytes = 0;
+
+        // Share of this node's memory that is free, -1 if the total is unknown
+        double freePercent() const;
+        bool starved() const;
+    };
+
+    struct Topology {
+        std::vector<Node> nodes;      // in node id order
+        std::vector<int> distance;    // nodes.size()^2, row-major; empty if unknown
+    };
+
+    // Every online node in one pass
+    Topology snapshot();
+
+    // ---- parsers (public so the tests can run them on fixtures) ----
+
+    // CPUs in a sysfs list ("0-3,8,10-11" -> 7), summed range by range
+    static int countCpus(const char* text, size_t length);
+
+    // "Node 0 MemTotal: 65755612 kB" / "MemFree" lines of nodeN/meminfo -> bytes.
+    // false if either line is missing.
+    static bool parseNodeMeminfo(const char* text, size_t length, uint64_t& totalBytes, uint64_t& freeBytes);
+
+    // "10 21" -> appended to out; returns the number of values read
+    static size_t parseDistance(const char* text, size_t length, std::vector<int>& out);
+};
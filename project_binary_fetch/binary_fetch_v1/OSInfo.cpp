@@ -1,16 +1,17 @@
 #include "OSInfo.h"
+#include "StaticFactsCache.h"
+#include "Profiler.h"
+#include "SystemQuery.h"
 #include <Windows.h>
 #include <VersionHelpers.h>
-#include <comdef.h>
-#include <Wbemidl.h>
 #include <winreg.h>
 #include <tchar.h>
-#pragma comment(lib, "wbemuuid.lib")
 
 // Get Windows version using RtlGetVersion----------------------------------------------------------------------------------
 typedef LONG(WINAPI* RtlGetVersionPtr)(PRTL_OSVERSIONINFOW);
 
 std::string OSInfo::GetOSVersion() {
+    PROFILE_SCOPE("OSInfo::GetOSVersion");
     HMODULE hMod = GetModuleHandleW(L"ntdll.dll");
     if (hMod) {
         RtlGetVersionPtr fn = (RtlGetVersionPtr)GetProcAddress(hMod, "RtlGetVersion");
@@ -29,6 +30,7 @@ std::string OSInfo::GetOSVersion() {
 
 // Get 32-bit or 64-bit architecture------------------------------------------------------------------------------------
 std::string OSInfo::GetOSArchitecture() {
+    PROFILE_SCOPE("OSInfo::GetOSArchitecture");
     BOOL is64bitOS = FALSE;
 #ifdef _WIN64
     is64bitOS = TRUE; // 64-bit program on 64-bit Windows
@@ -42,126 +44,31 @@ std::string OSInfo::GetOSArchitecture() {
     return is64bitOS ? "64-bit" : "32-bit";
 }
 
+// Caption, SerialNumber and InstallDate come from one Win32_OperatingSystem
+// query, shared by the three getters below
+static QueryRow operatingSystemRow() {
+    std::vector<QueryRow> os = SystemQuery::instance().cachedRows("Win32_OperatingSystem",
+        { "Caption", "SerialNumber", "InstallDate" });
+    return os.empty() ? QueryRow() : os[0];
+}
+
 // Get Windows edition (Home, Pro, Enterprise) via WMI--------------------------------------------------------------------------
 std::string OSInfo::GetOSName() {
-    HRESULT hres;
-
-    // Initialize COM
-    hres = CoInitializeEx(0, COINIT_MULTITHREADED);
-    if (FAILED(hres)) return "Unknown Edition";
-
-    // Initialize WMI
-    hres = CoInitializeSecurity(NULL, -1, NULL, NULL,
-        RPC_C_AUTHN_LEVEL_DEFAULT, RPC_C_IMP_LEVEL_IMPERSONATE,
-        NULL, EOAC_NONE, NULL);
-    if (FAILED(hres)) return "Unknown Edition";
-
-    IWbemLocator* pLoc = NULL;
-    hres = CoCreateInstance(CLSID_WbemLocator, 0, CLSCTX_INPROC_SERVER,
-        IID_IWbemLocator, (LPVOID*)&pLoc);
-    if (FAILED(hres)) return "Unknown Edition";
-
-    IWbemServices* pSvc = NULL;
-    hres = pLoc->ConnectServer(
-        _bstr_t(L"ROOT\\CIMV2"), NULL, NULL, 0,
-        NULL, 0, 0, &pSvc);
-    if (FAILED(hres)) {
-        pLoc->Release();
-        return "Unknown Edition";
-    }
-
-    hres = CoSetProxyBlanket(
-        pSvc, RPC_C_AUTHN_WINNT, RPC_C_AUTHZ_NONE, NULL,
-        RPC_C_AUTHN_LEVEL_CALL, RPC_C_IMP_LEVEL_IMPERSONATE,
-        NULL, EOAC_NONE);
-    if (FAILED(hres)) {
-        pSvc->Release();
-        pLoc->Release();
-        return "Unknown Edition";
-    }
-
-    IEnumWbemClassObject* pEnumerator = NULL;
-    hres = pSvc->ExecQuery(
-        bstr_t("WQL"),
-        bstr_t("SELECT Caption FROM Win32_OperatingSystem"),
-        WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY,
-        NULL,
-        &pEnumerator);
-    if (FAILED(hres)) {
-        pSvc->Release();
-        pLoc->Release();
-        return "Unknown Edition";
-    }
-
-    IWbemClassObject* pclsObj = NULL;
-    ULONG uReturn = 0;
-    std::string osName = "Unknown Edition";
-
-    if (pEnumerator) {
-        if (pEnumerator->Next(WBEM_INFINITE, 1, &pclsObj, &uReturn) == S_OK) {
-            VARIANT vtProp;
-            if (SUCCEEDED(pclsObj->Get(L"Caption", 0, &vtProp, 0, 0))) {
-                _bstr_t bstrOS(vtProp.bstrVal);
-                osName = std::string((char*)bstrOS);
-            }
-            VariantClear(&vtProp);
-            pclsObj->Release();
-        }
-        pEnumerator->Release();
-    }
-
-    pSvc->Release();
-    pLoc->Release();
-    CoUninitialize();
-
-    return osName;
+    PROFILE_SCOPE("OSInfo::GetOSName");
+    return operatingSystemRow().text("Caption", "Unknown Edition");
 }
 //function to get os serial number-----------------------------------------------------------------------------------------
 std::string OSInfo::get_os_serial_number()
 {
-    std::string serial_number = "Unknown"; //initially it's unknown
-
-    if (FAILED(CoInitializeEx(0, COINIT_MULTITHREADED)))
-        return serial_number;
-    CoInitializeSecurity(NULL, -1, NULL, NULL,
-        RPC_C_AUTHN_LEVEL_DEFAULT, RPC_C_IMP_LEVEL_IMPERSONATE,
-        NULL, EOAC_NONE, NULL);
-
-    IWbemLocator* locator = nullptr;
-    CoCreateInstance(CLSID_WbemLocator, 0, CLSCTX_INPROC_SERVER,
-        IID_IWbemLocator, (LPVOID*)&locator);
-
-    IWbemServices* service = nullptr;
-    locator->ConnectServer (_bstr_t(L"ROOT\\CIMV2"), NULL, NULL, 0, NULL, 0, 0, &service);
-    CoSetProxyBlanket(service, RPC_C_AUTHN_WINNT, RPC_C_AUTHZ_NONE, NULL,
-        RPC_C_AUTHN_LEVEL_CALL, RPC_C_IMP_LEVEL_IMPERSONATE, NULL, EOAC_NONE);
-
-    IEnumWbemClassObject* enumerator = nullptr;
-    service->ExecQuery(bstr_t("WQL"),
-        bstr_t("SELECT SerialNumber FROM Win32_OperatingSystem"),
-        WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY,
-        NULL, &enumerator);
-
-    IWbemClassObject* obj = nullptr;
-    ULONG ret = 0;
-    if (enumerator && enumerator->Next(WBEM_INFINITE, 1, &obj, &ret) == S_OK)
-    {
-        VARIANT vtProp;
-        obj->Get(L"SerialNumber", 0, &vtProp, 0, 0);
-        _bstr_t bstr(vtProp.bstrVal);
-        VariantClear(&vtProp);
-        obj->Release();
-    }
-
-    if (enumerator) enumerator->Release();
-    service->Release();
-    locator->Release();
-
-    return serial_number;
+    PROFILE_SCOPE("OSInfo::get_os_serial_number");
+    return StaticFactsCache::instance().getOrCompute("os.serial", []() -> std::string {
+        return operatingSystemRow().text("SerialNumber");
+    });
 }
 // function to show os uptime----------------------------------------------------------------------------------------------
 std::string OSInfo::get_os_uptime()
 {
+    PROFILE_SCOPE("OSInfo::get_os_uptime");
     // Get the number of milliseconds since the system started
     ULONGLONG ms = GetTickCount64();
 
@@ -217,81 +124,19 @@ std::string OSInfo::get_os_uptime()
 //function to get os install date-------------------------------------------------------------------------------------------
 std::string OSInfo::get_os_install_date()
 {
-    HRESULT hres;
-    hres = CoInitializeEx(0, COINITBASE_MULTITHREADED);
-    if (FAILED(hres)) return "Unknown";
-
-    hres = CoInitializeSecurity(
-        NULL,                     // Security descriptor
-        -1,                       // Count of authentication services
-        NULL,                     // Authentication services
-        NULL,                     // Reserved
-        RPC_C_AUTHN_LEVEL_DEFAULT,// Authentication level
-        RPC_C_IMP_LEVEL_IMPERSONATE, // Impersonation level
-        NULL,                     // Authentication list
-        EOAC_NONE,                // Capabilities
-        NULL                      // Reserved
-
-        );
-    if (FAILED(hres)) return "Unknown";
-
-    IWbemLocator* pLoc = NULL;
-    hres = CoCreateInstance(CLSID_WbemLocator, 0, CLSCTX_INPROC_SERVER, IID_IWbemLocator, (LPVOID*)&pLoc);
-    if (FAILED(hres)) return "Unknown";
-
-    IWbemServices* pSvc = NULL;
-    hres = pLoc->ConnectServer(
-        _bstr_t(L"ROOT\\CIMV2"),  // Namespace
-        NULL,                      // User
-        NULL,                      // Password
-        NULL,                      // Locale
-        0,                         // Security flags
-        NULL,                      // Authority
-        NULL,                      // Context
-        &pSvc                      // IWbemServices pointer
-    );
-    if (FAILED(hres)) { pLoc->Release(); return "Unknown"; }
-
-    CoSetProxyBlanket(pSvc, RPC_C_AUTHN_WINNT, RPC_C_AUTHZ_NONE, NULL, RPC_C_AUTHN_LEVEL_CALL, RPC_C_IMP_LEVEL_IMPERSONATE,
-        NULL, EOAC_NONE);
-
-    IEnumWbemClassObject* pEnumerator = NULL;
-    hres = pSvc->ExecQuery(
-        bstr_t("WQL"),
-        bstr_t("SELECT InstallDate FROM Win32_OperatingSystem"),
-        WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY,
-        NULL, &pEnumerator);
-    if (FAILED(hres)) { pSvc->Release(); pLoc->Release(); return "Unknown"; }
-
-    IWbemClassObject* pclsObj = NULL;
-    ULONG uReturn = 0;
-    std::string installDate = "Unknown";
-
-    if (pEnumerator && pEnumerator->Next(WBEM_INFINITE, 1, &pclsObj, &uReturn) == S_OK) {
-        VARIANT vtProp;
-        if (SUCCEEDED(pclsObj->Get(L"InstallDate", 0, &vtProp, 0, 0))) {
-            // Convert WMI datetime string to readable format YYYY-MM-DD
-            std::wstring wstr(vtProp.bstrVal, SysStringLen(vtProp.bstrVal));
-            installDate = std::string(wstr.begin(), wstr.begin() + 4) + "-" +  // Year
-                std::string(wstr.begin() + 4, wstr.begin() + 6) + "-" + // Month
-                std::string(wstr.begin() + 6, wstr.begin() + 8);        // Day
-        }
-        VariantClear(&vtProp);
-        pclsObj->Release();
-    }
-
-    if (pEnumerator) pEnumerator->Release();
-    pSvc->Release();
-    pLoc->Release();
-    CoUninitialize();
-
-    return installDate;
-
+    PROFILE_SCOPE("OSInfo::get_os_install_date");
+    return StaticFactsCache::instance().getOrCompute("os.install_date", []() -> std::string {
+        // WMI datetime "20230514093012.000000+300" -> YYYY-MM-DD
+        std::string stamp = operatingSystemRow().text("InstallDate", "");
+        if (stamp.size() < 8) return "Unknown";
+        return stamp.substr(0, 4) + "-" + stamp.substr(4, 2) + "-" + stamp.substr(6, 2);
+    });
 }
 
 //get os kernel version (major.major.build)
 std::string OSInfo::get_os_kernel_info()
 {
+    PROFILE_SCOPE("OSInfo::get_os_kernel_info");
     std::string result = "WIN32_NT "; // platform prefix
 
     // Step 1: Get Major.Minor.Build
@@ -0,0 +1,197 @@
+#include "PressureInfo.h"
+#include "Profiler.h"
+#include "SystemQuery.h"
+#include "CpuSampler.h"
+
+#include <string>
+#include <sstream>
+#include <iomanip>
+
+
+// ---------------- Parsers ----------------
+
+// "12.34" at p (no sign / exponent, as the kernel prints them). Sets ok = false
+// if there is no digit. Locale independent, unlike strtod.
+static const char* parseDecimal(const char* p, const char* end, float& out, bool& ok) {
+    double value = 0.0;
+    bool digits = false;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10.0 + (*p++ - '0');
+        digits = true;
+    }
+    if (p < end && *p == '.') {
+        double scale = 0.1;
+        for (++p; p < end && *p >= '0' && *p <= '9'; ++p, scale *= 0.1) {
+            value += (*p - '0') * scale;
+            digits = true;
+        }
+    }
+    ok = digits;
+    out = static_cast<float>(value);
+    return p;
+}
+
+bool PressureInfo::parseStall(const char* text, size_t length, Stall& out) {
+    const char* p = text;
+    const char* end = text + length;
+    bool some = false;
+
+    while (p < end) {
+        // Line kind, then "avg10=" and "avg60=" in their fixed order
+        bool isSome = end - p >= 4 && p[0] == 's' && p[1] == 'o' && p[2] == 'm' && p[3] == 'e';
+        bool isFull = end - p >= 4 && p[0] == 'f' && p[1] == 'u' && p[2] == 'l' && p[3] == 'l';
+        float avg10 = -1.0f, avg60 = -1.0f;
+        bool ok10 = false, ok60 = false;
+
+        while (p < end && *p != '\n') {
+            if (end - p > 6 && p[0] == 'a' && p[1] == 'v' && p[2] == 'g' && p[3] == '1' && p[4] == '0' && p[5] == '=') {
+                p = parseDecimal(p + 6, end, avg10, ok10);
+            }
+            else if (end - p > 6 && p[0] == 'a' && p[1] == 'v' && p[2] == 'g' && p[3] == '6' && p[4] == '0' && p[5] == '=') {
+                p = parseDecimal(p + 6, end, avg60, ok60);
+            }
+            else {
+                ++p;
+            }
+        }
+        if (p < end) ++p;
+
+        if (isSome && ok10 && ok60) {
+            out.someAvg10 = avg10;
+            out.someAvg60 = avg60;
+            some = true;
+        }
+        else if (isFull && ok10 && ok60) {
+            out.fullAvg10 = avg10;
+            out.fullAvg60 = avg60;
+        }
+    }
+    return some;
+}
+
+bool PressureInfo::parseLoadavg(const char* text, size_t length, Load& out) {
+    const char* p = text;
+    const char* end = text + length;
+    float avg[3];
+    for (float& a : avg) {
+        bool ok = false;
+        while (p < end && *p == ' ') ++p;
+        p = parseDecimal(p, end, a, ok);
+        if (!ok) return false;
+    }
+
+    // "running/total"
+    while (p < end && *p == ' ') ++p;
+    int running = 0, total = 0;
+    const char* start = p;
+    while (p < end && *p >= '0' && *p <= '9') running = running * 10 + (*p++ - '0');
+    if (p == start || p >= end || *p != '/') return false;
+    for (++p, start = p; p < end && *p >= '0' && *p <= '9'; ++p) total = total * 10 + (*p - '0');
+    if (p == start) return false;
+
+    out.avg1 = avg[0];
+    out.avg5 = avg[1];
+    out.avg15 = avg[2];
+    out.running = running;
+    out.total = total;
+    return true;
+}
+
+
+// ---------------- Formatting ----------------
+
+// some avg10/avg60 [full avg10/avg60], in percent of wall time
+static std::string stallText(const PressureInfo::Stall& st, bool full) {
+    std::ostringstream v;
+    v << std::fixed << std::setprecision(1) << st.someAvg10 << "/" << st.someAvg60;
+    if (full && st.fullAvg10 >= 0.0f) v << " full " << st.fullAvg10 << "/" << st.fullAvg60;
+    return v.str();
+}
+
+std::vector<PressureInfo::Field> PressureInfo::fields(const Snapshot& s, bool full) {
+    std::vector<Field> out;
+    if (s.cpu.someAvg10 >= 0.0f) out.push_back({ "cpu", "CPU", stallText(s.cpu, false) });
+    if (s.memory.someAvg10 >= 0.0f) out.push_back({ "memory", "MEM", stallText(s.memory, full) });
+    if (s.io.someAvg10 >= 0.0f) out.push_back({ "io", "IO", stallText(s.io, full) });
+
+    std::ostringstream load;
+    load << std::fixed << std::setprecision(2);
+    if (s.load.avg1 >= 0.0f) load << s.load.avg1 << " " << s.load.avg5 << " " << s.load.avg15 << " ";
+    if (s.load.running >= 0) load << "run " << s.load.running;
+    if (!load.str().empty()) out.push_back({ "load", "Load", load.str() });
+
+    if (s.switchesPerSec >= 0.0) {
+        std::ostringstream v;
+        v << std::fixed << std::setprecision(1);
+        if (s.switchesPerSec >= 1000.0) v << s.switchesPerSec / 1000.0 << "k/s";
+        else v << std::setprecision(0) << s.switchesPerSec << "/s";
+        out.push_back({ "switches", "Ctx", v.str() });
+    }
+    return out;
+}
+
+
+// ---------------- Backends ----------------
+
+#ifdef _WIN32
+
+PressureInfo::Snapshot PressureInfo::snapshot() {
+    PROFILE_SCOPE("PressureInfo::snapshot");
+    Snapshot s;
+    QueryRow row = SystemQuery::instance().first("Win32_PerfFormattedData_PerfOS_System",
+        { "ProcessorQueueLength", "ContextSwitchesPersec" });
+    s.load.running = static_cast<int>(row.integer("ProcessorQueueLength"));
+    s.switchesPerSec = static_cast<double>(row.integer("ContextSwitchesPersec"));
+    return s;
+}
+
+#else
+
+PressureInfo::Snapshot PressureInfo::snapshot() {
+    PROFILE_SCOPE("PressureInfo::snapshot");
+    Snapshot s;
+    SystemQuery& query = SystemQuery::instance();
+
+    const struct { const char* path; Stall* out; } files[] = {
+        { "/proc/pressure/cpu", &s.cpu },
+        { "/proc/pressure/memory", &s.memory },
+        { "/proc/pressure/io", &s.io },
+    };
+    for (const auto& f : files) {
+        std::string text = query.readFile(f.path);
+        parseStall(text.data(), text.size(), *f.out);
+    }
+
+    std::string loadavg = query.readFile("/proc/loadavg");
+    parseLoadavg(loadavg.data(), loadavg.size(), s.load);
+
+    s.switchesPerSec = CpuSampler::instance().switchRate();
+    return s;
+}
+
+#endif
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: PressureInfo
+OBJECT: pressure (main.cpp, "compact_pressure" section)
+DESCRIPTION: PSI stall averages, load / run queue and context switch rate.
+FUNCTIONS:
+    Snapshot snapshot()
+        Linux: the three /proc/pressure files and /proc/loadavg via
+        SystemQuery::readFile (descriptors stay open between --watch
+        frames), plus CpuSampler::switchRate().
+        Windows: one PerfOS_System row.
+
+    static bool parseStall(const char* text, size_t length, Stall& out)
+        some / full avg10 and avg60 of one /proc/pressure file.
+
+    static bool parseLoadavg(const char* text, size_t length, Load& out)
+        Load averages and running / total tasks of /proc/loadavg.
+
+    static std::vector<Field> fields(const Snapshot& s, bool full)
+        The compact_pressure values as text; unreadable ones are skipped.
+*/
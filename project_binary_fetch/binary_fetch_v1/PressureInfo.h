@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/*
+ ---------------------------------------------------------
+                   PressureInfo Class
+ ---------------------------------------------------------
+
+  Contention rather than utilization, for the
+  "compact_pressure" section: a CPU at 60 % can still have
+  tasks queueing for it, and RAM at 70 % can still stall on
+  reclaim.
+
+    Linux   : /proc/pressure/{cpu,memory,io} (PSI some/full
+              avg10 and avg60), /proc/loadavg (load averages
+              and runnable tasks) through SystemQuery's kept-open
+              descriptors - four pread() calls, a few us
+    Windows : PerfOS_System ProcessorQueueLength and
+              ContextSwitchesPersec (no PSI / load averages)
+
+  The context switch rate is not derived here: CpuSampler
+  already stores the /proc/stat "ctxt" value in its ring with
+  every reading, so a refresh in --watch just compares two
+  ring slots.
+
+  Values that can't be read stay -1 and are left out of the
+  line (kernels without CONFIG_PSI or booted with psi=0).
+
+  fields() turns a snapshot into the section's label / value
+  pairs; main.cpp only picks the enabled ones and colors them.
+*/
+class PressureInfo {
+public:
+    // One PSI file: share of wall time some / all non-idle tasks were stalled
+    struct Stall {
+        float someAvg10 = -1.0f;
+        float someAvg60 = -1.0f;
+        float fullAvg10 = -1.0f;    // cpu "full" is always 0 system-wide
+        float fullAvg60 = -1.0f;
+    };
+
+    struct Load {
+        float avg1 = -1.0f;
+        float avg5 = -1.0f;
+        float avg15 = -1.0f;
+        int running = -1;           // runnable tasks right now (run queue)
+        int total = -1;             // all tasks (Linux)
+    };
+
+    struct Snapshot {
+        Stall cpu;
+        Stall memory;
+        Stall io;
+        Load load;
+        double switchesPerSec = -1.0;
+    };
+
+    // Everything above in one pass
+    Snapshot snapshot();
+
+    // One compact_pressure field: "CPU" -> "1.2/0.8"
+    struct Field {
+        const char* name;            // config keys show_<name> and <name>_color
+        const char* label;
+        std::string value;
+    };
+
+    // The readable fields of s, in display order. full adds the PSI
+    // "full" averages to memory and io (cpu "full" is always 0).
+    static std::vector<Field> fields(const Snapshot& s, bool full);
+
+    // ---- parsers (public so the tests can run them on fixtures) ----
+
+    // "some avg10=.. avg60=.. avg300=.. total=..\nfull ..." -> Stall. false if no "some" line.
+    static bool parseStall(const char* text, size_t length, Stall& out);
+
+    // "0.52 0.58 0.59 2/1234 5678" -> Load. false if malformed.
+    static bool parseLoadavg(const char* text, size_t length, Load& out);
+};
@@ -0,0 +1,227 @@
+#include "ProcessCounter.h"
+#include "Profiler.h"
+#include "SystemQuery.h"
+
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+const unsigned ProcessCounter::MaxAgeMs;
+
+ProcessCounter& ProcessCounter::instance() {
+    static ProcessCounter counter;
+    return counter;
+}
+
+ProcessCounter::Counts ProcessCounter::counts() {
+    PROFILE_SCOPE("ProcessCounter::counts");
+    std::lock_guard<std::mutex> lock(mtx);
+    auto now = std::chrono::steady_clock::now();
+    if (!taken || now - takenAt > std::chrono::milliseconds(MaxAgeMs)) {
+        last = sample();
+        takenAt = now;
+        taken = true;
+    }
+    return last;
+}
+
+
+// ---------------- Parsers ----------------
+
+long long ProcessCounter::statThreads(const char* text, size_t length) {
+    // "pid (comm) state ppid ..." - comm is free text, so start after the last ')'
+    const char* end = text + length;
+    const char* p = end;
+    while (p > text && p[-1] != ')') --p;
+    if (p == text) return -1;
+
+    // Fields after comm start at 3 (state); num_threads is field 20
+    for (int field = 3; field < 20; ++field) {
+        while (p < end && *p == ' ') ++p;
+        while (p < end && *p != ' ') ++p;
+    }
+    while (p < end && *p == ' ') ++p;
+    if (p >= end || *p < '0' || *p > '9') return -1;
+
+    long long threads = 0;
+    while (p < end && *p >= '0' && *p <= '9') threads = threads * 10 + (*p++ - '0');
+    return threads;
+}
+
+long long ProcessCounter::fileNrHandles(const char* text, size_t length) {
+    const char* end = text + length;
+    const char* p = text;
+    while (p < end && (*p == ' ' || *p == '\t')) ++p;
+    if (p >= end || *p < '0' || *p > '9') return -1;
+
+    long long handles = 0;
+    while (p < end && *p >= '0' && *p <= '9') handles = handles * 10 + (*p++ - '0');
+    return handles;
+}
+
+
+// ---------------- Backends ----------------
+
+#ifdef _WIN32
+
+bool ProcessCounter::listPids(std::vector<int>& pids, std::vector<char>& buffer) {
+    (void)buffer;
+    pids.clear();
+    return false;
+}
+
+ProcessCounter::Counts ProcessCounter::sample() {
+    Counts c;
+    SystemQuery& query = SystemQuery::instance();
+    c.processes = query.first("Win32_PerfFormattedData_PerfOS_System", { "Processes" }).integer("Processes");
+
+    QueryRow total = query.first("Win32_PerfFormattedData_PerfProc_Process", { "ThreadCount", "HandleCount" }, "Name='_Total'");
+    c.threads = total.integer("ThreadCount");
+    c.handles = total.integer("HandleCount");
+    return c;
+}
+
+#else
+
+// Layout of the records getdents64 fills in (glibc has no public declaration)
+struct LinuxDirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[1];
+};
+
+bool ProcessCounter::listPids(std::vector<int>& pids, std::vector<char>& buffer) {
+    pids.clear();
+    int fd = open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    // One call returns ~8k entries; a 50k-process /proc takes a handful
+    if (buffer.size() < 256 * 1024) buffer.resize(256 * 1024);
+    for (;;) {
+        long n = syscall(SYS_getdents64, fd, buffer.data(), buffer.size());
+        if (n <= 0) break;
+
+        for (long offset = 0; offset < n;) {
+            const LinuxDirent64* entry = reinterpret_cast<const LinuxDirent64*>(buffer.data() + offset);
+            offset += entry->d_reclen;
+
+            const char* name = entry->d_name;
+            if (*name < '1' || *name > '9') continue;    // ".", "self", "sys", ...
+            int pid = 0;
+            while (*name >= '0' && *name <= '9') pid = pid * 10 + (*name++ - '0');
+            if (*name == '\0') pids.push_back(pid);
+        }
+    }
+    close(fd);
+    return true;
+}
+
+// The initial PID namespace always has inode PROC_PID_INIT_INO; anywhere else
+// (containers, Kubernetes pods) /proc/loadavg still counts the host's threads.
+static bool inInitialPidNamespace() {
+    char link[64] = { 0 };
+    ssize_t n = readlink("/proc/self/ns/pid", link, sizeof(link) - 1);
+    return n > 0 && std::string(link, static_cast<size_t>(n)) == "pid:[4026531836]";
+}
+
+// Fourth field of /proc/loadavg: "running/total" scheduling entities
+static long long loadavgThreads() {
+    std::string text = SystemQuery::instance().readFile("/proc/loadavg");
+    size_t slash = text.find('/');
+    if (slash == std::string::npos) return -1;
+    return std::atoll(text.c_str() + slash + 1);
+}
+
+// Sum num_threads over every pid, one slice of the list per worker
+static long long statThreadsParallel(const std::vector<int>& pids) {
+    const size_t perWorker = 4096;
+    size_t workers = (std::min)(static_cast<size_t>((std::max)(1u, std::thread::hardware_concurrency())),
+        pids.size() / perWorker + 1);
+    workers = (std::min)(workers, static_cast<size_t>(8));
+
+    std::atomic<long long> total(0);
+    auto scan = [&](size_t begin, size_t end) {
+        long long sum = 0;
+        char path[32];
+        char stat[1024];
+        for (size_t i = begin; i < end; ++i) {
+            snprintf(path, sizeof(path), "/proc/%d/stat", pids[i]);
+            int fd = open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0) continue;                        // exited meanwhile
+            ssize_t n = read(fd, stat, sizeof(stat));
+            close(fd);
+            if (n > 0) {
+                long long threads = ProcessCounter::statThreads(stat, static_cast<size_t>(n));
+                if (threads > 0) sum += threads;
+            }
+        }
+        total += sum;
+    };
+
+    std::vector<std::thread> pool;
+    size_t slice = (pids.size() + workers - 1) / workers;
+    for (size_t w = 1; w < workers; ++w) {
+        size_t begin = w * slice;
+        if (begin < pids.size()) pool.emplace_back(scan, begin, (std::min)(pids.size(), begin + slice));
+    }
+    scan(0, (std::min)(pids.size(), slice));
+    for (auto& t : pool) t.join();
+    return total.load();
+}
+
+ProcessCounter::Counts ProcessCounter::sample() {
+    Counts c;
+    std::vector<int> pids;
+    std::vector<char> buffer;
+    if (listPids(pids, buffer)) c.processes = static_cast<long long>(pids.size());
+
+    if (inInitialPidNamespace()) c.threads = loadavgThreads();
+    if (c.threads < 0 && !pids.empty()) c.threads = statThreadsParallel(pids);
+
+    std::string fileNr = SystemQuery::instance().readFile("/proc/sys/fs/file-nr");
+    c.handles = fileNrHandles(fileNr.data(), fileNr.size());
+    return c;
+}
+
+#endif
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: ProcessCounter (singleton)
+OBJECT: ProcessCounter::instance(), read by CPUInfo::get_process_count,
+        get_thread_count and get_handle_count
+DESCRIPTION: Process / thread / handle totals from one shared sample.
+FUNCTIONS:
+    Counts counts()
+        Cached sample, refreshed when older than MaxAgeMs (500 ms).
+
+    static bool listPids(std::vector<int>& pids, std::vector<char>& buffer)
+        getdents64 over /proc with a 256 KB buffer; numeric names only.
+        Also used by TopProcesses, which keeps both vectors between refreshes.
+
+    static long long statThreads(const char* text, size_t length)
+        Field 20 of /proc/<pid>/stat, parsed from the last ')'.
+
+    static long long fileNrHandles(const char* text, size_t length)
+        Allocated handles from /proc/sys/fs/file-nr.
+
+THREAD COUNT ON LINUX:
+    Initial PID namespace: /proc/loadavg nr_threads (one read).
+    Inside a container: every /proc/<pid>/stat, up to 8 workers with
+    4096+ pids each, so the count matches the processes listed.
+*/
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <mutex>
+#include <chrono>
+
+/*
+ ---------------------------------------------------------
+                  ProcessCounter Class
+ ---------------------------------------------------------
+
+  System-wide process / thread / open handle counts behind
+  CPUInfo::get_process_count, get_thread_count and
+  get_handle_count. The three getters share one sample (taken
+  at most every MaxAgeMs), so asking for all of them costs one
+  scan, not three.
+
+    Windows : PerfOS_System.Processes + the PerfProc_Process
+              "_Total" row (threads and handles in one query)
+    Linux   : /proc walked with raw getdents64 into a 256 KB
+              buffer (only the digit entries are kept);
+              threads from /proc/loadavg (nr_threads) in the
+              initial PID namespace, otherwise from field 20 of
+              every /proc/<pid>/stat, split across threads;
+              handles from /proc/sys/fs/file-nr
+
+  A node with 50k processes costs a handful of getdents64
+  calls instead of 50k opendir/ifstream round trips.
+*/
+class ProcessCounter {
+public:
+    static const unsigned MaxAgeMs = 500;
+
+    struct Counts {
+        long long processes = -1;      // -1 = could not be read
+        long long threads = -1;
+        long long handles = -1;        // Linux: allocated file handles
+    };
+
+    static ProcessCounter& instance();
+
+    // Latest counts (re-sampled when older than MaxAgeMs)
+    Counts counts();
+
+    // ---- Linux scanning pieces (public so the tests can run them on fixtures) ----
+
+    // All numeric entries of /proc, via getdents64. false if /proc can't be opened.
+    // buffer is the getdents64 scratch space, kept by callers that list repeatedly.
+    static bool listPids(std::vector<int>& pids, std::vector<char>& buffer);
+
+    // num_threads (field 20) of one /proc/<pid>/stat line, -1 if malformed.
+    // The comm field may itself contain spaces and ')'.
+    static long long statThreads(const char* text, size_t length);
+
+    // First field of /proc/sys/fs/file-nr ("allocated unused max")
+    static long long fileNrHandles(const char* text, size_t length);
+
+private:
+    ProcessCounter() = default;
+
+    Counts sample();
+
+    std::mutex mtx;
+    Counts last;
+    std::chrono::steady_clock::time_point takenAt;
+    bool taken = false;
+};
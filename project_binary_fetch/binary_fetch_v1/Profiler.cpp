@@ -0,0 +1,154 @@
+#include "Profiler.h"
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <thread>
+#include <algorithm>
+#include <functional>
+
+std::atomic<bool> Profiler::active{ false };
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+void Profiler::enable() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (active.load()) return;
+    origin = std::chrono::steady_clock::now();
+    recorded.reserve(512);
+    active.store(true);
+}
+
+// Caller holds mtx. Thread ids are opaque, so hand out 1, 2, 3... in order of first span.
+uint32_t Profiler::threadNumber() {
+    size_t id = std::hash<std::thread::id>()(std::this_thread::get_id());
+    for (const auto& t : threads) {
+        if (t.first == id) return t.second;
+    }
+    uint32_t number = static_cast<uint32_t>(threads.size()) + 1;
+    threads.push_back({ id, number });
+    return number;
+}
+
+void Profiler::record(std::string name, const char* category,
+    std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    using namespace std::chrono;
+    std::lock_guard<std::mutex> lock(mtx);
+
+    Span s;
+    s.name = std::move(name);
+    s.category = category;
+    s.thread = threadNumber();
+    s.startUs = duration_cast<microseconds>(start - origin).count();
+    s.durationUs = duration_cast<microseconds>(end - start).count();
+    recorded.push_back(std::move(s));
+}
+
+std::vector<Profiler::Span> Profiler::spans() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return recorded;
+}
+
+void Profiler::printTable(std::ostream& out, size_t maxRows) const {
+    struct Row {
+        std::string name;
+        size_t calls = 0;
+        int64_t totalUs = 0;
+        int64_t maxUs = 0;
+    };
+
+    // Sections are already covered by the per-collector rows they contain
+    std::map<std::string, Row> byName;
+    for (const Span& s : spans()) {
+        if (std::string(s.category) == "section") continue;
+        Row& r = byName[s.name];
+        r.name = s.name;
+        r.calls++;
+        r.totalUs += s.durationUs;
+        r.maxUs = std::max(r.maxUs, s.durationUs);
+    }
+
+    std::vector<Row> rows;
+    for (auto& entry : byName) rows.push_back(std::move(entry.second));
+    std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) { return a.totalUs > b.totalUs; });
+    if (rows.empty()) return;
+
+    size_t width = 4;
+    for (size_t i = 0; i < rows.size() && i < maxRows; ++i) width = std::max(width, rows[i].name.size());
+
+    out << "\nCollector latency (slowest first)\n";
+    out << "  " << std::left << std::setw(static_cast<int>(width)) << "span"
+        << std::right << std::setw(7) << "calls" << std::setw(12) << "total ms" << std::setw(10) << "max ms" << "\n";
+
+    out << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < rows.size() && i < maxRows; ++i) {
+        const Row& r = rows[i];
+        out << "  " << std::left << std::setw(static_cast<int>(width)) << r.name
+            << std::right << std::setw(7) << r.calls
+            << std::setw(12) << r.totalUs / 1000.0
+            << std::setw(10) << r.maxUs / 1000.0 << "\n";
+    }
+    if (rows.size() > maxRows) out << "  ... " << (rows.size() - maxRows) << " more (see --trace)\n";
+    out << std::defaultfloat;
+}
+
+static std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') { out += '\\'; out += c; }
+        else if (static_cast<unsigned char>(c) < 0x20) out += ' ';
+        else out += c;
+    }
+    return out;
+}
+
+bool Profiler::writeTrace(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+
+    std::vector<Span> all = spans();
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (size_t i = 0; i < all.size(); ++i) {
+        const Span& s = all[i];
+        file << "{\"name\":\"" << jsonEscape(s.name) << "\",\"cat\":\"" << s.category
+            << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << s.thread
+            << ",\"ts\":" << s.startUs << ",\"dur\":" << s.durationUs << "}"
+            << (i + 1 < all.size() ? ",\n" : "\n");
+    }
+    file << "]}\n";
+    return static_cast<bool>(file);
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: Profiler (singleton) + ProfileScope (RAII span)
+OBJECT: Profiler::instance(), PROFILE_SCOPE("...") in every collector getter
+DESCRIPTION: Per-collector latency spans for --timings and --trace.
+FUNCTIONS:
+    void enable()
+        Start recording. Until then every span is a no-op.
+
+    void record(name, category, start, end)
+        Store one finished span (thread safe).
+
+    void printTable(std::ostream& out, size_t maxRows)
+        Aggregate spans by name (calls, total, max) and print the
+        slowest first. Section spans are left out of the table.
+
+    bool writeTrace(const std::string& path)
+        Chrome trace-event JSON, one "X" (complete) event per span,
+        one track per worker thread.
+
+SPAN CATEGORIES:
+    collector   Class::getter, from PROFILE_SCOPE
+    construct   "<Collector> (construct)", from LazyCollector::get
+    section     config key of a section, from FetchScheduler workers
+
+ADDING A GETTER:
+    Put PROFILE_SCOPE("Class::getter"); on the first line of its body.
+*/
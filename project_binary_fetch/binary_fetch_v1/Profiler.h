@@ -0,0 +1,117 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+/*
+ ---------------------------------------------------------
+                      Profiler Class
+ ---------------------------------------------------------
+
+  Per-collector latency spans for "--timings" and "--trace".
+
+  Every collector getter opens a span on its first line:
+
+      std::string CompactGPU::getGPUName() {
+          PROFILE_SCOPE("CompactGPU::getGPUName");
+          ...
+      }
+
+  LazyCollector adds one more span around construction
+  ("CompactGPU (construct)"), and FetchScheduler one per
+  section, so a trace shows which section waited on what.
+
+  Until enable() is called a span is a single relaxed atomic
+  load, so normal runs pay nothing measurable.
+*/
+class Profiler {
+public:
+    struct Span {
+        std::string name;       // "Class::getter", "Class (construct)" or section key
+        const char* category;   // "collector", "construct" or "section"
+        uint32_t thread;        // small per-thread number (1 = first thread seen)
+        int64_t startUs;        // microseconds since enable()
+        int64_t durationUs;
+    };
+
+    static Profiler& instance();
+
+    // Start recording (main calls this for --timings / --trace)
+    void enable();
+    static bool enabled() { return active.load(std::memory_order_relaxed); }
+
+    // Called by ProfileScope when a span closes
+    void record(std::string name, const char* category,
+        std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+    // Copy of everything recorded so far
+    std::vector<Span> spans() const;
+
+    // Latency table: one row per span name, slowest total first
+    void printTable(std::ostream& out, size_t maxRows = 25) const;
+
+    // Chrome / Perfetto trace-event JSON ("X" complete events).
+    // Open the file in chrome://tracing or ui.perfetto.dev.
+    bool writeTrace(const std::string& path) const;
+
+private:
+    Profiler() = default;
+    uint32_t threadNumber();
+
+    static std::atomic<bool> active;
+
+    mutable std::mutex mtx;
+    std::chrono::steady_clock::time_point origin;
+    std::vector<Span> recorded;
+    std::vector<std::pair<size_t, uint32_t>> threads;   // (hashed thread id, number)
+};
+
+
+
+/*
+ ---------------------------------------------------------
+                    ProfileScope Class
+ ---------------------------------------------------------
+
+  RAII span: records from construction to end of scope.
+  Use PROFILE_SCOPE("Name") rather than naming one yourself.
+*/
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* spanName, const char* spanCategory = "collector")
+        : on(Profiler::enabled()), name(spanName), category(spanCategory) {
+        if (on) start = std::chrono::steady_clock::now();
+    }
+
+    // For names built at run time (collector / section names)
+    explicit ProfileScope(const std::string& spanName, const char* spanCategory)
+        : on(Profiler::enabled()), name(nullptr), category(spanCategory) {
+        if (on) {
+            owned = spanName;
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ProfileScope() {
+        if (on) Profiler::instance().record(name ? std::string(name) : owned, category, start, std::chrono::steady_clock::now());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    bool on;
+    const char* name;
+    const char* category;
+    std::string owned;
+    std::chrono::steady_clock::time_point start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(spanName) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(spanName)
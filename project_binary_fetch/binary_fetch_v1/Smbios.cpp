@@ -0,0 +1,286 @@
+#include "Smbios.h"
+#include "Profiler.h"
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fstream>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+int Smbios::installedDimms() const {
+    int n = 0;
+    for (const Dimm& d : dimms) n += d.sizeBytes > 0 ? 1 : 0;
+    return n;
+}
+
+const char* Smbios::memoryTypeName(uint8_t code) {
+    switch (code) {
+    case 0x12: return "DDR";
+    case 0x13: return "DDR2";
+    case 0x14: return "DDR2-FB-DIMM";
+    case 0x18: return "DDR3";
+    case 0x1A: return "DDR4";
+    case 0x1B: return "LPDDR";
+    case 0x1C: return "LPDDR2";
+    case 0x1D: return "LPDDR3";
+    case 0x1E: return "LPDDR4";
+    case 0x20: return "HBM";
+    case 0x21: return "HBM2";
+    case 0x22: return "DDR5";
+    case 0x23: return "LPDDR5";
+    case 0x24: return "HBM3";
+    default:   return nullptr;
+    }
+}
+
+
+// ---------------- Table parser ----------------
+
+namespace {
+
+    // One structure: formatted area [at, at + length) and its string set
+    // [strings, end). Readers return 0 / "" for anything past either.
+    struct Structure {
+        const uint8_t* at;
+        uint8_t length;
+        const uint8_t* strings;
+        const uint8_t* end;
+
+        uint8_t byte(size_t offset) const { return offset < length ? at[offset] : 0; }
+
+        uint16_t word(size_t offset) const {
+            return offset + 2 <= length ? static_cast<uint16_t>(at[offset] | (at[offset + 1] << 8)) : 0;
+        }
+
+        uint32_t dword(size_t offset) const {
+            if (offset + 4 > length) return 0;
+            return static_cast<uint32_t>(at[offset]) | (static_cast<uint32_t>(at[offset + 1]) << 8)
+                | (static_cast<uint32_t>(at[offset + 2]) << 16) | (static_cast<uint32_t>(at[offset + 3]) << 24);
+        }
+
+        // String number byte at offset (1-based, 0 = none), trailing spaces trimmed
+        std::string text(size_t offset) const {
+            unsigned index = byte(offset);
+            if (index == 0) return "";
+            const uint8_t* p = strings;
+            for (unsigned i = 1; p < end && *p; ++i) {
+                const uint8_t* stop = static_cast<const uint8_t*>(memchr(p, 0, static_cast<size_t>(end - p)));
+                if (!stop) stop = end;
+                if (i == index) {
+                    while (stop > p && stop[-1] == ' ') --stop;
+                    return std::string(reinterpret_cast<const char*>(p), static_cast<size_t>(stop - p));
+                }
+                p = stop + 1;
+            }
+            return "";
+        }
+    };
+
+    // Type 17 size: WORD at 0x0C (bit 15 = KB units), 0x7FFF = see Extended Size (MB) at 0x1C
+    uint64_t dimmSize(const Structure& s) {
+        uint16_t size = s.word(0x0C);
+        if (size == 0 || size == 0xFFFF) return 0;
+        if (size == 0x7FFF) return static_cast<uint64_t>(s.dword(0x1C) & 0x7FFFFFFF) << 20;
+        if (size & 0x8000) return static_cast<uint64_t>(size & 0x7FFF) << 10;
+        return static_cast<uint64_t>(size) << 20;
+    }
+
+    // Speed WORD, 0xFFFF = see the SMBIOS 3.3 extended DWORD
+    unsigned dimmSpeed(const Structure& s, size_t offset, size_t extended) {
+        uint16_t speed = s.word(offset);
+        if (speed == 0xFFFF) return s.dword(extended) & 0x7FFFFFFF;
+        return speed;
+    }
+
+}
+
+Smbios Smbios::parse(const uint8_t* table, size_t length) {
+    PROFILE_SCOPE("Smbios::parse");
+    Smbios out;
+    const uint8_t* p = table;
+    const uint8_t* end = table + length;
+
+    while (end - p >= 4) {
+        Structure s;
+        s.at = p;
+        s.length = p[1];
+        s.end = end;
+        if (s.length < 4 || s.length > end - p) break;
+        s.strings = p + s.length;
+
+        // The string set ends with a double NUL (just "\0\0" when there are no strings)
+        const uint8_t* next = s.strings;
+        while (end - next >= 2 && !(next[0] == 0 && next[1] == 0)) ++next;
+        if (end - next < 2) next = end;
+        else next += 2;
+        s.end = next;
+
+        switch (p[0]) {
+        case 0:
+            out.biosVendor = s.text(0x04);
+            out.biosVersion = s.text(0x05);
+            out.biosDate = s.text(0x08);
+            break;
+        case 1:
+            out.systemManufacturer = s.text(0x04);
+            out.systemProduct = s.text(0x05);
+            break;
+        case 2:
+            // Multi-board systems list several; the first is the main board
+            if (out.boardProduct.empty()) {
+                out.boardManufacturer = s.text(0x04);
+                out.boardProduct = s.text(0x05);
+            }
+            break;
+        case 16:
+            // Use 3 = system memory (skip flash / video arrays)
+            if (s.byte(0x05) == 3) out.memorySlots += s.word(0x0D);
+            break;
+        case 17: {
+            Dimm d;
+            d.locator = s.text(0x10);
+            d.bank = s.text(0x11);
+            d.sizeBytes = dimmSize(s);
+            const char* type = memoryTypeName(s.byte(0x12));
+            d.type = type ? type : "Unknown";
+            d.speedMTs = dimmSpeed(s, 0x15, 0x54);
+            d.configuredMTs = dimmSpeed(s, 0x20, 0x58);
+            d.manufacturer = s.text(0x17);
+            d.partNumber = s.text(0x1A);
+            out.dimms.push_back(std::move(d));
+            break;
+        }
+        case 127:
+            p = end;   // end-of-table
+            continue;
+        default:
+            break;
+        }
+        p = next;
+    }
+
+    out.source = "smbios";
+    return out;
+}
+
+Smbios Smbios::fromDmiId(const FileReader& read) {
+    Smbios out;
+    auto field = [&](const char* name) {
+        std::string value = read(std::string("/sys/class/dmi/id/") + name);
+        while (!value.empty() && (value.back() == '\n' || value.back() == ' ')) value.pop_back();
+        return value;
+    };
+    out.biosVendor = field("bios_vendor");
+    out.biosVersion = field("bios_version");
+    out.biosDate = field("bios_date");
+    out.systemManufacturer = field("sys_vendor");
+    out.systemProduct = field("product_name");
+    out.boardManufacturer = field("board_vendor");
+    out.boardProduct = field("board_name");
+    if (!out.biosVendor.empty() || !out.boardProduct.empty()) out.source = "dmi-id";
+    return out;
+}
+
+
+// ---------------- Backends ----------------
+
+#ifdef _WIN32
+
+static Smbios probe() {
+    PROFILE_SCOPE("Smbios::probe");
+    const DWORD provider = 'RSMB';
+    UINT size = GetSystemFirmwareTable(provider, 0, nullptr, 0);
+    if (size <= 8) return Smbios();
+
+    std::vector<uint8_t> raw(size);
+    if (GetSystemFirmwareTable(provider, 0, raw.data(), size) != size) return Smbios();
+
+    // RawSMBIOSData: 4 version bytes and a DWORD table length, then the table
+    uint32_t length = 0;
+    std::memcpy(&length, raw.data() + 4, sizeof(length));
+    if (length > size - 8) length = size - 8;
+    return Smbios::parse(raw.data() + 8, length);
+}
+
+#else
+
+static Smbios probe() {
+    PROFILE_SCOPE("Smbios::probe");
+    int fd = open("/sys/firmware/dmi/tables/DMI", O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        struct stat st = {};
+        Smbios parsed;
+        bool done = false;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* map = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED) {
+                parsed = Smbios::parse(static_cast<const uint8_t*>(map), static_cast<size_t>(st.st_size));
+                munmap(map, static_cast<size_t>(st.st_size));
+                done = true;
+            }
+        }
+        if (!done) {
+            // sysfs binary attributes usually can't be mapped: one read of the whole table
+            std::vector<uint8_t> table(st.st_size > 0 ? static_cast<size_t>(st.st_size) : 65536);
+            size_t got = 0;
+            for (ssize_t n; got < table.size() && (n = read(fd, table.data() + got, table.size() - got)) > 0; ) got += static_cast<size_t>(n);
+            if (got > 0) {
+                parsed = Smbios::parse(table.data(), got);
+                done = true;
+            }
+        }
+        close(fd);
+        if (done) return parsed;
+    }
+
+    // Not root: the strings, without memory devices
+    return Smbios::fromDmiId([](const std::string& path) {
+        std::ifstream file(path);
+        std::stringstream ss;
+        ss << file.rdbuf();
+        return ss.str();
+    });
+}
+
+#endif
+
+const Smbios& Smbios::current() {
+    static const Smbios smbios = probe();
+    return smbios;
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: Smbios
+OBJECT: Smbios::current(), read by SystemInfo (BIOS / board), CompactSystem
+        (BIOS / board summary), MemoryInfo::fetchModulesInfo (DIMMs) and
+        CompactMemory (slots used / available)
+DESCRIPTION: One linear pass over the raw SMBIOS structure table.
+FUNCTIONS:
+    static const Smbios& current()
+        Read on first call: firmware table, else /sys/class/dmi/id.
+        Callers still wrap their getters in StaticFactsCache, so warm
+        runs don't read the table at all.
+
+    static Smbios parse(const uint8_t* table, size_t length)
+        Walks header -> formatted area -> double-NUL string set for every
+        structure until type 127 or the end of the buffer. Types 0, 1,
+        2, 16 and 17 are decoded; all field reads go through bounds
+        checked accessors (fuzzed by tests\SmbiosTests.cpp).
+
+    static Smbios fromDmiId(const FileReader& read)
+        Non-root Linux fallback.
+
+    static const char* memoryTypeName(uint8_t code)
+        SMBIOS 3.x memory type codes.
+*/
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ ---------------------------------------------------------
+                      Smbios Struct
+ ---------------------------------------------------------
+
+  BIOS, system, baseboard and memory device facts decoded
+  from the raw SMBIOS table in one linear pass, shared by
+  SystemInfo, CompactSystem, MemoryInfo (modules) and
+  CompactMemory (slots) instead of a registry read or WMI
+  query per getter.
+
+    Windows : GetSystemFirmwareTable('RSMB')
+    Linux   : /sys/firmware/dmi/tables/DMI, mapped (or read,
+              sysfs rarely supports mmap on it); root only.
+              Without root the world-readable
+              /sys/class/dmi/id strings fill BIOS / board /
+              system, and there are no DIMMs.
+
+  Decoded structure types: 0 (BIOS), 1 (system), 2 (baseboard),
+  16 (physical memory array) and 17 (memory device). Every read
+  is bounds-checked against the table and the structure's own
+  length, so a truncated or corrupt table just yields fewer
+  fields. Missing strings stay "".
+*/
+struct Smbios {
+    struct Dimm {
+        std::string locator;          // "DIMM_A1"
+        std::string bank;             // "BANK 0"
+        uint64_t sizeBytes = 0;       // 0 = empty slot
+        std::string type;             // "DDR4", "DDR5", ... or "Unknown"
+        unsigned speedMTs = 0;        // rated
+        unsigned configuredMTs = 0;   // what the board actually runs it at
+        std::string manufacturer;
+        std::string partNumber;
+    };
+
+    std::string biosVendor;
+    std::string biosVersion;
+    std::string biosDate;
+    std::string systemManufacturer;
+    std::string systemProduct;
+    std::string boardManufacturer;
+    std::string boardProduct;
+    int memorySlots = 0;              // type 16 NumberOfMemoryDevices, summed
+    std::vector<Dimm> dimms;          // every type 17, empty slots included
+    const char* source = "none";      // "smbios", "dmi-id" or "none"
+
+    // Populated slots
+    int installedDimms() const;
+
+    // The shared snapshot (read once, thread-safe)
+    static const Smbios& current();
+
+    // ---- sources (public so the tests can feed captured tables) ----
+
+    // Structure table (no RawSMBIOSData header, no entry point)
+    static Smbios parse(const uint8_t* table, size_t length);
+
+    // path -> file contents ("" if missing), e.g. "/sys/class/dmi/id/bios_vendor"
+    using FileReader = std::function<std::string(const std::string&)>;
+    static Smbios fromDmiId(const FileReader& read);
+
+    // SMBIOS memory type code (type 17 offset 0x12) -> "DDR4", nullptr if unknown
+    static const char* memoryTypeName(uint8_t code);
+};
@@ -0,0 +1,309 @@
+#include "StaticFactsCache.h"
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+// ---------------- File format ----------------
+//
+//  "BFSF"                          magic
+//  uint32  version                 bump kFormatVersion when the layout or a key's meaning changes
+//  uint32  bootId length, bytes
+//  uint64  hardware fingerprint
+//  uint32  entry count
+//  entries: uint16 key length, key bytes, uint32 value length, value bytes
+//
+// Everything is written in host byte order; the file never leaves the machine.
+
+static const char kMagic[4] = { 'B', 'F', 'S', 'F' };
+static const uint32_t kFormatVersion = 1;
+
+// Sanity limits so a corrupt file can't make us allocate gigabytes
+static const uint32_t kMaxEntries = 4096;
+static const uint32_t kMaxValueSize = 64 * 1024;
+
+template <typename T>
+static bool readPod(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+template <typename T>
+static void writePod(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static bool readBytes(std::istream& in, std::string& s, uint32_t len) {
+    s.resize(len);
+    return len == 0 || static_cast<bool>(in.read(&s[0], len));
+}
+
+// 64-bit FNV-1a, enough to tell one machine setup from another
+static void fnvMix(uint64_t& h, const std::string& s) {
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    h ^= 0xff;   // field separator
+    h *= 1099511628211ULL;
+}
+
+static bool isFailedProbe(const std::string& v) {
+    return v.empty() || v == "Unknown" || v == "N/A";
+}
+
+#ifdef _WIN32
+static std::string readRegString(const char* subkey, const char* name) {
+    char value[256] = { 0 };
+    DWORD size = sizeof(value);
+    if (RegGetValueA(HKEY_LOCAL_MACHINE, subkey, name, RRF_RT_REG_SZ, nullptr, value, &size) != ERROR_SUCCESS)
+        return "";
+    return std::string(value);
+}
+#else
+static std::string readFirstLine(const char* path) {
+    std::ifstream f(path);
+    std::string line;
+    std::getline(f, line);
+    return line;
+}
+#endif
+
+
+// ---------------- Identity ----------------
+
+std::string StaticFactsCache::currentBootId() {
+#ifdef _WIN32
+    // PrefetchParameters\BootId is bumped by the kernel on every boot
+    DWORD bootCounter = 0;
+    DWORD size = sizeof(bootCounter);
+    if (RegGetValueA(HKEY_LOCAL_MACHINE,
+        "SYSTEM\\CurrentControlSet\\Control\\Session Manager\\Memory Management\\PrefetchParameters",
+        "BootId", RRF_RT_REG_DWORD, nullptr, &bootCounter, &size) == ERROR_SUCCESS) {
+        return "id:" + std::to_string(bootCounter);
+    }
+
+    // Fallback: boot time, rounded so timer drift doesn't look like a reboot
+    FILETIME ft;
+    GetSystemTimeAsFileTime(&ft);
+    ULARGE_INTEGER now;
+    now.LowPart = ft.dwLowDateTime;
+    now.HighPart = ft.dwHighDateTime;
+    unsigned long long nowSec = now.QuadPart / 10000000ULL;
+    unsigned long long bootSec = nowSec - GetTickCount64() / 1000ULL;
+    return "t:" + std::to_string(bootSec / 60);
+#else
+    return readFirstLine("/proc/sys/kernel/random/boot_id");
+#endif
+}
+
+uint64_t StaticFactsCache::hardwareFingerprint() {
+    uint64_t h = 1469598103934665603ULL;
+
+    fnvMix(h, std::to_string(std::thread::hardware_concurrency()));
+
+#ifdef _WIN32
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (GlobalMemoryStatusEx(&status)) fnvMix(h, std::to_string(status.ullTotalPhys));
+
+    const char* bios = "HARDWARE\\DESCRIPTION\\System\\BIOS";
+    fnvMix(h, readRegString(bios, "BIOSVersion"));
+    fnvMix(h, readRegString(bios, "BIOSReleaseDate"));
+    fnvMix(h, readRegString(bios, "BaseBoardProduct"));
+    fnvMix(h, readRegString(bios, "SystemProductName"));
+#else
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGESIZE);
+    fnvMix(h, std::to_string(static_cast<unsigned long long>(pages) * pageSize));
+
+    fnvMix(h, readFirstLine("/sys/class/dmi/id/bios_version"));
+    fnvMix(h, readFirstLine("/sys/class/dmi/id/bios_date"));
+    fnvMix(h, readFirstLine("/sys/class/dmi/id/board_name"));
+    fnvMix(h, readFirstLine("/sys/class/dmi/id/product_name"));
+#endif
+
+    return h;
+}
+
+
+// ---------------- StaticFactsCache ----------------
+
+StaticFactsCache& StaticFactsCache::instance() {
+    static StaticFactsCache cache;
+    return cache;
+}
+
+void StaticFactsCache::open(const std::string& path, bool refresh) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    filePath = path;
+    bootId = currentBootId();
+    fingerprint = hardwareFingerprint();
+    enabled = true;
+    facts.clear();
+
+    if (refresh) {
+        loadState = "refreshed";
+        dirty = true;   // rewrite even if nothing ends up cached
+        return;
+    }
+
+    load();
+}
+
+// Called with the lock held. Sets loadState to warm / cold / stale.
+bool StaticFactsCache::load() {
+    std::ifstream in(filePath, std::ios::binary);
+    if (!in.is_open()) {
+        loadState = "cold";
+        return false;
+    }
+
+    loadState = "stale";
+
+    char magic[4];
+    uint32_t version = 0;
+    if (!in.read(magic, 4) || std::string(magic, 4) != std::string(kMagic, 4)) return false;
+    if (!readPod(in, version) || version != kFormatVersion) return false;
+
+    uint32_t len = 0;
+    std::string fileBootId;
+    if (!readPod(in, len) || len > 256 || !readBytes(in, fileBootId, len)) return false;
+
+    uint64_t filePrint = 0;
+    if (!readPod(in, filePrint)) return false;
+
+    // Rebooted or hardware changed: everything in the file is suspect
+    if (fileBootId != bootId || filePrint != fingerprint) return false;
+
+    uint32_t count = 0;
+    if (!readPod(in, count) || count > kMaxEntries) return false;
+
+    std::map<std::string, std::string> loaded;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint16_t keyLen = 0;
+        uint32_t valueLen = 0;
+        std::string key, value;
+        if (!readPod(in, keyLen) || !readBytes(in, key, keyLen)) return false;
+        if (!readPod(in, valueLen) || valueLen > kMaxValueSize || !readBytes(in, value, valueLen)) return false;
+        loaded[key] = value;
+    }
+
+    facts.swap(loaded);
+    loadState = "warm";
+    return true;
+}
+
+std::string StaticFactsCache::getOrCompute(const std::string& key, const std::function<std::string()>& compute) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!enabled) return compute();
+
+        auto it = facts.find(key);
+        if (it != facts.end()) {
+            hitCount++;
+            return it->second;
+        }
+        missCount++;
+    }
+
+    // Probe outside the lock: other sections may be filling other keys
+    std::string value = compute();
+
+    if (!isFailedProbe(value)) {
+        std::lock_guard<std::mutex> lock(mtx);
+        facts[key] = value;
+        dirty = true;
+    }
+    return value;
+}
+
+bool StaticFactsCache::save() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!enabled || !dirty) return true;
+
+    // Write next to the real file and swap it in, so a crash mid-write
+    // never leaves a half written cache behind
+    std::string tmpPath = filePath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+
+        out.write(kMagic, 4);
+        writePod(out, kFormatVersion);
+        writePod(out, static_cast<uint32_t>(bootId.size()));
+        out.write(bootId.data(), bootId.size());
+        writePod(out, fingerprint);
+        writePod(out, static_cast<uint32_t>(facts.size()));
+        for (const auto& kv : facts) {
+            writePod(out, static_cast<uint16_t>(kv.first.size()));
+            out.write(kv.first.data(), kv.first.size());
+            writePod(out, static_cast<uint32_t>(kv.second.size()));
+            out.write(kv.second.data(), kv.second.size());
+        }
+        if (!out.good()) return false;
+    }
+
+#ifdef _WIN32
+    if (!MoveFileExA(tmpPath.c_str(), filePath.c_str(), MOVEFILE_REPLACE_EXISTING)) return false;
+#else
+    if (std::rename(tmpPath.c_str(), filePath.c_str()) != 0) return false;
+#endif
+
+    dirty = false;
+    return true;
+}
+
+int StaticFactsCache::hits() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return hitCount;
+}
+
+int StaticFactsCache::misses() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return missCount;
+}
+
+const char* StaticFactsCache::state() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return loadState;
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: StaticFactsCache
+OBJECT: StaticFactsCache::instance() (singleton, opened in main.cpp)
+FILE: C:\Users\Public\BinaryFetch\BinaryFetch_Cache.bin
+DESCRIPTION: Keeps facts that can't change within a boot so warm runs skip their probes.
+FUNCTIONS:
+    void open(const std::string& path, bool refresh)
+        Load the file. Discarded on a new boot ID, hardware change,
+        version mismatch or any read error. refresh = --refresh-cache.
+
+    std::string getOrCompute(const std::string& key, compute)
+        Cached value or compute() (failed probes are not stored).
+
+    bool save()
+        Rewrite the file (via .tmp + rename) if anything changed.
+
+    int hits() / int misses() / const char* state()
+        Shown by --timings.
+
+CACHED KEYS:
+    cpu.l1, cpu.l2, cpu.l3                                  (CPUInfo)
+    bios.vendor, bios.version, bios.date,
+    board.model, board.manufacturer                         (SystemInfo)
+    compact.bios, compact.board                             (CompactSystem)
+    memory.modules                                          (MemoryInfo)
+    memory.bench                                            (MemoryBench)
+    os.install_date, os.serial                              (OSInfo)
+*/
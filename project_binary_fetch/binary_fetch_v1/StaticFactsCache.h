@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include <map>
+#include <mutex>
+#include <functional>
+#include <cstdint>
+
+/*
+ ---------------------------------------------------------
+                  StaticFactsCache Class
+ ---------------------------------------------------------
+
+  Some facts can't change while the machine is up: CPU brand,
+  cache sizes, BIOS / motherboard strings, RAM modules, OS
+  install date and serial. Probing them costs WMI round trips
+  on every run, so they are kept in a small binary file next
+  to BinaryFetch_Config.json (BinaryFetch_Cache.bin). The
+  memory bandwidth / latency results ("memory.bench") are
+  kept there too, so the kernels run once per boot.
+
+  The file is thrown away when either of these changes:
+   - boot ID           (any reboot)
+   - hardware print    (CPU count, RAM size, BIOS, board)
+
+  Collectors wrap their slow getters:
+
+      return StaticFactsCache::instance().getOrCompute("cpu.brand", [&] {
+          ... original probe ...
+      });
+
+  Until open() is called the cache is a pass-through, so the
+  collectors keep working without it.
+*/
+class StaticFactsCache {
+public:
+    static StaticFactsCache& instance();
+
+    // Load the cache file. refresh = true ignores its contents
+    // (--refresh-cache) and rewrites it on save().
+    void open(const std::string& path, bool refresh);
+
+    // Cached value for key, or run compute() and remember the result.
+    // Failed probes ("", "Unknown", "N/A") are returned but not stored.
+    std::string getOrCompute(const std::string& key, const std::function<std::string()>& compute);
+
+    // Write the file back if anything new was computed
+    bool save();
+
+    // ------------ stats for --timings ------------
+    int hits() const;
+    int misses() const;
+    const char* state() const;   // "warm", "cold", "stale", "refreshed" or "off"
+
+private:
+    StaticFactsCache() = default;
+
+    bool load();
+    static std::string currentBootId();
+    static uint64_t hardwareFingerprint();
+
+    mutable std::mutex mtx;
+    std::map<std::string, std::string> facts;
+    std::string filePath;
+    std::string bootId;
+    uint64_t fingerprint = 0;
+    bool enabled = false;       // open() was called
+    bool dirty = false;         // something new to write
+    int hitCount = 0;
+    int missCount = 0;
+    const char* loadState = "off";
+};
@@ -10,12 +10,15 @@
 ===============================================================
 */
 
+#ifdef _WIN32
 #ifndef _WIN32_WINNT
 #define _WIN32_WINNT 0x0603  // Windows 8.1 or newer
 #endif
+#endif
 
 #include "StorageInfo.h"
-#include <Windows.h>
+#include "Profiler.h"
+#include "MountTable.h"
 #include <sstream>
 #include <iomanip>
 #include <vector>
@@ -23,6 +26,9 @@
 #include <chrono>
 #include <fstream>
 #include <algorithm>
+
+#ifdef _WIN32
+#include <Windows.h>
 #include <malloc.h>
 #include <winioctl.h>
 #include <setupapi.h>
@@ -32,9 +38,15 @@
 
 #pragma comment(lib, "setupapi.lib")
 #pragma comment(lib, "cfgmgr32.lib")
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
+#ifdef _WIN32
+
 // Property ID definitions
 #ifndef StorageDeviceSeekPenaltyProperty
 #define StorageDeviceSeekPenaltyProperty ((STORAGE_PROPERTY_ID)7)
@@ -60,6 +72,7 @@ static bool SafeCloseHandle(HANDLE& h) {
 //  OPTIMIZED: Fast drive type check with fallbacks
 // ============================================================
 string StorageInfo::get_storage_type(const string&, const string& root_path, bool) {
+    PROFILE_SCOPE("StorageInfo::get_storage_type");
     string type = "Unknown";
 
     // OPTIMIZATION 1: Quick USB check first (fastest)
@@ -349,323 +362,179 @@ static double measure_disk_speed(const string& root_path, bool writeTest) {
     return 0.0;
 }
 
+#else
+
 // ============================================================
-//  CRITICAL FIX: Enhanced drive detection with fallbacks
+//  Linux drive type: network file systems by name, local ones
+//  from the whole disk's sysfs queue/rotational flag
 // ============================================================
-vector<storage_data> StorageInfo::get_all_storage_info() {
-    vector<storage_data> all_disks;
-
-    // CRITICAL: Try multiple methods to get drives
-    DWORD drive_mask = GetLogicalDrives();
-
-    if (drive_mask == 0) {
-        // FALLBACK 1: Try GetLogicalDriveStrings
-        char buffer[256];
-        DWORD result = GetLogicalDriveStringsA(sizeof(buffer), buffer);
-
-        if (result > 0 && result <= sizeof(buffer)) {
-            char* p = buffer;
-            while (*p) {
-                char drive_letter = toupper(*p);
-                if (drive_letter >= 'A' && drive_letter <= 'Z') {
-                    drive_mask |= (1 << (drive_letter - 'A'));
-                }
-                p += strlen(p) + 1;
-            }
-        }
-
-        // FALLBACK 2: If still nothing, manually check common drives
-        if (drive_mask == 0) {
-            for (char c = 'C'; c <= 'D'; c++) {
-                string test = string(1, c) + ":\\";
-                if (GetDriveTypeA(test.c_str()) == DRIVE_FIXED) {
-                    drive_mask |= (1 << (c - 'A'));
-                }
-            }
-        }
+static string linux_storage_type(const MountTable::Mount& volume) {
+    if (volume.kind == MountTable::Kind::Network) return "Network";
+    if (volume.kind == MountTable::Kind::Removable) return "USB";
+    if (volume.deviceId.empty()) return "Unknown";
+
+    // "/sys/dev/block/259:2" is the partition; its parent directory holds the queue
+    const char* const paths[] = { "/queue/rotational", "/../queue/rotational" };
+    for (const char* path : paths) {
+        int fd = open(("/sys/dev/block/" + volume.deviceId + path).c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) continue;
+        char flag = 0;
+        bool ok = read(fd, &flag, 1) == 1;
+        close(fd);
+        if (ok) return flag == '1' ? "HDD" : "SSD";
     }
+    return "Unknown";
+}
 
-    if (drive_mask == 0) return all_disks; // No drives found at all
-
-    char drive_letter = 'A';
-    int disk_index = 0;
-
-    while (drive_mask) {
-        if (drive_mask & 1) {
-            string root_path = string(1, drive_letter) + ":\\";
-
-            // CRITICAL: Check if drive is accessible FIRST
-            UINT dt = GetDriveTypeA(root_path.c_str());
-            if (dt == DRIVE_NO_ROOT_DIR || dt == DRIVE_UNKNOWN) {
-                drive_mask >>= 1;
-                drive_letter++;
-                continue;
-            }
-
-            ULARGE_INTEGER free_bytes, total_bytes, free_bytes_available;
-
-            if (GetDiskFreeSpaceExA(root_path.c_str(), &free_bytes_available, &total_bytes, &free_bytes)) {
-                double total_gib = total_bytes.QuadPart / (1024.0 * 1024.0 * 1024.0);
-
-                // OPTIMIZATION: Skip tiny partitions (< 100MB)
-                if (total_gib < 0.1) {
-                    drive_mask >>= 1;
-                    drive_letter++;
-                    continue;
-                }
-
-                double free_gib = free_bytes.QuadPart / (1024.0 * 1024.0 * 1024.0);
-                double used_gib = total_gib - free_gib;
-                double used_percent = (total_gib > 0) ? (used_gib / total_gib) * 100.0 : 0.0;
-
-                char fs_name[MAX_PATH] = { 0 };
-                GetVolumeInformationA(root_path.c_str(), nullptr, 0, nullptr, nullptr, nullptr, fs_name, sizeof(fs_name));
-                string formatted_fs = string(fs_name);
-                if (formatted_fs.empty()) formatted_fs = "RAW";
-                if (formatted_fs == "NTFS") formatted_fs = "NTFS ";
-
-                bool is_external = (dt == DRIVE_REMOVABLE);
-
-                ostringstream used_str, total_str, percent_str;
-                used_str << fixed << setprecision(2) << used_gib;
-                total_str << fixed << setprecision(2) << total_gib;
-                percent_str << "(" << (int)used_percent << "%)";
-
-                storage_data disk;
-                disk.drive_letter = "Disk (" + string(1, drive_letter) + ":)";
-                disk.used_space = used_str.str();
-                disk.total_space = total_str.str();
-                disk.used_percentage = percent_str.str();
-                disk.file_system = formatted_fs;
-                disk.is_external = is_external;
-
-                // Storage type with error handling
-                try {
-                    disk.storage_type = get_storage_type(disk.drive_letter, root_path, is_external);
-                }
-                catch (...) {
-                    disk.storage_type = "SSD"; // Safe fallback
-                }
-
-                // Don't skip "Unknown" drives - show them anyway
-                // (User might have virtual drives, network drives, etc.)
-
-                // OPTIMIZED: Measure speeds with timeout protection and retry logic
-                double w = 0.0, r = 0.0;
-
-                try {
-                    // Try write test first (creates file for read test)
-                    w = measure_disk_speed(root_path, true);
-
-                    // Small delay to ensure file system sync
-                    Sleep(100);
-
-                    // Try read test
-                    r = measure_disk_speed(root_path, false);
-
-                    // CRITICAL FIX: If both failed (0.0), retry with fallback method
-                    if (w == 0.0 && r == 0.0) {
-                        // Retry without NO_BUFFERING (for compatibility)
-                        Sleep(200);
-                        w = measure_disk_speed(root_path, true);
-                        Sleep(100);
-                        r = measure_disk_speed(root_path, false);
-                    }
-
-                }
-                catch (...) {
-                    w = 0.0;
-                    r = 0.0;
-                }
-
-                ostringstream ss;
-                ss << fixed << setprecision(2) << (r > 0 ? r : 0.0);
-                disk.read_speed = ss.str();
-                ss.str("");
-                ss.clear();
-                ss << fixed << setprecision(2) << (w > 0 ? w : 0.0);
-                disk.write_speed = ss.str();
-
-                disk.serial_number = "SN-" + to_string(1000 + disk_index);
-
-                // Predicted speeds based on type
-                if (disk.storage_type == "USB") {
-                    disk.predicted_read_speed = "100";
-                    disk.predicted_write_speed = "80";
-                }
-                else if (disk.storage_type == "SSD") {
-                    disk.predicted_read_speed = "500";
-                    disk.predicted_write_speed = "450";
-                }
-                else if (disk.storage_type == "HDD") {
-                    disk.predicted_read_speed = "140";
-                    disk.predicted_write_speed = "120";
-                }
-                else {
-                    disk.predicted_read_speed = "---";
-                    disk.predicted_write_speed = "---";
-                }
+#endif
 
-                all_disks.push_back(disk);
-                disk_index++;
-            }
-        }
-        drive_letter++;
-        drive_mask >>= 1;
-    }
+// ============================================================
+//  Size / percentage / file system strings for one volume
+//  (pure formatting, shared by both walkers and BinaryFetchBench)
+// ============================================================
+void StorageInfo::fill_capacity(storage_data& disk, unsigned long long total_bytes, unsigned long long free_bytes, const string& fs_name) {
+    double total_gib = total_bytes / (1024.0 * 1024.0 * 1024.0);
+    double free_gib = free_bytes / (1024.0 * 1024.0 * 1024.0);
+    double used_gib = total_gib - free_gib;
+    double used_percent = (total_gib > 0) ? (used_gib / total_gib) * 100.0 : 0.0;
+
+    ostringstream used_str, total_str;
+    used_str << fixed << setprecision(2) << used_gib;
+    total_str << fixed << setprecision(2) << total_gib;
+
+    disk.used_space = used_str.str();
+    disk.total_space = total_str.str();
+    disk.used_percentage = "(" + to_string((int)used_percent) + "%)";
+
+    disk.file_system = fs_name.empty() ? "RAW" : fs_name;
+    if (disk.file_system == "NTFS") disk.file_system = "NTFS ";
+}
 
+// ============================================================
+//  Every volume, collected (same walk as process_storage_info)
+// ============================================================
+vector<storage_data> StorageInfo::get_all_storage_info() {
+    PROFILE_SCOPE("StorageInfo::get_all_storage_info");
+    vector<storage_data> all_disks;
+    process_storage_info([&](const storage_data& disk) { all_disks.push_back(disk); });
     return all_disks;
 }
 
 // ============================================================
-//  SAME FIX: Enhanced process_storage_info with streaming
+//  Streaming walk: capacity of every volume is probed up front,
+//  concurrently and with a per-volume timeout (MountTable), so a
+//  dead network share shows up as "unresponsive" instead of
+//  holding the whole section for 30+ seconds
 // ============================================================
 void StorageInfo::process_storage_info(std::function<void(const storage_data&)> callback) {
-    DWORD drive_mask = GetLogicalDrives();
-
-    if (drive_mask == 0) {
-        char buffer[256];
-        DWORD result = GetLogicalDriveStringsA(sizeof(buffer), buffer);
-
-        if (result > 0 && result <= sizeof(buffer)) {
-            char* p = buffer;
-            while (*p) {
-                char drive_letter = toupper(*p);
-                if (drive_letter >= 'A' && drive_letter <= 'Z') {
-                    drive_mask |= (1 << (drive_letter - 'A'));
-                }
-                p += strlen(p) + 1;
-            }
-        }
-
-        if (drive_mask == 0) {
-            for (char c = 'C'; c <= 'D'; c++) {
-                string test = string(1, c) + ":\\";
-                if (GetDriveTypeA(test.c_str()) == DRIVE_FIXED) {
-                    drive_mask |= (1 << (c - 'A'));
-                }
-            }
-        }
-    }
-
-    if (drive_mask == 0) return;
-
-    char drive_letter = 'A';
+    PROFILE_SCOPE("StorageInfo::process_storage_info");
+    vector<MountTable::Mount> volumes = MountTable::snapshot();
     int disk_index = 0;
 
-    while (drive_mask) {
-        if (drive_mask & 1) {
-            string root_path = string(1, drive_letter) + ":\\";
-
-            UINT dt = GetDriveTypeA(root_path.c_str());
-            if (dt == DRIVE_NO_ROOT_DIR || dt == DRIVE_UNKNOWN) {
-                drive_mask >>= 1;
-                drive_letter++;
-                continue;
-            }
-
-            ULARGE_INTEGER free_bytes, total_bytes, free_bytes_available;
+    for (const auto& volume : volumes) {
+        bool is_external = volume.kind == MountTable::Kind::Removable;
 
-            if (GetDiskFreeSpaceExA(root_path.c_str(), &free_bytes_available, &total_bytes, &free_bytes)) {
-                double total_gib = total_bytes.QuadPart / (1024.0 * 1024.0 * 1024.0);
+        storage_data disk;
+#ifdef _WIN32
+        const string& root_path = volume.mountPoint;        // "C:\\"
+        disk.drive_letter = "Disk (" + volume.device + ")";  // "Disk (C:)"
+#else
+        disk.drive_letter = "Disk (" + volume.mountPoint + ")";
+#endif
+        disk.is_external = is_external;
+
+        if (volume.state == MountTable::State::Unresponsive) {
+            // Still listed, so a hung mount is visible rather than silently missing
+            fill_capacity(disk, 0, 0, volume.fsType);
+            disk.used_percentage = "(unresponsive)";
+            disk.storage_type = volume.kind == MountTable::Kind::Network ? "Network" : "Unknown";
+            disk.read_speed = "0.00";
+            disk.write_speed = "0.00";
+            disk.serial_number = "SN-" + to_string(1000 + disk_index);
+            disk.predicted_read_speed = "---";
+            disk.predicted_write_speed = "---";
+            callback(disk);
+            disk_index++;
+            continue;
+        }
+        if (volume.state != MountTable::State::Ok) continue;
 
-                if (total_gib < 0.1) {
-                    drive_mask >>= 1;
-                    drive_letter++;
-                    continue;
-                }
+        // OPTIMIZATION: Skip tiny partitions (< 100MB)
+        double total_gib = volume.totalBytes / (1024.0 * 1024.0 * 1024.0);
+        if (total_gib < 0.1) continue;
 
-                double free_gib = free_bytes.QuadPart / (1024.0 * 1024.0 * 1024.0);
-                double used_gib = total_gib - free_gib;
-                double used_percent = (total_gib > 0) ? (used_gib / total_gib) * 100.0 : 0.0;
-
-                char fs_name[MAX_PATH] = { 0 };
-                GetVolumeInformationA(root_path.c_str(), nullptr, 0, nullptr, nullptr, nullptr, fs_name, sizeof(fs_name));
-                string formatted_fs = string(fs_name);
-                if (formatted_fs.empty()) formatted_fs = "RAW";
-                if (formatted_fs == "NTFS") formatted_fs = "NTFS ";
-
-                bool is_external = (dt == DRIVE_REMOVABLE);
-
-                ostringstream used_str, total_str, percent_str;
-                used_str << fixed << setprecision(2) << used_gib;
-                total_str << fixed << setprecision(2) << total_gib;
-                percent_str << "(" << (int)used_percent << "%)";
-
-                storage_data disk;
-                disk.drive_letter = "Disk (" + string(1, drive_letter) + ":)";
-                disk.used_space = used_str.str();
-                disk.total_space = total_str.str();
-                disk.used_percentage = percent_str.str();
-                disk.file_system = formatted_fs;
-                disk.is_external = is_external;
-
-                try {
-                    disk.storage_type = get_storage_type(disk.drive_letter, root_path, is_external);
-                }
-                catch (...) {
-                    disk.storage_type = "SSD";
-                }
+        fill_capacity(disk, volume.totalBytes, volume.freeBytes, volume.fsType);
 
-                double w = 0.0, r = 0.0;
-                try {
-                    // Try write test first (creates file for read test)
-                    w = measure_disk_speed(root_path, true);
+        double w = 0.0, r = 0.0;
+#ifdef _WIN32
+        // Storage type with error handling
+        try {
+            disk.storage_type = get_storage_type(disk.drive_letter, root_path, is_external);
+        }
+        catch (...) {
+            disk.storage_type = "SSD"; // Safe fallback
+        }
 
-                    // Small delay to ensure file system sync
-                    Sleep(100);
+        // OPTIMIZED: Measure speeds with timeout protection and retry logic
+        try {
+            // Try write test first (creates file for read test)
+            w = measure_disk_speed(root_path, true);
 
-                    // Try read test
-                    r = measure_disk_speed(root_path, false);
+            // Small delay to ensure file system sync
+            Sleep(100);
 
-                    // CRITICAL FIX: If both failed (0.0), retry with fallback method
-                    if (w == 0.0 && r == 0.0) {
-                        // Retry without NO_BUFFERING (for compatibility)
-                        Sleep(200);
-                        w = measure_disk_speed(root_path, true);
-                        Sleep(100);
-                        r = measure_disk_speed(root_path, false);
-                    }
+            // Try read test
+            r = measure_disk_speed(root_path, false);
 
-                }
-                catch (...) {
-                    w = 0.0;
-                    r = 0.0;
-                }
+            // CRITICAL FIX: If both failed (0.0), retry with fallback method
+            if (w == 0.0 && r == 0.0) {
+                // Retry without NO_BUFFERING (for compatibility)
+                Sleep(200);
+                w = measure_disk_speed(root_path, true);
+                Sleep(100);
+                r = measure_disk_speed(root_path, false);
+            }
 
-                ostringstream ss;
-                ss << fixed << setprecision(2) << (r > 0 ? r : 0.0);
-                disk.read_speed = ss.str();
-                ss.str("");
-                ss.clear();
-                ss << fixed << setprecision(2) << (w > 0 ? w : 0.0);
-                disk.write_speed = ss.str();
+        }
+        catch (...) {
+            w = 0.0;
+            r = 0.0;
+        }
+#else
+        // No write test on Linux: mount points are rarely writable for a normal user
+        disk.storage_type = linux_storage_type(volume);
+#endif
 
-                disk.serial_number = "SN-" + to_string(1000 + disk_index);
+        ostringstream ss;
+        ss << fixed << setprecision(2) << (r > 0 ? r : 0.0);
+        disk.read_speed = ss.str();
+        ss.str("");
+        ss.clear();
+        ss << fixed << setprecision(2) << (w > 0 ? w : 0.0);
+        disk.write_speed = ss.str();
 
-                if (disk.storage_type == "USB") {
-                    disk.predicted_read_speed = "100";
-                    disk.predicted_write_speed = "80";
-                }
-                else if (disk.storage_type == "SSD") {
-                    disk.predicted_read_speed = "500";
-                    disk.predicted_write_speed = "450";
-                }
-                else if (disk.storage_type == "HDD") {
-                    disk.predicted_read_speed = "140";
-                    disk.predicted_write_speed = "120";
-                }
-                else {
-                    disk.predicted_read_speed = "---";
-                    disk.predicted_write_speed = "---";
-                }
+        disk.serial_number = "SN-" + to_string(1000 + disk_index);
 
-                callback(disk);
-                disk_index++;
-            }
+        // Predicted speeds based on type
+        if (disk.storage_type == "USB") {
+            disk.predicted_read_speed = "100";
+            disk.predicted_write_speed = "80";
+        }
+        else if (disk.storage_type == "SSD") {
+            disk.predicted_read_speed = "500";
+            disk.predicted_write_speed = "450";
         }
-        drive_letter++;
-        drive_mask >>= 1;
+        else if (disk.storage_type == "HDD") {
+            disk.predicted_read_speed = "140";
+            disk.predicted_write_speed = "120";
+        }
+        else {
+            disk.predicted_read_speed = "---";
+            disk.predicted_write_speed = "---";
+        }
+
+        callback(disk);
+        disk_index++;
     }
 }
 
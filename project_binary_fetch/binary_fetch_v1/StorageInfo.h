@@ -27,6 +27,9 @@ public:
     // NEW: Process disks one-by-one with callback
     void process_storage_info(std::function<void(const storage_data&)> callback);
 
+    // Fill used/total/percent/file system of one volume (pure formatting, also used by BinaryFetchBench)
+    static void fill_capacity(storage_data& disk, unsigned long long total_bytes, unsigned long long free_bytes, const string& fs_name);
+
 private:
     string get_storage_type(const string& drive_letter, const string& root_path, bool is_external);
 };
\ No newline at end of file
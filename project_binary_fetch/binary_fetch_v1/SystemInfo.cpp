@@ -1,52 +1,55 @@
 #include "SystemInfo.h"
-#include <windows.h>
-#include <iostream>
+#include "StaticFactsCache.h"
+#include "Profiler.h"
+#include "Smbios.h"
 
 SystemInfo::SystemInfo() {
-    // Nothing to initialize, using registry only
+    PROFILE_SCOPE("SystemInfo::SystemInfo");
+    // Nothing to initialize, the SMBIOS table is read on first use
 }
 
 SystemInfo::~SystemInfo() {
     // Nothing to clean
 }
 
-// Registry reading function (internal)
-std::string SystemInfo::read_registry_value(const std::string& subkey, const std::string& valueName) {
-    HKEY hKey;
-    if (RegOpenKeyExA(HKEY_LOCAL_MACHINE, subkey.c_str(), 0, KEY_READ, &hKey) != ERROR_SUCCESS)
-        return "N/A";
-
-    char value[256] = { 0 };
-    DWORD size = sizeof(value);
-    DWORD type = 0;
-
-    if (RegQueryValueExA(hKey, valueName.c_str(), nullptr, &type, reinterpret_cast<LPBYTE>(value), &size) != ERROR_SUCCESS) {
-        RegCloseKey(hKey);
-        return "N/A";
-    }
-
-    RegCloseKey(hKey);
-    return std::string(value);
+// Empty SMBIOS strings print as before
+static std::string orNA(const std::string& value) {
+    return value.empty() ? "N/A" : value;
 }
 
 // BIOS info
 std::string SystemInfo::get_bios_vendor() {
-    return read_registry_value("HARDWARE\\DESCRIPTION\\System\\BIOS", "BIOSVendor");
+    PROFILE_SCOPE("SystemInfo::get_bios_vendor");
+    return StaticFactsCache::instance().getOrCompute("bios.vendor", [] {
+        return orNA(Smbios::current().biosVendor);
+    });
 }
 
 std::string SystemInfo::get_bios_version() {
-    return read_registry_value("HARDWARE\\DESCRIPTION\\System\\BIOS", "BIOSVersion");
+    PROFILE_SCOPE("SystemInfo::get_bios_version");
+    return StaticFactsCache::instance().getOrCompute("bios.version", [] {
+        return orNA(Smbios::current().biosVersion);
+    });
 }
 
 std::string SystemInfo::get_bios_date() {
-    return read_registry_value("HARDWARE\\DESCRIPTION\\System\\BIOS", "BIOSReleaseDate");
+    PROFILE_SCOPE("SystemInfo::get_bios_date");
+    return StaticFactsCache::instance().getOrCompute("bios.date", [] {
+        return orNA(Smbios::current().biosDate);
+    });
 }
 
 // Motherboard info
 std::string SystemInfo::get_motherboard_model() {
-    return read_registry_value("HARDWARE\\DESCRIPTION\\System\\BIOS", "BaseBoardProduct");
+    PROFILE_SCOPE("SystemInfo::get_motherboard_model");
+    return StaticFactsCache::instance().getOrCompute("board.model", [] {
+        return orNA(Smbios::current().boardProduct);
+    });
 }
 
 std::string SystemInfo::get_motherboard_manufacturer() {
-    return read_registry_value("HARDWARE\\DESCRIPTION\\System\\BIOS", "BaseBoardManufacturer");
+    PROFILE_SCOPE("SystemInfo::get_motherboard_manufacturer");
+    return StaticFactsCache::instance().getOrCompute("board.manufacturer", [] {
+        return orNA(Smbios::current().boardManufacturer);
+    });
 }
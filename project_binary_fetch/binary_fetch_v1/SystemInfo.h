@@ -2,6 +2,7 @@
 #include <string>
 #include <vector>
 
+// BIOS / motherboard strings, all from the shared SMBIOS parse (Smbios.h)
 class SystemInfo {
 public:
     SystemInfo();
@@ -12,7 +13,4 @@ public:
     std::string get_bios_date();
     std::string get_motherboard_model();
     std::string get_motherboard_manufacturer();
-
-private:
-    std::string read_registry_value(const std::string& subkey, const std::string& valueName);
 };
@@ -0,0 +1,419 @@
+#include "SystemQuery.h"
+#include "Profiler.h"
+#include <cstdlib>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <comdef.h>
+#include <Wbemidl.h>
+#include <fstream>
+#include <sstream>
+#pragma comment(lib, "wbemuuid.lib")
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+// ---------------- QueryRow ----------------
+
+const QueryRow::Value* QueryRow::find(const std::string& field) const {
+    for (const auto& v : values) {
+        if (v.first == field) return v.second.kind == Null ? nullptr : &v.second;
+    }
+    return nullptr;
+}
+
+bool QueryRow::has(const std::string& field) const {
+    return find(field) != nullptr;
+}
+
+std::string QueryRow::text(const std::string& field, const std::string& fallback) const {
+    const Value* v = find(field);
+    if (!v) return fallback;
+    switch (v->kind) {
+    case Text:    return v->text;
+    case Integer: return std::to_string(v->integer);
+    case Real: {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "%g", v->real);
+        return buf;
+    }
+    default:      return fallback;
+    }
+}
+
+long long QueryRow::integer(const std::string& field, long long fallback) const {
+    const Value* v = find(field);
+    if (!v) return fallback;
+    if (v->kind == Integer) return v->integer;
+    if (v->kind == Real) return static_cast<long long>(v->real);
+
+    // Text: leading number is enough ("16314664 kB", "3600")
+    const char* start = v->text.c_str();
+    char* end = nullptr;
+    long long n = std::strtoll(start, &end, 10);
+    return end == start ? fallback : n;
+}
+
+double QueryRow::real(const std::string& field, double fallback) const {
+    const Value* v = find(field);
+    if (!v) return fallback;
+    if (v->kind == Real) return v->real;
+    if (v->kind == Integer) return static_cast<double>(v->integer);
+
+    const char* start = v->text.c_str();
+    char* end = nullptr;
+    double d = std::strtod(start, &end);
+    return end == start ? fallback : d;
+}
+
+void QueryRow::setText(const std::string& field, const std::string& value) {
+    Value v;
+    v.kind = Text;
+    v.text = value;
+    values.emplace_back(field, std::move(v));
+}
+
+void QueryRow::setInteger(const std::string& field, long long value) {
+    Value v;
+    v.kind = Integer;
+    v.integer = value;
+    values.emplace_back(field, std::move(v));
+}
+
+void QueryRow::setReal(const std::string& field, double value) {
+    Value v;
+    v.kind = Real;
+    v.real = value;
+    values.emplace_back(field, std::move(v));
+}
+
+
+// ---------------- SystemQuery (shared) ----------------
+
+SystemQuery& SystemQuery::instance() {
+    static SystemQuery query;
+    return query;
+}
+
+std::string SystemQuery::memoKey(const std::string& source, std::initializer_list<const char*> fields,
+    const std::string& where, const std::string& ns) {
+    std::string key = ns + '|' + source + '|';
+    for (const char* f : fields) key += std::string(f) + ',';
+    return key + '|' + where;
+}
+
+std::vector<QueryRow> SystemQuery::cachedRows(const std::string& source, std::initializer_list<const char*> fields,
+    const std::string& where, const std::string& ns) {
+    std::string key = memoKey(source, fields, where, ns);
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = memo.find(key);
+        if (it != memo.end()) return it->second;
+    }
+
+    // Two threads may race to fill the same key; both get the same answer
+    std::vector<QueryRow> result = rows(source, fields, where, ns);
+    if (!result.empty()) {
+        std::lock_guard<std::mutex> lock(mtx);
+        memo.emplace(key, result);
+    }
+    return result;
+}
+
+QueryRow SystemQuery::first(const std::string& source, std::initializer_list<const char*> fields,
+    const std::string& where, const std::string& ns) {
+    std::vector<QueryRow> result = rows(source, fields, where, ns);
+    return result.empty() ? QueryRow() : result[0];
+}
+
+
+#ifdef _WIN32
+
+// ---------------- Windows: WMI ----------------
+
+static void storeVariant(QueryRow& row, const char* field, const VARIANT& v) {
+    switch (v.vt) {
+    case VT_BSTR:
+        if (v.bstrVal) row.setText(field, static_cast<const char*>(_bstr_t(v.bstrVal)));
+        break;
+    case VT_I1:   row.setInteger(field, v.cVal); break;
+    case VT_UI1:  row.setInteger(field, v.bVal); break;
+    case VT_I2:   row.setInteger(field, v.iVal); break;
+    case VT_UI2:  row.setInteger(field, v.uiVal); break;
+    case VT_I4:   row.setInteger(field, v.lVal); break;
+    case VT_UI4:  row.setInteger(field, v.ulVal); break;
+    case VT_INT:  row.setInteger(field, v.intVal); break;
+    case VT_UINT: row.setInteger(field, v.uintVal); break;
+    case VT_I8:   row.setInteger(field, v.llVal); break;
+    case VT_UI8:  row.setInteger(field, static_cast<long long>(v.ullVal)); break;
+    case VT_BOOL: row.setInteger(field, v.boolVal != VARIANT_FALSE ? 1 : 0); break;
+    case VT_R4:   row.setReal(field, v.fltVal); break;
+    case VT_R8:   row.setReal(field, v.dblVal); break;
+    default:      break;   // VT_NULL, arrays, ...: left out, has() says false
+    }
+}
+
+// Caller holds mtx. A namespace that fails to connect is remembered as
+// nullptr so optional providers (OpenHardwareMonitor) cost one attempt.
+IWbemServices* SystemQuery::connect(const std::string& ns) {
+    auto it = services.find(ns);
+    if (it != services.end()) return it->second;
+
+    PROFILE_SCOPE("SystemQuery::connect");
+
+    if (!securityDone) {
+        // main() normally did this already; then this is just RPC_E_TOO_LATE
+        CoInitializeSecurity(NULL, -1, NULL, NULL,
+            RPC_C_AUTHN_LEVEL_DEFAULT, RPC_C_IMP_LEVEL_IMPERSONATE,
+            NULL, EOAC_NONE, NULL);
+        securityDone = true;
+    }
+
+    if (!locator && FAILED(CoCreateInstance(CLSID_WbemLocator, 0, CLSCTX_INPROC_SERVER,
+        IID_IWbemLocator, (LPVOID*)&locator))) {
+        locator = nullptr;
+        return nullptr;
+    }
+
+    IWbemServices* svc = nullptr;
+    if (SUCCEEDED(locator->ConnectServer(_bstr_t(ns.c_str()), NULL, NULL, 0, NULL, 0, 0, &svc))) {
+        CoSetProxyBlanket(svc, RPC_C_AUTHN_WINNT, RPC_C_AUTHZ_NONE, NULL,
+            RPC_C_AUTHN_LEVEL_CALL, RPC_C_IMP_LEVEL_IMPERSONATE, NULL, EOAC_NONE);
+    }
+    else {
+        svc = nullptr;
+    }
+
+    services[ns] = svc;
+    return svc;
+}
+
+std::vector<QueryRow> SystemQuery::rows(const std::string& source, std::initializer_list<const char*> fields,
+    const std::string& where, const std::string& ns) {
+    std::vector<QueryRow> out;
+
+    // Worker threads are already in the MTA; this only matters for a stray caller
+    HRESULT com = CoInitializeEx(0, COINIT_MULTITHREADED);
+
+    IWbemServices* svc = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        svc = connect(ns);
+        if (svc) svc->AddRef();
+    }
+
+    if (svc) {
+        std::string wql = "SELECT ";
+        if (fields.size() == 0) wql += "*";
+        for (const char* f : fields) {
+            if (wql.size() > 7) wql += ", ";
+            wql += f;
+        }
+        wql += " FROM " + source;
+        if (!where.empty()) wql += " WHERE " + where;
+
+        IEnumWbemClassObject* enumerator = nullptr;
+        if (SUCCEEDED(svc->ExecQuery(bstr_t("WQL"), bstr_t(wql.c_str()),
+            WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY, NULL, &enumerator)) && enumerator) {
+            IWbemClassObject* obj = nullptr;
+            ULONG returned = 0;
+            while (enumerator->Next(WBEM_INFINITE, 1, &obj, &returned) == S_OK && returned) {
+                QueryRow row;
+                for (const char* f : fields) {
+                    VARIANT v;
+                    VariantInit(&v);
+                    if (SUCCEEDED(obj->Get(_bstr_t(f), 0, &v, 0, 0))) storeVariant(row, f, v);
+                    VariantClear(&v);
+                }
+                out.push_back(std::move(row));
+                obj->Release();
+            }
+            enumerator->Release();
+        }
+        svc->Release();
+    }
+
+    if (SUCCEEDED(com)) CoUninitialize();
+    return out;
+}
+
+std::string SystemQuery::readFile(const std::string& path) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return "";
+    std::ostringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+}
+
+void SystemQuery::close() {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto& s : services) {
+        if (s.second) s.second->Release();
+    }
+    services.clear();
+    if (locator) locator->Release();
+    locator = nullptr;
+    memo.clear();
+}
+
+#else
+
+// ---------------- Linux: procfs / sysfs ----------------
+
+const size_t SystemQuery::MaxDescriptors;
+
+// Shared by the cache and every readFile() in flight, so evicting a path
+// never closes (and lets the kernel reuse) an fd another thread is reading
+struct SystemQuery::OpenFile {
+    int fd;
+    explicit OpenFile(int f) : fd(f) {}
+    ~OpenFile() { ::close(fd); }
+};
+
+std::shared_ptr<SystemQuery::OpenFile> SystemQuery::descriptor(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = descriptors.find(path);
+    if (it != descriptors.end()) {
+        it->second.lastUse = ++useCounter;
+        return it->second.file;
+    }
+
+    // Failures are not remembered: EMFILE / EACCES can be transient and
+    // sysfs files (zram, hot-plugged CPUs) can appear later
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return nullptr;
+
+    if (descriptors.size() >= MaxDescriptors) {
+        auto oldest = descriptors.begin();
+        for (auto d = descriptors.begin(); d != descriptors.end(); ++d) {
+            if (d->second.lastUse < oldest->second.lastUse) oldest = d;
+        }
+        descriptors.erase(oldest);
+    }
+
+    CachedFile& entry = descriptors[path];
+    entry.file = std::make_shared<OpenFile>(fd);
+    entry.lastUse = ++useCounter;
+    return entry.file;
+}
+
+void SystemQuery::forget(const std::string& path, const std::shared_ptr<OpenFile>& file) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = descriptors.find(path);
+    if (it != descriptors.end() && it->second.file == file) descriptors.erase(it);
+}
+
+std::string SystemQuery::readFile(const std::string& path) {
+    std::shared_ptr<OpenFile> file = descriptor(path);
+    if (!file) return "";
+    int fd = file->fd;
+
+    // procfs regenerates the file on a read at offset 0, so one big first
+    // read gets a consistent picture; pread never moves a shared offset
+    std::string out(16 * 1024, '\0');
+    size_t used = 0;
+    for (;;) {
+        if (used == out.size()) out.resize(out.size() * 2);
+        ssize_t n = pread(fd, &out[used], out.size() - used, static_cast<off_t>(used));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            forget(path, file);   // e.g. ENODEV after the device went away: reopen next time
+            return "";
+        }
+        if (n == 0) break;
+        used += static_cast<size_t>(n);
+    }
+    out.resize(used);
+    return out;
+}
+
+static std::string trim(const std::string& s, size_t begin, size_t end) {
+    while (begin < end && (s[begin] == ' ' || s[begin] == '\t')) ++begin;
+    while (end > begin && (s[end - 1] == ' ' || s[end - 1] == '\t')) --end;
+    return s.substr(begin, end - begin);
+}
+
+std::vector<QueryRow> SystemQuery::rows(const std::string& source, std::initializer_list<const char*> fields,
+    const std::string&, const std::string&) {
+    std::vector<QueryRow> out;
+    std::string content = readFile(source);
+
+    QueryRow row;
+    bool rowHasData = false;
+    size_t pos = 0;
+    while (pos <= content.size()) {
+        size_t eol = content.find('\n', pos);
+        if (eol == std::string::npos) eol = content.size();
+
+        if (eol == pos) {
+            // blank line (or end of file): block done
+            if (rowHasData) out.push_back(std::move(row));
+            row = QueryRow();
+            rowHasData = false;
+        }
+        else {
+            size_t colon = content.find(':', pos);
+            if (colon != std::string::npos && colon < eol) {
+                std::string key = trim(content, pos, colon);
+                bool wanted = fields.size() == 0;
+                for (const char* f : fields) {
+                    if (key == f) wanted = true;
+                }
+                if (wanted) {
+                    row.setText(key, trim(content, colon + 1, eol));
+                    rowHasData = true;
+                }
+            }
+        }
+        pos = eol + 1;
+    }
+    if (rowHasData) out.push_back(std::move(row));
+    return out;
+}
+
+void SystemQuery::close() {
+    std::lock_guard<std::mutex> lock(mtx);
+    descriptors.clear();   // each fd closes once no readFile() holds it any more
+    memo.clear();
+}
+
+#endif
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: SystemQuery (singleton), QueryRow
+OBJECT: SystemQuery::instance(), used by CPUInfo, OSInfo, MemoryInfo,
+        CompactMemory and GpuSnapshot
+DESCRIPTION: One shared WMI connection (Windows) / set of kept-open
+             procfs descriptors (Linux) for every collector.
+FUNCTIONS:
+    std::vector<QueryRow> rows(source, { fields }, where, ns)
+        Windows: "SELECT f1, f2 FROM source WHERE where" on namespace ns.
+        The connection to ns is made on first use and kept.
+        Linux: parse the "key: value" file at source.
+
+    std::vector<QueryRow> cachedRows(...)
+        rows(), remembered for the rest of the process.
+
+    QueryRow first(...)
+        First row of rows() (empty row if none).
+
+    std::string readFile(const std::string& path)
+        Linux: pread() from offset 0 on a descriptor opened once.
+        Failed opens aren't cached; a failed read drops the descriptor.
+        At most MaxDescriptors (256) stay open, least recently read
+        evicted first.
+
+    void close()
+        Release connections / descriptors (main, before CoUninitialize).
+
+QueryRow getters:
+    has(f), text(f, fallback), integer(f, fallback), real(f, fallback)
+    Missing or NULL fields return the fallback.
+*/
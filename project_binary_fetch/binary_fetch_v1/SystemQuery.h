@@ -0,0 +1,141 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <memory>
+#include <cstdint>
+#include <utility>
+#include <initializer_list>
+
+#ifdef _WIN32
+struct IWbemLocator;
+struct IWbemServices;
+#endif
+
+/*
+ ---------------------------------------------------------
+                     QueryRow Class
+ ---------------------------------------------------------
+
+  One result row: a WMI object (Windows) or one block of
+  "key: value" lines from a procfs file (Linux). Values keep
+  the type they arrived with, and the getters convert when
+  asked for another one, so "17179869184" (WMI hands uint64
+  out as a string) still reads fine through integer().
+*/
+class QueryRow {
+public:
+    enum Kind { Null, Text, Integer, Real };
+
+    struct Value {
+        Kind kind = Null;
+        std::string text;
+        long long integer = 0;
+        double real = 0.0;
+    };
+
+    bool has(const std::string& field) const;     // present and not NULL
+
+    std::string text(const std::string& field, const std::string& fallback = "Unknown") const;
+    long long integer(const std::string& field, long long fallback = -1) const;
+    double real(const std::string& field, double fallback = -1.0) const;
+
+    // Backends fill rows through these
+    void setText(const std::string& field, const std::string& value);
+    void setInteger(const std::string& field, long long value);
+    void setReal(const std::string& field, double value);
+
+private:
+    const Value* find(const std::string& field) const;
+
+    std::vector<std::pair<std::string, Value>> values;   // few fields per row, linear search wins
+};
+
+
+
+/*
+ ---------------------------------------------------------
+                    SystemQuery Class
+ ---------------------------------------------------------
+
+  The one place collectors go for WMI (Windows) or procfs /
+  sysfs (Linux) data.
+
+  Windows: COM security, the WbemLocator and one
+  IWbemServices per namespace are set up on first use and
+  then shared by every collector and worker thread for the
+  rest of the process. Ask for all the properties you need
+  from a class in one rows() call instead of one query per
+  property:
+
+      auto os = SystemQuery::instance().cachedRows("Win32_OperatingSystem",
+                                                   { "Caption", "SerialNumber", "InstallDate" });
+
+  Linux: rows() parses "key: value" files (/proc/cpuinfo,
+  /proc/meminfo, ...), one row per blank-line separated
+  block. readFile() keeps the descriptor open and re-reads it
+  with pread(), so sampling /proc/stat every second is one
+  syscall instead of open/read/close. Only successful opens
+  are kept (a file that appears later, or an open that hit
+  EMFILE once, is retried on the next call), and at most
+  MaxDescriptors of them; the least recently read goes first.
+
+  Nothing here throws; a failed query is just an empty result.
+*/
+class SystemQuery {
+public:
+    static SystemQuery& instance();
+
+    // SELECT fields FROM source [WHERE where]. On Linux source is a file path,
+    // fields filter the keys (empty = all) and where / ns are ignored.
+    std::vector<QueryRow> rows(const std::string& source, std::initializer_list<const char*> fields,
+        const std::string& where = "", const std::string& ns = "ROOT\\CIMV2");
+
+    // Same, but the result is kept for the rest of the process. Only for
+    // classes whose values can't change while we run (hardware, OS install).
+    std::vector<QueryRow> cachedRows(const std::string& source, std::initializer_list<const char*> fields,
+        const std::string& where = "", const std::string& ns = "ROOT\\CIMV2");
+
+    // First row of rows(), or an empty row
+    QueryRow first(const std::string& source, std::initializer_list<const char*> fields,
+        const std::string& where = "", const std::string& ns = "ROOT\\CIMV2");
+
+    // Whole file, re-read from offset 0 on every call ("" if it can't be read)
+    std::string readFile(const std::string& path);
+
+    // Release every connection / descriptor (call before CoUninitialize)
+    void close();
+
+private:
+    SystemQuery() = default;
+
+    static std::string memoKey(const std::string& source, std::initializer_list<const char*> fields,
+        const std::string& where, const std::string& ns);
+
+    std::mutex mtx;
+    std::map<std::string, std::vector<QueryRow>> memo;   // cachedRows() results
+
+#ifdef _WIN32
+    IWbemServices* connect(const std::string& ns);
+
+    bool securityDone = false;
+    IWbemLocator* locator = nullptr;
+    std::map<std::string, IWbemServices*> services;      // namespace -> connection (nullptr = not available)
+#else
+    static const size_t MaxDescriptors = 256;            // well below the usual 1024 RLIMIT_NOFILE
+
+    struct OpenFile;                                     // closes its fd when the last reader lets go
+    struct CachedFile {
+        std::shared_ptr<OpenFile> file;
+        uint64_t lastUse = 0;
+    };
+
+    std::shared_ptr<OpenFile> descriptor(const std::string& path);   // nullptr if it can't be opened now
+    void forget(const std::string& path, const std::shared_ptr<OpenFile>& file);
+
+    std::map<std::string, CachedFile> descriptors;       // path -> open fd, successful opens only
+    uint64_t useCounter = 0;                             // LRU clock for descriptors
+#endif
+};
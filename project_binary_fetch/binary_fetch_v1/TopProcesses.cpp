@@ -0,0 +1,276 @@
+#include "TopProcesses.h"
+#include "Profiler.h"
+#include "ProcessCounter.h"
+
+#include <algorithm>
+#include <thread>
+#include <cstring>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <winternl.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+const unsigned TopProcesses::IntervalMs;
+const unsigned TopProcesses::MinWindowMs;
+
+
+// ---------------- Parsing ----------------
+
+bool TopProcesses::parseStat(const char* text, size_t length, StatFields& out) {
+    // "pid (comm) state ..." - comm may contain spaces and ')', so use the last ')'
+    const char* end = text + length;
+    const char* open = static_cast<const char*>(memchr(text, '(', length));
+    const char* close = end;
+    while (close > text && close[-1] != ')') --close;
+    if (!open || close <= open + 1) return false;
+    out.name.assign(open + 1, close - 1);
+
+    // Fields from 3 (state) on: 14 utime, 15 stime, 22 starttime, 24 rss
+    uint64_t field[25] = { 0 };
+    const char* p = close;
+    int index = 3;
+    for (; index <= 24 && p < end; ++index) {
+        while (p < end && *p == ' ') ++p;
+        uint64_t v = 0;
+        bool number = false;
+        while (p < end && *p >= '0' && *p <= '9') {
+            v = v * 10 + static_cast<uint64_t>(*p++ - '0');
+            number = true;
+        }
+        while (p < end && *p != ' ' && *p != '\n') ++p;
+        field[index] = number ? v : 0;
+    }
+    if (index <= 24) return false;
+
+    out.cpuTicks = field[14] + field[15];
+    out.startTicks = field[22];
+    out.rssPages = field[24];
+    return true;
+}
+
+void TopProcesses::copyName(const std::string& name, char* out, size_t size) {
+    size_t len = (std::min)(name.size(), size - 1);
+    if (len < name.size()) {
+        // Back up over continuation bytes (10xxxxxx) to the lead byte of the cut character
+        while (len > 0 && (static_cast<unsigned char>(name[len]) & 0xC0) == 0x80) --len;
+    }
+    memcpy(out, name.data(), len);
+    out[len] = '\0';
+}
+
+
+// ---------------- Backends ----------------
+
+#ifdef _WIN32
+
+typedef LONG(WINAPI* NtQuerySystemInformationPtr)(SYSTEM_INFORMATION_CLASS, PVOID, ULONG, PULONG);
+
+bool TopProcesses::sample() {
+    static NtQuerySystemInformationPtr query = reinterpret_cast<NtQuerySystemInformationPtr>(
+        GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtQuerySystemInformation"));
+    if (!query) return false;
+
+    // The list grows between the size probe and the call; retry with headroom
+    const LONG lengthMismatch = static_cast<LONG>(0xC0000004);
+    if (scratch.size() < 512 * 1024) scratch.resize(512 * 1024);
+    ULONG needed = 0;
+    LONG status;
+    while ((status = query(SystemProcessInformation, scratch.data(), static_cast<ULONG>(scratch.size()), &needed)) == lengthMismatch) {
+        scratch.resize(needed + 64 * 1024);
+    }
+    if (status < 0) return false;
+
+    current.clear();
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(scratch.data());
+    for (;;) {
+        const SYSTEM_PROCESS_INFORMATION* info = reinterpret_cast<const SYSTEM_PROCESS_INFORMATION*>(p);
+        int pid = static_cast<int>(reinterpret_cast<uintptr_t>(info->UniqueProcessId));
+        if (pid != 0) {   // skip the Idle process
+            // winternl.h hides these in Reserved1: CreateTime at 24, UserTime at 32, KernelTime at 40
+            LARGE_INTEGER createTime, userTime, kernelTime;
+            memcpy(&createTime, reinterpret_cast<const uint8_t*>(info->Reserved1) + 24, sizeof(createTime));
+            memcpy(&userTime, reinterpret_cast<const uint8_t*>(info->Reserved1) + 32, sizeof(userTime));
+            memcpy(&kernelTime, reinterpret_cast<const uint8_t*>(info->Reserved1) + 40, sizeof(kernelTime));
+
+            Record rec = {};
+            rec.pid = pid;
+            rec.startTime = static_cast<uint64_t>(createTime.QuadPart);
+            rec.cpuNs = static_cast<uint64_t>(userTime.QuadPart + kernelTime.QuadPart) * 100;
+            rec.memoryBytes = info->WorkingSetSize;
+            // Convert the whole name first: WideCharToMultiByte fails outright (returns 0)
+            // if the output buffer is too small, so long names can't go straight into rec.name
+            int chars = info->ImageName.Length / sizeof(wchar_t);
+            int bytes = chars > 0 ? WideCharToMultiByte(CP_UTF8, 0, info->ImageName.Buffer, chars,
+                nullptr, 0, nullptr, nullptr) : 0;
+            utf8Name.resize(bytes > 0 ? bytes : 0);
+            if (bytes > 0) {
+                WideCharToMultiByte(CP_UTF8, 0, info->ImageName.Buffer, chars,
+                    &utf8Name[0], bytes, nullptr, nullptr);
+            }
+            copyName(utf8Name, rec.name, sizeof(rec.name));
+            current.push_back(rec);
+        }
+        if (info->NextEntryOffset == 0) break;
+        p += info->NextEntryOffset;
+    }
+
+    std::sort(current.begin(), current.end(), [](const Record& a, const Record& b) { return a.pid < b.pid; });
+    return true;
+}
+
+#else
+
+bool TopProcesses::sample() {
+    if (!ProcessCounter::listPids(pids, scratch)) return false;
+    if (!std::is_sorted(pids.begin(), pids.end())) std::sort(pids.begin(), pids.end());
+
+    static const long tickNs = 1000000000L / sysconf(_SC_CLK_TCK);
+    static const long pageBytes = sysconf(_SC_PAGESIZE);
+
+    current.clear();
+    char path[32];
+    char text[1024];
+    StatFields fields;
+    for (int pid : pids) {
+        snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+        int fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) continue;                  // exited since the listing
+        ssize_t n = read(fd, text, sizeof(text));
+        close(fd);
+        if (n <= 0 || !parseStat(text, static_cast<size_t>(n), fields)) continue;
+
+        Record rec = {};
+        rec.pid = pid;
+        rec.startTime = fields.startTicks;
+        rec.cpuNs = fields.cpuTicks * static_cast<uint64_t>(tickNs);
+        rec.memoryBytes = fields.rssPages * static_cast<uint64_t>(pageBytes);
+        copyName(fields.name, rec.name, sizeof(rec.name));
+        current.push_back(rec);
+    }
+    return true;
+}
+
+#endif
+
+
+// ---------------- Incremental table ----------------
+
+void TopProcesses::merge(double elapsedNs) {
+    // Both lists are sorted by pid: one linear walk pairs each live process
+    // with its previous record; exited pids simply aren't carried over.
+    auto old = records.begin();
+    for (Record& rec : current) {
+        while (old != records.end() && old->pid < rec.pid) ++old;
+        bool same = old != records.end() && old->pid == rec.pid && old->startTime == rec.startTime;
+        rec.cpuPercent = (same && elapsedNs > 0.0 && rec.cpuNs >= old->cpuNs)
+            ? static_cast<float>(100.0 * static_cast<double>(rec.cpuNs - old->cpuNs) / elapsedNs)
+            : 0.0f;
+    }
+    records.swap(current);
+}
+
+bool TopProcesses::takeBaseline() {
+    if (!sample()) return false;
+    merge(0.0);
+    sampledAt = std::chrono::steady_clock::now();
+    hasSample = true;
+    return true;
+}
+
+void TopProcesses::prime() {
+    PROFILE_SCOPE("TopProcesses::prime");
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!hasSample) takeBaseline();
+}
+
+void TopProcesses::refresh() {
+    PROFILE_SCOPE("TopProcesses::refresh");
+    std::lock_guard<std::mutex> lock(mtx);
+
+    if (!hasSample) {
+        // Not primed at launch: nothing to compare against yet
+        if (!takeBaseline()) return;
+        std::this_thread::sleep_for(std::chrono::milliseconds(IntervalMs));
+    }
+    else {
+        // A baseline only a tick or two old would turn rounding into CPU %
+        auto age = std::chrono::steady_clock::now() - sampledAt;
+        auto window = std::chrono::milliseconds(MinWindowMs);
+        if (age < window) std::this_thread::sleep_for(window - age);
+    }
+
+    if (!sample()) return;
+    auto now = std::chrono::steady_clock::now();
+    merge(std::chrono::duration<double, std::nano>(now - sampledAt).count());
+    sampledAt = now;
+}
+
+std::vector<TopProcesses::Entry> TopProcesses::top(size_t n, bool cpu) {
+    std::lock_guard<std::mutex> lock(mtx);
+    order.resize(records.size());
+    for (uint32_t i = 0; i < order.size(); ++i) order[i] = i;
+
+    n = (std::min)(n, order.size());
+    std::partial_sort(order.begin(), order.begin() + n, order.end(), [&](uint32_t a, uint32_t b) {
+        return cpu ? records[a].cpuPercent > records[b].cpuPercent : records[a].memoryBytes > records[b].memoryBytes;
+    });
+
+    std::vector<Entry> list(n);
+    for (size_t i = 0; i < n; ++i) {
+        const Record& rec = records[order[i]];
+        list[i].pid = rec.pid;
+        list[i].name = rec.name;
+        list[i].cpuPercent = rec.cpuPercent;
+        list[i].memoryBytes = rec.memoryBytes;
+    }
+    return list;
+}
+
+std::vector<TopProcesses::Entry> TopProcesses::byCpu(size_t n) {
+    PROFILE_SCOPE("TopProcesses::byCpu");
+    return top(n, true);
+}
+
+std::vector<TopProcesses::Entry> TopProcesses::byMemory(size_t n) {
+    PROFILE_SCOPE("TopProcesses::byMemory");
+    return top(n, false);
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: TopProcesses
+OBJECT: top_procs (main.cpp, "top_processes" section)
+DESCRIPTION: Top CPU / memory consumers from an incrementally updated pid table.
+FUNCTIONS:
+    void prime()
+        Baseline sample, no wait. main() calls it at launch when the plan
+        needs TopProcesses.
+
+    void refresh()
+        New sample merged against the previous one (waits only to make the
+        window MinWindowMs, 50 ms, long). Unprimed, the first call samples
+        twice, IntervalMs (200 ms) apart.
+
+    std::vector<Entry> byCpu(size_t n) / byMemory(size_t n)
+        partial_sort over the latest records.
+
+    static bool parseStat(const char* text, size_t length, StatFields& out)
+        comm, utime + stime, starttime and rss of one /proc/<pid>/stat.
+
+    static void copyName(const std::string& name, char* out, size_t size)
+        Fills Record::name, truncating on a UTF-8 character boundary.
+        Windows converts the full image name into utf8Name first.
+
+RECORD STORE:
+    records (previous sample) and current (new sample) are vectors of
+    POD Records sorted by pid; merge() walks both once and swaps them.
+    A pid whose start time changed was reused and starts from 0 %.
+*/
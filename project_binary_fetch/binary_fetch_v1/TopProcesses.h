@@ -0,0 +1,96 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+/*
+ ---------------------------------------------------------
+                   TopProcesses Class
+ ---------------------------------------------------------
+
+  The processes using the most CPU and the most memory, for
+  the "top_processes" section.
+
+    Windows : one NtQuerySystemInformation(SystemProcessInformation)
+              call per refresh (times, working set, image name)
+    Linux   : ProcessCounter::listPids + /proc/<pid>/stat of the
+              live pids (utime + stime, starttime, rss)
+
+  CPU % needs two samples. The object keeps the previous one as
+  a table of records sorted by pid, so --watch / --agent refreshes
+  compare against it. main() calls prime() at launch, so the
+  section's first refresh only takes the second sample; it waits
+  only if the baseline is younger than MinWindowMs (the OS times
+  advance in 10-16 ms ticks). Without prime() the first refresh
+  takes two samples IntervalMs apart.
+
+  Records live in two vectors that swap roles every refresh
+  (plus reused scratch buffers), so once the process count
+  settles a refresh allocates nothing.
+
+  CPU % is per core, like top: a process busy on 4 cores shows 400.
+*/
+class TopProcesses {
+public:
+    static const unsigned IntervalMs = 200;    // first refresh, if prime() wasn't called
+    static const unsigned MinWindowMs = 50;    // shortest CPU % window after prime()
+
+    // Take the baseline sample now, without waiting. Idempotent.
+    void prime();
+
+    struct Entry {
+        int pid = 0;
+        std::string name;
+        float cpuPercent = 0.0f;
+        uint64_t memoryBytes = 0;    // RSS / working set
+    };
+
+    // Take a new sample (two on the first call)
+    void refresh();
+
+    // Top n of the latest sample, highest first
+    std::vector<Entry> byCpu(size_t n);
+    std::vector<Entry> byMemory(size_t n);
+
+    // Fields of one /proc/<pid>/stat line used here. false if malformed.
+    struct StatFields {
+        std::string name;
+        uint64_t cpuTicks = 0;       // utime + stime
+        uint64_t startTicks = 0;     // starttime (tells a reused pid apart)
+        uint64_t rssPages = 0;
+    };
+    static bool parseStat(const char* text, size_t length, StatFields& out);
+
+    // Copy a UTF-8 name into a fixed buffer of size bytes (NUL included),
+    // cutting before a multi-byte character that wouldn't fit whole
+    static void copyName(const std::string& name, char* out, size_t size);
+
+private:
+    // One process in one sample; POD so the record vectors recycle in place
+    struct Record {
+        int pid;
+        uint64_t startTime;          // backend units, only compared for equality
+        uint64_t cpuNs;              // total CPU time consumed
+        uint64_t memoryBytes;
+        float cpuPercent;
+        char name[32];
+    };
+
+    bool sample();                   // fills current (sorted by pid)
+    bool takeBaseline();             // first sample into records, caller holds mtx
+    void merge(double elapsedNs);    // current + records -> records with cpuPercent
+    std::vector<Entry> top(size_t n, bool cpu);
+
+    std::mutex mtx;
+    std::vector<Record> records;     // previous sample, sorted by pid
+    std::vector<Record> current;     // sample being taken
+    std::vector<uint32_t> order;     // scratch for the top-n selection
+    std::vector<int> pids;           // Linux: listPids output
+    std::vector<char> scratch;       // Linux: getdents64 buffer, Windows: process list
+    std::string utf8Name;            // Windows: image name before copyName
+    std::chrono::steady_clock::time_point sampledAt;
+    bool hasSample = false;
+};
@@ -1,4 +1,5 @@
 #include "UserInfo.h"
+#include "Profiler.h"
 #include <Windows.h>
 #include <lm.h>
 #include <iostream>
@@ -9,6 +10,7 @@ using namespace std;
 // Get current username
 string UserInfo::get_username()
 {
+    PROFILE_SCOPE("UserInfo::get_username");
     char username[UNLEN + 1];
     DWORD size = UNLEN + 1;
     if (GetUserNameA(username, &size))
@@ -18,6 +20,7 @@ string UserInfo::get_username()
 
 string UserInfo::get_domain_name()
 {
+    PROFILE_SCOPE("UserInfo::get_domain_name");
     // First try normal domain name
     char domainName[256];
     DWORD size = 256;
@@ -48,6 +51,7 @@ string UserInfo::get_domain_name()
 // Get user groups
 string UserInfo::get_user_groups()
 {
+    PROFILE_SCOPE("UserInfo::get_user_groups");
     LPLOCALGROUP_USERS_INFO_0 pBuf = NULL;
     DWORD entriesRead = 0;
     DWORD totalEntries = 0;
@@ -85,6 +89,7 @@ string UserInfo::get_user_groups()
 // Get computer name
 string UserInfo::get_computer_name()
 {
+    PROFILE_SCOPE("UserInfo::get_computer_name");
     char computerName[MAX_COMPUTERNAME_LENGTH + 1];
     DWORD size = MAX_COMPUTERNAME_LENGTH + 1;
     if (GetComputerNameA(computerName, &size))
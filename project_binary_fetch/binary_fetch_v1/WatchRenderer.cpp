@@ -0,0 +1,188 @@
+#include "WatchRenderer.h"
+#include "AsciiArt.h"
+#include <iostream>
+#include <algorithm>
+
+// ---------------- Cell splitting ----------------
+
+// Decode one UTF-8 sequence starting at s[i]; returns its byte length
+static size_t utf8Length(unsigned char lead) {
+    if (lead < 0x80) return 1;
+    if ((lead >> 5) == 0x6) return 2;
+    if ((lead >> 4) == 0xE) return 3;
+    if ((lead >> 3) == 0x1E) return 4;
+    return 1;   // stray continuation byte: treat as its own cell
+}
+
+static unsigned long utf8Codepoint(const std::string& s, size_t i, size_t len) {
+    unsigned char c = static_cast<unsigned char>(s[i]);
+    if (len == 1) return c;
+    unsigned long cp = c & (0xFF >> (len + 1));
+    for (size_t k = 1; k < len && i + k < s.size(); ++k) {
+        cp = (cp << 6) | (static_cast<unsigned char>(s[i + k]) & 0x3F);
+    }
+    return cp;
+}
+
+std::vector<WatchRenderer::Cell> WatchRenderer::splitCells(const std::string& line) {
+    std::vector<Cell> cells;
+    std::string style;
+    int col = 0;
+
+    size_t i = 0;
+    while (i < line.size()) {
+        // ANSI escape: ESC [ params final-byte
+        if (line[i] == '\x1b' && i + 1 < line.size() && line[i + 1] == '[') {
+            size_t j = i + 2;
+            while (j < line.size() && !(line[j] >= 0x40 && line[j] <= 0x7E)) ++j;
+            if (j >= line.size()) break;
+
+            if (line[j] == 'm') {
+                std::string params = line.substr(i + 2, j - i - 2);
+                if (params.empty() || params == "0") style.clear();   // reset
+                else style += line.substr(i, j - i + 1);
+            }
+            i = j + 1;
+            continue;
+        }
+
+        size_t len = std::min(utf8Length(static_cast<unsigned char>(line[i])), line.size() - i);
+        unsigned long cp = utf8Codepoint(line, i, len);
+
+        // Same widths LivePrinter's alignment uses; anything outside the BMP is emoji (2 columns)
+        int width = (cp > 0xFFFF) ? 2 : char_display_width(static_cast<wchar_t>(cp));
+
+        if (width == 0 && !cells.empty()) {
+            // combining mark / variation selector: belongs to the previous cell
+            cells.back().glyph += line.substr(i, len);
+        }
+        else {
+            cells.push_back({ line.substr(i, len), style, col, width });
+            col += width;
+        }
+        i += len;
+    }
+    return cells;
+}
+
+bool WatchRenderer::sameCell(const Cell& a, const Cell& b) {
+    return a.col == b.col && a.glyph == b.glyph && a.style == b.style;
+}
+
+
+// ---------------- WatchRenderer ----------------
+
+WatchRenderer::WatchRenderer(const AsciiArt& artRef, const std::vector<std::string>& firstFrame)
+    : art(artRef) {
+    infoColumn = art.getMaxWidth() + art.getSpacing();
+    for (const auto& line : firstFrame) screen.push_back(splitCells(line));
+
+    // LivePrinter prints at least as many rows as the art is tall, then main adds one blank line
+    bottom = std::max(static_cast<int>(firstFrame.size()), art.getHeight()) + 1;
+}
+
+// Rewrite the changed span of one row into out. Cursor is on the bottom line, column 1.
+size_t WatchRenderer::updateRow(size_t row, std::vector<Cell>& next, std::string& out) {
+    std::vector<Cell>& shown = screen[row];
+
+    size_t n = std::max(shown.size(), next.size());
+    size_t first = n, last = 0;
+    for (size_t k = 0; k < n; ++k) {
+        bool same = k < shown.size() && k < next.size() && sameCell(shown[k], next[k]);
+        if (!same) {
+            if (first == n) first = k;
+            last = k;
+        }
+    }
+    if (first == n) return 0;   // row unchanged
+
+    int up = bottom - static_cast<int>(row);
+    int col = (first < next.size()) ? next[first].col : shown[first].col;
+
+    // ESC[nF = up n lines to column 1, ESC[nG = column n (1-based)
+    out += "\x1b[" + std::to_string(up) + "F";
+    out += "\x1b[" + std::to_string(infoColumn + col + 1) + "G";
+
+    size_t written = 0;
+    size_t end = std::min(last + 1, next.size());
+    const std::string* current = nullptr;
+    for (size_t k = first; k < end; ++k) {
+        if (!current || *current != next[k].style) {
+            out += "\x1b[0m" + next[k].style;
+            current = &next[k].style;
+        }
+        out += next[k].glyph;
+        written++;
+    }
+    out += "\x1b[0m";
+
+    // Old row was longer: wipe what is left of it
+    if (last >= next.size()) out += "\x1b[K";
+
+    out += "\x1b[" + std::to_string(up) + "E";   // back down to the bottom line
+
+    shown.swap(next);
+    return written;
+}
+
+void WatchRenderer::redrawAll(const std::vector<std::string>& frame) {
+    // Back to the first row (if it is still on screen) and print everything again
+    int rows = terminal_rows();
+    if (rows > 0 && bottom < rows) std::cout << "\x1b[" << bottom << "F";
+
+    LivePrinter lp(art);
+    for (const auto& line : frame) lp.push(line + "\x1b[K");
+    lp.finish();
+    std::cout << "\x1b[J" << std::endl;
+
+    screen.clear();
+    for (const auto& line : frame) screen.push_back(splitCells(line));
+    bottom = std::max(static_cast<int>(frame.size()), art.getHeight()) + 1;
+}
+
+size_t WatchRenderer::update(const std::vector<std::string>& frame) {
+    if (frame.size() != screen.size()) {
+        redrawAll(frame);
+        return 0;
+    }
+
+    int rows = terminal_rows();
+    std::string out;
+    size_t changed = 0;
+
+    for (size_t row = 0; row < frame.size(); ++row) {
+        // Rows that scrolled out of the window can't be reached any more
+        if (rows > 0 && bottom - static_cast<int>(row) >= rows) continue;
+
+        std::vector<Cell> next = splitCells(frame[row]);
+        changed += updateRow(row, next, out);
+    }
+
+    // One write per frame keeps SSH traffic to a single small packet
+    if (!out.empty()) std::cout << out << std::flush;
+    return changed;
+}
+
+
+/*
+------------------------------------------------
+DOCUMENTATION
+------------------------------------------------
+CLASS: WatchRenderer
+OBJECT: watch (main.cpp, only with --watch)
+DESCRIPTION: Differential redraw for --watch: only changed cells are rewritten.
+FUNCTIONS:
+    WatchRenderer(const AsciiArt& art, const std::vector<std::string>& firstFrame)
+        Remember what the first (normal) print put on screen.
+
+    size_t update(const std::vector<std::string>& frame)
+        Diff frame against the screen and rewrite changed spans.
+        Row count changed -> full redraw instead.
+
+ESCAPES USED:
+    ESC[nF  cursor up n lines, column 1
+    ESC[nE  cursor down n lines, column 1
+    ESC[nG  cursor to column n
+    ESC[K   clear to end of line
+    ESC[J   clear below (full redraw only)
+*/
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+class AsciiArt;
+
+/*
+ ---------------------------------------------------------
+                   WatchRenderer Class
+ ---------------------------------------------------------
+
+  Drives "--watch <interval>". The first frame is printed the
+  normal way (LivePrinter). After that only the dynamic
+  sections are re-collected, and every new frame is compared
+  with what is on screen cell by cell:
+
+    - a cell = one visible character + the color it is drawn in
+    - per row, only the span between the first and the last
+      changed cell is rewritten, using cursor addressing
+    - art and unchanged rows are never touched
+
+  When the number of rows changes (a disk appears, a GPU line
+  disappears) the frame is redrawn in full once.
+*/
+class WatchRenderer {
+public:
+    // firstFrame = the lines that are already on screen. The cursor
+    // must sit on the line under the output (after lp.finish + endl).
+    WatchRenderer(const AsciiArt& artRef, const std::vector<std::string>& firstFrame);
+
+    // Bring the screen in line with frame. Returns how many cells were rewritten.
+    size_t update(const std::vector<std::string>& frame);
+
+private:
+    struct Cell {
+        std::string glyph;   // UTF-8 bytes of one visible character
+        std::string style;   // SGR sequences active for it ("" = default color)
+        int col;             // column inside the info area
+        int width;           // 1 or 2 terminal columns
+    };
+
+    static std::vector<Cell> splitCells(const std::string& line);
+    static bool sameCell(const Cell& a, const Cell& b);
+
+    void redrawAll(const std::vector<std::string>& frame);
+    size_t updateRow(size_t row, std::vector<Cell>& next, std::string& out);
+
+    const AsciiArt& art;
+    std::vector<std::vector<Cell>> screen;   // cells currently shown, per row
+    int infoColumn;                          // 0-based screen column where info text starts
+    int bottom;                              // rows between the first info row and the cursor
+};
@@ -1,25 +1,29 @@
 #include "compact_disk_info.h"
-#include <windows.h>
+#include "Profiler.h"
 
 DiskInfo::DiskInfo() {
+    PROFILE_SCOPE("DiskInfo::DiskInfo");
     // Constructor (empty)
 }
 
-// Calculate used percentage for a single disk (integer)
-int DiskInfo::calculateUsedPercentage(const std::string& driveLetter) {
-    ULARGE_INTEGER freeBytesAvailable, totalNumberOfBytes, totalNumberOfFreeBytes;
+// Fixed, removable and network disks ("C:\\" ... on Windows, mount points on Linux),
+// all probed concurrently so one dead share can't hold up the others
+void DiskInfo::probeDisks() {
+    std::vector<MountTable::Mount> all = MountTable::list();
+    disks.clear();
+    for (const auto& m : all) {
+        if (m.kind != MountTable::Kind::Other) disks.push_back(m);
+    }
+    MountTable::probe(disks, MountTable::DefaultTimeoutMs);
+    probed = true;
+}
 
-    if (GetDiskFreeSpaceExA(driveLetter.c_str(),
-        &freeBytesAvailable,
-        &totalNumberOfBytes,
-        &totalNumberOfFreeBytes)) {
+// Calculate used percentage for a single disk (integer)
+int DiskInfo::calculateUsedPercentage(const MountTable::Mount& disk) {
+    if (disk.state == MountTable::State::Unresponsive) return -1;
 
-        if (totalNumberOfBytes.QuadPart > 0) {
-            return static_cast<int>(
-                ((totalNumberOfBytes.QuadPart - totalNumberOfFreeBytes.QuadPart) * 100)
-                / totalNumberOfBytes.QuadPart
-                );
-        }
+    if (disk.state == MountTable::State::Ok && disk.totalBytes > 0) {
+        return static_cast<int>(((disk.totalBytes - disk.freeBytes) * 100) / disk.totalBytes);
     }
 
     return 0;
@@ -27,50 +31,35 @@ int DiskInfo::calculateUsedPercentage(const std::string& driveLetter) {
 
 // Get all disk usage (%)
 std::vector<std::pair<std::string, int>> DiskInfo::getAllDiskUsage() {
+    PROFILE_SCOPE("DiskInfo::getAllDiskUsage");
     std::vector<std::pair<std::string, int>> diskList;
 
-    for (char drive = 'A'; drive <= 'Z'; ++drive) {
-        std::string driveLetter = std::string(1, drive) + ":\\";
-
-        if (GetDriveTypeA(driveLetter.c_str()) == DRIVE_FIXED ||
-            GetDriveTypeA(driveLetter.c_str()) == DRIVE_REMOVABLE) {
-
-            int used = calculateUsedPercentage(driveLetter);
-            diskList.push_back({ driveLetter, used });
-        }
+    // Usage changes between --watch frames: probe again every time
+    probeDisks();
+    for (const auto& d : disks) {
+        diskList.push_back({ d.mountPoint, calculateUsedPercentage(d) });
     }
 
     return diskList;
 }
 
 // Helper: calculate capacity in GB
-int DiskInfo::calculateCapacityGB(const std::string& driveLetter) {
-    ULARGE_INTEGER freeBytesAvailable, totalNumberOfBytes, totalNumberOfFreeBytes;
+int DiskInfo::calculateCapacityGB(const MountTable::Mount& disk) {
+    if (disk.state == MountTable::State::Unresponsive) return -1;
 
-    if (GetDiskFreeSpaceExA(driveLetter.c_str(),
-        &freeBytesAvailable,
-        &totalNumberOfBytes,
-        &totalNumberOfFreeBytes)) {
-        // Convert bytes to GB
-        return static_cast<int>(totalNumberOfBytes.QuadPart / (1024 * 1024 * 1024));
-    }
-
-    return 0;
+    // Convert bytes to GB
+    return static_cast<int>(disk.totalBytes / (1024ull * 1024 * 1024));
 }
 
 // Get all disk capacities in GB
 std::vector<std::pair<std::string, int>> DiskInfo::getDiskCapacity() {
+    PROFILE_SCOPE("DiskInfo::getDiskCapacity");
     std::vector<std::pair<std::string, int>> diskCapList;
 
-    for (char drive = 'A'; drive <= 'Z'; ++drive) {
-        std::string driveLetter = std::string(1, drive) + ":\\";
-
-        if (GetDriveTypeA(driveLetter.c_str()) == DRIVE_FIXED ||
-            GetDriveTypeA(driveLetter.c_str()) == DRIVE_REMOVABLE) {
-
-            int capacity = calculateCapacityGB(driveLetter);
-            diskCapList.push_back({ driveLetter, capacity });
-        }
+    // Reuses the probe getAllDiskUsage() just made
+    if (!probed) probeDisks();
+    for (const auto& d : disks) {
+        diskCapList.push_back({ d.mountPoint, calculateCapacityGB(d) });
     }
 
     return diskCapList;
@@ -1,21 +1,28 @@
 #pragma once
 #include <vector>
 #include <string>
+#include "MountTable.h"
 
 class DiskInfo {
 public:
     DiskInfo();  // Constructor
 
-    // Get usage of all disks as integers (%)
+    // Get usage of all disks as integers (%), -1 = unresponsive (hung network mount)
     std::vector<std::pair<std::string, int>> getAllDiskUsage();
 
-    // Get capacity of all disks as integers (GB)
+    // Get capacity of all disks as integers (GB), -1 = unresponsive
     std::vector<std::pair<std::string, int>> getDiskCapacity();
 
 private:
+    // Probe every disk at once (MountTable, per-disk timeout)
+    void probeDisks();
+
     // Helper: calculate used percentage
-    int calculateUsedPercentage(const std::string& driveLetter);
+    int calculateUsedPercentage(const MountTable::Mount& disk);
 
     // Helper: calculate total capacity in GB
-    int calculateCapacityGB(const std::string& driveLetter);
+    int calculateCapacityGB(const MountTable::Mount& disk);
+
+    std::vector<MountTable::Mount> disks;   // last probe, shared by both getters
+    bool probed = false;
 };
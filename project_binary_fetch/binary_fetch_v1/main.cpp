@@ -8,6 +8,9 @@
 #include <fstream>        // File stream operations (reading/writing files) 
 #include <string>         // Standard string class and methods ✍
 #include <regex>          // Regular expressions for pattern matching 
+#include <cstdlib>        // std::quick_exit (leaving late sections behind) 
+#include <chrono>         // Fetch timing for --timings 
+#include <thread>         // --watch sleeps between frames 
 #include <windows.h>      // Core Windows API functions (handles, processes) 
 #include <shlobj.h>       // Shell object functions (folder paths, UI) 
 #include <direct.h>       // Directory and file handling functions (_mkdir, _chdir) 
@@ -43,12 +46,33 @@
 #include "CompactScreen.h"      // Lightweight screen resolution summary
 #include "CompactSystem.h"      // Lightweight motherboard/system summary
 #include "CompactGPU.h"         // Lightweight GPU summary
+#include "GpuSnapshot.h"        // One shared GPU probe behind every GPU section
 #include "CompactPerformance.h" // Lightweight performance stats
 #include "CompactUser.h"        // Lightweight user info
 #include "CompactNetwork.h"     // Lightweight network info
 #include "compact_disk_info.h"  // Lightweight storage/disk info (compact mode)
 #include "TimeInfo.h"           //returns current time info (second, minute, hour, day, week, month, year, leap year, etc)
 
+// ------------------ Fetch Engine ------------------
+#include "FetchScheduler.h"     // Runs sections concurrently, prints them in config order
+#include "CollectionPlan.h"     // Config -> which collectors are needed, lazy construction
+#include "StaticFactsCache.h"   // Per-boot cache of facts that never change (CPU brand, BIOS, RAM modules)
+#include "CommandLine.h"        // --refresh-cache, --timings, --agent, --help
+#include "Agent.h"              // --agent resident mode + snapshot client
+#include "WatchRenderer.h"      // --watch differential redraw
+#include "Profiler.h"           // --timings latency table, --trace Chrome trace
+#include "SystemQuery.h"        // One WMI connection (procfs descriptors on Linux) for all collectors
+#include "CpuSampler.h"         // Background CPU usage sampler (no sleeping in usage getters)
+#include "CpuCores.h"           // Per-core load / clock heat row
+#include "TopProcesses.h"       // Top CPU / memory processes (incremental pid table)
+#include "PressureInfo.h"       // PSI stall averages, load / run queue, context switch rate
+#include "NumaInfo.h"           // Per-node CPUs, memory and distance matrix
+#include "MemorySnapshot.h"     // One /proc/meminfo / GlobalMemoryStatusEx reading for every RAM figure
+#include "MemoryBench.h"        // Opt-in measured bandwidth / latency (cached per boot)
+#include "MemoryPressure.h"     // Swap rates, zswap / zram, huge pages, dirty pages, faults
+#include "CgroupLimits.h"       // cgroup v2 CPU / memory limits next to the host totals
+#include "Smbios.h"             // Rated DIMM speed for the bandwidth comparison
+
 
 
 #include "nlohmann/json.hpp"
@@ -80,34 +104,28 @@ it is a sign that the logic should be moved into a new module.
 */
 
 
-int main(){
+int main(int argc, char* argv[]){
 
-    // Initialize COM 
-    /*
-	 if you're a beginner and don't know what's com...here's a brief explanation:
+    // ------------------ Command line ------------------
+    CommandLineOptions options = parseCommandLine(argc, argv);
+    if (options.showHelp) {
+        printUsage();
+        return 0;
+    }
+    for (const auto& arg : options.unknown) {
+        std::cout << "Warning: unknown option " << arg << " (see --help)" << std::endl;
+    }
+    const auto fetchStart = std::chrono::steady_clock::now();
 
-     * 1. Provides "Native C++" wrappers for complex COM interfaces.
-     * 2. Includes _com_ptr_t (Smart Pointers) for automatic memory management.
-     * 3. Includes _com_error for C++ exception handling (try/catch) instead of HRESULTs.
-     * 4. Simplifies BSTR (string) and VARIANT data type conversions.
-     * 5. Makes COM code look like standard C++ rather than low-level C.
+    // Collector spans; not in agent mode, which would record forever
+    if ((options.showTimings || !options.tracePath.empty()) && !options.agentMode) {
+        Profiler::instance().enable();
+    }
 
-    
+    // CPU time counters are sampled in the background from here on, so by the
+    // time a section asks for CPU usage there is already a window to report
+    CpuSampler::instance().start();
 
-     why I used com here ?
-     -> COM initialization required for WMI (Windows Management
-     Instrumentation) queries used by system info modules to retrieve
-     hardware/software data via Win32 classes
-    
-    */
-
-	//com initialization
-    HRESULT hr = CoInitializeEx(0, COINIT_MULTITHREADED);
-    if (FAILED(hr)) {
-        std::cout << "Failed to initialize COM library. Error: 0x"
-            << std::hex << hr << std::endl;
-        return 1;
-    }
 
 
 
@@ -172,13 +190,13 @@ int main(){
     } 
 
     // ========== CONFIG LOADING ==========
-    json config;
+    json loaded_config;
     bool config_loaded = false; // must be false by default
 
     std::ifstream config_file(configPath);
     if (config_file.is_open()) {
         try {
-            config = json::parse(config_file);
+            loaded_config = json::parse(config_file);
             config_loaded = true; // if the json is successfully loaded
         }
         catch (const std::exception& e) {
@@ -192,10 +210,75 @@ int main(){
         std::cout << "Warning: Could not open config file: " << configPath << std::endl;
     }
 
+    // Sections run on worker threads and all read the config at the same time,
+    // so from here on it is read-only (const operator[] never inserts keys)
+    const json config = std::move(loaded_config);
+    const uint64_t configHash = agentConfigHash(config.dump());
+
+    auto elapsedMs = [&]() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - fetchStart).count();
+        };
+
+    // ------------------ Agent fast path ------------------
+    // If "binaryfetch --agent" is running with this same config, its snapshot
+    // already holds every line: render it and skip COM / WMI / PDH entirely.
+    if (!options.agentMode && !options.noAgent && !options.refreshCache && options.watchMs == 0) {
+        AgentSnapshot snapshot;
+        if (AgentClient::fetch(agentSocketPath(), configHash, snapshot)) {
+            LivePrinter lp(art);
+            for (const auto& line : snapshot.lines) lp.push(line);
+            lp.finish();
+            std::cout << std::endl;
+
+            if (options.showTimings) {
+                std::cout << "Fetch time    : " << elapsedMs() << " ms" << std::endl;
+                std::cout << "Source        : agent snapshot (" << (agentNowMs() - snapshot.takenAtMs) << " ms old)" << std::endl;
+            }
+            return 0;
+        }
+    }
+
+    // Initialize COM 
+    /*
+	 if you're a beginner and don't know what's com...here's a brief explanation:
+
+     * 1. Provides "Native C++" wrappers for complex COM interfaces.
+     * 2. Includes _com_ptr_t (Smart Pointers) for automatic memory management.
+     * 3. Includes _com_error for C++ exception handling (try/catch) instead of HRESULTs.
+     * 4. Simplifies BSTR (string) and VARIANT data type conversions.
+     * 5. Makes COM code look like standard C++ rather than low-level C.
+
+    
+
+     why I used com here ?
+     -> COM initialization required for WMI (Windows Management
+     Instrumentation) queries used by system info modules to retrieve
+     hardware/software data via Win32 classes
+    
+    */
+
+	//com initialization
+    HRESULT hr = CoInitializeEx(0, COINIT_MULTITHREADED);
+    if (FAILED(hr)) {
+        std::cout << "Failed to initialize COM library. Error: 0x"
+            << std::hex << hr << std::endl;
+        return 1;
+    }
+
+    // Set the process-wide COM security once, before any worker thread runs a
+    // WMI query. Collectors that call it again just get RPC_E_TOO_LATE.
+    CoInitializeSecurity(NULL, -1, NULL, NULL,
+        RPC_C_AUTHN_LEVEL_DEFAULT, RPC_C_IMP_LEVEL_IMPERSONATE,
+        NULL, EOAC_NONE, NULL);
+
+    // Facts that can't change within a boot are read from BinaryFetch_Cache.bin
+    // (next to the config) instead of being probed again
+    StaticFactsCache::instance().open(configDir + "\\BinaryFetch_Cache.bin", options.refreshCache);
+
 	// Color map (for ANSI escape codes) 
     // for beginners, we're simply assign colors like how we 
     // assin vaules in variables 
-    map<string, string> colors = {
+    const map<string, string> colors = {
         {"red", "\033[31m"}, {"green", "\033[32m"}, {"yellow", "\033[33m"},
         {"blue", "\033[34m"}, {"magenta", "\033[35m"}, {"cyan", "\033[36m"},
         {"white", "\033[37m"}, {"bright_red", "\033[91m"}, {"bright_green", "\033[92m"},
@@ -208,21 +291,21 @@ int main(){
     // here, we've assigned the default color as white 
     auto getColor = [&](const std::string& section, const std::string& key, const std::string& defaultColor = "white") -> std::string 
      {
-        if (!config_loaded || !config.contains(section)) return colors[defaultColor];
+        if (!config_loaded || !config.contains(section)) return colors.at(defaultColor);
 
         // First...try to get the color from the nested "colors" object
         if (config[section].contains("colors") && config[section]["colors"].contains(key)) 
         {
             std::string colorName = config[section]["colors"][key].get<std::string>();
-            return colors.count(colorName) ? colors[colorName] : colors[defaultColor];
+            return colors.count(colorName) ? colors.at(colorName) : colors.at(defaultColor);
         }
         // next...try to get the color directly from the section
         if (config[section].contains(key)) {
             std::string colorName = config[section][key].get<std::string>();
-            return colors.count(colorName) ? colors[colorName] : colors[defaultColor];
+            return colors.count(colorName) ? colors.at(colorName) : colors.at(defaultColor);
         }
 
-        return colors[defaultColor];
+        return colors.at(defaultColor);
      };
 
     // check for each section, is it enabled or not (Aka Core-Module)
@@ -273,7 +356,16 @@ int main(){
         return config[module][section].value(key, true);
         };
 
-    std::string r = colors["reset"];
+    // per-section time budget in ms ("deadline_ms"), 0 / missing = no deadline.
+    // A section that misses it prints a placeholder and is patched in later.
+    auto deadlineOf = [&](const std::string& section) -> unsigned {
+        if (options.watchMs > 0) return 0;   // --watch keeps running anyway, never abandon a section
+        if (!config_loaded || !config.contains(section)) return 0;
+        int ms = config[section].value("deadline_ms", 0);
+        return ms > 0 ? static_cast<unsigned>(ms) : 0;
+        };
+
+    std::string r = colors.at("reset");
 
 	// Anyway....this is how we're allowed to print emojis in C++ console
     // :cout << u8"😄 ❤️ 🎉 🚀 ⭐ 🐱 🍕 🎮 😭 🌈\n"; 
@@ -282,33 +374,57 @@ int main(){
     // Create LivePrinter
     LivePrinter lp(art);
 
-
-    // create objects of all classes here 
-    OSInfo os;                           
-    CPUInfo cpu;
-    MemoryInfo ram;
-    GPUInfo obj_gpu;
-    DetailedGPUInfo detailed_gpu_info;
-    StorageInfo storage;
-    NetworkInfo net;
-    UserInfo user;
-    PerformanceInfo perf;
-    DisplayInfo di;
-    ExtraInfo extra;
-    SystemInfo sys;
-
-    CompactAudio c_audio;
-    CompactOS c_os;
-    CompactCPU c_cpu;
+    // Every enabled section below is registered as a task and runs concurrently.
+    // Inside a task, "lp" is the section's own SectionPrinter; the scheduler
+    // forwards its lines to the real LivePrinter in config order.
+    FetchScheduler sched;
+
+
+    // Compile the config into the set of collectors this run actually reads.
+    // Collectors are built on first use, so a disabled field never touches
+    // WMI / PDH / DXGI / the network at all.
+    CollectionPlan plan(config, config_loaded);
+
+    // create objects of all classes here (constructed lazily, see CollectionPlan.h)
+    LazyCollector<OSInfo> os(plan, Collector::OS);
+    LazyCollector<CPUInfo> cpu(plan, Collector::CPU);
+    LazyCollector<MemoryInfo> ram(plan, Collector::Memory);
+    LazyCollector<GPUInfo> obj_gpu(plan, Collector::GPU);
+    LazyCollector<DetailedGPUInfo> detailed_gpu_info(plan, Collector::DetailedGPU);
+    LazyCollector<StorageInfo> storage(plan, Collector::Storage);
+    LazyCollector<NetworkInfo> net(plan, Collector::Network);
+    LazyCollector<UserInfo> user(plan, Collector::User);
+    LazyCollector<PerformanceInfo> perf(plan, Collector::Performance);
+    LazyCollector<DisplayInfo> di(plan, Collector::Display);
+    LazyCollector<SystemInfo> sys(plan, Collector::System);
+
+    LazyCollector<CompactAudio> c_audio(plan, Collector::CompactAudio);
+    LazyCollector<CompactOS> c_os(plan, Collector::CompactOS);
+    LazyCollector<CompactCPU> c_cpu(plan, Collector::CompactCPU);
    // CompactScreen c_screen;
-    CompactMemory c_memory;
-    CompactSystem c_system;
-    CompactGPU c_gpu;
-    CompactPerformance c_perf;
-    CompactUser c_user;
-    CompactNetwork c_net;
-    DiskInfo disk;
-    TimeInfo time;
+    LazyCollector<CompactMemory> c_memory(plan, Collector::CompactMemory);
+    LazyCollector<CompactGPU> c_gpu(plan, Collector::CompactGPU);
+    LazyCollector<CompactPerformance> c_perf(plan, Collector::CompactPerformance);
+    LazyCollector<CompactUser> c_user(plan, Collector::CompactUser);
+    LazyCollector<CompactNetwork> c_net(plan, Collector::CompactNetwork);
+    LazyCollector<DiskInfo> disk(plan, Collector::Disk);
+    LazyCollector<CpuCores> cpu_cores(plan, Collector::CpuCores);
+    LazyCollector<TopProcesses> top_procs(plan, Collector::TopProcesses);
+    LazyCollector<PressureInfo> pressure(plan, Collector::Pressure);
+    LazyCollector<NumaInfo> numa(plan, Collector::Numa);
+    LazyCollector<MemoryPressure> mem_pressure(plan, Collector::MemoryPressure);
+
+    // Clock readings ride along on the CPU sampler thread once a section shows a clock
+    if ((isEnabled("compact_cpu") && isSubEnabled("compact_cpu", "show_clock"))
+        || (isEnabled("cpu_info") && isSubEnabled("cpu_info", "show_speed"))
+        || (isEnabled("cpu_cores") && isSubEnabled("cpu_cores", "show_frequency"))) {
+        CpuSampler::instance().trackClocks();
+    }
+
+    // Baselines for sections that report rates, taken at launch so their
+    // first refresh compares against this instead of sleeping
+    if (plan.needs(Collector::TopProcesses)) top_procs->prime();
+    if (plan.needs(Collector::MemoryPressure)) mem_pressure->prime();
 
 
 
@@ -328,7 +444,7 @@ int main(){
         
 
         // BinaryFetch Header
-        if (isEnabled("header")) {
+        if (isEnabled("header")) sched.add("header", deadlineOf("header"), [&](SectionPrinter& lp) {
             std::ostringstream ss;
             ss << getColor("header", "prefix_color", "bright_red") << "~>> " << r
                 << getColor("header", "title_color", "green") << "BinaryFetch" << r
@@ -337,13 +453,12 @@ int main(){
             if (isSubEnabled("header", "show_line")) ss << getColor("header", "line_color", "white") << "_____________________________________________________" << r << " ";
 
             lp.push(ss.str());
-        }
+        });
 
 
 
         // Compact Time
-        if (isEnabled("compact_time"))
-        {
+        if (isEnabled("compact_time")) sched.add("compact_time", deadlineOf("compact_time"), [&](SectionPrinter& lp) {
             TimeInfo time;
             std::ostringstream ss;
 
@@ -351,13 +466,13 @@ int main(){
 
             // Helper to get colors from nested time structure
             auto getTimeColor = [&](const std::string& subsection, const std::string& key, const std::string& defaultColor = "white") -> std::string {
-                if (!config_loaded || !config.contains("compact_time")) return colors[defaultColor];
-                if (!config["compact_time"].contains(subsection)) return colors[defaultColor];
-                if (!config["compact_time"][subsection].contains("colors")) return colors[defaultColor];
-                if (!config["compact_time"][subsection]["colors"].contains(key)) return colors[defaultColor];
+                if (!config_loaded || !config.contains("compact_time")) return colors.at(defaultColor);
+                if (!config["compact_time"].contains(subsection)) return colors.at(defaultColor);
+                if (!config["compact_time"][subsection].contains("colors")) return colors.at(defaultColor);
+                if (!config["compact_time"][subsection]["colors"].contains(key)) return colors.at(defaultColor);
 
                 std::string colorName = config["compact_time"][subsection]["colors"][key].get<std::string>();
-                return colors.count(colorName) ? colors[colorName] : colors[defaultColor];
+                return colors.count(colorName) ? colors.at(colorName) : colors.at(defaultColor);
                 };
 
             // ---------- TIME SECTION ----------
@@ -474,10 +589,10 @@ int main(){
             }
 
             lp.push(ss.str());
-        }
+        });
 
         // Compact OS
-        if (isEnabled("compact_os")) {
+        if (isEnabled("compact_os")) sched.add("compact_os", deadlineOf("compact_os"), [&](SectionPrinter& lp) {
             std::ostringstream ss;
 
             if (isSubEnabled("compact_os", "show_emoji")) ss << getColor("compact_os", "emoji_color", "white") << u8"🚀 " << r ;
@@ -486,26 +601,26 @@ int main(){
                 << getColor("compact_os", "OS_:", "white") << ": " << r;
 
             
-            if (isSubEnabled("compact_os", "show_name")) ss << getColor("compact_os", "name_color", "white") << c_os.getOSName() << r << " ";
-            if (isSubEnabled("compact_os", "show_build")) ss << getColor("compact_os", "build_color", "white") << c_os.getOSBuild() << r;
+            if (isSubEnabled("compact_os", "show_name")) ss << getColor("compact_os", "name_color", "white") << c_os->getOSName() << r << " ";
+            if (isSubEnabled("compact_os", "show_build")) ss << getColor("compact_os", "build_color", "white") << c_os->getOSBuild() << r;
 
             if (isSubEnabled("compact_os", "show_arch")) {
                 ss << getColor("compact_os", "(", "white") << " (" << r
-                    << getColor("compact_os", "arch_color", "white") << c_os.getArchitecture() << r
+                    << getColor("compact_os", "arch_color", "white") << c_os->getArchitecture() << r
                     << getColor("compact_os", ")", "white") << ")" << r;
             }
 
             if (isSubEnabled("compact_os", "show_uptime")) {
                 ss << getColor("compact_os", "(", "white") << " (" << r
                     << getColor("compact_os", "uptime_label_color", "white") << "uptime: " << r
-                    << getColor("compact_os", "uptime_value_color", "white") << c_os.getUptime() << r
+                    << getColor("compact_os", "uptime_value_color", "white") << c_os->getUptime() << r
                     << getColor("compact_os", ")", "white") << ")" << r;
             }
             lp.push(ss.str());
-        }
+        });
 
         // Compact CPU
-        if (isEnabled("compact_cpu")) {
+        if (isEnabled("compact_cpu")) sched.add("compact_cpu", deadlineOf("compact_cpu"), [&](SectionPrinter& lp) {
             std::ostringstream ss;
 
             if (isSubEnabled("compact_cpu", "show_emoji")) ss << getColor("compact_cpu", "emoji_color", "white") << u8"🧠 " << r;
@@ -513,27 +628,94 @@ int main(){
             ss << getColor("compact_cpu", "CPU", "white") << "CPU" << r
                 << getColor("compact_cpu", "CPU_:", "white") << ": " << r;
 
-            if (isSubEnabled("compact_cpu", "show_name")) ss << getColor("compact_cpu", "name_color", "white") << c_cpu.getCPUName() << r;
+            if (isSubEnabled("compact_cpu", "show_name")) ss << getColor("compact_cpu", "name_color", "white") << c_cpu->getCPUName() << r;
 
             if (isSubEnabled("compact_cpu", "show_cores") || isSubEnabled("compact_cpu", "show_threads")) {
                 ss << getColor("compact_cpu", "(", "white") << " (" << r;
-                if (isSubEnabled("compact_cpu", "show_cores")) ss << getColor("compact_cpu", "core_color", "white") << c_cpu.getCPUCores() << r << getColor("compact_cpu", "text_color", "white") << "C" << r;
+                if (isSubEnabled("compact_cpu", "show_cores")) ss << getColor("compact_cpu", "core_color", "white") << c_cpu->getCPUCores() << r << getColor("compact_cpu", "text_color", "white") << "C" << r;
                 if (isSubEnabled("compact_cpu", "show_cores") && isSubEnabled("compact_cpu", "show_threads")) ss << getColor("compact_cpu", "separator_color", "white") << "/" << r;
-                if (isSubEnabled("compact_cpu", "show_threads")) ss << getColor("compact_cpu", "thread_color", "white") << c_cpu.getCPUThreads() << r << getColor("compact_cpu", "text_color", "white") << "T" << r;
+                if (isSubEnabled("compact_cpu", "show_threads")) ss << getColor("compact_cpu", "thread_color", "white") << c_cpu->getCPUThreads() << r << getColor("compact_cpu", "text_color", "white") << "T" << r;
                 ss << getColor("compact_cpu", ")", "white") << ")" << r;
             }
+
+            // In a container the host thread count says little: what cpu.max / cpuset allow
+            if (isSubEnabled("compact_cpu", "show_cgroup")) {
+                std::string cpus = CgroupLimits::current().cpuText(std::atoi(c_cpu->getCPUThreads().c_str()));
+                if (!cpus.empty()) {
+                    ss << getColor("compact_cpu", "(", "white") << " [" << r
+                        << getColor("compact_cpu", "text_color", "white") << "cgroup: " << r
+                        << getColor("compact_cpu", "cgroup_color", "white") << cpus << r
+                        << getColor("compact_cpu", ")", "white") << "]" << r;
+                }
+            }
              
             if (isSubEnabled("compact_cpu", "show_clock")) {
                 ss << std::fixed << std::setprecision(2)
                     << getColor("compact_cpu", "at_symbol_color", "white") << " @" << r
-                    << getColor("compact_cpu", "clock_color", "white") << " " << c_cpu.getClockSpeed() << " GHz" << r;
+                    << getColor("compact_cpu", "clock_color", "white") << " " << c_cpu->getClockSpeed() << " GHz" << r;
+
+                std::string range = isSubEnabled("compact_cpu", "show_clock_range") ? c_cpu->getClockRange() : "";
+                if (!range.empty()) {
+                    ss << getColor("compact_cpu", "(", "white") << " (" << r
+                        << getColor("compact_cpu", "clock_color", "white") << range << r
+                        << getColor("compact_cpu", ")", "white") << ")" << r;
+                }
             }
             lp.push(ss.str());
-        }
+        });
+
+        // Per-core heat row: one glyph per logical CPU, wrapped every cores_per_row
+        if (isEnabled("cpu_cores")) sched.add("cpu_cores", deadlineOf("cpu_cores"), [&](SectionPrinter& lp) {
+            int configured = (config_loaded && config.contains("cpu_cores")) ? config["cpu_cores"].value("cores_per_row", 64) : 64;
+            size_t perRow = configured > 0 ? static_cast<size_t>(configured) : 64;
+
+            CpuCores::Palette palette{
+                getColor("cpu_cores", "low_color", "green"),
+                getColor("cpu_cores", "mid_color", "yellow"),
+                getColor("cpu_cores", "high_color", "red"),
+                r
+            };
+
+            auto addRow = [&](const std::string& label, const std::vector<float>& values, const std::vector<float>& full,
+                float fullScale, const std::string& summary) {
+                std::string indent(label.size() + 2, ' ');
+                for (size_t begin = 0; begin < values.size(); begin += perRow) {
+                    std::ostringstream ss;
+                    if (begin == 0) {
+                        if (isSubEnabled("cpu_cores", "show_emoji")) ss << getColor("cpu_cores", "emoji_color", "white") << u8"🧩 " << r;
+                        ss << getColor("cpu_cores", "label_color", "white") << label << r
+                            << getColor("cpu_cores", "label_color", "white") << ": " << r;
+                    }
+                    else {
+                        if (isSubEnabled("cpu_cores", "show_emoji")) ss << "   ";
+                        ss << indent;
+                    }
+                    ss << CpuCores::heatRow(values, full, fullScale, begin, begin + perRow, palette);
+                    if (begin + perRow >= values.size()) ss << getColor("cpu_cores", "text_color", "white") << " " << summary << r;
+                    lp.push(ss.str());
+                }
+                };
+
+            if (isSubEnabled("cpu_cores", "show_usage")) {
+                std::vector<float> usage = cpu_cores->usagePercent();
+                std::ostringstream avg;
+                avg << "avg " << std::fixed << std::setprecision(0) << (std::max)(CpuCores::average(usage), 0.0f) << "%";
+                addRow("Core load ", usage, {}, 100.0f, avg.str());
+            }
+
+            if (isSubEnabled("cpu_cores", "show_frequency")) {
+                std::vector<float> mhz = cpu_cores->currentMHz();
+                float avgMHz = CpuCores::average(mhz);
+                std::ostringstream avg;
+                if (avgMHz > 0.0f) avg << "avg " << std::fixed << std::setprecision(2) << avgMHz / 1000.0f << " GHz";
+                else avg << "clock unavailable";
+                addRow("Core clock", mhz, cpu_cores->maxMHz(), 0.0f, avg.str());
+            }
+        });
 
 
         // Compact GPU
-        if (isEnabled("compact_gpu")) {
+        if (isEnabled("compact_gpu")) sched.add("compact_gpu", deadlineOf("compact_gpu"), [&](SectionPrinter& lp) {
             std::ostringstream ss;
 
             if (isSubEnabled("compact_gpu", "show_emoji")) ss << getColor("compact_gpu", "emoji_color", "white") << u8"🔥" << r << " ";
@@ -541,32 +723,32 @@ int main(){
             ss << getColor("compact_gpu", "GPU", "white") << "GPU" << r
                 << getColor("compact_gpu", "GPU_:", "white") << ": " << r;
 
-            if (isSubEnabled("compact_gpu", "show_name")) ss << getColor("compact_gpu", "name_color", "white") << c_gpu.getGPUName() << r;
+            if (isSubEnabled("compact_gpu", "show_name")) ss << getColor("compact_gpu", "name_color", "white") << c_gpu->getGPUName() << r;
 
             if (isSubEnabled("compact_gpu", "show_usage")) {
                 ss << getColor("compact_gpu", "(", "white") << " (" << r
-                    << getColor("compact_gpu", "usage_color", "white") << c_gpu.getGPUUsagePercent() << "%" << r
+                    << getColor("compact_gpu", "usage_color", "white") << c_gpu->getGPUUsagePercent() << "%" << r
                     << getColor("compact_gpu", ")", "white") << ")" << r;
             }
 
             if (isSubEnabled("compact_gpu", "show_vram")) {
                 ss << getColor("compact_gpu", "(", "white") << " (" << r
-                    << getColor("compact_gpu", "vram_color", "white") << c_gpu.getVRAMGB() << " GB" << r
+                    << getColor("compact_gpu", "vram_color", "white") << c_gpu->getVRAMGB() << " GB" << r
                     << getColor("compact_gpu", ")", "white") << ")" << r;
             }
 
             if (isSubEnabled("compact_gpu", "show_freq")) {
                 ss << getColor("compact_gpu", "(", "white") << " (" << r
                     << getColor("compact_gpu", "at_symbol_color", "white") << "@" << r
-                    << getColor("compact_gpu", "freq_color", "white") << c_gpu.getGPUFrequency() << r
+                    << getColor("compact_gpu", "freq_color", "white") << c_gpu->getGPUFrequency() << r
                     << getColor("compact_gpu", ")", "white") << ")" << r;
             }
             lp.push(ss.str());
-        }
+        });
 
 
         // Compact Screen
-        if (isEnabled("compact_screen")) {
+        if (isEnabled("compact_screen")) sched.add("compact_screen", deadlineOf("compact_screen"), [&](SectionPrinter& lp) {
             CompactScreen screenDetector;
             auto screens = screenDetector.getScreens();
             std::ostringstream ss;
@@ -604,7 +786,7 @@ int main(){
                     // Resolution: (3840 x 2160)
                     if (isSubEnabled("compact_screen", "show_resolution")) {
                         ss << getColor("compact_screen", "(", "white") << "(" << r
-                            << getColor("compact_screen", "resolution_color", "White")
+                            << getColor("compact_screen", "resolution_color", "white")
                             << screen.native_width << r
                             << getColor("compact_screen", "x", "white") << " x " << r
                             << getColor("compact_screen", "resolution_color", "white")
@@ -642,7 +824,7 @@ int main(){
                     lp.push(ss.str());
                 }
             }
-        }
+        });
         /*
         
         ## 🎨 Output Examples
@@ -669,7 +851,7 @@ int main(){
 
 
         // Compact Memory
-        if (isEnabled("compact_memory")) {
+        if (isEnabled("compact_memory")) sched.add("compact_memory", deadlineOf("compact_memory"), [&](SectionPrinter& lp) {
             std::ostringstream ss;
 
             if (isSubEnabled("compact_memory", "show_emoji")) ss << getColor("compact_memory", "emoji_color", "white") << u8"📟" << r << " ";
@@ -680,25 +862,35 @@ int main(){
             if (isSubEnabled("compact_memory", "show_total")) {
                 ss << getColor("compact_memory", "(", "white") << "(" << r
                     << getColor("compact_memory", "label_color", "white") << "total: " << r
-                    << getColor("compact_memory", "total_color", "white") << c_memory.get_total_memory() << " GB" << r
+                    << getColor("compact_memory", "total_color", "white") << c_memory->get_total_memory() << " GB" << r
                     << getColor("compact_memory", ")", "white") << ")" << r;
             }
             if (isSubEnabled("compact_memory", "show_free")) {
                 ss << " " << getColor("compact_memory", "(", "white") << "(" << r
                     << getColor("compact_memory", "label_color", "white") << "free: " << r
-                    << getColor("compact_memory", "free_color", "white") << c_memory.get_free_memory() << " GB" << r
+                    << getColor("compact_memory", "free_color", "white") << c_memory->get_free_memory() << " GB" << r
                     << getColor("compact_memory", ")", "white") << ")" << r;
             }
             if (isSubEnabled("compact_memory", "show_percent")) {
                 ss << " " << getColor("compact_memory", "(", "white") << "(" << r
-                    << getColor("compact_memory", "percent_color", "white") << c_memory.get_used_memory_percent() << "%" << r
+                    << getColor("compact_memory", "percent_color", "white") << c_memory->get_used_memory_percent() << "%" << r
                     << getColor("compact_memory", ")", "white") << ")" << r;
             }
+            // memory.max below the host total: the container's working set against its limit
+            if (isSubEnabled("compact_memory", "show_cgroup")) {
+                std::string usage = CgroupLimits::current().memoryText(MemorySnapshot::current().totalBytes);
+                if (!usage.empty()) {
+                    ss << " " << getColor("compact_memory", "(", "white") << "(" << r
+                        << getColor("compact_memory", "label_color", "white") << "cgroup: " << r
+                        << getColor("compact_memory", "cgroup_color", "white") << usage << r
+                        << getColor("compact_memory", ")", "white") << ")" << r;
+                }
+            }
             lp.push(ss.str());
-        }
+        });
 
         // Compact Audio
-        if (isEnabled("compact_audio")) {
+        if (isEnabled("compact_audio")) sched.add("compact_audio", deadlineOf("compact_audio"), [&](SectionPrinter& lp) {
             if (isSubEnabled("compact_audio", "show_input")) {
                 std::ostringstream ss1;
 
@@ -706,9 +898,9 @@ int main(){
 
                 ss1 << getColor("compact_audio", "Audio Input", "white") << "Audio Input" << r
                     << getColor("compact_audio", "Audio_Input_:", "white") << ": " << r
-                    << getColor("compact_audio", "device_color", "white") << c_audio.active_audio_input() << r << " "
+                    << getColor("compact_audio", "device_color", "white") << c_audio->active_audio_input() << r << " "
                     << getColor("compact_audio", "(", "white") << "[" << r
-                    << getColor("compact_audio", "status_color", "white") << c_audio.active_audio_input_status() << r
+                    << getColor("compact_audio", "status_color", "white") << c_audio->active_audio_input_status() << r
                     << getColor("compact_audio", ")", "white") << "]" << r;
                 lp.push(ss1.str());
             }
@@ -719,16 +911,16 @@ int main(){
 
                 ss2 << getColor("compact_audio", "Audio Output", "white") << "Audio Output" << r
                     << getColor("compact_audio", "Audio_Output_:", "white") << ": " << r
-                    << getColor("compact_audio", "device_color", "white") << c_audio.active_audio_output() << r << " "
+                    << getColor("compact_audio", "device_color", "white") << c_audio->active_audio_output() << r << " "
                     << getColor("compact_audio", "(", "white") << "[" << r
-                    << getColor("compact_audio", "status_color", "white") << c_audio.active_audio_output_status() << r
+                    << getColor("compact_audio", "status_color", "white") << c_audio->active_audio_output_status() << r
                     << getColor("compact_audio", ")", "white") << "]" << r;
                 lp.push(ss2.str());
             }
-        }
+        });
 
         // Compact Performance
-        if (isEnabled("compact_performance")) {
+        if (isEnabled("compact_performance")) sched.add("compact_performance", deadlineOf("compact_performance"), [&](SectionPrinter& lp) {
             std::ostringstream ss;
 
             if (isSubEnabled("compact_performancec", "show_emoji")) ss << getColor("compact_performance", "emoji_color", "white") << u8"🔋" << r << " ";
@@ -736,23 +928,49 @@ int main(){
             ss << getColor("compact_performance", "Performance", "white") << "Performance" << r
                 << getColor("compact_performance", "Performance_:", "white") << ": " << r;
 
-            auto addP = [&](const std::string& subKey, const std::string& label, const std::string& colorKey, auto val) {
+            // probe is only called when its field is enabled
+            auto addP = [&](const std::string& subKey, const std::string& label, const std::string& colorKey, auto probe) {
                 if (isSubEnabled("compact_performance", subKey)) {
                     ss << getColor("compact_performance", "(", "white") << "(" << r
                         << getColor("compact_performance", "label_color", "white") << label << ": " << r
-                        << getColor("compact_performance", colorKey, "white") << val << "%" << r
+                        << getColor("compact_performance", colorKey, "white") << probe() << "%" << r
                         << getColor("compact_performance", ")", "white") << ") " << r;
                 }
                 };
-            addP("show_cpu", "CPU", "cpu_color", c_perf.getCPUUsage());
-            addP("show_gpu", "GPU", "gpu_color", c_perf.getGPUUsage());
-            addP("show_ram", "RAM", "ram_color", c_perf.getRAMUsage());
-            addP("show_disk", "Disk", "disk_color", c_perf.getDiskUsage());
+            addP("show_cpu", "CPU", "cpu_color", [&] { return c_perf->getCPUUsage(); });
+            addP("show_gpu", "GPU", "gpu_color", [&] { return c_perf->getGPUUsage(); });
+            addP("show_ram", "RAM", "ram_color", [&] { return c_perf->getRAMUsage(); });
+            addP("show_disk", "Disk", "disk_color", [&] { return c_perf->getDiskUsage(); });
             lp.push(ss.str());
-        }
+        });
+
+        // Compact Pressure
+        if (isEnabled("compact_pressure")) sched.add("compact_pressure", deadlineOf("compact_pressure"), [&](SectionPrinter& lp) {
+            // Every show_* field off: the plan never built PressureInfo, print nothing
+            if (!plan.needs(Collector::Pressure)) return;
+
+            std::ostringstream ss;
+
+            if (isSubEnabled("compact_pressure", "show_emoji")) ss << getColor("compact_pressure", "emoji_color", "white") << u8"⏳" << r << " ";
+
+            ss << getColor("compact_pressure", "Pressure", "white") << "Pressure" << r
+                << getColor("compact_pressure", "Pressure_:", "white") << ": " << r;
+
+            // One pass over every source; fields that couldn't be read are left out
+            PressureInfo::Snapshot s = pressure->snapshot();
+            for (const auto& f : PressureInfo::fields(s, isSubEnabled("compact_pressure", "show_full"))) {
+                std::string name = f.name;
+                if (!isSubEnabled("compact_pressure", "show_" + name)) continue;
+                ss << getColor("compact_pressure", "(", "white") << "(" << r
+                    << getColor("compact_pressure", "label_color", "white") << f.label << ": " << r
+                    << getColor("compact_pressure", name + "_color", "white") << f.value << r
+                    << getColor("compact_pressure", ")", "white") << ") " << r;
+            }
+            lp.push(ss.str());
+        });
 
         // Compact User
-        if (isEnabled("compact_user")) {
+        if (isEnabled("compact_user")) sched.add("compact_user", deadlineOf("compact_user"), [&](SectionPrinter& lp) {
             std::ostringstream ss;
 
             if (isSubEnabled("compact_user", "show_emoji")) ss << getColor("compact_user", "emoji_color", "white") << u8"☕" << r << " ";
@@ -760,26 +978,26 @@ int main(){
             ss << getColor("compact_user", "User", "white") << "User" << r
                 << getColor("compact_user", "User_:", "white") << ": " << r;
 
-            if (isSubEnabled("compact_user", "show_username")) ss << getColor("compact_user", "username_color", "white") << "@" << c_user.getUsername() << r;
+            if (isSubEnabled("compact_user", "show_username")) ss << getColor("compact_user", "username_color", "white") << "@" << c_user->getUsername() << r;
             if (isSubEnabled("compact_user", "show_domain")) {
                 ss << " " << getColor("compact_user", "(", "white") << "(" << r
                     << getColor("compact_user", "label_color", "white") << "Domain: " << r
-                    << getColor("compact_user", "domain_color", "white") << c_user.getDomain() << r
+                    << getColor("compact_user", "domain_color", "white") << c_user->getDomain() << r
                     << getColor("compact_user", ")", "white") << ")" << r;
             }
             if (isSubEnabled("compact_user", "show_type")) {
                 ss << " " << getColor("compact_user", "(", "white") << "(" << r
                     << getColor("compact_user", "label_color", "white") << "Type: " << r
-                    << getColor("compact_user", "type_color", "white") << c_user.isAdmin() << r
+                    << getColor("compact_user", "type_color", "white") << c_user->isAdmin() << r
                     << getColor("compact_user", ")", "white") << ")" << r;
             }
             lp.push(ss.str());
-        }
+        });
 
 
 
             // Compact Network (real)
-            if (isEnabled("compact_network")) {
+            if (isEnabled("compact_network")) sched.add("compact_network", deadlineOf("compact_network"), [&](SectionPrinter& lp) {
                 std::ostringstream ss;
 
                 if (isSubEnabled("compact_network", "show_emoji")) ss << getColor("compact_network", "emoji_color", "white") << u8"🌐" << r << " ";
@@ -790,30 +1008,30 @@ int main(){
                 if (isSubEnabled("compact_network", "show_name")) {
                     ss << getColor("compact_network", "(", "white") << "(" << r
                         << getColor("compact_network", "label_color", "white") << "Name: " << r
-                        << getColor("compact_network", "name_color", "white") << c_net.get_network_name() << r
+                        << getColor("compact_network", "name_color", "white") << c_net->get_network_name() << r
                         << getColor("compact_network", ")", "white") << ") " << r;
                 }
                 if (isSubEnabled("compact_network", "show_type")) {
                     ss << getColor("compact_network", "(", "white") << "(" << r
                         << getColor("compact_network", "label_color", "white") << "Type: " << r
-                        << getColor("compact_network", "type_color", "white") << c_net.get_network_type() << r
+                        << getColor("compact_network", "type_color", "white") << c_net->get_network_type() << r
                         << getColor("compact_network", ")", "white") << ") " << r;
                 }
                 if (isSubEnabled("compact_network", "show_ip")) {
                     ss << getColor("compact_network", "(", "white") << "(" << r
                         << getColor("compact_network", "label_color", "white") << "ip: " << r
-                        << getColor("compact_network", "ip_color", "white") << c_net.get_network_ip() << r
+                        << getColor("compact_network", "ip_color", "white") << c_net->get_network_ip() << r
                         << getColor("compact_network", ")", "white") << ")" << r;
                 }
                 lp.push(ss.str());
-            }
+            });
 
 
 
 
 
             // Compact Network (dummy)
-            if (isEnabled("dummy_compact_network")) {
+            if (isEnabled("dummy_compact_network")) sched.add("dummy_compact_network", deadlineOf("dummy_compact_network"), [&](SectionPrinter& lp) {
                 std::ostringstream ss;
 
                 if (isSubEnabled("compact_network", "show_emoji")) ss << getColor("compact_network", "emoji_color", "white") << u8"🌐" << r << " ";
@@ -830,7 +1048,7 @@ int main(){
                 if (isSubEnabled("compact_network", "show_type")) {
                     ss << getColor("compact_network", "(", "white") << "(" << r
                         << getColor("compact_network", "label_color", "white") << "Type: " << r
-                        << getColor("compact_network", "type_color", "white") << c_net.get_network_type() << r
+                        << getColor("compact_network", "type_color", "white") << c_net->get_network_type() << r
                         << getColor("compact_network", ")", "white") << ") " << r;
                 }
                 if (isSubEnabled("compact_network", "show_ip")) {
@@ -840,49 +1058,57 @@ int main(){
                         << getColor("compact_network", ")", "white") << ")" << r;
                 }
                 lp.push(ss.str());
-            }
+            });
 
 
         
         
 
         // Compact Disk
-        if (isEnabled("compact_disk")) {
+        if (isEnabled("compact_disk")) sched.add("compact_disk", deadlineOf("compact_disk"), [&](SectionPrinter& lp) {
+            // "C:\\" -> "C" on Windows; Linux mount points ("/", "/home") print as they are
+            auto isDrive = [](const std::string& root) { return root.size() == 3 && root[1] == ':'; };
+            auto driveName = [&](const std::string& root) { return isDrive(root) ? root.substr(0, 1) : root; };
+
             if (isSubEnabled("compact_disk", "show_usage")) {
-                auto disks = disk.getAllDiskUsage();
+                auto disks = disk->getAllDiskUsage();
                 std::ostringstream ss;
 
                 if (isSubEnabled("compact_disk", "show_disk_usage_emoji")) ss << getColor("compact_disk", "disk_usage_emoji_color", "white") << u8"📂" << r << " ";
 
                 ss << getColor("compact_disk", "Disk Usage", "white") << "Disk Usage" << r << getColor("compact_disk", "Disk_Usage_:", "white") << ": " << r;
                 for (const auto& d : disks) {
-                    ss << getColor("compact_disk", "(", "white") << "(" << r << getColor("compact_disk", "letter_color", "white") << d.first[0] << ":" << r
-                        << " " << getColor("compact_disk", "percent_color", "white") << std::fixed << std::setprecision(1) << d.second << "%" << r
-                        << getColor("compact_disk", ")", "white") << ") " << r;
+                    ss << getColor("compact_disk", "(", "white") << "(" << r << getColor("compact_disk", "letter_color", "white") << driveName(d.first) << (isDrive(d.first) ? ":" : "") << r
+                        << " " << getColor("compact_disk", "percent_color", "white");
+                    if (d.second < 0) ss << "unresponsive" << r;
+                    else ss << std::fixed << std::setprecision(1) << d.second << "%" << r;
+                    ss << getColor("compact_disk", ")", "white") << ") " << r;
                 }
                 lp.push(ss.str());
             }
 
             if (isSubEnabled("compact_disk", "show_capacity")) {
-                auto caps = disk.getDiskCapacity();
+                auto caps = disk->getDiskCapacity();
                 std::ostringstream sc;
 
                 if (isSubEnabled("compact_disk", "show_disk_capacity_emoji")) sc << getColor("compact_disk", "disk_capacity_emoji_color", "white") << u8"📊" << r << " ";
 
                 sc << getColor("compact_disk", "Disk Cap", "white") << "Disk Cap" << r << getColor("compact_disk", "Disk_Cap_:", "white") << ": " << r;
                 for (const auto& c : caps) {
-                    sc << getColor("compact_disk", "(", "white") << "(" << r << getColor("compact_disk", "letter_color", "white") << c.first[0] << r
-                        << getColor("compact_disk", "separator_color", "white") << "-" << r << getColor("compact_disk", "capacity_color", "white") << c.second << "GB" << r
-                        << getColor("compact_disk", ")", "white") << ")" << r;
+                    sc << getColor("compact_disk", "(", "white") << "(" << r << getColor("compact_disk", "letter_color", "white") << driveName(c.first) << r
+                        << getColor("compact_disk", "separator_color", "white") << "-" << r << getColor("compact_disk", "capacity_color", "white");
+                    if (c.second < 0) sc << "unresponsive" << r;
+                    else sc << c.second << "GB" << r;
+                    sc << getColor("compact_disk", ")", "white") << ")" << r;
                 }
                 lp.push(sc.str());
             }
-        }
+        });
 
         //-----------------------------start of detailed modules----------------------//
 
         // ----------------- DETAILED MEMORY SECTION ----------------- //
-        if (isEnabled("detailed_memory")) {
+        if (isEnabled("detailed_memory")) sched.add("detailed_memory", deadlineOf("detailed_memory"), [&](SectionPrinter& lp) {
             lp.push(""); // blank line
 
             // ---------- HEADER ----------
@@ -905,7 +1131,7 @@ int main(){
                     ss << getColor("detailed_memory", "~", "white") << "~" << r
                         << getColor("detailed_memory", "brackets", "white") << " (" << r
                         << getColor("detailed_memory", "label", "white") << "Total: " << r
-                        << getColor("detailed_memory", "total_value", "white") << ram.getTotal() << " GB" << r
+                        << getColor("detailed_memory", "total_value", "white") << ram->getTotal() << " GB" << r
                         << getColor("detailed_memory", "brackets", "white") << ") " << r;
                 }
 
@@ -913,7 +1139,7 @@ int main(){
                 if (isSectionEnabled("detailed_memory", "free")) {
                     ss << getColor("detailed_memory", "brackets", "white") << "(" << r
                         << getColor("detailed_memory", "label", "white") << "Free: " << r
-                        << getColor("detailed_memory", "free_value", "white") << ram.getFree() << " GB" << r
+                        << getColor("detailed_memory", "free_value", "white") << ram->getFree() << " GB" << r
                         << getColor("detailed_memory", "brackets", "white") << ") " << r;
                 }
 
@@ -921,7 +1147,7 @@ int main(){
                 if (isSectionEnabled("detailed_memory", "used_percentage")) {
                     ss << getColor("detailed_memory", "brackets", "white") << "(" << r
                         << getColor("detailed_memory", "label", "white") << "Used: " << r
-                        << getColor("detailed_memory", "used_value", "white") << ram.getUsedPercentage() << "%" << r
+                        << getColor("detailed_memory", "used_value", "white") << ram->getUsedPercentage() << "%" << r
                         << getColor("detailed_memory", "brackets", "white") << ")" << r;
                 }
 
@@ -930,7 +1156,7 @@ int main(){
 
             // ---------- MODULES ----------
             if (isSectionEnabled("detailed_memory", "modules")) {
-                const auto& modules = ram.getModules();
+                const auto& modules = ram->getModules();
                 for (size_t i = 0; i < modules.size(); ++i) {
                     // --- Zero-pad capacity ---
                     std::string cap = modules[i].capacity;
@@ -949,7 +1175,7 @@ int main(){
                     // Used Percentage in parentheses
                     ss << getColor("detailed_memory", "brackets", "white") << "(" << r
                         << getColor("detailed_memory", "label", "white") << "Used: " << r
-                        << getColor("detailed_memory", "used_value", "white") << ram.getUsedPercentage() << "%" << r
+                        << getColor("detailed_memory", "used_value", "white") << ram->getUsedPercentage() << "%" << r
                         << getColor("detailed_memory", "brackets", "white") << ") " << r;
 
                     // Capacity, Type, and Speed
@@ -960,16 +1186,191 @@ int main(){
                     lp.push(ss.str());
                 }
             }
-        }
+        });
+
+
+        // NUMA Info (JSON Driven)
+        if (isEnabled("numa_info")) sched.add("numa_info", deadlineOf("numa_info"), [&](SectionPrinter& lp) {
+            // One pass over every node; a single-node machine has nothing to show
+            NumaInfo::Topology topo = numa->snapshot();
+            bool showSingle = config_loaded && config.contains("numa_info") && config["numa_info"].value("show_single_node", false);
+            if (topo.nodes.size() < 2 && !showSingle) return;
+            lp.push("");
+
+            // Header
+            if (isSubEnabled("numa_info", "show_header")) {
+                std::ostringstream ss;
+                ss << getColor("numa_info", "#-", "white") << "#- " << r
+                    << getColor("numa_info", "header_text_color", "white") << "NUMA Topology " << r
+                    << getColor("numa_info", "separator_line", "white")
+                    << "--------------------------------------------------#" << r;
+                lp.push(ss.str());
+            }
+
+            const double gib = 1024.0 * 1024.0 * 1024.0;
+            for (const auto& node : topo.nodes) {
+                std::ostringstream ss;
+                std::string label = "Node " + std::to_string(node.id);
+                label.resize((std::max)(label.size(), size_t(25)), ' ');
+                ss << getColor("numa_info", "~", "white") << "~ " << r
+                    << getColor("numa_info", "node_label_color", "white") << label << r
+                    << getColor("numa_info", ":", "white") << ": " << r;
+
+                if (isSubEnabled("numa_info", "show_cpus")) {
+                    ss << getColor("numa_info", "cpu_value_color", "white") << node.cpus << " CPUs" << r;
+                    if (!node.cpuList.empty()) ss << getColor("numa_info", "cpu_list_color", "white") << " [" << node.cpuList << "]" << r;
+                    ss << "  ";
+                }
+
+                if (isSubEnabled("numa_info", "show_memory")) {
+                    ss << std::fixed << std::setprecision(1)
+                        << getColor("numa_info", "memory_value_color", "white") << node.freeBytes / gib;
+                    if (node.totalBytes > 0) ss << " / " << node.totalBytes / gib;
+                    ss << " GB free" << r;
+                    if (node.totalBytes > 0) {
+                        ss << getColor("numa_info", "percent_color", "white") << " (" << node.freePercent() << "%)" << r;
+                    }
+                    // The point of the section: a node out of local memory
+                    if (node.starved()) ss << " " << getColor("numa_info", "starved_color", "white") << "LOW MEMORY" << r;
+                }
+                lp.push(ss.str());
+            }
+
+            // Distance matrix, one row per node (Linux only)
+            if (isSubEnabled("numa_info", "show_distance") && !topo.distance.empty()) {
+                std::ostringstream head;
+                head << getColor("numa_info", "~", "white") << "~ " << r
+                    << getColor("numa_info", "node_label_color", "white") << "Distance                 " << r
+                    << getColor("numa_info", ":", "white") << ":" << r;
+                for (const auto& node : topo.nodes) {
+                    head << getColor("numa_info", "node_label_color", "white") << std::setw(5) << node.id << r;
+                }
+                lp.push(head.str());
+
+                size_t n = topo.nodes.size();
+                for (size_t row = 0; row < n; ++row) {
+                    std::ostringstream ss;
+                    ss << "    " << getColor("numa_info", "node_label_color", "white") << std::left << std::setw(24)
+                        << ("node" + std::to_string(topo.nodes[row].id)) << std::right << r;
+                    for (size_t col = 0; col < n; ++col) {
+                        int d = topo.distance[row * n + col];
+                        ss << getColor("numa_info", row == col ? "local_distance_color" : "remote_distance_color", "white")
+                            << std::setw(5) << d << r;
+                    }
+                    lp.push(ss.str());
+                }
+            }
+        });
+
+
+        // Memory Pressure (JSON Driven)
+        if (isEnabled("memory_pressure")) sched.add("memory_pressure", deadlineOf("memory_pressure"), [&](SectionPrinter& lp) {
+            // Every show_* row off: the plan never built MemoryPressure, print nothing
+            if (!plan.needs(Collector::MemoryPressure)) return;
+
+            // One pass: meminfo sizes, vmstat rates, zram devices
+            MemoryPressure::Snapshot s = mem_pressure->snapshot();
+            lp.push("");
+
+            // Header
+            if (isSubEnabled("memory_pressure", "show_header")) {
+                std::ostringstream ss;
+                ss << getColor("memory_pressure", "#-", "white") << "#- " << r
+                    << getColor("memory_pressure", "header_text_color", "white") << "Memory Pressure " << r
+                    << getColor("memory_pressure", "separator_line", "white")
+                    << "------------------------------------------------#" << r;
+                lp.push(ss.str());
+            }
+
+            auto line = [&](const std::string& label, const std::string& value) {
+                std::ostringstream ss;
+                std::string padded = label;
+                padded.resize((std::max)(padded.size(), size_t(25)), ' ');
+                ss << getColor("memory_pressure", "~", "white") << "~ " << r
+                    << getColor("memory_pressure", "label_color", "white") << padded << r
+                    << getColor("memory_pressure", ":", "white") << ": " << r
+                    << getColor("memory_pressure", "value_color", "white") << value << r;
+                lp.push(ss.str());
+            };
+            for (const auto& row : MemoryPressure::rows(s)) {
+                if (isSubEnabled("memory_pressure", std::string("show_") + row.name)) line(row.label, row.value);
+            }
+        });
+
+
+        // Memory Bench (JSON Driven, opt-in: the first run of a boot blocks for budget_ms)
+        bool memoryBenchOn = config_loaded && config.contains("memory_bench") && config["memory_bench"].value("enabled", false);
+        if (memoryBenchOn) sched.add("memory_bench", deadlineOf("memory_bench"), [&](SectionPrinter& lp) {
+            int budget = config["memory_bench"].value("budget_ms", static_cast<int>(MemoryBench::DefaultBudgetMs));
+            MemoryBench::Result bench = MemoryBench::get(static_cast<unsigned>((std::max)(budget, 50)));
+            if (bench.copyGBs <= 0.0) return;
+            lp.push("");
+
+            // Header
+            if (isSubEnabled("memory_bench", "show_header")) {
+                std::ostringstream ss;
+                ss << getColor("memory_bench", "#-", "white") << "#- " << r
+                    << getColor("memory_bench", "header_text_color", "white") << "Memory Bench " << r
+                    << getColor("memory_bench", "separator_line", "white")
+                    << "---------------------------------------------------#" << r;
+                lp.push(ss.str());
+            }
+
+            auto line = [&](const std::string& label, const std::string& value) {
+                std::ostringstream ss;
+                std::string padded = label;
+                padded.resize((std::max)(padded.size(), size_t(25)), ' ');
+                ss << getColor("memory_bench", "~", "white") << "~ " << r
+                    << getColor("memory_bench", "label_color", "white") << padded << r
+                    << getColor("memory_bench", ":", "white") << ": " << r
+                    << getColor("memory_bench", "value_color", "white") << value << r;
+                lp.push(ss.str());
+            };
+            auto fixed = [](double v, int digits) {
+                std::ostringstream ss;
+                ss << std::fixed << std::setprecision(digits) << v;
+                return ss.str();
+            };
+
+            if (isSubEnabled("memory_bench", "show_bandwidth")) {
+                std::string how = " (" + std::to_string(bench.threads) + " threads, " + bench.kernel + ")";
+                line("Copy", fixed(bench.copyGBs, 1) + " GB/s" + how);
+                line("Triad", fixed(bench.triadGBs, 1) + " GB/s");
+            }
+            if (isSubEnabled("memory_bench", "show_latency")) {
+                line("Latency", fixed(bench.latencyNs, 1) + " ns");
+            }
+
+            // Rated speed of the first populated DIMM; triad at or below one
+            // channel's peak with several DIMMs fitted hints at a single channel
+            if (isSubEnabled("memory_bench", "show_rated")) {
+                const Smbios& smbios = Smbios::current();
+                for (const Smbios::Dimm& dimm : smbios.dimms) {
+                    if (dimm.sizeBytes == 0) continue;
+                    unsigned mts = dimm.configuredMTs ? dimm.configuredMTs : dimm.speedMTs;
+                    if (mts == 0) break;
+                    double peak = MemoryBench::channelPeakGBs(mts);
+                    std::string value = dimm.type + "-" + std::to_string(mts) + ", " + fixed(peak, 1) + " GB/s per channel";
+                    line("Rated", value);
+                    if (smbios.installedDimms() >= 2 && bench.triadGBs <= peak) {
+                        std::ostringstream ss;
+                        ss << "    " << getColor("memory_bench", "warning_color", "white")
+                            << "Bandwidth fits in one channel: single channel?" << r;
+                        lp.push(ss.str());
+                    }
+                    break;
+                }
+            }
+        });
 
 
         // ----------------- DETAILED STORAGE SECTION (FIXED) ----------------- //
-        if (isEnabled("detailed_storage")) {
+        if (isEnabled("detailed_storage")) sched.add("detailed_storage", deadlineOf("detailed_storage"), [&](SectionPrinter& lp) {
             lp.push("");
 
             // Helper function to get nested color values - Defaulted to white
             auto getNestedColor = [&](const std::string& path, const std::string& defaultColor = "white") -> std::string {
-                if (!config_loaded || !config.contains("detailed_storage")) return colors[defaultColor];
+                if (!config_loaded || !config.contains("detailed_storage")) return colors.at(defaultColor);
 
                 std::vector<std::string> keys;
                 std::stringstream ss(path);
@@ -980,15 +1381,15 @@ int main(){
 
                 json current = config["detailed_storage"];
                 for (const auto& k : keys) {
-                    if (!current.contains(k)) return colors[defaultColor];
+                    if (!current.contains(k)) return colors.at(defaultColor);
                     current = current[k];
                 }
 
                 if (current.is_string()) {
                     std::string colorName = current.get<std::string>();
-                    return colors.count(colorName) ? colors[colorName] : colors[defaultColor];
+                    return colors.count(colorName) ? colors.at(colorName) : colors.at(defaultColor);
                 }
-                return colors[defaultColor];
+                return colors.at(defaultColor);
                 };
 
             // Helper to check nested boolean values
@@ -1052,7 +1453,7 @@ int main(){
                 }
 
                 // Process each disk
-                storage.process_storage_info([&](const storage_data& d) {
+                storage->process_storage_info([&](const storage_data& d) {
                     all_disks_captured.push_back(d);
 
                     std::ostringstream ss;
@@ -1254,14 +1655,13 @@ int main(){
             if (all_disks_captured.empty()) {
                 lp.push("No drives detected.");
             }
-        }
+        });
         // ----------------- END DETAILED STORAGE ----------------- //
 
 
 
             // Network Info (Compact + Extra) (real)
-            if (isEnabled("network_info")) 
-            {
+            if (isEnabled("network_info")) sched.add("network_info", deadlineOf("network_info"), [&](SectionPrinter& lp) {
 
                 lp.push("");//blank line....don't use cout !!! it might break the allignment
 
@@ -1283,7 +1683,7 @@ int main(){
                         << "Network Name              " << r
                         << getColor("network_info", ":", "white") << ": " << r
                         << getColor("network_info", "name_value_color", "white")
-                        << net.get_network_name() << r;
+                        << net->get_network_name() << r;
                     lp.push(ss.str());
                 }
 
@@ -1295,7 +1695,7 @@ int main(){
                         << "Network Type              " << r
                         << getColor("network_info", ":", "white") << ": " << r
                         << getColor("network_info", "type_value_color", "white")
-                        << c_net.get_network_type() << r;
+                        << c_net->get_network_type() << r;
                     lp.push(ss.str());
                 }
 
@@ -1307,7 +1707,7 @@ int main(){
                         << "Local IP                  " << r
                         << getColor("network_info", ":", "white") << ": " << r
                         << getColor("network_info", "local_ip_color", "white")
-                        << net.get_local_ip() << r;
+                        << net->get_local_ip() << r;
                     lp.push(ss.str());
                 }
 
@@ -1319,7 +1719,7 @@ int main(){
                         << "Public IP:                " << r
                         << getColor("network_info", ":", "white") << ": " << r
                         << getColor("network_info", "public_ip_color", "white")
-                        << net.get_public_ip() << r;
+                        << net->get_public_ip() << r;
                     lp.push(ss.str());
                 }
 
@@ -1331,7 +1731,7 @@ int main(){
                         << "Locale                    " << r
                         << getColor("network_info", ":", "white") << ": " << r
                         << getColor("network_info", "locale_value_color", "white")
-                        << net.get_locale() << r;
+                        << net->get_locale() << r;
                     lp.push(ss.str());
                 }
 
@@ -1343,7 +1743,7 @@ int main(){
                         << "Mac address               " << r
                         << getColor("network_info", ":", "white") << ": " << r
                         << getColor("network_info", "mac_value_color", "white")
-                        << net.get_mac_address() << r;
+                        << net->get_mac_address() << r;
                     lp.push(ss.str());
                 }
 
@@ -1355,7 +1755,7 @@ int main(){
                         << "avg upload speed          " << r
                         << getColor("network_info", ":", "white") << ": " << r
                         << getColor("network_info", "upload_value_color", "white")
-                        << net.get_network_upload_speed() << r;
+                        << net->get_network_upload_speed() << r;
                     lp.push(ss.str());
                 }
 
@@ -1367,15 +1767,15 @@ int main(){
                         << "avg download speed        " << r
                         << getColor("network_info", ":", "white") << ": " << r
                         << getColor("network_info", "download_value_color", "white")
-                        << net.get_network_download_speed() << r;
+                        << net->get_network_download_speed() << r;
                     lp.push(ss.str());
                 }
-            }
+            });
 
        
         
             // Network Info (Compact + Extra) (dummy)
-            if (isEnabled("dummy_network_info")) {
+            if (isEnabled("dummy_network_info")) sched.add("dummy_network_info", deadlineOf("dummy_network_info"), [&](SectionPrinter& lp) {
 
                 lp.push("");//blank line....don't use cout !!! it might break the allignment
 
@@ -1409,7 +1809,7 @@ int main(){
                         << "Network Type              " << r
                         << getColor("network_info", ":", "white") << ": " << r
                         << getColor("network_info", "type_value_color", "white")
-                        << c_net.get_network_type() << r;
+                        << c_net->get_network_type() << r;
                     lp.push(ss.str());
                 }
 
@@ -1445,7 +1845,7 @@ int main(){
                         << "Locale                    " << r
                         << getColor("network_info", ":", "white") << ": " << r
                         << getColor("network_info", "locale_value_color", "white")
-                        << net.get_locale() << r;
+                        << net->get_locale() << r;
                     lp.push(ss.str());
                 }
 
@@ -1469,7 +1869,7 @@ int main(){
                         << "avg upload speed          " << r
                         << getColor("network_info", ":", "white") << ": " << r
                         << getColor("network_info", "upload_value_color", "white")
-                        << net.get_network_upload_speed() << r;
+                        << net->get_network_upload_speed() << r;
                     lp.push(ss.str());
                 }
 
@@ -1481,10 +1881,10 @@ int main(){
                         << "avg download speed        " << r
                         << getColor("network_info", ":", "white") << ": " << r
                         << getColor("network_info", "download_value_color", "white")
-                        << net.get_network_download_speed() << r;
+                        << net->get_network_download_speed() << r;
                     lp.push(ss.str());
                 }
-            }
+            });
 
 
         
@@ -1493,7 +1893,7 @@ int main(){
         // end of the detailed network section////////////////////////////////////////////////
 
         // OS Info (JSON Driven)
-        if (isEnabled("os_info")) {
+        if (isEnabled("os_info")) sched.add("os_info", deadlineOf("os_info"), [&](SectionPrinter& lp) {
             lp.push("");
 
             // Header
@@ -1512,7 +1912,7 @@ int main(){
                 ss << getColor("os_info", "~", "white") << "~ " << r
                     << getColor("os_info", "name_label_color", "white") << "Name                      " << r
                     << getColor("os_info", ":", "white") << ": " << r
-                    << getColor("os_info", "name_value_color", "white") << os.GetOSName() << r;
+                    << getColor("os_info", "name_value_color", "white") << os->GetOSName() << r;
                 lp.push(ss.str());
             }
 
@@ -1522,7 +1922,7 @@ int main(){
                 ss << getColor("os_info", "~", "white") << "~ " << r
                     << getColor("os_info", "build_label_color", "white") << "Build                     " << r
                     << getColor("os_info", ":", "white") << ": " << r
-                    << getColor("os_info", "build_value_color", "white") << os.GetOSVersion() << r;
+                    << getColor("os_info", "build_value_color", "white") << os->GetOSVersion() << r;
                 lp.push(ss.str());
             }
 
@@ -1532,7 +1932,7 @@ int main(){
                 ss << getColor("os_info", "~", "white") << "~ " << r
                     << getColor("os_info", "arch_label_color", "white") << "Architecture              " << r
                     << getColor("os_info", ":", "white") << ": " << r
-                    << getColor("os_info", "arch_value_color", "white") << os.GetOSArchitecture() << r;
+                    << getColor("os_info", "arch_value_color", "white") << os->GetOSArchitecture() << r;
                 lp.push(ss.str());
             }
 
@@ -1542,7 +1942,7 @@ int main(){
                 ss << getColor("os_info", "~", "white") << "~ " << r
                     << getColor("os_info", "kernel_label_color", "white") << "Kernel                    " << r
                     << getColor("os_info", ":", "white") << ": " << r
-                    << getColor("os_info", "kernel_value_color", "white") << os.get_os_kernel_info() << r;
+                    << getColor("os_info", "kernel_value_color", "white") << os->get_os_kernel_info() << r;
                 lp.push(ss.str());
             }
 
@@ -1552,7 +1952,7 @@ int main(){
                 ss << getColor("os_info", "~", "white") << "~ " << r
                     << getColor("os_info", "uptime_label_color", "white") << "Uptime                    " << r
                     << getColor("os_info", ":", "white") << ": " << r
-                    << getColor("os_info", "uptime_value_color", "white") << os.get_os_uptime() << r;
+                    << getColor("os_info", "uptime_value_color", "white") << os->get_os_uptime() << r;
                 lp.push(ss.str());
             }
 
@@ -1563,7 +1963,7 @@ int main(){
                     << getColor("os_info", "install_date_label_color", "white") << "Install Date              " << r
                     << getColor("os_info", ":", "white") << ": " << r
                     << getColor("os_info", "install_date_value_color", "white")
-                    << os.get_os_install_date() << r;
+                    << os->get_os_install_date() << r;
                 lp.push(ss.str());
             }
 
@@ -1574,16 +1974,16 @@ int main(){
                     << getColor("os_info", "serial_label_color", "white") << "Serial                    " << r
                     << getColor("os_info", ":", "white") << ": " << r
                     << getColor("os_info", "serial_value_color", "white")
-                    << os.get_os_serial_number() << r;
+                    << os->get_os_serial_number() << r;
                 lp.push(ss.str());
             }
-        }
+        });
 
         //end of the OS info section////////////////////////////////////////////////
 
 
         // CPU Info (JSON Driven)
-        if (isEnabled("cpu_info")) {
+        if (isEnabled("cpu_info")) sched.add("cpu_info", deadlineOf("cpu_info"), [&](SectionPrinter& lp) {
             lp.push("");
 
             // Header
@@ -1602,7 +2002,7 @@ int main(){
                 ss << getColor("cpu_info", "~", "white") << "~ " << r
                     << getColor("cpu_info", "brand_label_color", "white") << "Brand                     " << r
                     << getColor("cpu_info", ":", "white") << ": " << r
-                    << getColor("cpu_info", "brand_value_color", "white") << cpu.get_cpu_info() << r;
+                    << getColor("cpu_info", "brand_value_color", "white") << cpu->get_cpu_info() << r;
                 lp.push(ss.str());
             }
 
@@ -1612,7 +2012,7 @@ int main(){
                 ss << getColor("cpu_info", "~", "white") << "~ " << r
                     << getColor("cpu_info", "utilization_label_color", "white") << "Utilization               " << r
                     << getColor("cpu_info", ":", "white") << ": " << r
-                    << getColor("cpu_info", "utilization_value_color", "white") << cpu.get_cpu_utilization() << r
+                    << getColor("cpu_info", "utilization_value_color", "white") << cpu->get_cpu_utilization() << r
                     << getColor("cpu_info", "%", "white") << "%" << r;
                 lp.push(ss.str());
             }
@@ -1623,7 +2023,7 @@ int main(){
                 ss << getColor("cpu_info", "~", "white") << "~ " << r
                     << getColor("cpu_info", "speed_label_color", "white") << "Speed                     " << r
                     << getColor("cpu_info", ":", "white") << ": " << r
-                    << getColor("cpu_info", "speed_value_color", "white") << cpu.get_cpu_speed() << r;
+                    << getColor("cpu_info", "speed_value_color", "white") << cpu->get_cpu_speed() << r;
                 lp.push(ss.str());
             }
 
@@ -1633,7 +2033,7 @@ int main(){
                 ss << getColor("cpu_info", "~", "white") << "~ " << r
                     << getColor("cpu_info", "base_speed_label_color", "white") << "Base Speed                " << r
                     << getColor("cpu_info", ":", "white") << ": " << r
-                    << getColor("cpu_info", "base_speed_value_color", "white") << cpu.get_cpu_base_speed() << r;
+                    << getColor("cpu_info", "base_speed_value_color", "white") << cpu->get_cpu_base_speed() << r;
                 lp.push(ss.str());
             }
 
@@ -1643,7 +2043,7 @@ int main(){
                 ss << getColor("cpu_info", "~", "white") << "~ " << r
                     << getColor("cpu_info", "cores_label_color", "white") << "Cores                     " << r
                     << getColor("cpu_info", ":", "white") << ": " << r
-                    << getColor("cpu_info", "cores_value_color", "white") << cpu.get_cpu_cores() << r;
+                    << getColor("cpu_info", "cores_value_color", "white") << cpu->get_cpu_cores() << r;
                 lp.push(ss.str());
             }
 
@@ -1653,7 +2053,7 @@ int main(){
                 ss << getColor("cpu_info", "~", "white") << "~ " << r
                     << getColor("cpu_info", "logical_processors_label_color", "white") << "Logical Processors        " << r
                     << getColor("cpu_info", ":", "white") << ": " << r
-                    << getColor("cpu_info", "logical_processors_value_color", "white") << cpu.get_cpu_logical_processors() << r;
+                    << getColor("cpu_info", "logical_processors_value_color", "white") << cpu->get_cpu_logical_processors() << r;
                 lp.push(ss.str());
             }
 
@@ -1663,7 +2063,7 @@ int main(){
                 ss << getColor("cpu_info", "~", "white") << "~ " << r
                     << getColor("cpu_info", "sockets_label_color", "white") << "Sockets                   " << r
                     << getColor("cpu_info", ":", "white") << ": " << r
-                    << getColor("cpu_info", "sockets_value_color", "white") << cpu.get_cpu_sockets() << r;
+                    << getColor("cpu_info", "sockets_value_color", "white") << cpu->get_cpu_sockets() << r;
                 lp.push(ss.str());
             }
 
@@ -1673,7 +2073,17 @@ int main(){
                 ss << getColor("cpu_info", "~", "white") << "~ " << r
                     << getColor("cpu_info", "virtualization_label_color", "white") << "Virtualization            " << r
                     << getColor("cpu_info", ":", "white") << ": " << r
-                    << getColor("cpu_info", "virtualization_value_color", "white") << cpu.get_cpu_virtualization() << r;
+                    << getColor("cpu_info", "virtualization_value_color", "white") << cpu->get_cpu_virtualization() << r;
+                lp.push(ss.str());
+            }
+
+            // Features (SIMD tiers from CPUID)
+            if (isSubEnabled("cpu_info", "show_features")) {
+                std::ostringstream ss;
+                ss << getColor("cpu_info", "~", "white") << "~ " << r
+                    << getColor("cpu_info", "features_label_color", "white") << "Features                  " << r
+                    << getColor("cpu_info", ":", "white") << ": " << r
+                    << getColor("cpu_info", "features_value_color", "white") << cpu->get_cpu_features() << r;
                 lp.push(ss.str());
             }
 
@@ -1683,7 +2093,7 @@ int main(){
                 ss << getColor("cpu_info", "~", "white") << "~ " << r
                     << getColor("cpu_info", "l1_cache_label_color", "white") << "L1 Cache                  " << r
                     << getColor("cpu_info", ":", "white") << ": " << r
-                    << getColor("cpu_info", "l1_cache_value_color", "white") << cpu.get_cpu_l1_cache() << r;
+                    << getColor("cpu_info", "l1_cache_value_color", "white") << cpu->get_cpu_l1_cache() << r;
                 lp.push(ss.str());
             }
 
@@ -1693,7 +2103,7 @@ int main(){
                 ss << getColor("cpu_info", "~", "white") << "~ " << r
                     << getColor("cpu_info", "l2_cache_label_color", "white") << "L2 Cache                  " << r
                     << getColor("cpu_info", ":", "white") << ": " << r
-                    << getColor("cpu_info", "l2_cache_value_color", "white") << cpu.get_cpu_l2_cache() << r;
+                    << getColor("cpu_info", "l2_cache_value_color", "white") << cpu->get_cpu_l2_cache() << r;
                 lp.push(ss.str());
             }
 
@@ -1703,18 +2113,18 @@ int main(){
                 ss << getColor("cpu_info", "~", "white") << "~ " << r
                     << getColor("cpu_info", "l3_cache_label_color", "white") << "L3 Cache                  " << r
                     << getColor("cpu_info", ":", "white") << ": " << r
-                    << getColor("cpu_info", "l3_cache_value_color", "white") << cpu.get_cpu_l3_cache() << r;
+                    << getColor("cpu_info", "l3_cache_value_color", "white") << cpu->get_cpu_l3_cache() << r;
                 lp.push(ss.str());
             }
-        }
+        });
 
         //end of the CPU info section////////////////////////////////////////////////
  
 
         // GPU Info (JSON Driven)
-        if (isEnabled("gpu_info")) {
+        if (isEnabled("gpu_info")) sched.add("gpu_info", deadlineOf("gpu_info"), [&](SectionPrinter& lp) {
             lp.push("");
-            auto all_gpu_info = obj_gpu.get_all_gpu_info();
+            auto all_gpu_info = obj_gpu->get_all_gpu_info();
 
             if (all_gpu_info.empty()) {
                 if (isSubEnabled("gpu_info", "show_header")) {
@@ -1826,8 +2236,8 @@ int main(){
                 }
 
                 // Primary GPU Details
-                auto primary = detailed_gpu_info.primary_gpu_info();
                 if (isSubEnabled("gpu_info", "show_primary_details")) {
+                    auto primary = detailed_gpu_info->primary_gpu_info();
                     lp.push("");
                     std::ostringstream ss;
                     ss << getColor("gpu_info", "#-", "white") << "#- " << r
@@ -1867,14 +2277,14 @@ int main(){
                     }
                 }
             }
-        }
+        });
 		// end of the GPU info section////////////////////////////////////////////////
          
         // ================= DISPLAY INFO (FULLY JSON DRIVEN) =================
-        if (isEnabled("display_info")) {
+        if (isEnabled("display_info")) sched.add("display_info", deadlineOf("display_info"), [&](SectionPrinter& lp) {
             lp.push("");
 
-            const auto& screens = di.getScreens();
+            const auto& screens = di->getScreens();
 
             for (size_t i = 0; i < screens.size(); ++i) {
                 const auto& s = screens[i];
@@ -1990,14 +2400,14 @@ int main(){
 
                 lp.push("");
             }
-        }
+        });
 
 
 
         //END of gpu section/////////////////////////////////////////////////////////////////
 
         // BIOS & Motherboard Info (JSON Driven)
-        if (isEnabled("bios_mb_info")) {
+        if (isEnabled("bios_mb_info")) sched.add("bios_mb_info", deadlineOf("bios_mb_info"), [&](SectionPrinter& lp) {
             lp.push("");
 
             // Header
@@ -2016,7 +2426,7 @@ int main(){
                 ss << getColor("bios_mb_info", "~", "white") << "~ " << r
                     << getColor("bios_mb_info", "vendor_label_color", "white") << "Bios Vendor               " << r
                     << getColor("bios_mb_info", ":", "white") << ": " << r
-                    << getColor("bios_mb_info", "vendor_value_color", "white") << sys.get_bios_vendor() << r;
+                    << getColor("bios_mb_info", "vendor_value_color", "white") << sys->get_bios_vendor() << r;
                 lp.push(ss.str());
             }
 
@@ -2026,7 +2436,7 @@ int main(){
                 ss << getColor("bios_mb_info", "~", "white") << "~ " << r
                     << getColor("bios_mb_info", "version_label_color", "white") << "Bios Version              " << r
                     << getColor("bios_mb_info", ":", "white") << ": " << r
-                    << getColor("bios_mb_info", "version_value_color", "white") << sys.get_bios_version() << r;
+                    << getColor("bios_mb_info", "version_value_color", "white") << sys->get_bios_version() << r;
                 lp.push(ss.str());
             }
 
@@ -2036,7 +2446,7 @@ int main(){
                 ss << getColor("bios_mb_info", "~", "white") << "~ " << r
                     << getColor("bios_mb_info", "date_label_color", "white") << "Bios Date                 " << r
                     << getColor("bios_mb_info", ":", "white") << ": " << r
-                    << getColor("bios_mb_info", "date_value_color", "white") << sys.get_bios_date() << r;
+                    << getColor("bios_mb_info", "date_value_color", "white") << sys->get_bios_date() << r;
                 lp.push(ss.str());
             }
 
@@ -2046,7 +2456,7 @@ int main(){
                 ss << getColor("bios_mb_info", "~", "white") << "~ " << r
                     << getColor("bios_mb_info", "model_label_color", "white") << "Motherboard Model         " << r
                     << getColor("bios_mb_info", ":", "white") << ": " << r
-                    << getColor("bios_mb_info", "model_value_color", "white") << sys.get_motherboard_model() << r;
+                    << getColor("bios_mb_info", "model_value_color", "white") << sys->get_motherboard_model() << r;
                 lp.push(ss.str());
             }
 
@@ -2056,15 +2466,15 @@ int main(){
                 ss << getColor("bios_mb_info", "~", "white") << "~ " << r
                     << getColor("bios_mb_info", "mfg_label_color", "white") << "Motherboard Manufacturer  " << r
                     << getColor("bios_mb_info", ":", "white") << ": " << r
-                    << getColor("bios_mb_info", "mfg_value_color", "white") << sys.get_motherboard_manufacturer() << r;
+                    << getColor("bios_mb_info", "mfg_value_color", "white") << sys->get_motherboard_manufacturer() << r;
                 lp.push(ss.str());
             }
-        }
+        });
 
 		//end of the BIOS & Motherboard info section///////////////////////////////
 
         // User Info (JSON Driven)
-        if (isEnabled("user_info")) {
+        if (isEnabled("user_info")) sched.add("user_info", deadlineOf("user_info"), [&](SectionPrinter& lp) {
             lp.push("");
 
             // Header
@@ -2083,7 +2493,7 @@ int main(){
                 ss << getColor("user_info", "~", "white") << "~ " << r
                     << getColor("user_info", "username_label_color", "white") << "Username                  " << r
                     << getColor("user_info", ":", "white") << ": " << r
-                    << getColor("user_info", "username_value_color", "white") << user.get_username() << r;
+                    << getColor("user_info", "username_value_color", "white") << user->get_username() << r;
                 lp.push(ss.str());
             }
 
@@ -2093,7 +2503,7 @@ int main(){
                 ss << getColor("user_info", "~", "white") << "~ " << r
                     << getColor("user_info", "computer_name_label_color", "white") << "Computer Name             " << r
                     << getColor("user_info", ":", "white") << ": " << r
-                    << getColor("user_info", "computer_name_value_color", "white") << user.get_computer_name() << r;
+                    << getColor("user_info", "computer_name_value_color", "white") << user->get_computer_name() << r;
                 lp.push(ss.str());
             }
 
@@ -2103,15 +2513,15 @@ int main(){
                 ss << getColor("user_info", "~", "white") << "~ " << r
                     << getColor("user_info", "domain_label_color", "white") << "Domain                    " << r
                     << getColor("user_info", ":", "white") << ": " << r
-                    << getColor("user_info", "domain_value_color", "white") << user.get_domain_name() << r;
+                    << getColor("user_info", "domain_value_color", "white") << user->get_domain_name() << r;
                 lp.push(ss.str());
             }
-        }
+        });
 
 		// end of the User info section////////////////////////////////////////////////
 
         // Performance Info (JSON Driven)
-        if (isEnabled("performance_info")) {
+        if (isEnabled("performance_info")) sched.add("performance_info", deadlineOf("performance_info"), [&](SectionPrinter& lp) {
             lp.push("");
 
             // Header
@@ -2130,7 +2540,7 @@ int main(){
                 ss << getColor("performance_info", "~", "white") << "~ " << r
                     << getColor("performance_info", "uptime_label_color", "white") << "System Uptime            " << r
                     << getColor("performance_info", ":", "white") << ": " << r
-                    << getColor("performance_info", "uptime_value_color", "white") << perf.get_system_uptime() << r;
+                    << getColor("performance_info", "uptime_value_color", "white") << perf->get_system_uptime() << r;
                 lp.push(ss.str());
             }
 
@@ -2140,7 +2550,7 @@ int main(){
                 ss << getColor("performance_info", "~", "white") << "~ " << r
                     << getColor("performance_info", "cpu_usage_label_color", "white") << "CPU Usage                " << r
                     << getColor("performance_info", ":", "white") << ": " << r
-                    << getColor("performance_info", "usage_value_color", "white") << perf.get_cpu_usage_percent() << r
+                    << getColor("performance_info", "usage_value_color", "white") << perf->get_cpu_usage_percent() << r
                     << getColor("performance_info", "%", "white") << "%" << r;
                 lp.push(ss.str());
             }
@@ -2151,7 +2561,7 @@ int main(){
                 ss << getColor("performance_info", "~", "white") << "~ " << r
                     << getColor("performance_info", "ram_usage_label_color", "white") << "RAM Usage                " << r
                     << getColor("performance_info", ":", "white") << ": " << r
-                    << getColor("performance_info", "usage_value_color", "white") << perf.get_ram_usage_percent() << r
+                    << getColor("performance_info", "usage_value_color", "white") << perf->get_ram_usage_percent() << r
                     << getColor("performance_info", "%", "white") << "%" << r;
                 lp.push(ss.str());
             }
@@ -2162,7 +2572,7 @@ int main(){
                 ss << getColor("performance_info", "~", "white") << "~ " << r
                     << getColor("performance_info", "disk_usage_label_color", "white") << "Disk Usage               " << r
                     << getColor("performance_info", ":", "white") << ": " << r
-                    << getColor("performance_info", "usage_value_color", "white") << perf.get_disk_usage_percent() << r
+                    << getColor("performance_info", "usage_value_color", "white") << perf->get_disk_usage_percent() << r
                     << getColor("performance_info", "%", "white") << "%" << r;
                 lp.push(ss.str());
             }
@@ -2173,17 +2583,66 @@ int main(){
                 ss << getColor("performance_info", "~", "white") << "~ " << r
                     << getColor("performance_info", "gpu_usage_label_color", "white") << "GPU Usage                " << r
                     << getColor("performance_info", ":", "white") << ": " << r
-                    << getColor("performance_info", "usage_value_color", "white") << perf.get_gpu_usage_percent() << r
+                    << getColor("performance_info", "usage_value_color", "white") << perf->get_gpu_usage_percent() << r
                     << getColor("performance_info", "%", "white") << "%" << r;
                 lp.push(ss.str());
             }
-        }
+        });
 
 		// end of the Performance info section////////////////////////////////////////
 
+
+        // Top Processes (JSON Driven)
+        if (isEnabled("top_processes")) sched.add("top_processes", deadlineOf("top_processes"), [&](SectionPrinter& lp) {
+            lp.push("");
+
+            // Header
+            if (isSubEnabled("top_processes", "show_header")) {
+                std::ostringstream ss;
+                ss << getColor("top_processes", "#-", "white") << "#- " << r
+                    << getColor("top_processes", "header_text_color", "white") << "Top Processes " << r
+                    << getColor("top_processes", "separator_line", "white")
+                    << "--------------------------------------------------#" << r;
+                lp.push(ss.str());
+            }
+
+            bool byCpu = isSubEnabled("top_processes", "show_by_cpu");
+            bool byMemory = isSubEnabled("top_processes", "show_by_memory");
+            if (!byCpu && !byMemory) return;
+
+            int configured = (config_loaded && config.contains("top_processes")) ? config["top_processes"].value("count", 5) : 5;
+            size_t count = configured > 0 ? static_cast<size_t>(configured) : 5;
+
+            // One sample serves both lists (watch / agent refreshes reuse the previous one)
+            top_procs->refresh();
+
+            auto addList = [&](const std::string& label, const std::vector<TopProcesses::Entry>& list) {
+                std::ostringstream head;
+                head << getColor("top_processes", "~", "white") << "~ " << r
+                    << getColor("top_processes", "list_label_color", "white") << label << r
+                    << getColor("top_processes", ":", "white") << ":" << r;
+                lp.push(head.str());
+
+                for (const auto& e : list) {
+                    std::ostringstream ss;
+                    ss << "    " << getColor("top_processes", "pid_color", "white") << std::setw(7) << e.pid << r << "  "
+                        << getColor("top_processes", "name_color", "white") << std::left << std::setw(18) << e.name.substr(0, 18) << std::right << r
+                        << getColor("top_processes", "cpu_value_color", "white") << std::fixed << std::setprecision(1) << std::setw(6) << e.cpuPercent << r
+                        << getColor("top_processes", "%", "white") << "%" << r << "  "
+                        << getColor("top_processes", "memory_value_color", "white") << std::setprecision(1) << std::setw(7)
+                        << (e.memoryBytes >= (1ULL << 30) ? e.memoryBytes / double(1ULL << 30) : e.memoryBytes / double(1ULL << 20))
+                        << (e.memoryBytes >= (1ULL << 30) ? " GB" : " MB") << r;
+                    lp.push(ss.str());
+                }
+                };
+
+            if (byCpu) addList("By CPU                   ", top_procs->byCpu(count));
+            if (byMemory) addList("By Memory                ", top_procs->byMemory(count));
+        });
+
  
         // Audio & Power Info (JSON Driven)
-        if (isEnabled("audio_power_info")) {
+        if (isEnabled("audio_power_info")) sched.add("audio_power_info", deadlineOf("audio_power_info"), [&](SectionPrinter& lp) {
             lp.push("");
             ExtraInfo audio;
 
@@ -2275,7 +2734,7 @@ int main(){
                 }
                 lp.push(ossPower.str());
             }
-        }
+        });
 
 
         /*
@@ -2329,11 +2788,88 @@ int main(){
 
     // ---------------- End of info lines ----------------
 
+    // ------------------ Agent mode ------------------
+    // Stay resident: re-run the sections on a timer and hand the lines to
+    // clients over the local socket instead of printing them.
+    if (options.agentMode) {
+        AgentServer agent(agentSocketPath(), configHash, options.agentIntervalMs);
+        int code = agent.run([&] {
+            // DisplayInfo reads its numbers in the constructor, everything
+            // else samples on every call and stays warm
+            di.reset();
+            MemorySnapshot::refresh();
+            CgroupLimits::refresh();
+            GpuSnapshot::instance().refresh();   // clocks / usage / temperature
+            std::vector<std::string> lines = sched.collect();
+            StaticFactsCache::instance().save();
+            return lines;
+            });
+
+        SystemQuery::instance().close();
+        CoUninitialize();
+        return code;   // only reached when the socket could not be set up
+    }
+
+    // Start every registered section and stream the results in order
+    sched.run(lp);
+
     // Print remaining ASCII art lines (if art is taller than info)
     lp.finish();
 
     std::cout << std::endl;
 
+    // Store anything the cache didn't have yet (no-op on a warm run)
+    StaticFactsCache::instance().save();
+
+    // Before watch mode, which never returns: the trace covers the first frame
+    if (!options.tracePath.empty() && !options.agentMode) {
+        if (!Profiler::instance().writeTrace(options.tracePath)) {
+            std::cout << "Warning: could not write " << options.tracePath << std::endl;
+        }
+    }
+
+    // ------------------ Watch mode ------------------
+    // Keep the art and static lines where they are; every interval only the
+    // sections with live values run again and only changed cells are redrawn.
+    if (options.watchMs > 0) {
+        if (terminal_rows() == 0) {
+            std::cout << "Note: --watch needs a terminal, printed once." << std::endl;
+        }
+        else {
+            sched.markDynamic({
+                "compact_time", "compact_os", "compact_cpu", "cpu_cores", "compact_gpu", "compact_memory",
+                "compact_performance", "compact_pressure", "compact_disk", "detailed_memory", "numa_info",
+                "memory_pressure", "os_info", "cpu_info", "performance_info", "top_processes"
+                });
+
+            WatchRenderer watch(art, sched.lines());
+            for (;;) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(options.watchMs));
+                MemorySnapshot::refresh();
+                CgroupLimits::refresh();
+                GpuSnapshot::instance().refresh();
+                watch.update(sched.collect(true));
+            }
+        }
+    }
+
+    if (options.showTimings) {
+        const StaticFactsCache& cache = StaticFactsCache::instance();
+        std::cout << "Fetch time    : " << elapsedMs() << " ms" << std::endl;
+        std::cout << "Static cache  : " << cache.state() << " (" << cache.hits() << " hit, " << cache.misses() << " miss)" << std::endl;
+        Profiler::instance().printTable(std::cout);
+    }
+
+    // Sections that blew their deadline are still running on worker threads
+    // that use the collectors above, so skip the destructors on the way out.
+    if (sched.abandoned()) {
+        std::cout.flush();
+        std::quick_exit(0);
+    }
+
+    // Shared WMI connections go first, then COM itself
+    SystemQuery::instance().close();
+
     // End of CoUninitialize 
     CoUninitialize();
     return 0;
@@ -2383,11 +2919,13 @@ C. FULL SYSTEM INFO MODULES (Detailed Mode):
    - OSInfo.h          - OS name, version, build, architecture, uptime
    - CPUInfo.h         - CPU model, cores, threads, clocks, cache
    - MemoryInfo.h      - RAM capacity, usage, modules, speed, type
+   - NumaInfo.h        - Per-node CPUs, memory and distance matrix
    - GPUInfo.h         - Basic GPU information (name, memory, usage)
    - DetailedGPUInfo.h - Advanced GPU details (VRAM, clocks, temps)
    - StorageInfo.h     - Disk drives, partitions, usage, performance
    - NetworkInfo.h     - Network adapters, IP, speeds, MAC
    - PerformanceInfo.h - Real-time CPU/RAM/GPU/Disk usage
+   - TopProcesses.h    - Top processes by CPU and memory
    - UserInfo.h        - Username, PC name, domain, admin status
    - SystemInfo.h      - Motherboard, BIOS, manufacturer
    - DisplayInfo.h     - Monitor resolution, refresh, scaling
@@ -2398,11 +2936,13 @@ D. COMPACT MODE MODULES:
    - CompactAudio.h      - Audio device summary
    - CompactOS.h         - Lightweight OS summary
    - CompactCPU.h        - Lightweight CPU summary
+   - CpuCores.h          - Per-core load / clock heat row
    - CompactMemory.h     - Lightweight RAM summary
    - CompactScreen.h     - Screen resolution/refresh summary
    - CompactSystem.h     - Motherboard/system summary
    - CompactGPU.h        - Lightweight GPU summary
    - CompactPerformance.h - Performance stats
+   - PressureInfo.h      - PSI stall averages, load, context switch rate
    - CompactUser.h       - User info summary
    - CompactNetwork.h    - Network info summary
    - compact_disk_info.h - Storage summary
@@ -2468,6 +3008,214 @@ B. KEY METHODS (AsciiArt class):
    2. LivePrinter.push() - Adds formatted line to output queue
    3. LivePrinter.finish() - Prints remaining ASCII art lines
 
+C. CONCURRENT SECTIONS (FetchScheduler):
+   - Every enabled section is registered with sched.add("key", task)
+   - run() executes the tasks on a worker pool, so slow probes overlap
+   - Inside a task, lp is a SectionPrinter (same push() API)
+   - A reorder buffer releases lines to LivePrinter in config order,
+     as soon as a line and every line before it are ready
+   - "deadline_ms" in a section's config caps how long it may hold up
+     the output; a late section prints one placeholder row, which is
+     patched in place (cursor movement) if it finishes before the end
+   - Sections still running at the end are abandoned (std::quick_exit)
+
+D. COLLECTION PLAN (CollectionPlan):
+   - Built once from the config, before any section runs
+   - Collectors are LazyCollector<T> and are used with "->"
+   - A collector is only constructed when an enabled field reads it;
+     fully disabled collectors are never built or queried
+   - New getter call in a section -> add its row to the rule table
+     in CollectionPlan.cpp; using an unplanned collector still builds it
+     but names it on stderr, and a Collector with no row at all fails to
+     compile. Sections that touch a collector before any show_* check
+     test plan.needs() first (compact_pressure, memory_pressure)
+
+E. STATIC FACTS CACHE (StaticFactsCache):
+   - C:\Users\Public\BinaryFetch\BinaryFetch_Cache.bin
+   - Holds CPU brand/caches, BIOS/board, RAM modules, OS install date/serial
+   - Invalidated by a new boot ID or hardware fingerprint
+   - --refresh-cache re-probes everything, --timings shows hit/miss
+
+F. AGENT MODE (AgentServer / AgentClient):
+   - "binaryfetch --agent" registers the sections as usual, then re-runs
+     them every --agent-interval ms (sched.collect()) and serves the lines
+     over a local Unix socket
+   - A plain run asks the agent first (right after loading the config)
+     and only renders; no agent / other config / stale -> normal fetch
+   - --no-agent and --refresh-cache always collect in-process
+   - The socket is per user (%LOCALAPPDATA%\BinaryFetch with a user-only DACL,
+     $XDG_RUNTIME_DIR or a checked 0700 /tmp/binaryfetch-<uid>); the config
+     in Users\Public is shared, so the hash alone can't keep users apart
+
+G. WATCH MODE (WatchRenderer):
+   - "binaryfetch --watch 1" prints normally, then every interval re-runs
+     only the sections passed to sched.markDynamic() (time, usage, clocks,
+     uptime, memory, disk)
+   - WatchRenderer diffs the new lines cell by cell (character + color)
+     and rewrites only the changed spans with cursor addressing
+   - Deadlines are off in watch mode; the agent is not used
+
+H. PROFILING (Profiler):
+   - Every collector getter opens PROFILE_SCOPE("Class::getter"); LazyCollector
+     adds "<Collector> (construct)" and each worker a span per section
+   - --timings prints the spans grouped by name, slowest total first
+   - --trace [file] writes them as Chrome trace-event JSON (chrome://tracing,
+     ui.perfetto.dev), one track per worker thread
+   - Spans are no-ops unless one of the two flags is given
+
+I. BENCHMARKS (..\binary_fetch_bench, BinaryFetchBench.exe):
+   - Separate project in the solution; BinaryFetch.exe itself has no bench
+     code and keeps the default allocator
+   - "BinaryFetchBench [n]" runs the parsing/formatting helpers of the
+     collectors on recorded inputs: ns/op, allocs/op, p50, p99
+   - Exit code 1 when a fixture no longer produces its recorded output
+   - The portable parsers (/proc, sysfs, SMBIOS, CPUID) are checked by
+     ..\tests instead: a CMake target, one executable per module, that
+     builds them without windows.h on Linux and Windows alike
+
+J. GPU SNAPSHOT (GpuSnapshot):
+   - CompactGPU, GPUInfo, DetailedGPUInfo, CompactPerformance::getGPUUsage and
+     PerformanceInfo::get_gpu_usage_percent all read GpuSnapshot::instance()
+   - One DXGI enumeration + one NVAPI session per run; the PDH usage sample and
+     the WMI temperature query run once, and only if a section needs them
+   - Agent and watch mode call refresh() before re-collecting
+
+K. SYSTEM QUERY SESSION (SystemQuery):
+   - CPUInfo, OSInfo and GpuSnapshot ask
+     SystemQuery::instance() for WMI rows instead of connecting themselves
+   - Locator + one IWbemServices per namespace are created on first use and
+     shared by all worker threads; close() releases them before CoUninitialize
+   - Properties of one class are fetched in one query (cachedRows() for classes
+     that can't change during the run, e.g. Win32_OperatingSystem)
+   - On Linux the same class reads procfs/sysfs through kept-open descriptors
+
+L. CPU SAMPLER (CpuSampler):
+   - Started right after the command line is parsed; a background thread reads
+     the CPU time counters every 250 ms (GetSystemTimes, /proc/stat on Linux)
+     into a 16-entry ring buffer
+   - CPUInfo, CompactCPU, CompactPerformance and PerformanceInfo usage getters
+     return the busy share of the last second at once instead of sleeping
+     between two PDH collections
+   - When compact_cpu show_clock, cpu_info show_speed or cpu_cores
+     show_frequency is on, the same thread
+     also records every CPU's effective clock (APERF / MPERF or
+     scaling_cur_freq, CallNtPowerInformation on Windows) into the ring;
+     the clock getters report min / avg / max and the share of samples at
+     the top clock over the last 2 s instead of one instantaneous value
+
+M. PER-CORE HEAT ROW (CpuCores, "cpu_cores" section):
+   - One glyph per logical CPU for load and clock, both from the CpuSampler
+     ring (clock against each CPU's maximum)
+   - Block height = level, color = band (below 50 % / 80 % / above); offline
+     CPUs show a dot. Rows wrap every "cores_per_row" CPUs (default 64)
+   - Per-CPU deltas are one vectorizable loop over structure-of-arrays
+     counters, so 256+ threads cost microseconds per refresh
+
+N. CPU TOPOLOGY (CpuTopology):
+   - Sockets, cores, threads, L1-L3 totals and base clock are probed once
+     (GetLogicalProcessorInformationEx, or sysfs topology + cache/index* on
+     Linux, CPUID as the fallback) and shared by CPUInfo and CompactCPU
+   - Only online CPUs are walked; offline CPUs and gaps in the numbering are
+     skipped, and each core / cache instance is read from one CPU only
+
+O. CPUID ENGINE (Cpuid):
+   - Brand, feature flags (SSE4.2 .. AVX-512 / AMX, checked against XCR0),
+     hypervisor vendor, hybrid flag, cache descriptors and base clock are
+     decoded once from CPUID through constexpr bit tables in Cpuid.cpp
+   - Brand, virtualization and the "Features" line of cpu_info need no
+     syscall; CpuTopology uses it when the OS topology source is missing
+
+P. PROCESS COUNTER (ProcessCounter):
+   - CPUInfo's process / thread / handle getters share one sample (reused for
+     500 ms): two WMI perf queries on Windows; on Linux a getdents64 walk of
+     /proc, nr_threads from /proc/loadavg (per-pid stat, split across worker
+     threads, inside containers) and /proc/sys/fs/file-nr
+
+Q. TOP PROCESSES (TopProcesses, "top_processes" section):
+   - Top "count" processes by CPU % and by resident memory
+   - CPU % compares two samples; the collector keeps the previous one as a
+     pid-sorted record table, so --watch / --agent refreshes are incremental
+   - The baseline is taken at launch (prime(), right after the plan), so the
+     section's first refresh only takes the second sample; it waits at most
+     until that baseline is 50 ms old
+   - Records are recycled between two vectors, no per-refresh allocation
+
+R. PRESSURE (PressureInfo, "compact_pressure" section):
+   - PSI some (and full, for memory / io) avg10/avg60 from /proc/pressure,
+     load averages and run queue from /proc/loadavg, context switches / s
+   - The files are re-read with pread() on descriptors SystemQuery keeps
+     open, so the line costs a few microseconds per fetch or --watch frame
+   - The switch rate comes from the "ctxt" values CpuSampler already keeps
+     in its ring (one /proc/stat read serves CPU usage and switches)
+   - Windows: run queue and switch rate from PerfOS_System
+   - PressureInfo::fields() formats the values; the section only filters
+     them by show_<name> and colors them with <name>_color
+
+S. NUMA (NumaInfo, "numa_info" section):
+   - Per node: CPU count and sysfs cpulist, free / total memory, and a
+     LOW MEMORY mark below 10 % free; then the node distance matrix
+   - cpulist ranges are counted, never expanded, so thousand-CPU nodes cost
+     the same as small ones
+   - Hidden on single-node machines unless show_single_node is set
+   - Windows: per-node CPUs and available memory only (no total / distances)
+
+T. MEMORY SNAPSHOT (MemorySnapshot):
+   - MemoryInfo, CompactMemory, CompactPerformance::getRAMUsage and
+     PerformanceInfo::get_ram_usage_percent all read MemorySnapshot::current()
+   - One /proc/meminfo read (table-driven key scanner, exact bytes) or one
+     GlobalMemoryStatusEx + GetPerformanceInfo per fetch
+   - Shared rounding (0.1 GB, whole percent), so every section agrees
+   - Agent and watch mode call refresh() before re-collecting
+
+U. SMBIOS (Smbios):
+   - SystemInfo, CompactSystem (BIOS / board), MemoryInfo (modules) and
+     CompactMemory (slots) all read Smbios::current()
+   - The raw table (GetSystemFirmwareTable 'RSMB', /sys/firmware/dmi/tables/DMI)
+     is decoded in one bounds-checked pass over types 0/1/2/16/17
+   - Non-root Linux falls back to /sys/class/dmi/id strings (no DIMMs)
+   - tests\SmbiosTests.cpp parses captured tables and fuzzes the parser with corrupted copies
+
+V. MEMORY BENCH (MemoryBench, "memory_bench" section):
+   - Off unless "enabled": true; the first fetch of a boot measures for
+     budget_ms (300 ms), later fetches read StaticFactsCache "memory.bench"
+   - STREAM copy / triad on every hardware thread (first-touch slices,
+     AVX-512F / AVX2 / scalar kernel) and a Sattolo pointer chase latency
+   - Printed next to the rated DIMM speed from Smbios, with a single
+     channel hint when triad doesn't beat one channel's peak
+
+W. MEMORY PRESSURE (MemoryPressure, "memory_pressure" section):
+   - Swap used and in / out MB/s, zswap and per-zram-device compression
+     ratio, THP and explicit huge pages, dirty / writeback, page faults / s
+   - Sizes come from MemorySnapshot (no second /proc/meminfo read); the
+     ten /proc/vmstat counters are picked out with a perfect-hash key table
+     while every other line is skipped with memchr
+   - Rates compare against the previous reading; the first one against the
+     /proc/vmstat baseline prime() takes at launch, so the section never sleeps
+   - Windows: PerfOS_Memory only. Its page in / out rates include mapped
+     files, so they print as a separate "Paging (file + mapped)" line, and
+     hard-fault disk reads stand in for major faults, labelled as such
+   - MemoryPressure::rows() formats the lines; the section only filters
+     them by show_<name> and pads / colors them
+
+X. CGROUP LIMITS (CgroupLimits, compact_cpu / compact_memory "show_cgroup"):
+   - cgroup v2 cpu.max, cpuset.cpus.effective, memory.max, memory.current
+     and memory.stat of our own cgroup, resolved once from /proc/self/cgroup
+   - cpu.max / memory.max are read on every ancestor; the tightest wins
+   - Printed only when a limit is below the host: "[cgroup: 2.50 CPUs]"
+     after the thread count, "(cgroup: 1.2 / 4.0 GB, 30%)" after memory,
+     where used is the working set (memory.current - inactive_file)
+   - CgroupLimits::cpuText() / memoryText() build those values; the
+     compact lines only color them
+   - Windows and cgroup v1 hosts: nothing extra is printed
+
+Y. MOUNTS (MountTable, compact_disk / detailed_storage):
+   - Linux lists /proc/self/mountinfo (streamed in 16 KB reads), keeps real
+     storage and network mounts, one per device; Windows lists drive letters
+   - Capacity calls (statvfs / GetDiskFreeSpaceExA) run on 4 threads with a
+     1 s timeout each; a hung NFS / SMB mount prints "unresponsive" instead
+     of stalling the fetch, and later --watch frames skip it until it answers
+   - compact_disk prints mount points on Linux ("/", "/home"), letters on Windows
+
 IV. MODULE FUNCTIONALITY SUMMARY:
 ---------------------------------
 
@@ -2485,6 +3233,8 @@ B. COMPACT MODULES (Single-line summaries):
    8. CompactUser: Username, domain, admin status
    9. CompactNetwork: Network name, type, IP address
    10. DiskInfo: Disk usage percentages and capacities
+   11. CpuCores: Per-core load and clock heat row (one glyph per CPU)
+   12. PressureInfo: PSI stall averages, load / run queue, context switch rate
 
 C. DETAILED MODULES (Multi-line expanded info):
    1. MemoryInfo: RAM modules with capacity, type, speed, usage
@@ -2498,6 +3248,10 @@ C. DETAILED MODULES (Multi-line expanded info):
    9. UserInfo: User and computer identification
    10. PerformanceInfo: Real-time performance metrics
    11. ExtraInfo: Audio devices and power/battery status
+   12. TopProcesses: Top processes by CPU and memory
+   13. NumaInfo: Per-node CPUs, free / total memory, distance matrix
+   14. MemoryBench: Measured copy / triad bandwidth and load latency (opt-in)
+   15. MemoryPressure: Swap rates, zswap / zram ratio, huge pages, dirty pages, fault rate
 
 V. OUTPUT SECTIONS ORGANIZATION:
 --------------------------------
@@ -2507,27 +3261,33 @@ A. COMPACT MODE SECTIONS (Top-to-bottom flow):
    2. Compact Time
    3. Compact OS
    4. Compact CPU
-   5. Compact GPU
-   6. Compact Screen
-   7. Compact Memory
-   8. Compact Audio
-   9. Compact Performance
-   10. Compact User
-   11. Compact Network
-   12. Compact Disk
+   5. CPU Cores (heat row)
+   6. Compact GPU
+   7. Compact Screen
+   8. Compact Memory
+   9. Compact Audio
+   10. Compact Performance
+   11. Compact Pressure
+   12. Compact User
+   13. Compact Network
+   14. Compact Disk
 
 B. DETAILED MODE SECTIONS:
    1. Detailed Memory
-   2. Detailed Storage
-   3. Network Info
-   4. OS Info
-   5. CPU Info
-   6. GPU Info
-   7. Display Info
-   8. BIOS & Motherboard Info
-   9. User Info
-   10. Performance Info
-   11. Audio & Power Info
+   2. NUMA Info
+   3. Memory Pressure
+   4. Memory Bench (opt-in)
+   5. Detailed Storage
+   6. Network Info
+   7. OS Info
+   8. CPU Info
+   9. GPU Info
+   10. Display Info
+   11. BIOS & Motherboard Info
+   12. User Info
+   13. Performance Info
+   14. Top Processes
+   15. Audio & Power Info
 
 VI. CONFIGURATION-DRIVEN FEATURES:
 -----------------------------------
@@ -2699,7 +3459,7 @@ OBJECT: cpu
 FUNCTIONS:
 1. get_cpu_info() - Returns CPU brand/model
 2. get_cpu_utilization() - Returns CPU usage percentage
-3. get_cpu_speed() - Returns current CPU speed
+3. get_cpu_speed() - Returns average CPU speed over the sampler window (with min / max / % at max)
 4. get_cpu_base_speed() - Returns base CPU speed
 5. get_cpu_cores() - Returns number of physical cores
 6. get_cpu_logical_processors() - Returns number of logical processors
@@ -2708,13 +3468,14 @@ FUNCTIONS:
 9. get_cpu_l1_cache() - Returns L1 cache size
 10. get_cpu_l2_cache() - Returns L2 cache size
 11. get_cpu_l3_cache() - Returns L3 cache size
+12. get_cpu_features() - Returns supported SIMD / crypto extensions
 
 CLASS: MemoryInfo
 OBJECT: ram
 FUNCTIONS:
-1. getTotal() - Returns total RAM in GB
-2. getFree() - Returns free RAM in GB
-3. getUsedPercentage() - Returns RAM usage percentage
+1. getTotal() - Returns total RAM in GB (MemorySnapshot, 0.1 GB steps)
+2. getFree() - Returns available RAM in GB (MemorySnapshot, 0.1 GB steps)
+3. getUsedPercentage() - Returns RAM usage percentage (MemorySnapshot)
 4. getModules() - Returns vector of RAM module information
 
 CLASS: GPUInfo
@@ -2743,6 +3504,7 @@ CLASS: StorageInfo
 OBJECT: storage
 FUNCTIONS:
 1. process_storage_info(callback) - Processes all storage devices with callback
+   (capacities from MountTable::snapshot(); hung volumes report "(unresponsive)")
 
 STRUCT: storage_data (passed to callback)
 - drive_letter - Drive letter (e.g., "C:")
@@ -2785,6 +3547,45 @@ FUNCTIONS:
 4. get_disk_usage_percent() - Returns disk usage percentage
 5. get_gpu_usage_percent() - Returns GPU usage percentage
 
+CLASS: TopProcesses
+OBJECT: top_procs
+FUNCTIONS:
+1. prime() - Baseline sample at launch, no wait
+2. refresh() - Takes a new process sample against the previous one
+3. byCpu(n) - Returns the n processes with the highest CPU %
+4. byMemory(n) - Returns the n processes with the largest RSS / working set
+
+CLASS: NumaInfo
+OBJECT: numa
+FUNCTIONS:
+1. snapshot() - Returns every online node (CPUs, free / total memory) and the distance matrix
+
+CLASS: CgroupLimits
+OBJECT: none (static, CgroupLimits::current)
+FUNCTIONS:
+1. current() - cgroup v2 quota / cpuset / memory limit and usage, shared until refresh()
+2. effectiveCpus(hostThreads) - The smallest of quota, cpuset and host threads
+3. cpuText(hostThreads) / memoryText(hostBytes) - "2.50 CPUs" / "1.2 / 4.0 GB, 30%", "" when not limited
+
+CLASS: MountTable
+OBJECT: none (static, used by StorageInfo and DiskInfo)
+FUNCTIONS:
+1. snapshot(timeoutMs) - Storage mounts with capacity, probed concurrently; hung ones marked Unresponsive
+2. MountinfoParser - Incremental /proc/self/mountinfo parser (feed chunks, finish)
+
+CLASS: MemoryPressure
+OBJECT: mem_pressure
+FUNCTIONS:
+1. prime() - /proc/vmstat baseline at launch (no-op on Windows)
+2. snapshot() - Returns swap / fault rates since the previous call, zram devices and the MemorySnapshot sizes
+3. rows(snapshot) - Returns the section's lines as label / text pairs, tagged with their show_ key
+
+CLASS: MemoryBench
+OBJECT: none (static, MemoryBench::get)
+FUNCTIONS:
+1. get(budgetMs) - Cached copy / triad GB/s and latency ns, measured on the first call of a boot
+2. channelPeakGBs(mts) - Peak of one 64-bit channel, for the rated speed line
+
 CLASS: DisplayInfo
 OBJECT: di
 FUNCTIONS:
@@ -2865,7 +3666,8 @@ FUNCTIONS:
 1. getCPUName() - Returns CPU name
 2. getCPUCores() - Returns number of cores
 3. getCPUThreads() - Returns number of threads
-4. getClockSpeed() - Returns clock speed in GHz
+4. getClockSpeed() - Returns clock speed in GHz (window average)
+5. getClockRange() - Returns min-max clock and share of samples at max
 
 CLASS: CompactMemory
 OBJECT: c_memory
@@ -2906,6 +3708,12 @@ FUNCTIONS:
 3. getRAMUsage() - Returns RAM usage percentage
 4. getDiskUsage() - Returns disk usage percentage
 
+CLASS: PressureInfo
+OBJECT: pressure
+FUNCTIONS:
+1. snapshot() - Returns PSI cpu/memory/io stalls, load / run queue and context switches per second
+2. fields(snapshot, full) - Returns the readable values as label / text pairs for the line
+
 CLASS: CompactUser
 OBJECT: c_user
 FUNCTIONS:
@@ -2923,8 +3731,8 @@ FUNCTIONS:
 CLASS: DiskInfo
 OBJECT: disk
 FUNCTIONS:
-1. getAllDiskUsage() - Returns map of drive letters to usage percentages
-2. getDiskCapacity() - Returns map of drive letters to capacities in GB
+1. getAllDiskUsage() - Returns map of drive letters (Linux: mount points) to usage percentages, -1 = unresponsive
+2. getDiskCapacity() - Returns map of drive letters to capacities in GB (reuses the usage probe)
 
 --- JSON CONFIGURATION ---
 OBJECT: config
@@ -0,0 +1,57 @@
+#include "TestHarness.h"
+#include "fixtures/CgroupLimitsFixtures.h"
+#include "CgroupLimits.h"
+#include <cstring>
+
+namespace fx = Fixtures;
+
+TEST_CASE(parseSelfCgroup) {
+    const char* selfCgroup = fx::selfCgroup();
+    CHECK(CgroupLimits::parseSelfCgroup(selfCgroup, std::strlen(selfCgroup))
+        == "/kubepods.slice/kubepods-burstable.slice/kubepods-burstable-pod7f3c.slice/cri-containerd-4b1e.scope");
+}
+
+TEST_CASE(parseCpuMaxAndBytes) {
+    const char* cpuMax = fx::cgroupCpuMax();
+    double quota = 0.0, unlimited = 0.0;
+    uint64_t maxBytes = 1;
+    CHECK(CgroupLimits::parseCpuMax(cpuMax, std::strlen(cpuMax), quota) && quota == 2.5);
+    CHECK(CgroupLimits::parseCpuMax("max 100000\n", 11, unlimited) && unlimited == -1.0);
+    CHECK(CgroupLimits::parseBytes("max\n", 4, maxBytes) && maxBytes == 0);
+}
+
+// 2.5 CPUs and a 4 GiB container on a 32-CPU host
+TEST_CASE(parseMemoryStat) {
+    const char* memoryStat = fx::cgroupMemoryStat();
+    CgroupLimits cg;
+    cg.cpuQuota = 2.5;
+    cg.cpusetCpus = 4;
+    cg.memoryCurrent = 2147483648ULL;
+    CHECK(CgroupLimits::parseMemoryStat(memoryStat, std::strlen(memoryStat), cg) == 5);
+    CHECK(cg.anonBytes == 1288490188ULL);
+    CHECK(cg.fileBytes == 805306368ULL);
+    CHECK(cg.inactiveFileBytes == 536870912ULL);
+    CHECK(cg.workingSetBytes() == 1610612736ULL);
+    CHECK(cg.effectiveCpus(32) == 2.5);
+    CHECK(cg.cpuLimited(32));
+}
+
+// The show_cgroup values, empty unless a limit is below the host
+TEST_CASE(limitTexts) {
+    const uint64_t gib = 1024ull * 1024 * 1024;
+    CgroupLimits limits;
+    CHECK(limits.cpuText(8).empty());
+    CHECK(limits.memoryText(16 * gib).empty());
+
+    limits.cpuQuota = 2.5;
+    CHECK(limits.cpuText(8) == "2.50 CPUs");
+    limits.cpuQuota = 2.0;
+    CHECK(limits.cpuText(8) == "2 CPUs");
+    CHECK(limits.cpuText(2).empty());
+
+    limits.memoryMax = 4 * gib;
+    limits.memoryCurrent = 3 * gib / 2;
+    limits.inactiveFileBytes = 3 * gib / 10;
+    CHECK(limits.memoryText(16 * gib) == "1.2 / 4.0 GB, 30%");
+    CHECK(limits.memoryText(4 * gib).empty());
+}
@@ -0,0 +1,51 @@
+#include "TestHarness.h"
+#include "CollectionPlan.h"
+
+using json = nlohmann::json;
+
+// No config file: every section and field counts as enabled
+TEST_CASE(defaultsPlanEverything) {
+    CollectionPlan plan(json::object(), false);
+    CHECK(plan.count() == static_cast<size_t>(Collector::Count));
+}
+
+// compact_pressure on with all five fields off: nothing reads PressureInfo,
+// so the section must check the plan before touching it
+TEST_CASE(compactPressureAllFieldsOff) {
+    json config = json::parse(R"({
+        "compact_pressure": { "enabled": true, "show_cpu": false, "show_memory": false,
+                              "show_io": false, "show_load": false, "show_switches": false }
+    })");
+    CHECK(!CollectionPlan(config, true).needs(Collector::Pressure));
+
+    config["compact_pressure"]["show_load"] = true;
+    CHECK(CollectionPlan(config, true).needs(Collector::Pressure));
+}
+
+// Same for memory_pressure and its five show_* rows
+TEST_CASE(memoryPressureAllRowsOff) {
+    json config = json::parse(R"({
+        "memory_pressure": { "enabled": true, "show_header": true, "show_swap": false, "show_compression": false,
+                             "show_hugepages": false, "show_dirty": false, "show_faults": false }
+    })");
+    CHECK(!CollectionPlan(config, true).needs(Collector::MemoryPressure));
+
+    config["memory_pressure"]["show_dirty"] = true;
+    CHECK(CollectionPlan(config, true).needs(Collector::MemoryPressure));
+}
+
+TEST_CASE(disabledSectionPlansNothing) {
+    json config = json::parse(R"({ "compact_pressure": { "enabled": false } })");
+    CHECK(!CollectionPlan(config, true).needs(Collector::Pressure));
+}
+
+// A missing rule row is reported, not fatal: the collector is still built
+TEST_CASE(unplannedCollectorStillBuilds) {
+    struct Probe { int value = 42; };
+    json config = json::parse(R"({ "numa_info": { "enabled": false } })");
+    CollectionPlan plan(config, true);
+    LazyCollector<Probe> probe(plan, Collector::Numa);
+    CHECK(!plan.needs(Collector::Numa));
+    CHECK(probe->value == 42);
+    CHECK(probe.built());
+}
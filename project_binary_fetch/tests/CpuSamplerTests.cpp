@@ -0,0 +1,36 @@
+#include "TestHarness.h"
+#include "fixtures/CpuSamplerFixtures.h"
+#include "CpuSampler.h"
+#include <cmath>
+#include <vector>
+
+namespace fx = Fixtures;
+
+// /proc/stat text -> per-CPU counters -> per-CPU percent, cpu2 offline
+TEST_CASE(parseProcStatAndDeltaKernel) {
+    const fx::ProcStatFixture& stat = fx::procStat();
+    std::vector<uint64_t> busyOld(stat.cores), totalOld(stat.cores), busyNew(stat.cores), totalNew(stat.cores);
+    uint64_t aggBusy = 0, aggTotal = 0;
+    size_t seen = CpuSampler::parseProcStat(stat.before.data(), stat.before.size(), aggBusy, aggTotal, busyOld.data(), totalOld.data(), stat.cores);
+    CpuSampler::parseProcStat(stat.after.data(), stat.after.size(), aggBusy, aggTotal, busyNew.data(), totalNew.data(), stat.cores);
+    CHECK(seen == stat.cores);
+
+    std::vector<float> usage(stat.cores);
+    CpuSampler::coreDeltaKernel(busyNew.data(), busyOld.data(), totalNew.data(), totalOld.data(), usage.data(), stat.cores);
+    for (size_t i = 0; i < stat.cores; ++i) CHECK(std::abs(usage[i] - stat.usage[i]) <= 0.01f);
+}
+
+TEST_CASE(parseContextSwitches) {
+    const fx::ProcStatFixture& stat = fx::procStat();
+    CHECK(CpuSampler::parseContextSwitches(stat.after.data(), stat.after.size()) == 93410);
+}
+
+// Clock window summary over a hybrid part (per-CPU ceilings)
+TEST_CASE(clockSummary) {
+    const fx::ClockFixture& clocks = fx::clockWindow();
+    CpuSampler::ClockStats summary = CpuSampler::clockSummary(clocks.mhz.data(), clocks.samples, clocks.cores, clocks.ceiling.data());
+    CHECK(std::abs(summary.minMHz - clocks.minMHz) <= 0.5f);
+    CHECK(std::abs(summary.avgMHz - clocks.avgMHz) <= 0.5f);
+    CHECK(std::abs(summary.maxMHz - clocks.maxMHz) <= 0.5f);
+    CHECK(std::abs(summary.atMaxPercent - clocks.atMaxPercent) <= 0.1f);
+}
@@ -0,0 +1,32 @@
+#include "TestHarness.h"
+#include "fixtures/CpuTopologyFixtures.h"
+#include "CpuTopology.h"
+
+namespace fx = Fixtures;
+
+static CpuTopology::FileReader recordedTree() {
+    return [](const std::string& path) {
+        const auto& files = fx::sysfsTopology().files;
+        auto it = files.find(path);
+        return it == files.end() ? std::string() : it->second;
+    };
+}
+
+// One pass over a recorded sysfs tree with offline CPUs
+TEST_CASE(fromSysfsCounts) {
+    const fx::SysfsTopologyFixture& tree = fx::sysfsTopology();
+    CpuTopology topology = CpuTopology::fromSysfs(recordedTree());
+    CHECK(topology.sockets == tree.sockets);
+    CHECK(topology.cores == tree.cores);
+    CHECK(topology.logical == tree.logical);
+    CHECK(topology.offline == tree.offline);
+    CHECK(topology.baseMHz == tree.baseMHz);
+}
+
+TEST_CASE(fromSysfsCacheTotals) {
+    const fx::SysfsTopologyFixture& tree = fx::sysfsTopology();
+    CpuTopology topology = CpuTopology::fromSysfs(recordedTree());
+    CHECK(topology.cacheBytes[1] == tree.l1);
+    CHECK(topology.cacheBytes[2] == tree.l2);
+    CHECK(topology.cacheBytes[3] == tree.l3);
+}
@@ -0,0 +1,41 @@
+#include "TestHarness.h"
+#include "fixtures/CpuidFixtures.h"
+#include "Cpuid.h"
+
+namespace fx = Fixtures;
+
+static Cpuid::LeafSource recordedLeaves() {
+    return [](uint32_t leaf, uint32_t subleaf) {
+        Cpuid::Regs regs;
+        for (const auto& l : fx::cpuidSapphireRapidsKvm().leaves) {
+            if (l.leaf == leaf && l.subleaf == subleaf) {
+                regs.eax = l.eax;
+                regs.ebx = l.ebx;
+                regs.ecx = l.ecx;
+                regs.edx = l.edx;
+            }
+        }
+        return regs;
+    };
+}
+
+TEST_CASE(decodeBrandAndHypervisor) {
+    const fx::CpuidFixture& leaves = fx::cpuidSapphireRapidsKvm();
+    Cpuid decoded = Cpuid::decode(recordedLeaves(), leaves.xcr0);
+    CHECK(decoded.brand == leaves.brand);
+    CHECK(decoded.hypervisor == leaves.hypervisor);
+}
+
+// With and without AVX-512 / AMX OS state
+TEST_CASE(decodeFeatures) {
+    const fx::CpuidFixture& leaves = fx::cpuidSapphireRapidsKvm();
+    CHECK(Cpuid::decode(recordedLeaves(), leaves.xcr0).featureLine() == leaves.features);
+    CHECK(Cpuid::decode(recordedLeaves(), 0x7).featureLine() == leaves.featuresAvxOnly);
+}
+
+TEST_CASE(decodeL2Descriptor) {
+    const fx::CpuidFixture& leaves = fx::cpuidSapphireRapidsKvm();
+    uint64_t l2 = 0;
+    for (const auto& c : Cpuid::decode(recordedLeaves(), leaves.xcr0).caches) if (c.level == 2) l2 += c.sizeBytes;
+    CHECK(l2 == leaves.l2Bytes);
+}
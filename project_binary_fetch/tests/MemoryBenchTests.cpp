@@ -0,0 +1,29 @@
+#include "TestHarness.h"
+#include "MemoryBench.h"
+#include <string>
+
+// The StaticFactsCache encoding only; the kernels themselves take 300 ms
+TEST_CASE(packRoundTrip) {
+    MemoryBench::Result measured;
+    measured.copyGBs = 41.27;
+    measured.triadGBs = 44.9;
+    measured.latencyNs = 78.35;
+    measured.threads = 16;
+    measured.kernel = "AVX2";
+    MemoryBench::Result restored;
+    CHECK(MemoryBench::unpack(MemoryBench::pack(measured), restored));
+    CHECK(restored.copyGBs == 41.27);
+    CHECK(restored.triadGBs == 44.9);
+    CHECK(restored.latencyNs == 78.35);
+    CHECK(restored.threads == 16);
+    CHECK(std::string(restored.kernel) == "AVX2");
+}
+
+TEST_CASE(unpackRejectsUnknownKernel) {
+    MemoryBench::Result restored;
+    CHECK(!MemoryBench::unpack("41.27 44.90 78.35 16 SSE9", restored));
+}
+
+TEST_CASE(channelPeak) {
+    CHECK(MemoryBench::channelPeakGBs(3200) == 25.6);
+}
@@ -0,0 +1,79 @@
+#include "TestHarness.h"
+#include "fixtures/MemoryPressureFixtures.h"
+#include "MemoryPressure.h"
+#include <cstring>
+
+namespace fx = Fixtures;
+
+TEST_CASE(vmstatTableValid) {
+    CHECK(MemoryPressure::vmstatTableValid());
+}
+
+// Perfect-hash scan; the near-miss keys in the fixture must not match
+TEST_CASE(parseVmstat) {
+    const char* vmstat = fx::procVmstat();
+    MemoryPressure::Counters vm;
+    CHECK(MemoryPressure::parseVmstat(vmstat, std::strlen(vmstat), vm) == 10);
+    CHECK(vm.pswpin == 117281);
+    CHECK(vm.pswpout == 239044);
+    CHECK(vm.pgfault == 18233019472ULL);
+    CHECK(vm.pgmajfault == 1872211);
+    CHECK(vm.thpFaultFallback == 20331);
+    CHECK(vm.thpCollapseAlloc == 48291);
+    CHECK(vm.zswpout == 190443);
+    CHECK(vm.oomKill == 3);
+}
+
+TEST_CASE(parseMmStat) {
+    const char* mmStat = fx::zramMmStat();
+    MemoryPressure::Zram zram;
+    CHECK(MemoryPressure::parseMmStat(mmStat, std::strlen(mmStat), zram));
+    CHECK(zram.origBytes == 2143174656ULL);
+    CHECK(zram.comprBytes == 634757234ULL);
+    CHECK(zram.usedBytes == 653828096ULL);
+}
+
+// One line per enabled key, one per zram device, no fault line without a rate
+TEST_CASE(rows) {
+    const uint64_t gib = 1024ull * 1024 * 1024;
+    MemoryPressure::Snapshot s;
+    s.memory.swapTotalBytes = 8 * gib;
+    s.memory.swapFreeBytes = 6 * gib;
+    s.memory.anonHugeBytes = gib / 2;
+    MemoryPressure::Zram z;
+    z.device = "zram0";
+    z.origBytes = 3 * gib;
+    z.comprBytes = gib;
+    z.usedBytes = gib;
+    s.zram.push_back(z);
+
+    std::vector<MemoryPressure::Row> rows = MemoryPressure::rows(s);
+    CHECK(rows.size() == 4);
+    if (rows.size() != 4) return;
+    CHECK(std::strcmp(rows[0].name, "swap") == 0 && rows[0].value == "2.0 GB / 8.0 GB used");
+    CHECK(std::strcmp(rows[1].name, "compression") == 0 && rows[1].label == "zram0");
+    CHECK(rows[1].value == "3.0 GB -> 1.0 GB (3.0x), 1.0 GB RAM");
+    CHECK(std::strcmp(rows[2].name, "hugepages") == 0 && rows[2].value == "THP 0.5 GB");
+    CHECK(std::strcmp(rows[3].name, "dirty") == 0);
+
+    s.faultsPerSec = 2500.0;
+    s.majorFaultsPerSec = 3.0;
+    rows = MemoryPressure::rows(s);
+    CHECK(rows.back().label == "Page Faults" && rows.back().value == "2.5k/s (major 3/s)");
+}
+
+// Windows-style snapshot: paging and hard-fault reads are not shown as swap / major faults
+TEST_CASE(rowsPagingIsNotSwap) {
+    MemoryPressure::Snapshot s;
+    s.pagingInBytesPerSec = 2.0 * 1024 * 1024;
+    s.pagingOutBytesPerSec = 0.0;
+    s.faultsPerSec = 800.0;
+    s.pageReadsPerSec = 12.0;
+
+    std::vector<MemoryPressure::Row> rows = MemoryPressure::rows(s);
+    CHECK(rows.size() == 5);
+    if (rows.size() != 5) return;
+    CHECK(rows[0].label == "Swap" && rows[0].value == "none");
+    CHECK(rows[1].label == "Paging (file + mapped)" && rows[1].value == "in 2.0 MB/s, out 0.0 MB/s");
+    CHECK(rows[4].value == "800/s (hard-fault reads 12/s)");
+}
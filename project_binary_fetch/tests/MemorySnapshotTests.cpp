@@ -0,0 +1,29 @@
+#include "TestHarness.h"
+#include "fixtures/MemorySnapshotFixtures.h"
+#include "MemorySnapshot.h"
+#include <cstring>
+
+namespace fx = Fixtures;
+
+// The one /proc/meminfo parse every RAM figure comes from
+TEST_CASE(parseMeminfo) {
+    const char* meminfo = fx::procMeminfo();
+    MemorySnapshot mem;
+    CHECK(MemorySnapshot::parseMeminfo(meminfo, std::strlen(meminfo), mem) == 16);
+    CHECK(mem.totalBytes == 65755612ULL * 1024);
+    CHECK(mem.availableBytes == 23711044ULL * 1024);
+    CHECK(mem.cachedBytes == 21380572ULL * 1024);
+    CHECK(mem.swapFreeBytes == 7919612ULL * 1024);
+    CHECK(mem.hugePagesTotal == 2048);
+    CHECK(mem.hugePageBytes == 2048ULL * 1024);
+    CHECK(mem.anonHugeBytes == 10487808ULL * 1024);
+    CHECK(mem.dirtyBytes == 18244ULL * 1024);
+}
+
+TEST_CASE(rounding) {
+    const char* meminfo = fx::procMeminfo();
+    MemorySnapshot mem;
+    MemorySnapshot::parseMeminfo(meminfo, std::strlen(meminfo), mem);
+    CHECK(MemorySnapshot::gib(mem.totalBytes) == 62.7);
+    CHECK(mem.usedPercent() == 64);
+}
@@ -0,0 +1,43 @@
+#include "TestHarness.h"
+#include "fixtures/MountTableFixtures.h"
+#include "MountTable.h"
+#include <algorithm>
+#include <cstring>
+
+namespace fx = Fixtures;
+
+static std::vector<MountTable::Mount> parseInChunks(size_t chunk) {
+    const std::string mountinfo = fx::mountinfo();
+    MountTable::MountinfoParser parser;
+    for (size_t at = 0; at < mountinfo.size(); at += chunk) {
+        parser.feed(mountinfo.data() + at, (std::min)(chunk, mountinfo.size() - at));
+    }
+    return parser.finish();
+}
+
+// Workstation with Docker and NFS: five storage mounts survive
+TEST_CASE(mountinfoWhole) {
+    std::vector<MountTable::Mount> mounts = parseInChunks(std::strlen(fx::mountinfo()));
+    const char* const expected[] = { "/", "/home", "/mnt/My Backup", "/mnt/media", "/mnt/scratch" };
+    CHECK(mounts.size() == 5);
+    if (mounts.size() != 5) return;
+    for (size_t i = 0; i < 5; ++i) CHECK(mounts[i].mountPoint == expected[i]);
+    CHECK(mounts[0].deviceId == "259:2");
+    CHECK(mounts[1].fsType == "btrfs");
+    CHECK(mounts[2].kind == MountTable::Kind::Local);
+    CHECK(mounts[3].kind == MountTable::Kind::Network);
+    CHECK(mounts[3].device == "nas:/export/media");
+    CHECK(mounts[4].kind == MountTable::Kind::Network);
+}
+
+// 7-byte feeds split lines (and the \040 escape); the result must not change
+TEST_CASE(mountinfoChunked) {
+    std::vector<MountTable::Mount> whole = parseInChunks(std::strlen(fx::mountinfo()));
+    std::vector<MountTable::Mount> pieces = parseInChunks(7);
+    CHECK(pieces.size() == whole.size());
+    for (size_t i = 0; i < (std::min)(whole.size(), pieces.size()); ++i) {
+        CHECK(pieces[i].mountPoint == whole[i].mountPoint);
+        CHECK(pieces[i].deviceId == whole[i].deviceId);
+        CHECK(pieces[i].kind == whole[i].kind);
+    }
+}
@@ -0,0 +1,28 @@
+#include "TestHarness.h"
+#include "fixtures/NumaInfoFixtures.h"
+#include "NumaInfo.h"
+#include <cstring>
+
+namespace fx = Fixtures;
+
+// node1 nearly out of local memory
+TEST_CASE(parseNodeMeminfo) {
+    const char* meminfo = fx::numaNodeMeminfo();
+    NumaInfo::Node node;
+    CHECK(NumaInfo::parseNodeMeminfo(meminfo, std::strlen(meminfo), node.totalBytes, node.freeBytes));
+    CHECK(node.totalBytes == 65970652ULL * 1024);
+    CHECK(node.freeBytes == 3012884ULL * 1024);
+    CHECK(node.starved());
+}
+
+TEST_CASE(countCpus) {
+    const char* cpulist = fx::numaCpulist();
+    CHECK(NumaInfo::countCpus(cpulist, std::strlen(cpulist)) == 4096);
+}
+
+TEST_CASE(parseDistance) {
+    const char* distance = fx::numaDistance();
+    std::vector<int> row;
+    CHECK(NumaInfo::parseDistance(distance, std::strlen(distance), row) == 2);
+    CHECK(row.size() == 2 && row[0] == 21 && row[1] == 10);
+}
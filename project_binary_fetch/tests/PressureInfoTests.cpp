@@ -0,0 +1,47 @@
+#include "TestHarness.h"
+#include "fixtures/PressureInfoFixtures.h"
+#include "PressureInfo.h"
+#include <cmath>
+#include <cstring>
+
+namespace fx = Fixtures;
+
+TEST_CASE(parseStall) {
+    const char* psi = fx::psiIo();
+    PressureInfo::Stall stall;
+    CHECK(PressureInfo::parseStall(psi, std::strlen(psi), stall));
+    CHECK(std::abs(stall.someAvg10 - 12.48f) <= 0.001f);
+    CHECK(std::abs(stall.someAvg60 - 7.03f) <= 0.001f);
+    CHECK(std::abs(stall.fullAvg10 - 9.70f) <= 0.001f);
+    CHECK(std::abs(stall.fullAvg60 - 5.12f) <= 0.001f);
+}
+
+TEST_CASE(parseLoadavg) {
+    const char* loadavg = fx::loadavg();
+    PressureInfo::Load load;
+    CHECK(PressureInfo::parseLoadavg(loadavg, std::strlen(loadavg), load));
+    CHECK(std::abs(load.avg1 - 3.27f) <= 0.001f);
+    CHECK(std::abs(load.avg15 - 2.10f) <= 0.001f);
+    CHECK(load.running == 5);
+    CHECK(load.total == 1873);
+}
+
+// Unreadable values are skipped; "full" only on memory / io when asked for
+TEST_CASE(fields) {
+    PressureInfo::Snapshot s;
+    s.cpu.someAvg10 = 1.25f;  s.cpu.someAvg60 = 0.5f;  s.cpu.fullAvg10 = 0.0f;  s.cpu.fullAvg60 = 0.0f;
+    s.io.someAvg10 = 12.48f;  s.io.someAvg60 = 7.03f;  s.io.fullAvg10 = 9.70f;  s.io.fullAvg60 = 5.12f;
+    s.load.running = 5;
+    s.switchesPerSec = 12345.0;
+
+    std::vector<PressureInfo::Field> f = PressureInfo::fields(s, true);
+    CHECK(f.size() == 4);
+    if (f.size() != 4) return;
+    CHECK(std::strcmp(f[0].name, "cpu") == 0 && f[0].value == "1.2/0.5");
+    CHECK(std::strcmp(f[1].name, "io") == 0 && f[1].value == "12.5/7.0 full 9.7/5.1");
+    CHECK(std::strcmp(f[2].name, "load") == 0 && f[2].value == "run 5");
+    CHECK(std::strcmp(f[3].name, "switches") == 0 && f[3].value == "12.3k/s");
+
+    CHECK(PressureInfo::fields(s, false)[1].value == "12.5/7.0");
+    CHECK(PressureInfo::fields(PressureInfo::Snapshot(), true).empty());
+}
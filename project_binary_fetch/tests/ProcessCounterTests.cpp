@@ -0,0 +1,48 @@
+#include "TestHarness.h"
+#include "fixtures/ProcessCounterFixtures.h"
+#include "ProcessCounter.h"
+#include "TopProcesses.h"
+#include <cstring>
+
+namespace fx = Fixtures;
+
+// /proc/<pid>/stat num_threads, comm with spaces and ") " inside it
+TEST_CASE(statThreads) {
+    for (const auto& s : fx::procPidStats()) {
+        CHECK(ProcessCounter::statThreads(s.line.data(), s.line.size()) == s.threads);
+    }
+}
+
+TEST_CASE(topProcessesParseStat) {
+    TopProcesses::StatFields fields;
+    for (const auto& s : fx::procPidStats()) {
+        bool parsed = TopProcesses::parseStat(s.line.data(), s.line.size(), fields);
+        CHECK(parsed == (s.threads >= 0));
+        if (!parsed) continue;
+        CHECK(fields.name == s.name);
+        CHECK(fields.cpuTicks == s.cpuTicks);
+        CHECK(fields.rssPages == s.rssPages);
+    }
+}
+
+// Names longer than the record buffer are cut on a character boundary
+TEST_CASE(topProcessesCopyName) {
+    char name[8];
+    TopProcesses::copyName("short", name, sizeof(name));
+    CHECK(std::strcmp(name, "short") == 0);
+    TopProcesses::copyName("exactly", name, sizeof(name));
+    CHECK(std::strcmp(name, "exactly") == 0);
+    TopProcesses::copyName("abcdefgh", name, sizeof(name));
+    CHECK(std::strcmp(name, "abcdefg") == 0);
+    TopProcesses::copyName("abcde\xC3\xA9z", name, sizeof(name));         // "abcde" + e-acute fits
+    CHECK(std::strcmp(name, "abcde\xC3\xA9") == 0);
+    TopProcesses::copyName("abcdef\xC3\xA9", name, sizeof(name));         // e-acute would be split
+    CHECK(std::strcmp(name, "abcdef") == 0);
+    TopProcesses::copyName("ab\xE6\x97\xA5\xE6\x9C\xAC", name, sizeof(name)); // second CJK char split
+    CHECK(std::strcmp(name, "ab\xE6\x97\xA5") == 0);
+}
+
+TEST_CASE(fileNrHandles) {
+    const char* fileNr = fx::fileNr();
+    CHECK(ProcessCounter::fileNrHandles(fileNr, std::strlen(fileNr)) == 26144);
+}
@@ -0,0 +1,36 @@
+#include "TestHarness.h"
+#include "fixtures/SmbiosFixtures.h"
+#include "Smbios.h"
+
+namespace fx = Fixtures;
+
+TEST_CASE(parseCapturedTables) {
+    for (const auto& t : fx::smbiosTables()) {
+        Smbios s = Smbios::parse(t.table.data(), t.table.size());
+        const Smbios::Dimm* first = nullptr;
+        for (const auto& d : s.dimms) if (!first && d.sizeBytes > 0) first = &d;
+        CHECK(s.biosVendor == t.biosVendor);
+        CHECK(s.biosVersion == t.biosVersion);
+        CHECK(s.boardProduct == t.boardProduct);
+        CHECK(s.memorySlots == t.slots);
+        CHECK(s.installedDimms() == t.installed);
+        CHECK(first && first->sizeBytes == t.firstDimmBytes && first->speedMTs == t.firstDimmMTs);
+    }
+}
+
+// Truncated and bit-flipped copies of the captured tables. The parse only
+// has to finish (a bad read faults, or trips ASan in a sanitizer build) and
+// never invent more DIMMs than the damaged table has bytes for.
+TEST_CASE(parseCorruptedTables) {
+    for (const auto& t : fx::smbiosTables()) {
+        uint32_t seed = 0x9E3779B9u;
+        auto next = [&seed] { seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5; return seed; };
+        std::vector<uint8_t> damaged;
+        for (int round = 0; round < 2000; ++round) {
+            damaged.assign(t.table.begin(), t.table.begin() + next() % (t.table.size() + 1));
+            for (int flips = next() % 8; flips > 0 && !damaged.empty(); --flips) damaged[next() % damaged.size()] = static_cast<uint8_t>(next());
+            Smbios f = Smbios::parse(damaged.data(), damaged.size());
+            CHECK(f.dimms.size() * 4 <= damaged.size());
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+/*
+ ---------------------------------------------------------
+                      Test Harness
+ ---------------------------------------------------------
+
+  Just enough to run the fixture checks of one module per
+  executable (see CMakeLists.txt): TEST_CASE registers a
+  function, CHECK records a failed expression and keeps
+  going, TestMain.cpp runs everything and returns 1 if any
+  check failed.
+
+  No windows.h anywhere in here: the parsers under test are
+  the ones the Linux build uses, so they have to build on
+  Linux too.
+*/
+namespace TestHarness {
+
+struct Case {
+    const char* name;
+    void (*run)();
+};
+
+inline std::vector<Case>& cases() {
+    static std::vector<Case> list;
+    return list;
+}
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+inline void fail(const char* file, int line, const char* expression) {
+    std::cout << "  " << file << ":" << line << ": CHECK(" << expression << ") failed\n";
+    failures()++;
+}
+
+struct Register {
+    Register(const char* name, void (*run)()) { cases().push_back({ name, run }); }
+};
+
+} // namespace TestHarness
+
+#define TEST_CASE(name)                                                 \
+    static void name();                                                 \
+    static TestHarness::Register name##Registration(#name, name);       \
+    static void name()
+
+#define CHECK(expression)                                                       \
+    do {                                                                        \
+        if (!(expression)) TestHarness::fail(__FILE__, __LINE__, #expression);  \
+    } while (0)
@@ -0,0 +1,10 @@
+#include "TestHarness.h"
+
+int main() {
+    for (const auto& c : TestHarness::cases()) {
+        int before = TestHarness::failures();
+        c.run();
+        std::cout << (TestHarness::failures() == before ? "[ ok ] " : "[FAIL] ") << c.name << "\n";
+    }
+    return TestHarness::failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+// Recorded CgroupLimits input, checked by tests/CgroupLimitsTests.cpp and timed by BinaryFetchBench
+namespace Fixtures {
+
+// ---------------- CgroupLimits parsers ----------------
+
+// /proc/self/cgroup of a pod container on a hybrid host (v1 lines first)
+inline const char* selfCgroup() {
+    return "12:pids:/kubepods/burstable/pod7f3c/4b1e\n"
+           "4:memory:/kubepods/burstable/pod7f3c/4b1e\n"
+           "1:name=systemd:/kubepods/burstable/pod7f3c/4b1e\n"
+           "0::/kubepods.slice/kubepods-burstable.slice/kubepods-burstable-pod7f3c.slice/cri-containerd-4b1e.scope\n";
+}
+
+// cpu.max of a 2500m limit, and memory.stat of the same container (4 GiB limit)
+inline const char* cgroupCpuMax() { return "250000 100000\n"; }
+
+inline const char* cgroupMemoryStat() {
+    return "anon 1288490188\n"
+           "file 805306368\n"
+           "kernel 41943040\n"
+           "kernel_stack 2424832\n"
+           "pagetables 8388608\n"
+           "sec_pagetables 0\n"
+           "percpu 1179648\n"
+           "sock 0\n"
+           "vmalloc 65536\n"
+           "shmem 16777216\n"
+           "zswap 0\n"
+           "zswapped 0\n"
+           "file_mapped 134217728\n"
+           "file_dirty 135168\n"
+           "file_writeback 0\n"
+           "swapcached 0\n"
+           "anon_thp 0\n"
+           "inactive_anon 1304526848\n"
+           "active_anon 4096\n"
+           "inactive_file 536870912\n"
+           "active_file 268435456\n"
+           "unevictable 0\n"
+           "slab_reclaimable 25165824\n"
+           "slab_unreclaimable 4194304\n";
+}
+
+} // namespace Fixtures
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// Recorded CpuSampler input, checked by tests/CpuSamplerTests.cpp and timed by BinaryFetchBench
+namespace Fixtures {
+
+// ---------------- CpuSampler::parseProcStat / coreDeltaKernel ----------------
+
+// Two /proc/stat readings one second apart on a 4-slot machine with cpu2
+// offline (no line at all, like a hot-unplugged core). The intr line is long
+// on real systems; the parser has to stop before it.
+struct ProcStatFixture {
+    std::string before;
+    std::string after;
+    size_t cores;                 // expected highest CPU number + 1
+    std::vector<float> usage;     // expected per-CPU percent, -1 = offline
+};
+
+inline const ProcStatFixture& procStat() {
+    static const ProcStatFixture f = {
+        "cpu  350 10 190 2900 50 0 0 0 0 0\n"
+        "cpu0 100 0 50 800 50 0 0 0 0 0\n"
+        "cpu1 200 10 90 1700 0 0 0 0 0 0\n"
+        "cpu3 50 0 50 400 0 0 0 0 0 0\n"
+        "intr 48213 9 0 0 0 0 0 0 0 1 0 0 0 0 0 0 0 0\n"
+        "ctxt 91833\n",
+        "cpu  575 10 240 3025 50 0 0 0 0 0\n"
+        "cpu0 200 0 100 850 50 0 0 0 0 0\n"
+        "cpu1 225 10 90 1775 0 0 0 0 0 0\n"
+        "cpu3 150 0 50 400 0 0 0 0 0 0\n"
+        "intr 49002 9 0 0 0 0 0 0 0 1 0 0 0 0 0 0 0 0\n"
+        "ctxt 93410\n",
+        4,
+        { 75.0f, 25.0f, -1.0f, 100.0f },
+    };
+    return f;
+}
+
+
+// Four clock readings of a 4-CPU hybrid part: cpu0/cpu1 P-cores (top 5000
+// MHz), cpu2/cpu3 E-cores (top 3800 MHz), cpu3 offline in the last reading.
+struct ClockFixture {
+    std::vector<float> mhz;       // samples * cores, slot-major
+    std::vector<float> ceiling;
+    size_t samples, cores;
+    float minMHz, avgMHz, maxMHz, atMaxPercent;
+};
+
+inline const ClockFixture& clockWindow() {
+    static const ClockFixture f = {
+        {
+            4990, 4200, 3800, 1200,
+            4995, 4985, 3790, 800,
+            3100, 4980, 3000, 800,
+            4975, 4990, 3795, -1,
+        },
+        { 5000, 5000, 3800, 3800 },
+        4, 4,
+        800.0f, 3626.67f, 4995.0f, 60.0f,
+    };
+    return f;
+}
+
+} // namespace Fixtures
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <map>
+#include <cstdint>
+
+// Recorded CpuTopology input, checked by tests/CpuTopologyTests.cpp and timed by BinaryFetchBench
+namespace Fixtures {
+
+// ---------------- CpuTopology::fromSysfs ----------------
+
+// Two-socket box with SMT, booted with half the CPUs offline and a hole in
+// the numbering: online "0-1,4-5,64-67" out of present "0-7,64-71". Each
+// socket has one 32 MB L3; every core its own 48K + 32K L1 and 2 MB L2.
+struct SysfsTopologyFixture {
+    std::map<std::string, std::string> files;
+    int sockets, cores, logical, offline;
+    uint64_t l1, l2, l3;
+    int baseMHz;
+};
+
+inline const SysfsTopologyFixture& sysfsTopology() {
+    static const SysfsTopologyFixture f = [] {
+        SysfsTopologyFixture t;
+        const std::string base = "/sys/devices/system/cpu/";
+        t.files[base + "online"] = "0-1,4-5,64-67";
+        t.files[base + "present"] = "0-7,64-71";
+        for (int cpu : { 0, 1, 4, 5, 64, 65, 66, 67 }) {
+            const std::string dir = base + "cpu" + std::to_string(cpu) + "/";
+            const int first = cpu & ~1;
+            const std::string core = std::to_string(first) + "-" + std::to_string(first + 1);
+            t.files[dir + "topology/thread_siblings_list"] = core;
+            t.files[dir + "topology/physical_package_id"] = cpu < 64 ? "0" : "1";
+
+            const char* levels[4] = { "1", "1", "2", "3" };
+            const char* sizes[4] = { "48K", "32K", "2048K", "32768K" };
+            for (int i = 0; i < 4; ++i) {
+                const std::string cache = dir + "cache/index" + std::to_string(i) + "/";
+                t.files[cache + "level"] = levels[i];
+                t.files[cache + "size"] = sizes[i];
+                t.files[cache + "shared_cpu_list"] = i < 3 ? core : (cpu < 64 ? "0-1,4-5" : "64-67");
+            }
+        }
+        t.files[base + "cpu0/cpufreq/base_frequency"] = "2100000";
+        t.sockets = 2;
+        t.cores = 4;
+        t.logical = 8;
+        t.offline = 8;
+        t.l1 = 4 * 80 * 1024;
+        t.l2 = 4 * 2048 * 1024;
+        t.l3 = 2 * 32768ULL * 1024;
+        t.baseMHz = 2100;
+        return t;
+    }();
+    return f;
+}
+
+} // namespace Fixtures
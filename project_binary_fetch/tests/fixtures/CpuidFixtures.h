@@ -0,0 +1,63 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Recorded Cpuid input, checked by tests/CpuidTests.cpp and timed by BinaryFetchBench
+namespace Fixtures {
+
+// ---------------- Cpuid::decode ----------------
+
+struct CpuidLeaf {
+    uint32_t leaf, subleaf;
+    uint32_t eax, ebx, ecx, edx;
+};
+
+// Sapphire Rapids vCPU under KVM (1 vCPU, AMX passed through). Leaves not
+// listed read as zeros. Decoded twice: with the guest's XCR0, and with an
+// OS that only saves SSE/AVX state (AVX-512 and AMX must drop out).
+struct CpuidFixture {
+    std::vector<CpuidLeaf> leaves;
+    uint64_t xcr0;
+    std::string brand;
+    std::string hypervisor;
+    std::string features;          // expected featureLine() with xcr0
+    std::string featuresAvxOnly;   // expected featureLine() with XCR0 = 0x7
+    uint64_t l2Bytes;
+};
+
+inline const CpuidFixture& cpuidSapphireRapidsKvm() {
+    static const CpuidFixture f = {
+        {
+            { 0x0, 0,        0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69 },
+            { 0x1, 0,        0x000806F8, 0x00010800, 0xFFFA3203, 0x0F8BFBFF },
+            { 0x4, 0,        0x00000121, 0x02C0003F, 0x0000003F, 0x00000000 },
+            { 0x4, 1,        0x00000122, 0x01C0003F, 0x0000003F, 0x00000000 },
+            { 0x4, 2,        0x00000143, 0x03C0003F, 0x000007FF, 0x00000000 },
+            { 0x4, 3,        0x00000163, 0x0380003F, 0x0001BFFF, 0x00000004 },
+            { 0x7, 0,        0x00000002, 0xF1BF27EB, 0x1B415FDE, 0xBFD14410 },
+            { 0x7, 1,        0x00001C30, 0x00000000, 0x00000000, 0x00000000 },
+            { 0xB, 0,        0x00000000, 0x00000001, 0x00000100, 0x00000000 },
+            { 0xB, 1,        0x00000005, 0x00000001, 0x00000201, 0x00000000 },
+            { 0xB, 2,        0x00000000, 0x00000000, 0x00000002, 0x00000000 },
+            { 0x1F, 0,       0x00000000, 0x00000001, 0x00000100, 0x00000000 },
+            { 0x40000000, 0, 0x40000001, 0x4B4D564B, 0x564B4D56, 0x0000004D },
+            { 0x80000000, 0, 0x80000008, 0x00000000, 0x00000000, 0x00000000 },
+            { 0x80000001, 0, 0x00000000, 0x00000000, 0x00000121, 0x2C100800 },
+            { 0x80000002, 0, 0x65746E49, 0x2952286C, 0x6F655820, 0x2952286E },
+            { 0x80000003, 0, 0x6F725020, 0x73736563, 0x0000726F, 0x00000000 },
+            { 0x80000006, 0, 0x00000000, 0x00000000, 0x08007040, 0x00000000 },
+        },
+        0x602E7,
+        "Intel(R) Xeon(R) Processor",
+        "KVM",
+        "SSE2 SSE3 SSSE3 SSE4.1 SSE4.2 POPCNT AES PCLMUL SHA AVX F16C FMA AVX2 BMI1 BMI2 AVX-VNNI "
+        "AVX-512F AVX-512DQ AVX-512BW AVX-512VL AVX-512VNNI AVX-512BF16 AVX-512FP16 AMX-TILE AMX-INT8 AMX-BF16",
+        "SSE2 SSE3 SSSE3 SSE4.1 SSE4.2 POPCNT AES PCLMUL SHA AVX F16C FMA AVX2 BMI1 BMI2 AVX-VNNI",
+        2048 * 1024,
+    };
+    return f;
+}
+
+} // namespace Fixtures
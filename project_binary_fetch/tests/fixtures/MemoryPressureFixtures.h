@@ -0,0 +1,79 @@
+#pragma once
+
+// Recorded MemoryPressure input, checked by tests/MemoryPressureTests.cpp and timed by BinaryFetchBench
+namespace Fixtures {
+
+// ---------------- MemoryPressure::parseVmstat / parseMmStat ----------------
+
+// /proc/vmstat of the same host, trimmed (the real file has ~190 lines); the
+// near misses (zswpwb, thp_fault_fallback_charge, pgfault-like pgfree) stay in
+inline const char* procVmstat() {
+    return "nr_free_pages 468352\n"
+           "nr_zone_inactive_anon 1775528\n"
+           "nr_zone_active_anon 7327715\n"
+           "nr_zone_inactive_file 3182001\n"
+           "nr_zone_active_file 2222714\n"
+           "nr_zone_unevictable 7680\n"
+           "nr_zone_write_pending 4561\n"
+           "nr_mlock 7680\n"
+           "nr_bounce 0\n"
+           "nr_zspages 0\n"
+           "nr_free_cma 0\n"
+           "numa_hit 9817263512\n"
+           "numa_miss 0\n"
+           "numa_foreign 0\n"
+           "numa_interleave 4120\n"
+           "numa_local 9817263512\n"
+           "numa_other 0\n"
+           "nr_inactive_anon 1775528\n"
+           "nr_active_anon 7327715\n"
+           "nr_inactive_file 3182001\n"
+           "nr_active_file 2222714\n"
+           "nr_unevictable 7680\n"
+           "nr_slab_reclaimable 302719\n"
+           "nr_slab_unreclaimable 275278\n"
+           "nr_isolated_anon 0\n"
+           "nr_isolated_file 0\n"
+           "nr_anon_pages 9095127\n"
+           "nr_mapped 503721\n"
+           "nr_file_pages 5345143\n"
+           "nr_dirty 4561\n"
+           "nr_writeback 0\n"
+           "nr_shmem 153024\n"
+           "nr_anon_transparent_hugepages 5121\n"
+           "nr_dirtied 1893326475\n"
+           "nr_written 1887114006\n"
+           "pgpgin 2312788944\n"
+           "pgpgout 9182736411\n"
+           "pswpin 117281\n"
+           "pswpout 239044\n"
+           "pgalloc_normal 12817263999\n"
+           "pgfree 12818103377\n"
+           "pgactivate 412883010\n"
+           "pgfault 18233019472\n"
+           "pgmajfault 1872211\n"
+           "pgrefill 83710224\n"
+           "pgsteal_kswapd 402118374\n"
+           "pgscan_kswapd 431877210\n"
+           "oom_kill 3\n"
+           "compact_stall 1871\n"
+           "thp_fault_alloc 1029113\n"
+           "thp_fault_fallback 20331\n"
+           "thp_fault_fallback_charge 0\n"
+           "thp_collapse_alloc 48291\n"
+           "thp_collapse_alloc_failed 311\n"
+           "thp_split_page 8127\n"
+           "balloon_inflate 0\n"
+           "swap_ra 40122\n"
+           "zswpin 88127\n"
+           "zswpout 190443\n"
+           "zswpwb 0\n"
+           "direct_map_level2_splits 1311\n";
+}
+
+// /sys/block/zram0/mm_stat: 2 GB stored in 605 MB, 623 MB of RAM used
+inline const char* zramMmStat() {
+    return "  2143174656   634757234   653828096           0   653828096     12037        0        0        0\n";
+}
+
+} // namespace Fixtures
@@ -0,0 +1,57 @@
+#pragma once
+
+// Recorded MemorySnapshot input, checked by tests/MemorySnapshotTests.cpp and timed by BinaryFetchBench
+namespace Fixtures {
+
+// ---------------- MemorySnapshot::parseMeminfo ----------------
+
+// /proc/meminfo of a 64 GB database host (6.8 kernel, 2 MB hugepages reserved)
+inline const char* procMeminfo() {
+    return "MemTotal:       65755612 kB\n"
+           "MemFree:         1873408 kB\n"
+           "MemAvailable:   23711044 kB\n"
+           "Buffers:          902144 kB\n"
+           "Cached:         21380572 kB\n"
+           "SwapCached:        41212 kB\n"
+           "Active:         38201716 kB\n"
+           "Inactive:       19830116 kB\n"
+           "Active(anon):   29310860 kB\n"
+           "Inactive(anon):  7102112 kB\n"
+           "Active(file):    8890856 kB\n"
+           "Inactive(file): 12728004 kB\n"
+           "Unevictable:       30720 kB\n"
+           "Mlocked:           30720 kB\n"
+           "SwapTotal:       8388604 kB\n"
+           "SwapFree:        7919612 kB\n"
+           "Zswap:                0 kB\n"
+           "Zswapped:             0 kB\n"
+           "Dirty:             18244 kB\n"
+           "Writeback:             0 kB\n"
+           "AnonPages:      36380508 kB\n"
+           "Mapped:          2014884 kB\n"
+           "Shmem:            612096 kB\n"
+           "KReclaimable:    1210876 kB\n"
+           "Slab:            2311988 kB\n"
+           "SReclaimable:    1210876 kB\n"
+           "SUnreclaim:      1101112 kB\n"
+           "KernelStack:       30432 kB\n"
+           "PageTables:       160484 kB\n"
+           "CommitLimit:    37072904 kB\n"
+           "Committed_AS:   51893120 kB\n"
+           "VmallocTotal:   34359738367 kB\n"
+           "VmallocUsed:      223720 kB\n"
+           "AnonHugePages:  10487808 kB\n"
+           "ShmemHugePages:        0 kB\n"
+           "FileHugePages:         0 kB\n"
+           "HugePages_Total:    2048\n"
+           "HugePages_Free:      512\n"
+           "HugePages_Rsvd:        0\n"
+           "HugePages_Surp:        0\n"
+           "Hugepagesize:       2048 kB\n"
+           "Hugetlb:         4194304 kB\n"
+           "DirectMap4k:      812916 kB\n"
+           "DirectMap2M:    34709504 kB\n"
+           "DirectMap1G:    33554432 kB\n";
+}
+
+} // namespace Fixtures
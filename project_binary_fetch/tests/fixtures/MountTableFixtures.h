@@ -0,0 +1,31 @@
+#pragma once
+
+// Recorded MountTable input, checked by tests/MountTableTests.cpp and timed by BinaryFetchBench
+namespace Fixtures {
+
+// ---------------- MountTable mountinfo parser ----------------
+
+// /proc/self/mountinfo of a workstation with Docker: pseudo file systems,
+// a bind mount of the root device, two btrfs subvolumes of one device, a
+// label with an escaped space, a snap, a container layer and two NFS
+// shares. Five storage mounts survive: /, /home, "/mnt/My Backup",
+// /mnt/media and /mnt/scratch.
+inline const char* mountinfo() {
+    return "22 28 0:21 / /sys rw,nosuid,nodev,noexec,relatime shared:7 - sysfs sysfs rw\n"
+           "23 28 0:22 / /proc rw,nosuid,nodev,noexec,relatime shared:13 - proc proc rw\n"
+           "24 28 0:5 / /dev rw,nosuid,relatime shared:2 - devtmpfs udev rw,size=16342668k,nr_inodes=4085667,mode=755\n"
+           "26 24 0:25 / /dev/shm rw,nosuid,nodev shared:4 - tmpfs tmpfs rw,inode64\n"
+           "28 1 259:2 / / rw,relatime shared:1 - ext4 /dev/nvme0n1p2 rw,errors=remount-ro\n"
+           "30 22 0:27 / /sys/fs/cgroup rw,nosuid,nodev,noexec,relatime shared:9 - cgroup2 cgroup2 rw,nsdelegate\n"
+           "41 23 0:35 / /proc/sys/fs/binfmt_misc rw,relatime shared:14 - autofs systemd-1 rw,fd=29,pgrp=1,timeout=0\n"
+           "57 28 0:31 /@home /home rw,relatime shared:30 - btrfs /dev/nvme0n1p3 rw,ssd,space_cache=v2,subvol=/@home\n"
+           "58 57 0:31 /@snapshots /home/.snapshots rw,relatime shared:31 - btrfs /dev/nvme0n1p3 rw,ssd,subvol=/@snapshots\n"
+           "61 28 7:3 / /snap/core22/1380 ro,nodev,relatime shared:33 - squashfs /dev/loop3 ro,errors=continue\n"
+           "64 28 8:17 / /mnt/My\\040Backup rw,nosuid,nodev,relatime shared:35 - ext4 /dev/sdb1 rw\n"
+           "88 28 0:52 / /mnt/media rw,relatime shared:40 - nfs4 nas:/export/media rw,vers=4.2,hard,proto=tcp\n"
+           "89 28 0:53 / /mnt/scratch rw,relatime shared:41 - nfs nas:/export/scratch rw,vers=3,hard\n"
+           "95 28 259:2 /var/lib/docker /var/lib/docker rw,relatime shared:1 - ext4 /dev/nvme0n1p2 rw,errors=remount-ro\n"
+           "97 95 0:60 / /var/lib/docker/overlay2/3f9c/merged rw,relatime - overlay overlay rw,lowerdir=/var/lib/docker/overlay2/l/AB\n";
+}
+
+} // namespace Fixtures
@@ -0,0 +1,26 @@
+#pragma once
+
+// Recorded NumaInfo input, checked by tests/NumaInfoTests.cpp and timed by BinaryFetchBench
+namespace Fixtures {
+
+// ---------------- NumaInfo parsers ----------------
+
+// node1 of a dual-socket database host, nearly out of local memory
+// (MemFree 4.6 % of MemTotal), with the head of its meminfo file
+inline const char* numaNodeMeminfo() {
+    return "Node 1 MemTotal:       65970652 kB\n"
+           "Node 1 MemFree:         3012884 kB\n"
+           "Node 1 MemUsed:        62957768 kB\n"
+           "Node 1 SwapCached:            0 kB\n"
+           "Node 1 Active:         41203316 kB\n"
+           "Node 1 Inactive:       19807112 kB\n"
+           "Node 1 FilePages:      20114436 kB\n"
+           "Node 1 HugePages_Total:     0\n";
+}
+
+// One node of a large partitioned box: 4096 CPUs in two ranges, plus a
+// distance row; the counter must not walk every CPU
+inline const char* numaCpulist() { return "0-2047,4096-6143\n"; }
+inline const char* numaDistance() { return "21 10\n"; }
+
+} // namespace Fixtures
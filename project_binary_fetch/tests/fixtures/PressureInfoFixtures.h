@@ -0,0 +1,16 @@
+#pragma once
+
+// Recorded PressureInfo input, checked by tests/PressureInfoTests.cpp and timed by BinaryFetchBench
+namespace Fixtures {
+
+// ---------------- PressureInfo parsers ----------------
+
+// /proc/pressure/io on a box stalling on writeback, and /proc/loadavg
+inline const char* psiIo() {
+    return "some avg10=12.48 avg60=7.03 avg300=2.91 total=184467342\n"
+           "full avg10=9.70 avg60=5.12 avg300=2.05 total=139904117\n";
+}
+
+inline const char* loadavg() { return "3.27 2.94 2.10 5/1873 402117\n"; }
+
+} // namespace Fixtures
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Recorded ProcessCounter input, checked by tests/ProcessCounterTests.cpp and timed by BinaryFetchBench
+namespace Fixtures {
+
+// ---------------- ProcessCounter / TopProcesses parsers ----------------
+
+struct ProcStatLineFixture {
+    std::string line;          // one /proc/<pid>/stat
+    long long threads;         // expected num_threads (-1 = malformed)
+    std::string name;          // expected comm
+    uint64_t cpuTicks;         // expected utime + stime
+    uint64_t rssPages;
+};
+
+// comm is free text: spaces, parentheses and a ") " inside the name must not shift the fields
+inline const std::vector<ProcStatLineFixture>& procPidStats() {
+    static const std::vector<ProcStatLineFixture> list = {
+        { "1 (systemd) S 0 1 1 0 -1 4194560 48212 2191837 129 1672 391 688 5210 2317 20 0 1 0 27 172589056 3261 18446744073709551615 1 1 0 0 0 0 671173123 4096 1260 0 0 0 17 3 0 0 0 0 0\n", 1, "systemd", 1079, 3261 },
+        { "48211 (java) S 1 48211 48211 0 -1 1077936384 918273 0 12 0 81723 9123 0 0 20 0 212 0 913827 9126805504 412876 18446744073709551615 1 1 0 0 0 0 0 0 16800975 0 0 0 17 41 0 0 0 0 0\n", 212, "java", 90846, 412876 },
+        { "733 (tmux: server) ) S 1 733 733 0 -1 4194368 1281 0 0 0 91 77 0 0 20 0 1 0 4127 11862016 1024 18446744073709551615 1 1 0 0 0 0 0 4096 134433283 0 0 0 17 0 0 0 0 0 0\n", 1, "tmux: server) ", 168, 1024 },
+        { "9 (kworker/0:1-events) I 2 0 0 0 -1 69238880 0 0 0 0 0 3 0 0 20 0 1 0 12 0 0 18446744073709551615 0 0 0 0 0 0 0 2147483647 0 0 0 0 17 0 0 0 0 0 0\n", 1, "kworker/0:1-events", 3, 0 },
+        { "12 (truncated", -1, "", 0, 0 },
+    };
+    return list;
+}
+
+inline const char* fileNr() { return "26144\t0\t9223372036854775807\n"; }
+
+} // namespace Fixtures
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Recorded Smbios input, checked by tests/SmbiosTests.cpp and timed by BinaryFetchBench
+namespace Fixtures {
+
+// ---------------- Smbios::parse ----------------
+
+struct SmbiosFixture {
+    const char* label;
+    std::vector<uint8_t> table;        // structure table, as after the RawSMBIOSData header
+    std::string biosVendor;            // expected fields
+    std::string biosVersion;
+    std::string boardProduct;          // trailing spaces trimmed
+    int slots;
+    int installed;
+    uint64_t firstDimmBytes;           // first populated DIMM
+    unsigned firstDimmMTs;
+};
+
+// B550 desktop, AMI BIOS (SMBIOS 3.3 layout, 0x54-byte type 17): two of four
+// slots filled with 16 GB DDR4-3200. Empty slots keep their locator strings
+// and report memory type "Unknown" (0x02).
+inline const std::vector<SmbiosFixture>& smbiosTables() {
+    static const std::vector<SmbiosFixture> list = {
+        { "ASUS ROG STRIX B550-F, 2 x 16 GB DDR4", {
+            0x00, 0x1A, 0x00, 0x00, 0x01, 0x02, 0x00, 0xF0, 0x03, 0xFF, 0x80, 0x98, 0x9A, 0x09, 0x08, 0x00,
+            0x00, 0x00, 0x03, 0x0D, 0x05, 0x11, 0xFF, 0xFF, 0x20, 0x00, 0x41, 0x6D, 0x65, 0x72, 0x69, 0x63,
+            0x61, 0x6E, 0x20, 0x4D, 0x65, 0x67, 0x61, 0x74, 0x72, 0x65, 0x6E, 0x64, 0x73, 0x20, 0x49, 0x6E,
+            0x63, 0x2E, 0x00, 0x32, 0x38, 0x30, 0x33, 0x00, 0x30, 0x34, 0x2F, 0x32, 0x37, 0x2F, 0x32, 0x30,
+            0x32, 0x32, 0x00, 0x00, 0x01, 0x1B, 0x01, 0x00, 0x01, 0x02, 0x03, 0x04, 0x00, 0x01, 0x02, 0x03,
+            0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x06, 0x05, 0x06, 0x53,
+            0x79, 0x73, 0x74, 0x65, 0x6D, 0x20, 0x6D, 0x61, 0x6E, 0x75, 0x66, 0x61, 0x63, 0x74, 0x75, 0x72,
+            0x65, 0x72, 0x00, 0x53, 0x79, 0x73, 0x74, 0x65, 0x6D, 0x20, 0x50, 0x72, 0x6F, 0x64, 0x75, 0x63,
+            0x74, 0x20, 0x4E, 0x61, 0x6D, 0x65, 0x00, 0x53, 0x79, 0x73, 0x74, 0x65, 0x6D, 0x20, 0x56, 0x65,
+            0x72, 0x73, 0x69, 0x6F, 0x6E, 0x00, 0x53, 0x79, 0x73, 0x74, 0x65, 0x6D, 0x20, 0x53, 0x65, 0x72,
+            0x69, 0x61, 0x6C, 0x20, 0x4E, 0x75, 0x6D, 0x62, 0x65, 0x72, 0x00, 0x54, 0x6F, 0x20, 0x62, 0x65,
+            0x20, 0x66, 0x69, 0x6C, 0x6C, 0x65, 0x64, 0x20, 0x62, 0x79, 0x20, 0x4F, 0x2E, 0x45, 0x2E, 0x4D,
+            0x2E, 0x00, 0x53, 0x4B, 0x55, 0x00, 0x00, 0x02, 0x0F, 0x02, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+            0x09, 0x06, 0x03, 0x00, 0x0A, 0x00, 0x41, 0x53, 0x55, 0x53, 0x54, 0x65, 0x4B, 0x20, 0x43, 0x4F,
+            0x4D, 0x50, 0x55, 0x54, 0x45, 0x52, 0x20, 0x49, 0x4E, 0x43, 0x2E, 0x00, 0x52, 0x4F, 0x47, 0x20,
+            0x53, 0x54, 0x52, 0x49, 0x58, 0x20, 0x42, 0x35, 0x35, 0x30, 0x2D, 0x46, 0x20, 0x47, 0x41, 0x4D,
+            0x49, 0x4E, 0x47, 0x20, 0x20, 0x20, 0x00, 0x52, 0x65, 0x76, 0x20, 0x58, 0x2E, 0x30, 0x78, 0x00,
+            0x32, 0x31, 0x30, 0x34, 0x38, 0x35, 0x37, 0x39, 0x32, 0x31, 0x30, 0x30, 0x31, 0x32, 0x33, 0x00,
+            0x44, 0x65, 0x66, 0x61, 0x75, 0x6C, 0x74, 0x20, 0x73, 0x74, 0x72, 0x69, 0x6E, 0x67, 0x00, 0x44,
+            0x65, 0x66, 0x61, 0x75, 0x6C, 0x74, 0x20, 0x73, 0x74, 0x72, 0x69, 0x6E, 0x67, 0x00, 0x00, 0x10,
+            0x17, 0x10, 0x00, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x08, 0xFE, 0xFF, 0x04, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x54, 0x11, 0x00, 0x10, 0x00, 0xFE, 0xFF,
+            0x40, 0x00, 0x40, 0x00, 0x00, 0x00, 0x09, 0x00, 0x01, 0x02, 0x02, 0x00, 0x00, 0x00, 0x00, 0x03,
+            0x04, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x49, 0x4D, 0x4D,
+            0x5F, 0x41, 0x31, 0x00, 0x42, 0x41, 0x4E, 0x4B, 0x20, 0x30, 0x00, 0x55, 0x6E, 0x6B, 0x6E, 0x6F,
+            0x77, 0x6E, 0x00, 0x55, 0x6E, 0x6B, 0x6E, 0x6F, 0x77, 0x6E, 0x00, 0x4E, 0x6F, 0x74, 0x20, 0x53,
+            0x70, 0x65, 0x63, 0x69, 0x66, 0x69, 0x65, 0x64, 0x00, 0x55, 0x6E, 0x6B, 0x6E, 0x6F, 0x77, 0x6E,
+            0x00, 0x00, 0x11, 0x54, 0x12, 0x00, 0x10, 0x00, 0xFE, 0xFF, 0x40, 0x00, 0x40, 0x00, 0x00, 0x40,
+            0x09, 0x00, 0x01, 0x02, 0x1A, 0x80, 0x00, 0x80, 0x0C, 0x03, 0x04, 0x05, 0x06, 0x02, 0x00, 0x00,
+            0x00, 0x00, 0x80, 0x0C, 0xB0, 0x04, 0xB0, 0x04, 0xB0, 0x04, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x49, 0x4D, 0x4D, 0x5F, 0x41, 0x32, 0x00, 0x42, 0x41,
+            0x4E, 0x4B, 0x20, 0x31, 0x00, 0x47, 0x20, 0x53, 0x6B, 0x69, 0x6C, 0x6C, 0x20, 0x49, 0x6E, 0x74,
+            0x6C, 0x00, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x00, 0x4E, 0x6F, 0x74, 0x20, 0x53,
+            0x70, 0x65, 0x63, 0x69, 0x66, 0x69, 0x65, 0x64, 0x00, 0x46, 0x34, 0x2D, 0x33, 0x32, 0x30, 0x30,
+            0x43, 0x31, 0x36, 0x2D, 0x31, 0x36, 0x47, 0x56, 0x4B, 0x20, 0x20, 0x20, 0x20, 0x00, 0x00, 0x11,
+            0x54, 0x13, 0x00, 0x10, 0x00, 0xFE, 0xFF, 0x40, 0x00, 0x40, 0x00, 0x00, 0x00, 0x09, 0x00, 0x01,
+            0x02, 0x02, 0x00, 0x00, 0x00, 0x00, 0x03, 0x04, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x44, 0x49, 0x4D, 0x4D, 0x5F, 0x42, 0x31, 0x00, 0x42, 0x41, 0x4E, 0x4B, 0x20,
+            0x32, 0x00, 0x55, 0x6E, 0x6B, 0x6E, 0x6F, 0x77, 0x6E, 0x00, 0x55, 0x6E, 0x6B, 0x6E, 0x6F, 0x77,
+            0x6E, 0x00, 0x4E, 0x6F, 0x74, 0x20, 0x53, 0x70, 0x65, 0x63, 0x69, 0x66, 0x69, 0x65, 0x64, 0x00,
+            0x55, 0x6E, 0x6B, 0x6E, 0x6F, 0x77, 0x6E, 0x00, 0x00, 0x11, 0x54, 0x14, 0x00, 0x10, 0x00, 0xFE,
+            0xFF, 0x40, 0x00, 0x40, 0x00, 0x00, 0x40, 0x09, 0x00, 0x01, 0x02, 0x1A, 0x80, 0x00, 0x80, 0x0C,
+            0x03, 0x04, 0x05, 0x06, 0x02, 0x00, 0x00, 0x00, 0x00, 0x80, 0x0C, 0xB0, 0x04, 0xB0, 0x04, 0xB0,
+            0x04, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x49, 0x4D,
+            0x4D, 0x5F, 0x42, 0x32, 0x00, 0x42, 0x41, 0x4E, 0x4B, 0x20, 0x33, 0x00, 0x47, 0x20, 0x53, 0x6B,
+            0x69, 0x6C, 0x6C, 0x20, 0x49, 0x6E, 0x74, 0x6C, 0x00, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+            0x30, 0x00, 0x4E, 0x6F, 0x74, 0x20, 0x53, 0x70, 0x65, 0x63, 0x69, 0x66, 0x69, 0x65, 0x64, 0x00,
+            0x46, 0x34, 0x2D, 0x33, 0x32, 0x30, 0x30, 0x43, 0x31, 0x36, 0x2D, 0x31, 0x36, 0x47, 0x56, 0x4B,
+            0x20, 0x20, 0x20, 0x20, 0x00, 0x00, 0x7F, 0x04, 0xFF, 0xFE, 0x00, 0x00,
+          }, "American Megatrends Inc.", "2803", "ROG STRIX B550-F GAMING", 4, 2, 17179869184ULL, 3200 },
+    };
+    return list;
+}
+
+} // namespace Fixtures